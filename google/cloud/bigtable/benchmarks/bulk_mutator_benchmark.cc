@@ -0,0 +1,162 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/benchmarks/constants.h"
+#include "google/cloud/bigtable/internal/bulk_mutator.h"
+#include "google/cloud/testing_util/allocation_counter.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+/**
+ * @file
+ *
+ * Measure the CPU cost of `bigtable::internal::BulkMutator`.
+ *
+ * This benchmark does not contact Cloud Bigtable. For each batch size it
+ * creates a `BulkMutation` with that many rows (each with `kNumFields` cells),
+ * and simulates a `BulkApply()` where half of the mutations fail with a
+ * transient error and succeed on the retry. It reports the number of row
+ * mutations processed per second, and the number of heap allocations per
+ * `BulkApply()`, both for building the `BulkMutation` and for the
+ * `BulkMutator` bookkeeping.
+ *
+ * The responses are created before the measurement starts, their allocations
+ * are not included.
+ *
+ * Usage: bulk_mutator_benchmark [iterations]
+ */
+
+namespace {
+namespace bigtable = google::cloud::bigtable;
+namespace btproto = google::bigtable::v2;
+using google::cloud::testing_util::AllocationCount;
+
+constexpr int kBatchSizes[] = {1000, 2000, 5000, 10000};
+constexpr int kDefaultIterations = 10;
+
+/// Expose the steps of a request, which are normally driven by a DataClient.
+class BenchmarkMutator : public bigtable::internal::BulkMutator {
+ public:
+  using BulkMutator::BulkMutator;
+  using BulkMutator::FinishRequest;
+  using BulkMutator::PrepareForRequest;
+  using BulkMutator::ProcessResponse;
+};
+
+/// Create a response reporting @p code for the entries in [begin, end).
+btproto::MutateRowsResponse MakeResponse(int begin, int end,
+                                         grpc::StatusCode code) {
+  btproto::MutateRowsResponse response;
+  for (int i = begin; i != end; ++i) {
+    auto& e = *response.add_entries();
+    e.set_index(i);
+    e.mutable_status()->set_code(code);
+  }
+  return response;
+}
+
+/// Create a batch with @p row_count rows.
+bigtable::BulkMutation MakeBatch(int row_count, std::string const& value) {
+  bigtable::BulkMutation batch;
+  for (int row = 0; row != row_count; ++row) {
+    std::ostringstream os;
+    os << "user" << std::setw(12) << std::setfill('0') << row;
+    bigtable::SingleRowMutation mutation(os.str());
+    for (int field = 0; field != bigtable::benchmarks::kNumFields; ++field) {
+      mutation.emplace_back(bigtable::SetCell(
+          bigtable::benchmarks::kColumnFamily, "field" + std::to_string(field),
+          std::chrono::milliseconds(0), value));
+    }
+    batch.emplace_back(std::move(mutation));
+  }
+  return batch;
+}
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) try {
+  int iterations = kDefaultIterations;
+  if (argc > 1) {
+    iterations = std::stoi(argv[1]);
+  }
+  if (iterations <= 0) {
+    std::cerr << "Usage: " << argv[0] << " [iterations]" << std::endl;
+    return 1;
+  }
+
+  std::string const value(bigtable::benchmarks::kFieldSize, 'x');
+  auto policy = bigtable::DefaultIdempotentMutationPolicy();
+
+  std::cout << "# Cells per Row: " << bigtable::benchmarks::kNumFields
+            << "\n# Value Size: " << bigtable::benchmarks::kFieldSize
+            << "\n# Iterations: " << iterations << std::endl;
+  std::cout << "BatchSize,Iteration,ElapsedUs,MutationsPerSecond,"
+               "BuildAllocations,MutatorAllocations"
+            << std::endl;
+  for (int batch_size : kBatchSizes) {
+    int const half = batch_size / 2;
+    // The first request fails the first half of the batch, the retry contains
+    // only those mutations, and they all succeed.
+    auto const first = [&] {
+      auto r = MakeResponse(0, half, grpc::StatusCode::UNAVAILABLE);
+      r.MergeFrom(MakeResponse(half, batch_size, grpc::StatusCode::OK));
+      return r;
+    }();
+    auto const retry = MakeResponse(0, half, grpc::StatusCode::OK);
+
+    for (int i = 0; i != iterations; ++i) {
+      auto responses = std::make_pair(first, retry);
+
+      long const before_build = AllocationCount();
+      auto start = std::chrono::steady_clock::now();
+      auto batch = MakeBatch(batch_size, value);
+      long const build_allocations = AllocationCount() - before_build;
+
+      long const before_mutator = AllocationCount();
+      BenchmarkMutator mutator(bigtable::AppProfileId(""),
+                               bigtable::TableId("benchmark-table"), *policy,
+                               std::move(batch));
+      mutator.PrepareForRequest();
+      mutator.ProcessResponse(responses.first);
+      mutator.FinishRequest();
+      mutator.PrepareForRequest();
+      mutator.ProcessResponse(responses.second);
+      mutator.FinishRequest();
+      auto failures = mutator.ExtractFinalFailures();
+      auto elapsed = std::chrono::steady_clock::now() - start;
+      long const mutator_allocations = AllocationCount() - before_mutator;
+      if (mutator.HasPendingMutations() or not failures.empty()) {
+        std::cerr << "Unexpected failures in the simulated BulkApply()"
+                  << std::endl;
+        return 1;
+      }
+
+      using std::chrono::microseconds;
+      auto us = std::chrono::duration_cast<microseconds>(elapsed).count();
+      double mutations_per_second =
+          us == 0 ? 0.0 : batch_size * 1000000.0 / us;
+      std::cout << batch_size << "," << i << "," << us << "," << std::fixed
+                << std::setprecision(0) << mutations_per_second << ","
+                << build_allocations << "," << mutator_allocations
+                << std::endl;
+    }
+  }
+
+  return 0;
+} catch (std::exception const& ex) {
+  std::cerr << "Standard exception raised: " << ex.what() << std::endl;
+  return 1;
+}
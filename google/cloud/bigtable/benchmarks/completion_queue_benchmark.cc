@@ -0,0 +1,126 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/completion_queue.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @file
+ *
+ * Measure the throughput of `bigtable::CompletionQueue`.
+ *
+ * This benchmark does not contact Cloud Bigtable. For each thread count it
+ * starts that many threads running a `CompletionQueue`, and the same number of
+ * threads scheduling operations with `RunAsync()`. Every operation creates,
+ * registers, notifies and releases an asynchronous operation, which is the
+ * bookkeeping every asynchronous RPC pays. The benchmark reports the number of
+ * completed operations per second.
+ *
+ * Usage: completion_queue_benchmark [operations-per-thread]
+ */
+
+namespace {
+namespace bigtable = google::cloud::bigtable;
+
+constexpr int kThreadCounts[] = {1, 2, 4, 8, 16, 32};
+constexpr int kDefaultOperationsPerThread = 100000;
+constexpr int kIterations = 3;
+
+/// Run @p operations_per_thread operations from @p thread_count threads.
+std::chrono::microseconds RunIteration(int thread_count,
+                                       int operations_per_thread) {
+  bigtable::CompletionQueue cq;
+  std::vector<std::thread> runners;
+  for (int i = 0; i != thread_count; ++i) {
+    runners.emplace_back([&cq] { cq.Run(); });
+  }
+
+  long const expected = static_cast<long>(thread_count) * operations_per_thread;
+  std::atomic<long> completed(0);
+  std::mutex mu;
+  std::condition_variable cv;
+  bool done = false;
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> producers;
+  for (int i = 0; i != thread_count; ++i) {
+    producers.emplace_back([&] {
+      for (int j = 0; j != operations_per_thread; ++j) {
+        cq.RunAsync([&](bigtable::CompletionQueue&) {
+          if (++completed == expected) {
+            std::lock_guard<std::mutex> lk(mu);
+            done = true;
+            cv.notify_one();
+          }
+        });
+      }
+    });
+  }
+  for (auto& t : producers) {
+    t.join();
+  }
+  {
+    std::unique_lock<std::mutex> lk(mu);
+    cv.wait(lk, [&done] { return done; });
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+
+  cq.Shutdown();
+  for (auto& t : runners) {
+    t.join();
+  }
+  return std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+}
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) try {
+  int operations_per_thread = kDefaultOperationsPerThread;
+  if (argc > 1) {
+    operations_per_thread = std::stoi(argv[1]);
+  }
+  if (operations_per_thread <= 0) {
+    std::cerr << "Usage: " << argv[0] << " [operations-per-thread]"
+              << std::endl;
+    return 1;
+  }
+
+  std::cout << "# Operations per Thread: " << operations_per_thread
+            << "\n# Hardware Concurrency: "
+            << std::thread::hardware_concurrency() << std::endl;
+  std::cout << "ThreadCount,Iteration,ElapsedUs,OperationsPerSecond"
+            << std::endl;
+  for (int thread_count : kThreadCounts) {
+    for (int i = 0; i != kIterations; ++i) {
+      auto us = RunIteration(thread_count, operations_per_thread).count();
+      double ops_per_second =
+          us == 0 ? 0.0
+                  : thread_count * 1000000.0 * operations_per_thread / us;
+      std::cout << thread_count << "," << i << "," << us << "," << std::fixed
+                << std::setprecision(0) << ops_per_second << std::endl;
+    }
+  }
+
+  return 0;
+} catch (std::exception const& ex) {
+  std::cerr << "Standard exception raised: " << ex.what() << std::endl;
+  return 1;
+}
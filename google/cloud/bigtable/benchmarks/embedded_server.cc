@@ -40,7 +40,10 @@ namespace benchmarks {
 class BigtableImpl final : public btproto::Bigtable::Service {
  public:
   BigtableImpl()
-      : mutate_row_count_(0), mutate_rows_count_(0), read_rows_count_(0) {
+      : mutate_row_count_(0),
+        mutate_rows_count_(0),
+        read_rows_count_(0),
+        sample_row_keys_count_(0) {
     // Prepare a list of random values to use at run-time.  This is because we
     // want the overhead of this implementation to be as small as possible.
     // Using a single value is an option, but compresses too well and makes the
@@ -116,15 +119,39 @@ class BigtableImpl final : public btproto::Bigtable::Service {
     return grpc::Status::OK;
   }
 
+  grpc::Status SampleRowKeys(
+      grpc::ServerContext* context,
+      btproto::SampleRowKeysRequest const* request,
+      grpc::ServerWriter<btproto::SampleRowKeysResponse>* writer) override {
+    ++sample_row_keys_count_;
+    // Pretend the table has kDefaultTableSize rows split in 16 tablets, this
+    // is enough to exercise the parallel scans.
+    int const sample_count = 16;
+    for (int i = 1; i != sample_count + 1; ++i) {
+      btproto::SampleRowKeysResponse msg;
+      std::int64_t offset = kDefaultTableSize / sample_count * i;
+      if (i != sample_count) {
+        std::ostringstream os;
+        os << "user" << std::setw(12) << std::setfill('0') << offset;
+        msg.set_row_key(os.str());
+      }
+      msg.set_offset_bytes(offset * kNumFields * kFieldSize);
+      writer->Write(msg);
+    }
+    return grpc::Status::OK;
+  }
+
   int mutate_row_count() const { return mutate_row_count_.load(); }
   int mutate_rows_count() const { return mutate_rows_count_.load(); }
   int read_rows_count() const { return read_rows_count_.load(); }
+  int sample_row_keys_count() const { return sample_row_keys_count_.load(); }
 
  private:
   std::vector<std::string> values_;
   std::atomic<int> mutate_row_count_;
   std::atomic<int> mutate_rows_count_;
   std::atomic<int> read_rows_count_;
+  std::atomic<int> sample_row_keys_count_;
 };
 
 /**
@@ -191,6 +218,9 @@ class DefaultEmbeddedServer : public EmbeddedServer {
   int read_rows_count() const override {
     return bigtable_service_.read_rows_count();
   }
+  int sample_row_keys_count() const override {
+    return bigtable_service_.sample_row_keys_count();
+  }
 
  private:
   BigtableImpl bigtable_service_;
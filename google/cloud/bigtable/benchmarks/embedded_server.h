@@ -44,6 +44,7 @@ class EmbeddedServer {
   virtual int mutate_row_count() const = 0;
   virtual int mutate_rows_count() const = 0;
   virtual int read_rows_count() const = 0;
+  virtual int sample_row_keys_count() const = 0;
 };
 
 /// Create an embedded server.
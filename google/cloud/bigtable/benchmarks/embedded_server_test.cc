@@ -145,3 +145,23 @@ TEST(EmbeddedServer, ReadRows100) {
   server->Shutdown();
   wait_thread.join();
 }
+
+TEST(EmbeddedServer, SampleRowKeys) {
+  auto server = CreateEmbeddedServer();
+  std::thread wait_thread([&server]() { server->Wait(); });
+
+  bigtable::ClientOptions options(grpc::InsecureChannelCredentials());
+  options.set_data_endpoint(server->address());
+  bigtable::Table table(bigtable::CreateDefaultDataClient(
+                            "fake-project", "fake-instance", options),
+                        "fake-table");
+
+  EXPECT_EQ(0, server->sample_row_keys_count());
+  auto samples = table.SampleRows<std::vector>();
+  ASSERT_FALSE(samples.empty());
+  EXPECT_TRUE(samples.back().row_key.empty());
+  EXPECT_EQ(1, server->sample_row_keys_count());
+
+  server->Shutdown();
+  wait_thread.join();
+}
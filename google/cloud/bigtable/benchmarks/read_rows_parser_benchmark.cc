@@ -0,0 +1,147 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/benchmarks/constants.h"
+#include "google/cloud/bigtable/internal/readrowsparser.h"
+#include "google/cloud/testing_util/allocation_counter.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ *
+ * Measure the CPU cost of `bigtable::internal::ReadRowsParser`.
+ *
+ * This benchmark does not contact Cloud Bigtable. It creates the chunks that
+ * the service would return for a scan over a "typical" table (one column
+ * family, `kNumFields` columns, and `kFieldSize` bytes per value), feeds them
+ * to the parser, and reports the number of cells parsed per second and the
+ * number of heap allocations per row.
+ *
+ * The allocation count includes only the allocations made while parsing, the
+ * chunks are created (and copied) before the measurement starts.
+ *
+ * Usage: read_rows_parser_benchmark [row-count] [iterations]
+ */
+
+namespace {
+namespace bigtable = google::cloud::bigtable;
+using google::bigtable::v2::ReadRowsResponse_CellChunk;
+using google::cloud::testing_util::AllocationCount;
+
+constexpr long kDefaultRowCount = 10000;
+constexpr int kDefaultIterations = 10;
+
+/// Create the chunks returned by a scan over @p row_count rows.
+std::vector<ReadRowsResponse_CellChunk> MakeChunks(long row_count) {
+  std::vector<ReadRowsResponse_CellChunk> chunks;
+  chunks.reserve(
+      static_cast<std::size_t>(row_count * bigtable::benchmarks::kNumFields));
+  for (long row = 0; row != row_count; ++row) {
+    std::ostringstream os;
+    os << "user" << std::setw(12) << std::setfill('0') << row;
+    for (int field = 0; field != bigtable::benchmarks::kNumFields; ++field) {
+      ReadRowsResponse_CellChunk chunk;
+      // Like the service, only send the row key and family when they change.
+      if (field == 0) {
+        chunk.set_row_key(os.str());
+        chunk.mutable_family_name()->set_value(
+            bigtable::benchmarks::kColumnFamily);
+      }
+      chunk.mutable_qualifier()->set_value("field" + std::to_string(field));
+      chunk.set_timestamp_micros(1000 * row);
+      chunk.set_value(std::string(bigtable::benchmarks::kFieldSize, 'x'));
+      if (field == bigtable::benchmarks::kNumFields - 1) {
+        chunk.set_commit_row(true);
+      }
+      chunks.emplace_back(std::move(chunk));
+    }
+  }
+  return chunks;
+}
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) try {
+  long row_count = kDefaultRowCount;
+  int iterations = kDefaultIterations;
+  if (argc > 1) {
+    row_count = std::stol(argv[1]);
+  }
+  if (argc > 2) {
+    iterations = std::stoi(argv[2]);
+  }
+  if (row_count <= 0 or iterations <= 0) {
+    std::cerr << "Usage: " << argv[0] << " [row-count] [iterations]"
+              << std::endl;
+    return 1;
+  }
+
+  auto const prototype = MakeChunks(row_count);
+
+  std::cout << "# Row Count: " << row_count
+            << "\n# Cells per Row: " << bigtable::benchmarks::kNumFields
+            << "\n# Value Size: " << bigtable::benchmarks::kFieldSize
+            << "\n# Iterations: " << iterations << std::endl;
+  std::cout << "Iteration,CellCount,ElapsedUs,CellsPerSecond,AllocationsPerRow"
+            << std::endl;
+  for (int i = 0; i != iterations; ++i) {
+    // Parsing consumes the chunks, make a fresh copy for each iteration.
+    auto chunks = prototype;
+    std::vector<bigtable::Row> rows;
+    rows.reserve(static_cast<std::size_t>(row_count));
+
+    grpc::Status status;
+    bigtable::internal::ReadRowsParser parser;
+    long const allocations_before = AllocationCount();
+    auto start = std::chrono::steady_clock::now();
+    for (auto& chunk : chunks) {
+      parser.HandleChunk(std::move(chunk), status);
+      if (not status.ok()) {
+        break;
+      }
+      if (parser.HasNext()) {
+        rows.emplace_back(parser.Next(status));
+      }
+    }
+    parser.HandleEndOfStream(status);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    long const allocations = AllocationCount() - allocations_before;
+    if (not status.ok()) {
+      std::cerr << "Parser error: " << status.error_message() << std::endl;
+      return 1;
+    }
+
+    long cell_count = 0;
+    for (auto const& r : rows) {
+      cell_count += static_cast<long>(r.cells().size());
+    }
+    using std::chrono::microseconds;
+    auto us = std::chrono::duration_cast<microseconds>(elapsed).count();
+    double cells_per_second = us == 0 ? 0.0 : cell_count * 1000000.0 / us;
+    std::cout << i << "," << cell_count << "," << us << "," << std::fixed
+              << std::setprecision(0) << cells_per_second << ","
+              << std::setprecision(2)
+              << static_cast<double>(allocations) / rows.size() << std::endl;
+  }
+
+  return 0;
+} catch (std::exception const& ex) {
+  std::cerr << "Standard exception raised: " << ex.what() << std::endl;
+  return 1;
+}
@@ -0,0 +1,172 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/resumable_row_set.h"
+#include "google/cloud/testing_util/allocation_counter.h"
+#include <google/bigtable/v2/bigtable.pb.h>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ *
+ * Measure the CPU cost of resuming a `ReadRows` scan over a large `RowSet`.
+ *
+ * This benchmark does not contact Cloud Bigtable. For each set size it creates
+ * a `RowSet` with that many explicit row keys, and simulates a scan that fails
+ * `kRetries` times, at evenly spaced keys. Each retry computes the rows
+ * remaining and builds the protobuf for the next request, first as the readers
+ * used to, with `RowSet::Intersect()` and a copy of the `RowSet` protobuf, and
+ * then with `bigtable::internal::ResumableRowSet`. It reports the elapsed time
+ * and the number of heap allocations for each approach, including the initial
+ * request and, for `ResumableRowSet`, its construction.
+ *
+ * Usage: row_set_resume_benchmark [iterations]
+ */
+
+namespace {
+namespace bigtable = google::cloud::bigtable;
+namespace btproto = google::bigtable::v2;
+using google::cloud::testing_util::AllocationCount;
+
+constexpr int kSetSizes[] = {10000, 20000, 50000, 100000};
+constexpr int kRetries = 10;
+constexpr int kDefaultIterations = 5;
+
+std::string MakeKey(int row) {
+  std::ostringstream os;
+  os << "user" << std::setw(12) << std::setfill('0') << row;
+  return os.str();
+}
+
+/// Create a set with @p keys, in the same order.
+bigtable::RowSet MakeRowSet(std::vector<std::string> const& keys) {
+  bigtable::RowSet row_set;
+  for (auto const& k : keys) {
+    row_set.Append(k);
+  }
+  return row_set;
+}
+
+/// Simulate a request, return something that depends on the protobuf so the
+/// work cannot be optimized away.
+int SendRequest(btproto::RowSet row_set) {
+  btproto::ReadRowsRequest request;
+  request.mutable_rows()->Swap(&row_set);
+  return request.rows().row_keys_size() + request.rows().row_ranges_size();
+}
+
+int ScanWithIntersect(bigtable::RowSet row_set,
+                      std::vector<std::string> const& resume_keys) {
+  int total = SendRequest(row_set.as_proto());
+  for (auto const& last : resume_keys) {
+    row_set = row_set.Intersect(bigtable::RowRange::Open(last, ""));
+    if (row_set.IsEmpty()) {
+      break;
+    }
+    total += SendRequest(row_set.as_proto());
+  }
+  return total;
+}
+
+int ScanWithResumable(bigtable::RowSet const& original,
+                      std::vector<std::string> const& resume_keys) {
+  bigtable::internal::ResumableRowSet row_set(original);
+  int total = SendRequest(row_set.as_proto());
+  for (auto const& last : resume_keys) {
+    row_set.AdvancePast(last);
+    if (row_set.IsEmpty()) {
+      break;
+    }
+    total += SendRequest(row_set.as_proto());
+  }
+  return total;
+}
+
+struct Measurement {
+  long elapsed_us;
+  long allocations;
+  int total;
+};
+
+template <typename Functor>
+Measurement Measure(Functor&& functor) {
+  long const before = AllocationCount();
+  auto start = std::chrono::steady_clock::now();
+  int total = functor();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  long const allocations = AllocationCount() - before;
+  using std::chrono::microseconds;
+  return Measurement{
+      static_cast<long>(
+          std::chrono::duration_cast<microseconds>(elapsed).count()),
+      allocations, total};
+}
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) try {
+  int iterations = kDefaultIterations;
+  if (argc > 1) {
+    iterations = std::stoi(argv[1]);
+  }
+  if (iterations <= 0) {
+    std::cerr << "Usage: " << argv[0] << " [iterations]" << std::endl;
+    return 1;
+  }
+
+  std::cout << "# Retries per Scan: " << kRetries
+            << "\n# Iterations: " << iterations << std::endl;
+  std::cout << "SetSize,Iteration,IntersectUs,IntersectAllocations,"
+               "ResumableUs,ResumableAllocations"
+            << std::endl;
+  for (int set_size : kSetSizes) {
+    // Use the keys in reverse order, applications rarely sort them.
+    std::vector<std::string> keys;
+    keys.reserve(set_size);
+    for (int row = set_size - 1; row >= 0; --row) {
+      keys.push_back(MakeKey(row));
+    }
+    std::vector<std::string> resume_keys;
+    for (int i = 1; i != kRetries + 1; ++i) {
+      resume_keys.push_back(MakeKey(set_size * i / (kRetries + 1)));
+    }
+
+    for (int i = 0; i != iterations; ++i) {
+      auto row_set = MakeRowSet(keys);
+      // The readers own their RowSet, do not measure the cost of a copy.
+      auto copy = row_set;
+      auto intersect = Measure(
+          [&] { return ScanWithIntersect(std::move(copy), resume_keys); });
+      auto resumable = Measure(
+          [&] { return ScanWithResumable(row_set, resume_keys); });
+      if (intersect.total != resumable.total) {
+        std::cerr << "Mismatched requests: " << intersect.total
+                  << " != " << resumable.total << std::endl;
+        return 1;
+      }
+      std::cout << set_size << "," << i << "," << intersect.elapsed_us << ","
+                << intersect.allocations << "," << resumable.elapsed_us << ","
+                << resumable.allocations << std::endl;
+    }
+  }
+
+  return 0;
+} catch (std::exception const& ex) {
+  std::cerr << "Standard exception raised: " << ex.what() << std::endl;
+  return 1;
+}
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "google/cloud/bigtable/benchmarks/benchmark.h"
+#include <atomic>
 #include <chrono>
 #include <future>
 #include <iomanip>
@@ -47,6 +48,17 @@
  * The benchmark will report throughput in rows per second for each scans with
  * 100, 1,000 and 10,000 rows.
  *
+ * Then the benchmark measures `bigtable::Table::ParallelReadRows()`:
+ *
+ * - Execute the following block with 1, 2, 4, ... streams, up to the number
+ *   of threads configured for the benchmark:
+ *   - Execute the following loop for S seconds:
+ *     - Pick one of the 10,000,000 keys at random, with uniform probability.
+ *     - Scan the 100,000 rows starting at that key using `ParallelReadRows()`.
+ *
+ * The benchmark reports the latency of each parallel scan, which shows how
+ * the scan time decreases (or not) as the number of streams grows.
+ *
  * Using a command-line parameter the benchmark can be configured to create a
  * local gRPC server that implements the Cloud Bigtable APIs used by the
  * benchmark.  If this parameter is not used, the benchmark uses the default
@@ -60,6 +72,7 @@ namespace bigtable = google::cloud::bigtable;
 using namespace bigtable::benchmarks;
 
 constexpr int kScanSizes[] = {100, 1000, 10000};
+constexpr long kParallelScanSize = 100000;
 
 /// Run an iteration of the test.
 BenchmarkResult RunBenchmark(bigtable::benchmarks::Benchmark const& benchmark,
@@ -68,6 +81,13 @@ BenchmarkResult RunBenchmark(bigtable::benchmarks::Benchmark const& benchmark,
                              bigtable::AppProfileId app_profile_id,
                              std::string const& table_id, long scan_size,
                              std::chrono::seconds test_duration);
+
+/// Run an iteration of the parallel scan test.
+BenchmarkResult RunParallelBenchmark(
+    bigtable::benchmarks::Benchmark const& benchmark,
+    std::shared_ptr<bigtable::DataClient> data_client, long table_size,
+    bigtable::AppProfileId app_profile_id, std::string const& table_id,
+    std::size_t concurrency, std::chrono::seconds test_duration);
 }  // anonymous namespace
 
 int main(int argc, char* argv[]) try {
@@ -101,6 +121,26 @@ int main(int argc, char* argv[]) try {
     results_by_size[op_name] = std::move(combined);
   }
 
+  for (int concurrency = 1; concurrency <= setup.thread_count();
+       concurrency *= 2) {
+    std::cout << "# Running parallel benchmark [" << concurrency << "] "
+              << std::flush;
+    auto start = std::chrono::steady_clock::now();
+    auto combined = RunParallelBenchmark(
+        benchmark, data_client, setup.table_size(),
+        bigtable::AppProfileId(setup.app_profile_id()), setup.table_id(),
+        static_cast<std::size_t>(concurrency), setup.test_duration());
+    using std::chrono::duration_cast;
+    combined.elapsed = duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+    std::cout << " DONE. Elapsed=" << FormatDuration(combined.elapsed)
+              << ", Ops=" << combined.operations.size()
+              << ", Rows=" << combined.row_count << std::endl;
+    auto op_name = "ParallelScan(" + std::to_string(concurrency) + ")";
+    benchmark.PrintLatencyResult(std::cout, "scant", op_name, combined);
+    results_by_size[op_name] = std::move(combined);
+  }
+
   std::cout << bigtable::benchmarks::Benchmark::ResultsCsvHeader() << std::endl;
   benchmark.PrintResultCsv(std::cout, "scant", "BulkApply()", "Latency",
                            populate_results);
@@ -150,4 +190,37 @@ BenchmarkResult RunBenchmark(bigtable::benchmarks::Benchmark const& benchmark,
   return result;
 }
 
+BenchmarkResult RunParallelBenchmark(
+    bigtable::benchmarks::Benchmark const& benchmark,
+    std::shared_ptr<bigtable::DataClient> data_client, long table_size,
+    bigtable::AppProfileId app_profile_id, std::string const& table_id,
+    std::size_t concurrency, std::chrono::seconds test_duration) {
+  BenchmarkResult result = {};
+
+  bigtable::Table table(std::move(data_client), app_profile_id, table_id);
+
+  auto generator = google::cloud::internal::MakeDefaultPRNG();
+  std::uniform_int_distribution<long> prng(0,
+                                           table_size - kParallelScanSize - 1);
+
+  auto test_start = std::chrono::steady_clock::now();
+  while (std::chrono::steady_clock::now() < test_start + test_duration) {
+    auto start = prng(generator);
+    auto range = bigtable::RowRange::RightOpen(
+        benchmark.MakeKey(start), benchmark.MakeKey(start + kParallelScanSize));
+
+    std::atomic<long> count(0);
+    auto op = [&count, &table, &range, concurrency]() {
+      table.ParallelReadRows(
+          bigtable::RowSet(std::move(range)),
+          bigtable::Filter::ColumnRangeClosed(kColumnFamily, "field0",
+                                              "field9"),
+          concurrency, [&count](bigtable::Row) { ++count; });
+    };
+    result.operations.push_back(Benchmark::TimeOperation(op));
+    result.row_count += count.load();
+  }
+  return result;
+}
+
 }  // anonymous namespace
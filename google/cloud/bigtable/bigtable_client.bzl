@@ -28,6 +28,7 @@ bigtable_client_hdrs = [
     "cluster_config.h",
     "column_family.h",
     "completion_queue.h",
+    "completion_queue_pool.h",
     "data_client.h",
     "filters.h",
     "grpc_error.h",
@@ -35,6 +36,7 @@ bigtable_client_hdrs = [
     "instance_admin.h",
     "instance_config.h",
     "instance_update_config.h",
+    "internal/async_batcher.h",
     "internal/async_bulk_apply.h",
     "internal/async_check_consistency.h",
     "internal/async_future_from_callback.h",
@@ -52,7 +54,9 @@ bigtable_client_hdrs = [
     "internal/async_retry_unary_rpc.h",
     "internal/async_retry_unary_rpc_and_poll.h",
     "internal/async_row_reader.h",
+    "internal/async_row_stream.h",
     "internal/bulk_mutator.h",
+    "internal/channel_load.h",
     "internal/completion_queue_impl.h",
     "internal/common_client.h",
     "internal/conjunction.h",
@@ -63,6 +67,9 @@ bigtable_client_hdrs = [
     "internal/poll_longrunning_operation.h",
     "internal/prefix_range_end.h",
     "internal/readrowsparser.h",
+    "internal/resumable_row_set.h",
+    "internal/row_prefetch_queue.h",
+    "internal/row_set_partition.h",
     "internal/rpc_policy_parameters.inc",
     "internal/rpc_policy_parameters.h",
     "internal/rowreaderiterator.h",
@@ -71,12 +78,15 @@ bigtable_client_hdrs = [
     "internal/table_admin.h",
     "internal/unary_client_utils.h",
     "idempotent_mutation_policy.h",
+    "mutation_batcher.h",
     "mutations.h",
     "polling_policy.h",
     "read_modify_write_rule.h",
+    "read_row_batcher.h",
     "row.h",
     "row_key_sample.h",
     "row_range.h",
+    "row_cache.h",
     "row_reader.h",
     "row_set.h",
     "rpc_backoff_policy.h",
@@ -95,12 +105,14 @@ bigtable_client_srcs = [
     "client_options.cc",
     "cluster_config.cc",
     "completion_queue.cc",
+    "completion_queue_pool.cc",
     "data_client.cc",
     "grpc_error.cc",
     "instance_admin_client.cc",
     "instance_admin.cc",
     "instance_config.cc",
     "instance_update_config.cc",
+    "internal/async_row_stream.cc",
     "internal/async_sample_row_keys.cc",
     "internal/bulk_mutator.cc",
     "internal/completion_queue_impl.cc",
@@ -110,13 +122,19 @@ bigtable_client_srcs = [
     "internal/instance_admin.cc",
     "internal/prefix_range_end.cc",
     "internal/readrowsparser.cc",
+    "internal/resumable_row_set.cc",
+    "internal/row_prefetch_queue.cc",
+    "internal/row_set_partition.cc",
     "internal/rowreaderiterator.cc",
     "internal/table.cc",
     "internal/table_admin.cc",
     "idempotent_mutation_policy.cc",
+    "mutation_batcher.cc",
     "mutations.cc",
     "polling_policy.cc",
+    "read_row_batcher.cc",
     "row_range.cc",
+    "row_cache.cc",
     "row_reader.cc",
     "row_set.cc",
     "rpc_backoff_policy.cc",
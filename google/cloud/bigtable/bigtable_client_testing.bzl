@@ -17,6 +17,7 @@
 """Automatically generated source lists for bigtable_client_testing - DO NOT EDIT."""
 
 bigtable_client_testing_hdrs = [
+    "testing/batcher_test_fixture.h",
     "testing/embedded_server_test_fixture.h",
     "testing/internal_table_test_fixture.h",
     "testing/mock_admin_client.h",
@@ -24,6 +24,7 @@ bigtable_client_unit_tests = [
     "client_options_test.cc",
     "cluster_config_test.cc",
     "column_family_test.cc",
+    "completion_queue_pool_test.cc",
     "completion_queue_test.cc",
     "data_client_test.cc",
     "filters_test.cc",
@@ -45,16 +46,23 @@ bigtable_client_unit_tests = [
     "internal/async_retry_op_test.cc",
     "internal/async_retry_unary_rpc_and_poll_test.cc",
     "internal/bulk_mutator_test.cc",
+    "internal/channel_load_test.cc",
+    "internal/common_client_test.cc",
     "internal/table_async_check_and_mutate_row_test.cc",
     "internal/instance_admin_test.cc",
     "internal/grpc_error_delegate_test.cc",
     "internal/prefix_range_end_test.cc",
+    "internal/resumable_row_set_test.cc",
+    "internal/row_prefetch_queue_test.cc",
+    "internal/row_set_partition_test.cc",
     "internal/table_admin_test.cc",
     "internal/table_async_apply_test.cc",
     "internal/table_async_bulk_apply_test.cc",
+    "internal/table_async_read_rows_stream_test.cc",
     "internal/table_async_row_reader_test.cc",
     "internal/table_async_sample_row_keys_test.cc",
     "internal/table_test.cc",
+    "mutation_batcher_test.cc",
     "mutations_test.cc",
     "table_admin_test.cc",
     "table_apply_test.cc",
@@ -67,6 +75,8 @@ bigtable_client_unit_tests = [
     "table_test.cc",
     "table_readmodifywriterow_test.cc",
     "read_modify_write_rule_test.cc",
+    "read_row_batcher_test.cc",
+    "row_cache_test.cc",
     "row_reader_test.cc",
     "row_test.cc",
     "row_range_test.cc",
@@ -19,6 +19,7 @@
 #include "google/cloud/bigtable/version.h"
 
 #include <chrono>
+#include <memory>
 #include <vector>
 
 namespace google {
@@ -34,7 +35,9 @@ inline namespace BIGTABLE_CLIENT_NS {
  * storage is sparse, column families, columns, and timestamps might contain
  * zero cells.
  *
- * The Cell class owns all its data.
+ * The Cell class owns all its data. Cells returned by the same read may share
+ * their (immutable) row key and column family name, copying a Cell is cheaper
+ * than copying each of its fields.
  */
 class Cell {
  public:
@@ -42,31 +45,51 @@ class Cell {
   Cell(std::string row_key, std::string family_name,
        std::string column_qualifier, std::int64_t timestamp, std::string value,
        std::vector<std::string> labels)
+      : row_key_(std::make_shared<std::string const>(std::move(row_key))),
+        family_name_(
+            std::make_shared<std::string const>(std::move(family_name))),
+        column_qualifier_(std::move(column_qualifier)),
+        value_(std::move(value)),
+        labels_(std::move(labels)),
+        timestamp_(timestamp) {}
+
+  /**
+   * Create a Cell sharing the row key and family name with other cells.
+   *
+   * The ReadRows parser uses this constructor, all the cells in a row share a
+   * single copy of the row key, and all the cells in a column family share a
+   * single copy of the family name.
+   */
+  Cell(std::shared_ptr<std::string const> row_key,
+       std::shared_ptr<std::string const> family_name,
+       std::string column_qualifier, std::int64_t timestamp, std::string value,
+       std::vector<std::string> labels)
       : row_key_(std::move(row_key)),
         family_name_(std::move(family_name)),
         column_qualifier_(std::move(column_qualifier)),
-        timestamp_(timestamp),
         value_(std::move(value)),
-        labels_(std::move(labels)) {}
+        labels_(std::move(labels)),
+        timestamp_(timestamp) {}
 
   /// Create a Cell and fill it with bigendian 64 bit value.
   Cell(std::string row_key, std::string family_name,
        std::string column_qualifier, std::int64_t timestamp,
        bigendian64_t value, std::vector<std::string> labels)
-      : row_key_(std::move(row_key)),
-        family_name_(std::move(family_name)),
+      : row_key_(std::make_shared<std::string const>(std::move(row_key))),
+        family_name_(
+            std::make_shared<std::string const>(std::move(family_name))),
         column_qualifier_(std::move(column_qualifier)),
-        timestamp_(timestamp),
         value_(google::cloud::bigtable::internal::AsBigEndian64(value)),
-        labels_(std::move(labels)) {}
+        labels_(std::move(labels)),
+        timestamp_(timestamp) {}
 
   /// Return the row key this cell belongs to. The returned value is not valid
   /// after this object is deleted.
-  std::string const& row_key() const { return row_key_; }
+  std::string const& row_key() const { return *row_key_; }
 
   /// Return the family this cell belongs to. The returned value is not valid
   /// after this object is deleted.
-  std::string const& family_name() const { return family_name_; }
+  std::string const& family_name() const { return *family_name_; }
 
   /// Return the column this cell belongs to. The returned value is not valid
   /// after this object is deleted.
@@ -99,12 +122,14 @@ class Cell {
   std::vector<std::string> const& labels() const { return labels_; }
 
  private:
-  std::string row_key_;
-  std::string family_name_;
+  std::shared_ptr<std::string const> row_key_;
+  std::shared_ptr<std::string const> family_name_;
   std::string column_qualifier_;
-  std::int64_t timestamp_;
   std::string value_;
+  // An empty vector does not allocate, cells without labels (the common case)
+  // pay only for the vector itself.
   std::vector<std::string> labels_;
+  std::int64_t timestamp_;
 };
 
 }  // namespace BIGTABLE_CLIENT_NS
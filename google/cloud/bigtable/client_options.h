@@ -18,6 +18,7 @@
 #include "google/cloud/bigtable/version.h"
 #include "google/cloud/internal/throw_delegate.h"
 #include <grpcpp/grpcpp.h>
+#include <chrono>
 
 namespace google {
 namespace cloud {
@@ -114,6 +115,42 @@ class ClientOptions {
   }
   std::size_t connection_pool_size() const { return connection_pool_size_; }
 
+  /**
+   * Connect all the channels in the pool when the client is created.
+   *
+   * By default each channel connects on its first call, and that call pays
+   * for the TCP, TLS, and HTTP/2 handshakes.  With a non-zero @p timeout the
+   * client starts connecting all the channels as soon as it is created, and
+   * waits up to @p timeout for them to become ready.  The default is zero,
+   * which disables the pre-connection.
+   */
+  ClientOptions& set_preconnect_timeout(std::chrono::milliseconds timeout) {
+    preconnect_timeout_ = timeout;
+    return *this;
+  }
+  std::chrono::milliseconds preconnect_timeout() const {
+    return preconnect_timeout_;
+  }
+
+  /**
+   * Replace the channels in the pool before they reach @p max_age.
+   *
+   * The service closes connections after some time, calls that arrive while a
+   * connection is being re-established see higher latency.  With a non-zero
+   * @p max_age the client replaces each channel before it reaches that age.
+   * The replacement starts connecting on the first call after the channel
+   * expires, and receives calls only once it is ready, meanwhile the old
+   * channel keeps serving calls.  Channels are replaced one at a time, with
+   * their expiration spread over the second half of @p max_age.  Applications
+   * should use a value smaller than the service connection age limit.  The
+   * default is zero, which disables the replacement.
+   */
+  ClientOptions& set_max_channel_age(std::chrono::milliseconds max_age) {
+    max_channel_age_ = max_age;
+    return *this;
+  }
+  std::chrono::milliseconds max_channel_age() const { return max_channel_age_; }
+
   /// Return the current credentials.
   std::shared_ptr<grpc::ChannelCredentials> credentials() const {
     return credentials_;
@@ -300,6 +337,8 @@ class ClientOptions {
   grpc::ChannelArguments channel_arguments_;
   std::string connection_pool_name_;
   std::size_t connection_pool_size_;
+  std::chrono::milliseconds preconnect_timeout_;
+  std::chrono::milliseconds max_channel_age_;
   std::string data_endpoint_;
   std::string admin_endpoint_;
   // The endpoint for instance admin operations, in most scenarios this should
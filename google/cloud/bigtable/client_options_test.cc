@@ -165,6 +165,25 @@ TEST(ClientOptionsTest, InvalidConnectionPoolSize) {
 #endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
 }
 
+TEST(ClientOptionsTest, EditPreconnectTimeout) {
+  bigtable::ClientOptions client_options_object;
+  EXPECT_EQ(0, client_options_object.preconnect_timeout().count());
+  auto& returned = client_options_object.set_preconnect_timeout(
+      std::chrono::milliseconds(500));
+  EXPECT_EQ(&returned, &client_options_object);
+  EXPECT_EQ(500, returned.preconnect_timeout().count());
+}
+
+TEST(ClientOptionsTest, EditMaxChannelAge) {
+  bigtable::ClientOptions client_options_object;
+  EXPECT_EQ(0, client_options_object.max_channel_age().count());
+  auto& returned =
+      client_options_object.set_max_channel_age(std::chrono::minutes(45));
+  EXPECT_EQ(&returned, &client_options_object);
+  EXPECT_EQ(std::chrono::milliseconds(std::chrono::minutes(45)),
+            returned.max_channel_age());
+}
+
 TEST(ClientOptionsTest, SetGrpclbFallbackTimeoutMS) {
   // Test milliseconds are set properly to channel_arguments
   bigtable::ClientOptions client_options_object = bigtable::ClientOptions();
@@ -205,6 +205,52 @@ class CompletionQueue {
     return op;
   }
 
+  /**
+   * Make an asynchronous unary RPC with streamed response and flow control.
+   *
+   * Unlike `MakeUnaryStreamRpc()`, the stream does not read any responses until
+   * the caller grants credits with `RequestRead()` on the returned operation,
+   * one credit per response. This keeps the memory used by slow consumers
+   * bounded without blocking the threads running the completion queue.
+   *
+   * The parameters and template parameters have the same requirements as in
+   * `MakeUnaryStreamRpc()`.
+   *
+   * @return an operation that can be used to grant credits or to request
+   *   cancelation of the stream.
+   */
+  template <typename Client, typename MemberFunction, typename Request,
+            typename DataFunctor, typename FinishedFunctor,
+            typename Sig =
+                internal::CheckAsyncUnaryStreamRpcSignature<MemberFunction>,
+            typename std::enable_if<Sig::value, int>::type
+                valid_member_function_type = 0,
+            typename std::enable_if<
+                internal::CheckUnaryStreamRpcDataCallback<
+                    DataFunctor, typename Sig::ResponseType>::value,
+                int>::type valid_data_callback_type = 0,
+            typename std::enable_if<
+                internal::CheckUnaryStreamRpcFinishedCallback<
+                    FinishedFunctor, typename Sig::ResponseType>::value,
+                int>::type valid_finished_callback_type = 0>
+  std::shared_ptr<internal::AsyncFlowControlledOperation>
+  MakeFlowControlledStreamRpc(Client& client, MemberFunction Client::*call,
+                              Request const& request,
+                              std::unique_ptr<grpc::ClientContext> context,
+                              DataFunctor&& data_functor,
+                              FinishedFunctor&& finished_functor) {
+    static_assert(std::is_same<typename Sig::RequestType,
+                               typename std::decay<Request>::type>::value,
+                  "Mismatched pointer to member function and request types");
+    auto op = std::make_shared<internal::AsyncFlowControlledStreamRpcFunctor<
+        typename Sig::RequestType, typename Sig::ResponseType, DataFunctor,
+        FinishedFunctor>>(std::forward<DataFunctor>(data_functor),
+                          std::forward<FinishedFunctor>(finished_functor));
+    void* tag = impl_->RegisterOperation(op);
+    op->Set(client, call, std::move(context), request, &impl_->cq(), tag);
+    return op;
+  }
+
   /**
    * Asynchronously run a functor on a thread `Run()`ning the `CompletionQueue`.
    *
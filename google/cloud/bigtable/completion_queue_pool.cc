@@ -0,0 +1,85 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/completion_queue_pool.h"
+#include "google/cloud/internal/throw_delegate.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+std::size_t DefaultQueueCount() {
+  // As in ClientOptions, the value returned by hardware_concurrency() is only
+  // a hint and it may be 0.
+  return (std::max)(1U, std::thread::hardware_concurrency());
+}
+}  // namespace
+
+CompletionQueuePool::CompletionQueuePool()
+    : CompletionQueuePool(DefaultQueueCount(), DefaultQueueCount()) {}
+
+CompletionQueuePool::CompletionQueuePool(std::size_t queue_count,
+                                         std::size_t thread_count,
+                                         std::size_t callback_thread_count)
+    : next_(0), shutdown_(false) {
+  if (queue_count == 0) {
+    google::cloud::internal::ThrowInvalidArgument(
+        "CompletionQueuePool requires queue_count > 0");
+  }
+  queues_.resize(queue_count);
+  thread_count = (std::max)(thread_count, queue_count);
+  for (std::size_t i = 0; i != thread_count; ++i) {
+    CompletionQueue cq = queues_[i % queue_count];
+    threads_.emplace_back([cq]() mutable { cq.Run(); });
+  }
+  if (callback_thread_count == 0) {
+    return;
+  }
+  // All the callback threads share one queue, so any idle thread can pick up
+  // the next callback.
+  callback_queues_.resize(1);
+  for (std::size_t i = 0; i != callback_thread_count; ++i) {
+    CompletionQueue cq = callback_queues_.front();
+    callback_threads_.emplace_back([cq]() mutable { cq.Run(); });
+  }
+}
+
+CompletionQueuePool::~CompletionQueuePool() { Shutdown(); }
+
+void CompletionQueuePool::Shutdown() {
+  if (shutdown_.exchange(true)) {
+    return;
+  }
+  for (auto& cq : queues_) {
+    cq.Shutdown();
+  }
+  // Callbacks wrapped by `Offload()` schedule work on the callback queue from
+  // the pool threads, shutting it down before they finish would break them.
+  for (auto& t : threads_) {
+    t.join();
+  }
+  for (auto& cq : callback_queues_) {
+    cq.Shutdown();
+  }
+  for (auto& t : callback_threads_) {
+    t.join();
+  }
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,168 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_COMPLETION_QUEUE_POOL_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_COMPLETION_QUEUE_POOL_H_
+
+#include "google/cloud/bigtable/completion_queue.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+/**
+ * Wrap a callback to run it on a different `CompletionQueue`.
+ *
+ * The arguments are copied, and the wrapped callback is scheduled using
+ * `CompletionQueue::RunAsync()` on the @p executor queue, with that queue as
+ * its first argument.
+ */
+template <typename Functor>
+class OffloadedCallback {
+ public:
+  OffloadedCallback(CompletionQueue executor, Functor functor)
+      : executor_(std::move(executor)),
+        functor_(std::make_shared<Functor>(std::move(functor))) {}
+
+  template <typename... Args>
+  void operator()(CompletionQueue&, Args&&... args) const {
+    using Bound = decltype(std::bind(std::ref(std::declval<Functor&>()),
+                                     std::placeholders::_1,
+                                     std::forward<Args>(args)...));
+    auto functor = functor_;
+    // The bound call is held by a shared_ptr because `RunAsync()` invokes
+    // a const copy of its callback, and the callback may take its arguments
+    // by non-const reference.
+    auto bound = std::make_shared<Bound>(std::bind(
+        std::ref(*functor), std::placeholders::_1,
+        std::forward<Args>(args)...));
+    CompletionQueue executor = executor_;
+    executor.RunAsync([functor, bound](CompletionQueue& cq) { (*bound)(cq); });
+  }
+
+ private:
+  CompletionQueue executor_;
+  std::shared_ptr<Functor> functor_;
+};
+}  // namespace internal
+
+/**
+ * Run a pool of threads over several `CompletionQueue` objects.
+ *
+ * A single `CompletionQueue` served by a single thread becomes a bottleneck
+ * for applications with many asynchronous operations in flight, or with
+ * expensive callbacks.  This class creates @p queue_count completion queues,
+ * and runs @p thread_count threads distributed over them.  Applications
+ * spread their asynchronous operations over the queues by calling `cq()` for
+ * each operation.
+ *
+ * Callbacks run on the thread that completes the operation.  Expensive
+ * callbacks can be moved off the queue threads with `Offload()`: the wrapped
+ * callbacks run on a separate set of @p callback_thread_count threads.
+ *
+ * @par Example
+ * @code
+ * bigtable::CompletionQueuePool pool(4, 8, 4);
+ * table.AsyncApply(
+ *     pool.cq(),
+ *     pool.Offload([](bigtable::CompletionQueue&,
+ *                     google::bigtable::v2::MutateRowResponse&,
+ *                     grpc::Status& status) {
+ *       // ... expensive work here ...
+ *     }),
+ *     std::move(mutation));
+ * @endcode
+ */
+class CompletionQueuePool {
+ public:
+  /// Create a pool with one queue and one thread for each core.
+  CompletionQueuePool();
+
+  /**
+   * Create a pool with @p queue_count queues and @p thread_count threads.
+   *
+   * @param queue_count the number of completion queues, must be positive.
+   * @param thread_count the number of threads running the queues, if smaller
+   *     than @p queue_count each queue gets one thread.
+   * @param callback_thread_count the number of threads running the offloaded
+   *     callbacks, if zero the callbacks run on the pool queues.
+   */
+  CompletionQueuePool(std::size_t queue_count, std::size_t thread_count,
+                      std::size_t callback_thread_count = 0);
+
+  /// Shutdown the queues and wait for all the threads, see `Shutdown()`.
+  ~CompletionQueuePool();
+
+  CompletionQueuePool(CompletionQueuePool const&) = delete;
+  CompletionQueuePool& operator=(CompletionQueuePool const&) = delete;
+
+  /// Return the queue for the next asynchronous operation.
+  CompletionQueue& cq() {
+    auto index = next_.fetch_add(1, std::memory_order_relaxed);
+    return queues_[index % queues_.size()];
+  }
+
+  /// Return the queue used to run offloaded callbacks.
+  CompletionQueue& callback_queue() {
+    return callback_queues_.empty() ? cq() : callback_queues_.front();
+  }
+
+  /**
+   * Wrap @p functor to run it on the callback threads.
+   *
+   * The returned callback copies its arguments and schedules @p functor on
+   * `callback_queue()`, the first argument received by @p functor is that
+   * queue.  It can be used with any of the asynchronous APIs that report
+   * results by reference, but the results are copies.
+   */
+  template <typename Functor>
+  internal::OffloadedCallback<typename std::decay<Functor>::type> Offload(
+      Functor&& functor) {
+    return internal::OffloadedCallback<typename std::decay<Functor>::type>(
+        callback_queue(), std::forward<Functor>(functor));
+  }
+
+  /**
+   * Shutdown all the queues and wait for their threads.
+   *
+   * The pool queues are drained first, their callbacks may still offload work
+   * to the callback queue, which is shutdown only after they finish. This
+   * function must not be called from one of the pool threads.
+   */
+  void Shutdown();
+
+  /// The number of queues used for asynchronous operations.
+  std::size_t queue_count() const { return queues_.size(); }
+
+ private:
+  std::vector<CompletionQueue> queues_;
+  std::vector<CompletionQueue> callback_queues_;
+  std::vector<std::thread> threads_;
+  std::vector<std::thread> callback_threads_;
+  std::atomic<std::size_t> next_;
+  std::atomic<bool> shutdown_;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_COMPLETION_QUEUE_POOL_H_
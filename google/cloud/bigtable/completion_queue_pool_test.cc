@@ -0,0 +1,138 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/completion_queue_pool.h"
+#include "google/cloud/testing_util/chrono_literals.h"
+#include <gmock/gmock.h>
+#include <future>
+#include <set>
+
+using namespace google::cloud::testing_util::chrono_literals;
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+
+/// Return the id of the thread running @p cq.
+std::thread::id RunningThread(CompletionQueue& cq) {
+  std::promise<std::thread::id> promise;
+  cq.RunAsync([&promise](CompletionQueue&) {
+    promise.set_value(std::this_thread::get_id());
+  });
+  return promise.get_future().get();
+}
+
+/// @test Verify the basic lifecycle of a pool.
+TEST(CompletionQueuePoolTest, LifeCycle) {
+  CompletionQueuePool pool(2, 4);
+  EXPECT_EQ(2U, pool.queue_count());
+
+  std::promise<bool> promise;
+  auto alarm = pool.cq().MakeRelativeTimer(
+      2_ms, [&promise](CompletionQueue&, AsyncTimerResult&) {
+        promise.set_value(true);
+      });
+
+  auto f = promise.get_future();
+  EXPECT_EQ(std::future_status::ready, f.wait_for(50_ms));
+
+  pool.Shutdown();
+  // Calling Shutdown() more than once, including from the destructor, is
+  // harmless.
+  pool.Shutdown();
+}
+
+/// @test Verify that operations are spread across the queues.
+TEST(CompletionQueuePoolTest, SpreadsOperations) {
+  // With one thread per queue, each queue is run by a different thread.
+  CompletionQueuePool pool(3, 3);
+  std::set<std::thread::id> ids;
+  for (int i = 0; i != 3; ++i) {
+    ids.insert(RunningThread(pool.cq()));
+  }
+  EXPECT_EQ(3U, ids.size());
+}
+
+/// @test Verify that offloaded callbacks run on the callback threads.
+TEST(CompletionQueuePoolTest, Offload) {
+  CompletionQueuePool pool(1, 1, 1);
+  auto queue_thread = RunningThread(pool.cq());
+  auto callback_thread = RunningThread(pool.callback_queue());
+  EXPECT_NE(queue_thread, callback_thread);
+
+  std::promise<std::thread::id> promise;
+  auto alarm = pool.cq().MakeRelativeTimer(
+      1_ms, pool.Offload([&promise](CompletionQueue&, AsyncTimerResult& r) {
+        EXPECT_FALSE(r.cancelled);
+        promise.set_value(std::this_thread::get_id());
+      }));
+  auto f = promise.get_future();
+  ASSERT_EQ(std::future_status::ready, f.wait_for(100_ms));
+  EXPECT_EQ(callback_thread, f.get());
+}
+
+/// @test Verify that without callback threads Offload() uses the pool queues.
+TEST(CompletionQueuePoolTest, OffloadWithoutCallbackThreads) {
+  CompletionQueuePool pool(1, 1);
+  auto queue_thread = RunningThread(pool.cq());
+
+  std::promise<std::thread::id> promise;
+  pool.cq().RunAsync(pool.Offload([&promise](CompletionQueue&) {
+    promise.set_value(std::this_thread::get_id());
+  }));
+  auto f = promise.get_future();
+  ASSERT_EQ(std::future_status::ready, f.wait_for(100_ms));
+  EXPECT_EQ(queue_thread, f.get());
+}
+
+/// @test Verify that callbacks offloaded during Shutdown() still run.
+TEST(CompletionQueuePoolTest, OffloadDuringShutdown) {
+  CompletionQueuePool pool(1, 1, 1);
+  std::promise<bool> offloaded;
+  auto callback = pool.Offload(
+      [&offloaded](CompletionQueue&) { offloaded.set_value(true); });
+
+  std::promise<void> shutting_down;
+  auto shutting_down_future = shutting_down.get_future().share();
+  pool.cq().RunAsync([shutting_down_future, &callback](CompletionQueue& cq) {
+    shutting_down_future.wait();
+    // Give Shutdown() time to shutdown the pool queues.
+    std::this_thread::sleep_for(20_ms);
+    callback(cq);
+  });
+  shutting_down.set_value();
+  pool.Shutdown();
+
+  auto f = offloaded.get_future();
+  ASSERT_EQ(std::future_status::ready, f.wait_for(0_ms));
+  EXPECT_TRUE(f.get());
+}
+
+/// @test Verify that the pool requires at least one queue.
+TEST(CompletionQueuePoolTest, InvalidQueueCount) {
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  EXPECT_THROW(CompletionQueuePool(0, 1), std::invalid_argument);
+#else
+  EXPECT_DEATH_IF_SUPPORTED(CompletionQueuePool(0, 1),
+                            "exceptions are disabled");
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+}
+
+}  // namespace
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -146,6 +146,53 @@ TEST(CompletionQueueTest, AyncRpcSimple) {
   EXPECT_TRUE(impl->empty());
 }
 
+/// @test Verify that destroying a completion queue releases pending operations.
+TEST(CompletionQueueTest, DestroyReleasesPendingOperations) {
+  MockClient client;
+
+  auto reader =
+      google::cloud::internal::make_unique<testing::MockAsyncApplyReader>();
+  // The RPC never completes.
+  EXPECT_CALL(*reader, Finish(_, _, _)).Times(1);
+  EXPECT_CALL(client, AsyncMutateRow(_, _, _))
+      .WillOnce(Invoke([&reader](grpc::ClientContext*,
+                                 btproto::MutateRowRequest const&,
+                                 grpc::CompletionQueue*) {
+        return std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
+            // This is safe, see comments in MockAsyncResponseReader.
+            btproto::MutateRowResponse>>(reader.get());
+      }));
+
+  auto timer_state = std::make_shared<int>(0);
+  auto rpc_state = std::make_shared<int>(0);
+  std::weak_ptr<int> timer_watcher = timer_state;
+  std::weak_ptr<int> rpc_watcher = rpc_state;
+  {
+    auto impl = std::make_shared<testing::MockCompletionQueue>();
+    bigtable::CompletionQueue cq(impl);
+
+    cq.MakeRelativeTimer(
+        std::chrono::hours(1),
+        [timer_state](CompletionQueue&, AsyncTimerResult&) {});
+    btproto::MutateRowRequest request;
+    cq.MakeUnaryRpc(
+        client, &MockClient::AsyncMutateRow, request,
+        google::cloud::internal::make_unique<grpc::ClientContext>(),
+        [rpc_state](CompletionQueue&, btproto::MutateRowResponse&,
+                    grpc::Status&) {});
+    EXPECT_EQ(2U, impl->size());
+
+    // Only the callbacks keep the state alive.
+    timer_state.reset();
+    rpc_state.reset();
+    EXPECT_FALSE(timer_watcher.expired());
+    EXPECT_FALSE(rpc_watcher.expired());
+    cq.Shutdown();
+  }
+  EXPECT_TRUE(timer_watcher.expired());
+  EXPECT_TRUE(rpc_watcher.expired());
+}
+
 /// @test Verify that completion queues can create async operations with
 //        streamed responses.
 TEST(CompletionQueueTest, AsyncRpcSimpleStream) {
@@ -96,20 +96,29 @@ class DefaultDataClient : public DataClient {
   std::unique_ptr<grpc::ClientReaderInterface<btproto::ReadRowsResponse>>
   ReadRows(grpc::ClientContext* context,
            btproto::ReadRowsRequest const& request) override {
-    return impl_.Stub()->ReadRows(context, request);
+    auto stub = impl_.Stub();
+    auto reader = stub->ReadRows(context, request);
+    return bigtable::internal::MakeLeasedClientReader(std::move(stub),
+                                                      std::move(reader));
   }
 
   std::unique_ptr<grpc::ClientAsyncReaderInterface<btproto::ReadRowsResponse>>
   AsyncReadRows(grpc::ClientContext* context,
                 const google::bigtable::v2::ReadRowsRequest& request,
                 grpc::CompletionQueue* cq, void* tag) override {
-    return impl_.Stub()->AsyncReadRows(context, request, cq, tag);
+    auto stub = impl_.Stub();
+    auto reader = stub->AsyncReadRows(context, request, cq, tag);
+    return bigtable::internal::MakeLeasedClientAsyncReader(std::move(stub),
+                                                           std::move(reader));
   }
 
   std::unique_ptr<grpc::ClientReaderInterface<btproto::SampleRowKeysResponse>>
   SampleRowKeys(grpc::ClientContext* context,
                 btproto::SampleRowKeysRequest const& request) override {
-    return impl_.Stub()->SampleRowKeys(context, request);
+    auto stub = impl_.Stub();
+    auto reader = stub->SampleRowKeys(context, request);
+    return bigtable::internal::MakeLeasedClientReader(std::move(stub),
+                                                      std::move(reader));
   }
   std::unique_ptr<::grpc::ClientAsyncReaderInterface<
       ::google::bigtable::v2::SampleRowKeysResponse>>
@@ -117,20 +126,29 @@ class DefaultDataClient : public DataClient {
       ::grpc::ClientContext* context,
       const ::google::bigtable::v2::SampleRowKeysRequest& request,
       ::grpc::CompletionQueue* cq, void* tag) override {
-    return impl_.Stub()->AsyncSampleRowKeys(context, request, cq, tag);
+    auto stub = impl_.Stub();
+    auto reader = stub->AsyncSampleRowKeys(context, request, cq, tag);
+    return bigtable::internal::MakeLeasedClientAsyncReader(std::move(stub),
+                                                           std::move(reader));
   }
 
   std::unique_ptr<grpc::ClientReaderInterface<btproto::MutateRowsResponse>>
   MutateRows(grpc::ClientContext* context,
              btproto::MutateRowsRequest const& request) override {
-    return impl_.Stub()->MutateRows(context, request);
+    auto stub = impl_.Stub();
+    auto reader = stub->MutateRows(context, request);
+    return bigtable::internal::MakeLeasedClientReader(std::move(stub),
+                                                      std::move(reader));
   }
   std::unique_ptr<::grpc::ClientAsyncReaderInterface<
       ::google::bigtable::v2::MutateRowsResponse>>
   AsyncMutateRows(::grpc::ClientContext* context,
                   const ::google::bigtable::v2::MutateRowsRequest& request,
                   ::grpc::CompletionQueue* cq, void* tag) override {
-    return impl_.Stub()->AsyncMutateRows(context, request, cq, tag);
+    auto stub = impl_.Stub();
+    auto reader = stub->AsyncMutateRows(context, request, cq, tag);
+    return bigtable::internal::MakeLeasedClientAsyncReader(std::move(stub),
+                                                           std::move(reader));
   }
 
  private:
@@ -0,0 +1,214 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ASYNC_BATCHER_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ASYNC_BATCHER_H_
+
+#include "google/cloud/bigtable/completion_queue.h"
+#include "google/cloud/bigtable/version.h"
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+/**
+ * The admission, flush, and timer logic shared by the batchers.
+ *
+ * `MutationBatcher` and `ReadRowBatcher` both queue requests from many threads,
+ * admit them into the current batch, send the batch when it is full or when
+ * its oldest request has waited too long, and limit the number of batches in
+ * flight. This class implements that state machine, the derived class defines
+ * what the requests and batches are through these member functions:
+ *
+ * - `bool HasRoom(Batch const&, Request const&) const`: the request fits in
+ *   the batch.
+ * - `bool IsFull(Batch const&) const`: the batch should be sent right away.
+ * - `bool CanAdmit(Request const&) const`: any other limits allow admitting the
+ *   request. Optional.
+ * - `void Admit(Batch&, Request&)`: move the request into the batch.
+ * - `void Discard(Batch&)`: the batch will never be sent. Optional.
+ * - `Notifications TakeNotifications()`: return the promises that became
+ *   ready. Optional.
+ * - `void Send(CompletionQueue&, std::shared_ptr<Batch>)`: start the request
+ *   for the batch, its callback must call `BatchCompleted()`.
+ * - `void Fail(Batch&, grpc::Status const&)`: fail all the requests in a batch
+ *   that is never sent.
+ * - `void Notify(Notifications&)`: satisfy the promises. Optional.
+ *
+ * `Send()`, `Fail()` and `Notify()` are called with the lock released, their
+ * continuations may call back into the batcher. The other functions are called
+ * with `mu_` held.
+ *
+ * @tparam Derived the batcher implementation, the callbacks for timers and
+ *     requests hold a `std::shared_ptr<Derived>`, so the state remains valid
+ *     until they all complete.
+ * @tparam Request a request waiting for admission.
+ * @tparam Batch the requests admitted into a batch, must have an `empty()`
+ *     member function.
+ */
+template <typename Derived, typename Request, typename Batch>
+class AsyncBatcher : public std::enable_shared_from_this<Derived> {
+ public:
+  AsyncBatcher(std::size_t max_batches,
+               std::chrono::microseconds max_batch_latency)
+      : max_batches_(max_batches), max_batch_latency_(max_batch_latency) {}
+
+ protected:
+  /// The promises satisfied after a flush, by default there are none.
+  struct Notifications {};
+
+  bool CanAdmit(Request const&) const { return true; }
+  void Discard(Batch&) {}
+  Notifications TakeNotifications() { return Notifications{}; }
+  void Notify(Notifications&) {}
+
+  /// Queue @p request and send any batches that are ready.
+  void Enqueue(CompletionQueue& cq, Request request) {
+    std::unique_lock<std::mutex> lk(mu_);
+    waiting_.push_back(std::move(request));
+    AdmitAndFlush(cq, std::move(lk));
+  }
+
+  /// Record the end of a batch and send any batches ready. Releases @p lk.
+  void BatchCompleted(CompletionQueue& cq, std::unique_lock<std::mutex> lk) {
+    --in_flight_;
+    AdmitAndFlush(cq, std::move(lk));
+  }
+
+  /**
+   * Admit waiting requests, send the batches that are ready, and satisfy the
+   * promises that became ready. Releases @p lk.
+   */
+  void AdmitAndFlush(CompletionQueue& cq, std::unique_lock<std::mutex> lk) {
+    std::vector<std::shared_ptr<Batch>> to_send;
+    while (not waiting_.empty()) {
+      auto& next = waiting_.front();
+      if (not self().HasRoom(current_, next)) {
+        if (not CanSend()) {
+          break;
+        }
+        to_send.push_back(TakeBatch());
+      }
+      if (not self().CanAdmit(next)) {
+        break;
+      }
+      self().Admit(current_, next);
+      waiting_.pop_front();
+    }
+    if (not current_.empty() and CanSend() and
+        (current_ready_ or self().IsFull(current_))) {
+      to_send.push_back(TakeBatch());
+    }
+
+    // Flush a new partial batch after `max_batch_latency`. The timers for
+    // batches sent earlier than that find a different generation and do
+    // nothing.
+    bool start_timer =
+        not current_.empty() and not current_ready_ and not timer_pending_;
+    if (start_timer) {
+      timer_pending_ = true;
+    }
+    auto timer_generation = generation_;
+    auto notifications = self().TakeNotifications();
+    lk.unlock();
+
+    if (start_timer) {
+      auto s = this->shared_from_this();
+      cq.MakeRelativeTimer(
+          max_batch_latency_,
+          [s, timer_generation](CompletionQueue& cq, AsyncTimerResult& r) {
+            s->OnTimer(cq, timer_generation, r.cancelled);
+          });
+    }
+    for (auto& batch : to_send) {
+      self().Send(cq, std::move(batch));
+    }
+    self().Notify(notifications);
+  }
+
+  /// Return true if no requests are waiting, batched, or in flight.
+  bool IsIdle() const {
+    return waiting_.empty() and current_.empty() and in_flight_ == 0;
+  }
+
+  std::mutex mu_;
+  Batch current_;
+  /// Set when the current batch should be sent even if it is not full.
+  bool current_ready_ = false;
+
+ private:
+  Derived& self() { return *static_cast<Derived*>(this); }
+
+  bool CanSend() const { return in_flight_ < max_batches_; }
+
+  std::shared_ptr<Batch> TakeBatch() {
+    auto batch = std::make_shared<Batch>(std::move(current_));
+    current_ = Batch();
+    current_ready_ = false;
+    ++in_flight_;
+    ++generation_;
+    timer_pending_ = false;
+    return batch;
+  }
+
+  void OnTimer(CompletionQueue& cq, std::uint64_t generation, bool cancelled) {
+    std::unique_lock<std::mutex> lk(mu_);
+    if (generation != generation_) {
+      return;
+    }
+    timer_pending_ = false;
+    if (not cancelled) {
+      current_ready_ = true;
+      AdmitAndFlush(cq, std::move(lk));
+      return;
+    }
+    // A cancelled timer means the completion queue is shutting down, the batch
+    // cannot be sent, but its requests must not wait forever.
+    Batch batch(std::move(current_));
+    current_ = Batch();
+    current_ready_ = false;
+    ++generation_;
+    self().Discard(batch);
+    auto notifications = self().TakeNotifications();
+    lk.unlock();
+
+    self().Fail(batch, grpc::Status(grpc::StatusCode::CANCELLED,
+                                    "the completion queue is shutting down"));
+    self().Notify(notifications);
+  }
+
+  std::size_t const max_batches_;
+  std::chrono::microseconds const max_batch_latency_;
+
+  std::deque<Request> waiting_;
+  std::size_t in_flight_ = 0;
+  /// Incremented each time a batch is sent, used to discard stale timers.
+  std::uint64_t generation_ = 0;
+  bool timer_pending_ = false;
+};
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ASYNC_BATCHER_H_
@@ -19,6 +19,7 @@
 #include "google/cloud/bigtable/data_client.h"
 #include "google/cloud/bigtable/filters.h"
 #include "google/cloud/bigtable/internal/readrowsparser.h"
+#include "google/cloud/bigtable/internal/resumable_row_set.h"
 #include "google/cloud/bigtable/internal/table.h"
 #include "google/cloud/bigtable/metadata_update_policy.h"
 #include "google/cloud/bigtable/row.h"
@@ -66,7 +67,7 @@ class AsyncRowReader {
       : client_(std::move(client)),
         app_profile_id_(std::move(app_profile_id)),
         table_name_(std::move(table_name)),
-        row_set_(std::move(row_set)),
+        row_set_(row_set),
         rows_limit_(rows_limit),
         filter_(std::move(filter)),
         context_(),
@@ -121,7 +122,7 @@ class AsyncRowReader {
     if (not last_read_row_key_.empty()) {
       // We've returned some rows and need to make sure we don't
       // request them again.
-      row_set_ = row_set_.Intersect(RowRange::Open(last_read_row_key_, ""));
+      row_set_.AdvancePast(last_read_row_key_);
     }
     auto row_set_proto = row_set_.as_proto();
     request.mutable_rows()->Swap(&row_set_proto);
@@ -181,7 +182,7 @@ class AsyncRowReader {
   std::shared_ptr<bigtable::DataClient> client_;
   bigtable::AppProfileId app_profile_id_;
   bigtable::TableId table_name_;
-  RowSet row_set_;
+  ResumableRowSet row_set_;
   std::int64_t rows_limit_;
   Filter filter_;
   std::unique_ptr<grpc::ClientContext> context_;
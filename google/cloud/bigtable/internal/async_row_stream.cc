@@ -0,0 +1,276 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/async_row_stream.h"
+#include "google/cloud/bigtable/grpc_error.h"
+#include "google/cloud/internal/make_unique.h"
+#include "google/cloud/internal/throw_delegate.h"
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+// Defined in the class, but C++11 needs a definition for odr-used constants.
+std::int64_t constexpr AsyncRowStream::NO_ROWS_LIMIT;
+
+std::shared_ptr<AsyncRowStream> AsyncRowStream::Create(
+    CompletionQueue& cq, std::shared_ptr<DataClient> client,
+    bigtable::AppProfileId app_profile_id, bigtable::TableId table_name,
+    RowSet row_set, std::int64_t rows_limit, Filter filter,
+    std::unique_ptr<RPCRetryPolicy> rpc_retry_policy,
+    std::unique_ptr<RPCBackoffPolicy> rpc_backoff_policy,
+    MetadataUpdatePolicy metadata_update_policy,
+    std::unique_ptr<ReadRowsParserFactory> parser_factory,
+    std::size_t max_buffered_rows) {
+  std::shared_ptr<AsyncRowStream> stream(new AsyncRowStream(
+      std::move(client), std::move(app_profile_id), std::move(table_name),
+      std::move(row_set), rows_limit, std::move(filter),
+      std::move(rpc_retry_policy), std::move(rpc_backoff_policy),
+      std::move(metadata_update_policy), std::move(parser_factory),
+      max_buffered_rows));
+  std::unique_lock<std::mutex> lk(stream->mu_);
+  stream->StartAttempt(cq);
+  return stream;
+}
+
+AsyncRowStream::AsyncRowStream(
+    std::shared_ptr<DataClient> client, bigtable::AppProfileId app_profile_id,
+    bigtable::TableId table_name, RowSet row_set, std::int64_t rows_limit,
+    Filter filter, std::unique_ptr<RPCRetryPolicy> rpc_retry_policy,
+    std::unique_ptr<RPCBackoffPolicy> rpc_backoff_policy,
+    MetadataUpdatePolicy metadata_update_policy,
+    std::unique_ptr<ReadRowsParserFactory> parser_factory,
+    std::size_t max_buffered_rows)
+    : client_(std::move(client)),
+      app_profile_id_(std::move(app_profile_id)),
+      table_name_(std::move(table_name)),
+      row_set_(row_set),
+      rows_limit_(rows_limit),
+      filter_(std::move(filter)),
+      rpc_retry_policy_(std::move(rpc_retry_policy)),
+      rpc_backoff_policy_(std::move(rpc_backoff_policy)),
+      metadata_update_policy_(std::move(metadata_update_policy)),
+      parser_factory_(std::move(parser_factory)),
+      max_buffered_rows_(max_buffered_rows == 0 ? 1 : max_buffered_rows),
+      read_pending_(false),
+      rows_count_(0),
+      has_consumer_(false),
+      cancelled_(false),
+      finished_(false) {}
+
+AsyncRowStream::~AsyncRowStream() {
+  // The callbacks only hold weak pointers to this object, so the pending
+  // operations simply complete without effect.
+  if (op_) {
+    op_->Cancel();
+  }
+  if (timer_) {
+    timer_->Cancel();
+  }
+}
+
+future<std::vector<Row>> AsyncRowStream::AsyncNext() {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (has_consumer_) {
+    google::cloud::internal::ThrowLogicError(
+        "AsyncRowStream::AsyncNext() called while a previous call is pending");
+  }
+  has_consumer_ = true;
+  consumer_ = promise<std::vector<Row>>();
+  auto f = consumer_.get_future();
+  Deliver(lk);
+  return f;
+}
+
+void AsyncRowStream::Cancel() {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (finished_ or cancelled_) {
+    return;
+  }
+  cancelled_ = true;
+  buffer_.clear();
+  // The stream is finished from the callbacks of these operations.
+  if (op_) {
+    op_->Cancel();
+  }
+  if (timer_) {
+    timer_->Cancel();
+  }
+}
+
+void AsyncRowStream::StartAttempt(CompletionQueue& cq) {
+  google::bigtable::v2::ReadRowsRequest request;
+  request.set_app_profile_id(app_profile_id_.get());
+  request.set_table_name(table_name_.get());
+  auto row_set_proto = row_set_.as_proto();
+  request.mutable_rows()->Swap(&row_set_proto);
+  auto filter_proto = filter_.as_proto();
+  request.mutable_filter()->Swap(&filter_proto);
+  if (rows_limit_ != NO_ROWS_LIMIT) {
+    request.set_rows_limit(rows_limit_ - rows_count_);
+  }
+
+  auto context = google::cloud::internal::make_unique<grpc::ClientContext>();
+  rpc_retry_policy_->Setup(*context);
+  rpc_backoff_policy_->Setup(*context);
+  metadata_update_policy_.Setup(*context);
+
+  parser_ = parser_factory_->Create();
+  attempt_status_ = grpc::Status::OK;
+
+  std::weak_ptr<AsyncRowStream> weak = shared_from_this();
+  op_ = cq.MakeFlowControlledStreamRpc(
+      *client_, &DataClient::AsyncReadRows, request, std::move(context),
+      [weak](CompletionQueue&, grpc::ClientContext const&,
+             google::bigtable::v2::ReadRowsResponse& response) {
+        if (auto self = weak.lock()) {
+          self->OnResponse(response);
+        }
+      },
+      [weak](CompletionQueue& cq, grpc::ClientContext&, grpc::Status& status) {
+        if (auto self = weak.lock()) {
+          self->OnFinish(cq, status);
+        }
+      });
+  MaybeRequestRead();
+}
+
+void AsyncRowStream::OnResponse(
+    google::bigtable::v2::ReadRowsResponse& response) {
+  std::unique_lock<std::mutex> lk(mu_);
+  read_pending_ = false;
+  if (cancelled_ or not attempt_status_.ok()) {
+    return;
+  }
+  for (auto& chunk : *response.mutable_chunks()) {
+    parser_->HandleChunk(std::move(chunk), attempt_status_);
+    if (attempt_status_.ok() and parser_->HasNext()) {
+      Row row = parser_->Next(attempt_status_);
+      if (attempt_status_.ok()) {
+        ++rows_count_;
+        last_read_row_key_ = std::string(row.row_key());
+        buffer_.push_back(std::move(row));
+      }
+    }
+    if (not attempt_status_.ok()) {
+      // Stop this attempt, `OnFinish()` retries with `attempt_status_`.
+      op_->Cancel();
+      break;
+    }
+  }
+  MaybeRequestRead();
+  Deliver(lk);
+}
+
+void AsyncRowStream::OnFinish(CompletionQueue& cq, grpc::Status status) {
+  std::unique_lock<std::mutex> lk(mu_);
+  op_.reset();
+  read_pending_ = false;
+  if (cancelled_) {
+    Finish(lk, grpc::Status(grpc::StatusCode::CANCELLED,
+                            "AsyncRowStream cancelled"));
+    return;
+  }
+  if (not attempt_status_.ok()) {
+    status = attempt_status_;
+  } else if (status.ok()) {
+    parser_->HandleEndOfStream(status);
+  }
+  if (status.ok()) {
+    Finish(lk, status);
+    return;
+  }
+
+  if (not last_read_row_key_.empty()) {
+    // We've returned some rows and need to make sure we don't
+    // request them again.
+    row_set_.AdvancePast(last_read_row_key_);
+  }
+  // If we receive an error, but the retriable set is empty, or the row limit
+  // has been reached, we are done.
+  if (row_set_.IsEmpty() or
+      (rows_limit_ != NO_ROWS_LIMIT and rows_limit_ <= rows_count_)) {
+    Finish(lk, grpc::Status::OK);
+    return;
+  }
+  if (not rpc_retry_policy_->OnFailure(status)) {
+    Finish(lk, status);
+    return;
+  }
+
+  auto delay = rpc_backoff_policy_->OnCompletion(status);
+  std::weak_ptr<AsyncRowStream> weak = shared_from_this();
+  timer_ = cq.MakeRelativeTimer(
+      delay, [weak](CompletionQueue& cq, AsyncTimerResult& timer) {
+        if (auto self = weak.lock()) {
+          self->OnTimer(cq, timer);
+        }
+      });
+}
+
+void AsyncRowStream::OnTimer(CompletionQueue& cq, AsyncTimerResult& timer) {
+  std::unique_lock<std::mutex> lk(mu_);
+  timer_.reset();
+  if (cancelled_ or timer.cancelled) {
+    Finish(lk, grpc::Status(grpc::StatusCode::CANCELLED,
+                            "AsyncRowStream cancelled"));
+    return;
+  }
+  StartAttempt(cq);
+}
+
+void AsyncRowStream::MaybeRequestRead() {
+  if (not op_ or read_pending_ or cancelled_ or
+      buffer_.size() >= max_buffered_rows_) {
+    return;
+  }
+  read_pending_ = true;
+  op_->RequestRead();
+}
+
+void AsyncRowStream::Finish(std::unique_lock<std::mutex>& lk,
+                            grpc::Status status) {
+  finished_ = true;
+  final_status_ = std::move(status);
+  Deliver(lk);
+}
+
+void AsyncRowStream::Deliver(std::unique_lock<std::mutex>& lk) {
+  if (not has_consumer_ or (buffer_.empty() and not finished_)) {
+    lk.unlock();
+    return;
+  }
+  has_consumer_ = false;
+  auto consumer = std::move(consumer_);
+  std::vector<Row> rows;
+  rows.swap(buffer_);
+  auto status = final_status_;
+  // The buffer is empty, read more rows while the consumer processes these.
+  MaybeRequestRead();
+  // Satisfying the promise may run continuations, do not hold the lock.
+  lk.unlock();
+  if (rows.empty() and not status.ok()) {
+    consumer.set_exception(std::make_exception_ptr(
+        GRpcError("AsyncRowStream::AsyncNext()", status)));
+    return;
+  }
+  consumer.set_value(std::move(rows));
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,180 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ASYNC_ROW_STREAM_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ASYNC_ROW_STREAM_H_
+
+#include "google/cloud/bigtable/bigtable_strong_types.h"
+#include "google/cloud/bigtable/completion_queue.h"
+#include "google/cloud/bigtable/data_client.h"
+#include "google/cloud/bigtable/filters.h"
+#include "google/cloud/bigtable/internal/readrowsparser.h"
+#include "google/cloud/bigtable/internal/resumable_row_set.h"
+#include "google/cloud/bigtable/metadata_update_policy.h"
+#include "google/cloud/bigtable/row.h"
+#include "google/cloud/bigtable/row_set.h"
+#include "google/cloud/bigtable/rpc_backoff_policy.h"
+#include "google/cloud/bigtable/rpc_retry_policy.h"
+#include "google/cloud/bigtable/table_strong_types.h"
+#include "google/cloud/future.h"
+#include <cinttypes>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+/**
+ * Read rows asynchronously, in batches, with bounded memory usage.
+ *
+ * `AsyncRowReader` delivers each row to a callback on a completion queue
+ * thread, and has no way to pause the stream. This class buffers parsed rows
+ * instead, and returns them through futures from `AsyncNext()`. It only reads
+ * the next response from the stream while fewer than `max_buffered_rows` rows
+ * are buffered, so the buffer can exceed that limit by at most the rows in one
+ * response. A slow consumer simply stops reading from the stream, without
+ * blocking any completion queue threads.
+ *
+ * Failed streams are retried as in `RowReader`, resuming after the last row
+ * returned.
+ *
+ * Applications must drain or `Cancel()` the stream, an idle stream holds the
+ * underlying RPC open until the object is destroyed.
+ */
+class AsyncRowStream : public std::enable_shared_from_this<AsyncRowStream> {
+ public:
+  /// A constant for the magic value that means "no limit, get all rows".
+  static std::int64_t constexpr NO_ROWS_LIMIT = 0;
+
+  /**
+   * Create a stream and start reading.
+   *
+   * @param cq the completion queue that will execute the asynchronous calls,
+   *     the application must ensure that one or more threads are blocked on
+   *     `cq.Run()`.
+   * @param max_buffered_rows the number of rows buffered before the stream
+   *     stops reading responses, zero is treated as one.
+   */
+  static std::shared_ptr<AsyncRowStream> Create(
+      CompletionQueue& cq, std::shared_ptr<DataClient> client,
+      bigtable::AppProfileId app_profile_id, bigtable::TableId table_name,
+      RowSet row_set, std::int64_t rows_limit, Filter filter,
+      std::unique_ptr<RPCRetryPolicy> rpc_retry_policy,
+      std::unique_ptr<RPCBackoffPolicy> rpc_backoff_policy,
+      MetadataUpdatePolicy metadata_update_policy,
+      std::unique_ptr<ReadRowsParserFactory> parser_factory,
+      std::size_t max_buffered_rows);
+
+  ~AsyncRowStream();
+
+  /**
+   * Return the next batch of rows.
+   *
+   * The future is satisfied with all the rows buffered when it becomes ready,
+   * at least one row. An empty vector means the stream completed successfully.
+   * If the stream fails (after all retries) or is cancelled, the future holds
+   * a `bigtable::GRpcError` exception.
+   *
+   * Only one call may be pending at a time.
+   */
+  future<std::vector<Row>> AsyncNext();
+
+  /**
+   * Cancel the stream.
+   *
+   * Any buffered rows are discarded, a pending (or later) `AsyncNext()` fails
+   * with a `CANCELLED` status once the stream stops.
+   */
+  void Cancel();
+
+ private:
+  AsyncRowStream(std::shared_ptr<DataClient> client,
+                 bigtable::AppProfileId app_profile_id,
+                 bigtable::TableId table_name, RowSet row_set,
+                 std::int64_t rows_limit, Filter filter,
+                 std::unique_ptr<RPCRetryPolicy> rpc_retry_policy,
+                 std::unique_ptr<RPCBackoffPolicy> rpc_backoff_policy,
+                 MetadataUpdatePolicy metadata_update_policy,
+                 std::unique_ptr<ReadRowsParserFactory> parser_factory,
+                 std::size_t max_buffered_rows);
+
+  /// Start a new attempt at the ReadRows RPC, must hold `mu_`.
+  void StartAttempt(CompletionQueue& cq);
+
+  /// Parse the rows in @p response and hand them to any pending consumer.
+  void OnResponse(google::bigtable::v2::ReadRowsResponse& response);
+
+  /// Handle the end of an attempt, retrying if needed.
+  void OnFinish(CompletionQueue& cq, grpc::Status status);
+
+  /// Handle the end of the backoff period before a retry.
+  void OnTimer(CompletionQueue& cq, AsyncTimerResult& timer);
+
+  /// Grant a credit to the stream if there is room in the buffer, must hold
+  /// `mu_`.
+  void MaybeRequestRead();
+
+  /// Mark the stream as completed with @p status, releases @p lk.
+  void Finish(std::unique_lock<std::mutex>& lk, grpc::Status status);
+
+  /// Satisfy the pending `AsyncNext()` if possible, releases @p lk.
+  void Deliver(std::unique_lock<std::mutex>& lk);
+
+  std::mutex mu_;
+  std::shared_ptr<DataClient> client_;
+  bigtable::AppProfileId app_profile_id_;
+  bigtable::TableId table_name_;
+  ResumableRowSet row_set_;
+  std::int64_t rows_limit_;
+  Filter filter_;
+  std::unique_ptr<RPCRetryPolicy> rpc_retry_policy_;
+  std::unique_ptr<RPCBackoffPolicy> rpc_backoff_policy_;
+  MetadataUpdatePolicy metadata_update_policy_;
+  std::unique_ptr<ReadRowsParserFactory> parser_factory_;
+  std::unique_ptr<ReadRowsParser> parser_;
+  std::size_t const max_buffered_rows_;
+
+  /// The current attempt, null between attempts and after the stream ends.
+  std::shared_ptr<AsyncFlowControlledOperation> op_;
+  /// The backoff timer between attempts.
+  std::shared_ptr<AsyncOperation> timer_;
+  /// True while a credit was granted to `op_` and not used yet.
+  bool read_pending_;
+  /// The status of the current attempt, set when parsing fails.
+  grpc::Status attempt_status_;
+
+  /// Number of rows read so far, used to set row_limit in retries.
+  std::int64_t rows_count_;
+  /// Holds the last read row key, for retries.
+  std::string last_read_row_key_;
+
+  std::vector<Row> buffer_;
+  bool has_consumer_;
+  promise<std::vector<Row>> consumer_;
+  bool cancelled_;
+  bool finished_;
+  grpc::Status final_status_;
+};
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ASYNC_ROW_STREAM_H_
@@ -30,28 +30,26 @@ BulkMutator::BulkMutator(bigtable::AppProfileId const& app_profile_id,
                          bigtable::TableId const& table_name,
                          IdempotentMutationPolicy& idempotent_policy,
                          BulkMutation&& mut) {
-  // Every time the client library calls MakeOneRequest(), the data in the
-  // "pending_*" variables initializes the next request.  So in the constructor
-  // we start by putting the data on the "pending_*" variables.
-  // Move the mutations to the "pending" request proto, this is a zero copy
-  // optimization.
-  mut.MoveTo(&pending_mutations_);
+  // Move the mutations to the request proto, this is a zero copy
+  // optimization. The same proto (and the same entries) are used for all the
+  // requests, FinishRequest() removes the entries that do not need a retry.
+  mut.MoveTo(&mutations_);
   bigtable::internal::SetCommonTableOperationRequest<
-      btproto::MutateRowsRequest>(pending_mutations_, app_profile_id.get(),
+      btproto::MutateRowsRequest>(mutations_, app_profile_id.get(),
                                   table_name.get());
   // As we receive successful responses, we shrink the size of the request (only
   // those pending are resent).  But if any fails we want to report their index
   // in the original sequence provided by the user.  So this vector maps from
   // the index in the current array to the index in the original array.
-  pending_annotations_.reserve(pending_mutations_.entries_size());
+  annotations_.reserve(mutations_.entries_size());
   int index = 0;
-  for (auto const& e : pending_mutations_.entries()) {
+  for (auto const& e : mutations_.entries()) {
     // This is a giant && across all the mutations for each row.
     auto r = std::all_of(e.mutations().begin(), e.mutations().end(),
                          [&idempotent_policy](btproto::Mutation const& m) {
                            return idempotent_policy.is_idempotent(m);
                          });
-    pending_annotations_.push_back(Annotations{index++, r, false});
+    annotations_.push_back(Annotations{index++, r, false, true});
   }
 }
 
@@ -69,16 +67,10 @@ grpc::Status BulkMutator::MakeOneRequest(bigtable::DataClient& client,
 }
 
 void BulkMutator::PrepareForRequest() {
-  mutations_.Swap(&pending_mutations_);
-  annotations_.swap(pending_annotations_);
   for (auto& a : annotations_) {
     a.has_mutation_result = false;
+    a.is_pending = false;
   }
-  pending_mutations_ = {};
-  bigtable::internal::SetCommonTableOperationRequest<
-      btproto::MutateRowsRequest>(
-      pending_mutations_, mutations_.app_profile_id(), mutations_.table_name());
-  pending_annotations_ = {};
 }
 
 void BulkMutator::ProcessResponse(
@@ -99,18 +91,16 @@ void BulkMutator::ProcessResponse(
     if (grpc::StatusCode::OK == code) {
       continue;
     }
-    auto& original = *mutations_.mutable_entries(index);
     // Failed responses are handled according to the current policies.
     if (SafeGrpcRetry::IsTransientFailure(code) and annotation.is_idempotent) {
-      // Retryable requests are saved in the pending mutations, along with the
-      // mapping from their index in pending_mutations_ to the original
-      // vector and other miscellanea.
-      pending_mutations_.add_entries()->Swap(&original);
-      pending_annotations_.push_back(annotation);
+      // Retryable requests stay in the request, FinishRequest() moves them
+      // to the front.
+      annotation.is_pending = true;
     } else {
       // Failures are saved for reporting, notice that we avoid copying, and
       // we use the original index in the first request, not the one where it
       // failed.
+      auto& original = *mutations_.mutable_entries(index);
       failures_.emplace_back(SingleRowMutation(std::move(original)),
                              std::move(*entry.mutable_status()),
                              annotation.original_index);
@@ -119,40 +109,52 @@ void BulkMutator::ProcessResponse(
 }
 
 void BulkMutator::FinishRequest() {
-  int index = 0;
-  for (auto const& annotation : annotations_) {
-    if (annotation.has_mutation_result) {
-      ++index;
+  google::rpc::Status ok_status;
+  ok_status.set_code(grpc::StatusCode::OK);
+  auto& entries = *mutations_.mutable_entries();
+  int pending = 0;
+  for (int index = 0; index != entries.size(); ++index) {
+    auto& annotation = annotations_[index];
+    if (not annotation.has_mutation_result) {
+      // If there are any mutations with unknown state, they need to be
+      // handled.
+      if (annotation.is_idempotent) {
+        // If the mutation was retryable, keep it for the next request.
+        annotation.is_pending = true;
+      } else {
+        // These are weird failures.  We do not know their error code, and we
+        // cannot retry them.  Report them as OK in the failure list.
+        failures_.emplace_back(
+            SingleRowMutation(std::move(*entries.Mutable(index))), ok_status,
+            annotation.original_index);
+      }
+    }
+    if (not annotation.is_pending) {
       continue;
     }
-    // If there are any mutations with unknown state, they need to be handled.
-    auto& original = *mutations_.mutable_entries(index);
-    if (annotation.is_idempotent) {
-      // If the mutation was retryable, move it to the pending mutations to try
-      // again, along with their index.
-      pending_mutations_.add_entries()->Swap(&original);
-      pending_annotations_.push_back(annotation);
-    } else {
-      // These are weird failures.  We do not know their error code, and we
-      // cannot retry them.  Report them as OK in the failure list.
-      google::rpc::Status ok_status;
-      ok_status.set_code(grpc::StatusCode::OK);
-      failures_.emplace_back(
-          FailedMutation(SingleRowMutation(std::move(original)), ok_status,
-                         annotation.original_index));
+    // Move the pending entries to the front, this only swaps pointers.
+    if (index != pending) {
+      entries.SwapElements(index, pending);
+      annotations_[pending] = annotation;
     }
-    ++index;
+    ++pending;
   }
+  entries.DeleteSubrange(pending, entries.size() - pending);
+  annotations_.resize(static_cast<std::size_t>(pending));
 }
 
 std::vector<FailedMutation> BulkMutator::ExtractFinalFailures() {
   std::vector<FailedMutation> result(std::move(failures_));
   google::rpc::Status ok_status;
   ok_status.set_code(grpc::StatusCode::OK);
-  for (auto& mutation : *pending_mutations_.mutable_entries()) {
+  std::size_t index = 0;
+  for (auto& mutation : *mutations_.mutable_entries()) {
     result.emplace_back(
-        FailedMutation(SingleRowMutation(std::move(mutation)), ok_status));
+        FailedMutation(SingleRowMutation(std::move(mutation)), ok_status,
+                       annotations_[index++].original_index));
   }
+  mutations_.clear_entries();
+  annotations_.clear();
   return result;
 }
 
@@ -37,9 +37,7 @@ class BulkMutator {
               IdempotentMutationPolicy& idempotent_policy, BulkMutation&& mut);
 
   /// Return true if there are pending mutations in the mutator
-  bool HasPendingMutations() const {
-    return pending_mutations_.entries_size() != 0;
-  }
+  bool HasPendingMutations() const { return mutations_.entries_size() != 0; }
 
   /// Synchronously send one batch request to the given stub.
   grpc::Status MakeOneRequest(bigtable::DataClient& client,
@@ -61,7 +59,14 @@ class BulkMutator {
   /// Accumulate any permanent failures and the list of mutations we gave up on.
   std::vector<FailedMutation> failures_;
 
-  /// The current request proto.
+  /**
+   * The current request proto.
+   *
+   * Between requests it contains only the mutations that need to be retried.
+   * The entries are reused across retries: `FinishRequest()` moves the
+   * pending entries to the front of the request and discards the rest, so a
+   * retry does not copy or allocate any entries.
+   */
   google::bigtable::v2::MutateRowsRequest mutations_;
 
   /**
@@ -82,16 +87,12 @@ class BulkMutator {
     bool is_idempotent;
     /// Set to false if the result is unknown.
     bool has_mutation_result;
+    /// Set to true if the mutation must be sent again in the next request.
+    bool is_pending;
   };
 
-  /// The annotations about the current bulk request.
+  /// The annotations about the current bulk request, one per entry.
   std::vector<Annotations> annotations_;
-
-  /// Accumulate mutations for the next request.
-  google::bigtable::v2::MutateRowsRequest pending_mutations_;
-
-  /// Accumulate annotations for the next request.
-  std::vector<Annotations> pending_annotations_;
 };
 
 /**
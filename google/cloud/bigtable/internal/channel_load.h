@@ -0,0 +1,134 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_CHANNEL_LOAD_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_CHANNEL_LOAD_H_
+
+#include "google/cloud/bigtable/version.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+/**
+ * Track the number of calls in flight on each channel of a pool.
+ *
+ * `Pick()` implements the "power of two choices" load balancing algorithm: it
+ * samples two channels and returns the one with fewer calls in flight. This
+ * avoids sending 1/N of the calls to a channel that is busy with long running
+ * streams, without the cost of examining every channel on each call.
+ *
+ * All the member functions are lock-free and safe to call from multiple
+ * threads.
+ */
+class ChannelLoad {
+ public:
+  explicit ChannelLoad(std::size_t size)
+      : size_(size), state_(new std::atomic<std::uint64_t>[size]), seed_(0) {
+    for (std::size_t i = 0; i != size_; ++i) {
+      state_[i].store(0);
+    }
+  }
+
+  std::size_t size() const { return size_; }
+
+  /**
+   * Pick the channel for the next call.
+   *
+   * @param is_ready a callable with `bool(std::size_t)` signature, returns true
+   *     if the channel at the given index is ready. A channel that is not ready
+   *     is only picked if the other choice is not ready either.
+   */
+  template <typename IsReady>
+  std::size_t Pick(IsReady&& is_ready) {
+    if (size_ <= 1) {
+      return 0;
+    }
+    auto r = NextRandom();
+    // Pick two different channels, `b` is at a random non-zero offset from `a`.
+    auto a = static_cast<std::size_t>(r % size_);
+    auto offset = 1 + static_cast<std::size_t>((r >> 32) % (size_ - 1));
+    auto b = (a + offset) % size_;
+    bool a_ready = is_ready(a);
+    if (a_ready != is_ready(b)) {
+      return a_ready ? a : b;
+    }
+    return outstanding(b) < outstanding(a) ? b : a;
+  }
+
+  /**
+   * Record the start of a call on the channel at @p index.
+   *
+   * @return the token to pass to `Release()` when the call ends.
+   */
+  std::uint32_t Acquire(std::size_t index) {
+    return static_cast<std::uint32_t>(state_[index].fetch_add(1) >> 32U);
+  }
+
+  /// Record the end of a call on the channel at @p index.
+  void Release(std::size_t index, std::uint32_t token) {
+    auto current = state_[index].load();
+    // Calls started before the channel was reset are no longer counted.
+    while (static_cast<std::uint32_t>(current >> 32U) == token and
+           not state_[index].compare_exchange_weak(current, current - 1)) {
+    }
+  }
+
+  /**
+   * Stop counting the calls in flight on the channel at @p index.
+   *
+   * Used when the channel is replaced: the calls on the old channel do not
+   * load the new one, and their `Release()` calls are ignored.
+   */
+  void Reset(std::size_t index) {
+    auto current = state_[index].load();
+    while (not state_[index].compare_exchange_weak(
+        current, ((current >> 32U) + 1) << 32U)) {
+    }
+  }
+
+  /// The number of calls in flight on the channel at @p index.
+  long outstanding(std::size_t index) const {
+    return static_cast<long>(state_[index].load(std::memory_order_relaxed) &
+                             0xFFFFFFFFULL);
+  }
+
+ private:
+  /// A lock-free pseudo-random generator, the SplitMix64 sequence.
+  std::uint64_t NextRandom() {
+    std::uint64_t z = seed_.fetch_add(0x9E3779B97F4A7C15ULL) +
+                      0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+
+  std::size_t const size_;
+  // The low 32 bits count the calls in flight, the high 32 bits count how many
+  // times the channel was reset.
+  std::unique_ptr<std::atomic<std::uint64_t>[]> state_;
+  std::atomic<std::uint64_t> seed_;
+};
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_CHANNEL_LOAD_H_
@@ -0,0 +1,103 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/channel_load.h"
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <set>
+
+namespace bigtable = google::cloud::bigtable;
+using bigtable::internal::ChannelLoad;
+
+namespace {
+auto const kAllReady = [](std::size_t) { return true; };
+}  // anonymous namespace
+
+TEST(ChannelLoadTest, SingleChannel) {
+  ChannelLoad tested(1);
+  EXPECT_EQ(0U, tested.Pick(kAllReady));
+  auto token = tested.Acquire(0);
+  EXPECT_EQ(1, tested.outstanding(0));
+  EXPECT_EQ(0U, tested.Pick(kAllReady));
+  tested.Release(0, token);
+  EXPECT_EQ(0, tested.outstanding(0));
+}
+
+TEST(ChannelLoadTest, Reset) {
+  ChannelLoad tested(2);
+  auto old_token = tested.Acquire(0);
+  tested.Acquire(0);
+  tested.Acquire(1);
+  tested.Reset(0);
+  EXPECT_EQ(0, tested.outstanding(0));
+  EXPECT_EQ(1, tested.outstanding(1));
+
+  // Calls started before the reset do not affect the new count.
+  auto token = tested.Acquire(0);
+  EXPECT_EQ(1, tested.outstanding(0));
+  tested.Release(0, old_token);
+  EXPECT_EQ(1, tested.outstanding(0));
+  tested.Release(0, token);
+  EXPECT_EQ(0, tested.outstanding(0));
+}
+
+TEST(ChannelLoadTest, UsesAllChannels) {
+  ChannelLoad tested(4);
+  std::set<std::size_t> picked;
+  for (int i = 0; i != 100; ++i) {
+    auto index = tested.Pick(kAllReady);
+    ASSERT_LT(index, tested.size());
+    picked.insert(index);
+  }
+  EXPECT_EQ(4U, picked.size());
+}
+
+TEST(ChannelLoadTest, AvoidsBusiestChannel) {
+  ChannelLoad tested(2);
+  for (int i = 0; i != 10; ++i) {
+    tested.Acquire(0);
+  }
+  // With two channels both are always sampled, so the busy one is never used.
+  for (int i = 0; i != 100; ++i) {
+    EXPECT_EQ(1U, tested.Pick(kAllReady));
+  }
+}
+
+TEST(ChannelLoadTest, BalancesLoad) {
+  ChannelLoad tested(8);
+  // Start many long running calls, picking a channel for each one.
+  for (int i = 0; i != 800; ++i) {
+    tested.Acquire(tested.Pick(kAllReady));
+  }
+  long max = 0;
+  for (std::size_t i = 0; i != tested.size(); ++i) {
+    max = std::max(max, tested.outstanding(i));
+  }
+  // Perfect balance is 100 calls per channel, the algorithm stays close.
+  EXPECT_GE(110, max);
+}
+
+TEST(ChannelLoadTest, PrefersReadyChannels) {
+  ChannelLoad tested(2);
+  for (int i = 0; i != 10; ++i) {
+    tested.Acquire(1);
+  }
+  auto only_one = [](std::size_t index) { return index == 1; };
+  for (int i = 0; i != 100; ++i) {
+    EXPECT_EQ(1U, tested.Pick(only_one));
+  }
+  // If no channel is ready the load decides.
+  auto none = [](std::size_t) { return false; };
+  EXPECT_EQ(0U, tested.Pick(none));
+}
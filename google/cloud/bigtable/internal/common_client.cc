@@ -19,22 +19,48 @@ namespace bigtable {
 inline namespace BIGTABLE_CLIENT_NS {
 namespace internal {
 
+std::shared_ptr<grpc::Channel> CreateChannel(
+    std::string const& endpoint, bigtable::ClientOptions const& options,
+    std::size_t index, int generation) {
+  auto args = options.channel_arguments();
+  if (not options.connection_pool_name().empty()) {
+    args.SetString("cbt-c++/connection-pool-name",
+                   options.connection_pool_name());
+  }
+  args.SetInt("cbt-c++/connection-pool-id", static_cast<int>(index));
+  if (generation != 0) {
+    // gRPC shares sockets between channels with the same arguments, a new
+    // generation forces the replacement channel to open a new connection.
+    args.SetInt("cbt-c++/connection-pool-generation", generation);
+  }
+  return grpc::CreateCustomChannel(endpoint, options.credentials(), args);
+}
+
 std::vector<std::shared_ptr<grpc::Channel>> CreateChannelPool(
     std::string const& endpoint, bigtable::ClientOptions const& options) {
   std::vector<std::shared_ptr<grpc::Channel>> result;
   for (std::size_t i = 0; i != options.connection_pool_size(); ++i) {
-    auto args = options.channel_arguments();
-    if (not options.connection_pool_name().empty()) {
-      args.SetString("cbt-c++/connection-pool-name",
-                     options.connection_pool_name());
-    }
-    args.SetInt("cbt-c++/connection-pool-id", static_cast<int>(i));
-    result.push_back(
-        grpc::CreateCustomChannel(endpoint, options.credentials(), args));
+    result.push_back(CreateChannel(endpoint, options, i, 0));
   }
   return result;
 }
 
+bool WaitForChannelsReady(
+    std::vector<std::shared_ptr<grpc::Channel>> const& channels,
+    std::chrono::milliseconds timeout) {
+  auto deadline = std::chrono::system_clock::now() + timeout;
+  // Start all the connections before waiting on any of them, so the handshakes
+  // run in parallel.
+  for (auto const& channel : channels) {
+    channel->GetState(true);
+  }
+  bool all_ready = true;
+  for (auto const& channel : channels) {
+    all_ready = channel->WaitForConnected(deadline) and all_ready;
+  }
+  return all_ready;
+}
+
 }  // namespace internal
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
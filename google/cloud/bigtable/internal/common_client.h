@@ -16,7 +16,15 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_COMMON_CLIENT_H_
 
 #include "google/cloud/bigtable/client_options.h"
+#include "google/cloud/bigtable/internal/channel_load.h"
 #include <grpcpp/grpcpp.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -24,18 +32,129 @@ namespace bigtable {
 inline namespace BIGTABLE_CLIENT_NS {
 namespace internal {
 
+/**
+ * Create the @p index channel of a pool based on the client options.
+ *
+ * Channels with different values of @p generation do not share connections,
+ * use a new generation when replacing a channel in an existing pool.
+ */
+std::shared_ptr<grpc::Channel> CreateChannel(
+    std::string const& endpoint, bigtable::ClientOptions const& options,
+    std::size_t index, int generation);
+
 /// Create a pool of grpc::Channel objects based on the client options.
 std::vector<std::shared_ptr<grpc::Channel>> CreateChannelPool(
     std::string const& endpoint, bigtable::ClientOptions const& options);
 
+/**
+ * Start connecting all the @p channels, and wait until they are ready.
+ *
+ * @return true if all the channels became ready before @p timeout expired.
+ */
+bool WaitForChannelsReady(
+    std::vector<std::shared_ptr<grpc::Channel>> const& channels,
+    std::chrono::milliseconds timeout);
+
+/**
+ * A `grpc::ClientReaderInterface` wrapper that keeps its stub lease alive.
+ *
+ * `CommonClient::Stub()` counts a call as in flight until the last copy of the
+ * returned pointer is released. For streaming RPCs the call lasts as long as
+ * the reader, this wrapper holds the stub until the reader is destroyed.
+ */
+template <typename Response, typename StubPtr>
+class LeasedClientReader : public grpc::ClientReaderInterface<Response> {
+ public:
+  LeasedClientReader(StubPtr stub,
+                     std::unique_ptr<grpc::ClientReaderInterface<Response>> r)
+      : stub_(std::move(stub)), reader_(std::move(r)) {}
+
+  grpc::Status Finish() override { return reader_->Finish(); }
+  bool NextMessageSize(std::uint32_t* sz) override {
+    return reader_->NextMessageSize(sz);
+  }
+  bool Read(Response* msg) override { return reader_->Read(msg); }
+  void WaitForInitialMetadata() override { reader_->WaitForInitialMetadata(); }
+
+ private:
+  // Declared first so it is destroyed after the reader.
+  StubPtr stub_;
+  std::unique_ptr<grpc::ClientReaderInterface<Response>> reader_;
+};
+
+/// Wrap @p reader to keep @p stub alive as long as the reader.
+template <typename Response, typename StubPtr>
+std::unique_ptr<grpc::ClientReaderInterface<Response>> MakeLeasedClientReader(
+    StubPtr stub, std::unique_ptr<grpc::ClientReaderInterface<Response>> r) {
+  return std::unique_ptr<grpc::ClientReaderInterface<Response>>(
+      new LeasedClientReader<Response, StubPtr>(std::move(stub), std::move(r)));
+}
+
+/**
+ * A `grpc::ClientAsyncReaderInterface` wrapper that keeps its stub lease alive.
+ *
+ * The asynchronous operation owns the reader until the stream finishes, so the
+ * call is counted as in flight for the life of the stream.
+ */
+template <typename Response, typename StubPtr>
+class LeasedClientAsyncReader
+    : public grpc::ClientAsyncReaderInterface<Response> {
+ public:
+  LeasedClientAsyncReader(
+      StubPtr stub,
+      std::unique_ptr<grpc::ClientAsyncReaderInterface<Response>> r)
+      : stub_(std::move(stub)), reader_(std::move(r)) {}
+
+  void StartCall(void* tag) override { reader_->StartCall(tag); }
+  void ReadInitialMetadata(void* tag) override {
+    reader_->ReadInitialMetadata(tag);
+  }
+  void Finish(grpc::Status* status, void* tag) override {
+    reader_->Finish(status, tag);
+  }
+  void Read(Response* msg, void* tag) override { reader_->Read(msg, tag); }
+
+ private:
+  // Declared first so it is destroyed after the reader.
+  StubPtr stub_;
+  std::unique_ptr<grpc::ClientAsyncReaderInterface<Response>> reader_;
+};
+
+/// Wrap @p reader to keep @p stub alive as long as the reader.
+template <typename Response, typename StubPtr>
+std::unique_ptr<grpc::ClientAsyncReaderInterface<Response>>
+MakeLeasedClientAsyncReader(
+    StubPtr stub,
+    std::unique_ptr<grpc::ClientAsyncReaderInterface<Response>> r) {
+  return std::unique_ptr<grpc::ClientAsyncReaderInterface<Response>>(
+      new LeasedClientAsyncReader<Response, StubPtr>(std::move(stub),
+                                                     std::move(r)));
+}
+
 /**
  * Refactor implementation of `bigtable::{Data,Admin,InstanceAdmin}Client`.
  *
  * All the clients need to keep a collection (sometimes with a single element)
- * of channels, update the collection when needed and round-robin across the
+ * of channels, update the collection when needed and load balance across the
  * channels. At least `bigtable::DataClient` needs to optimize the creation of
  * the stub objects.
  *
+ * The calls are load balanced using `ChannelLoad`: each call goes to the less
+ * loaded of two randomly sampled channels, preferring channels in the
+ * `GRPC_CHANNEL_READY` state. A call is in flight until the lease returned by
+ * `Stub()` is destroyed; callers starting streaming RPCs should hold on to it
+ * for the duration of the stream (see `MakeLeasedClientReader()` and
+ * `MakeLeasedClientAsyncReader()`). Asynchronous unary calls are counted only
+ * while they are being started: gRPC never deletes their response readers, so
+ * the readers cannot hold the lease.
+ *
+ * If `ClientOptions::preconnect_timeout()` is set the channels are created and
+ * connected by the constructor.  If `ClientOptions::max_channel_age()` is set,
+ * expired channels are replaced: the first call after a channel expires starts
+ * connecting its replacement, and the replacement is swapped into the pool by
+ * the first call that finds it ready.  Calls keep using the old channel until
+ * then, so the replacement does not stall any call.
+ *
  * The class exposes the channels because they are needed for clients that
  * use more than one type of Stub.
  *
@@ -45,15 +164,66 @@ std::vector<std::shared_ptr<grpc::Channel>> CreateChannelPool(
  */
 template <typename Traits, typename Interface>
 class CommonClient {
+ private:
+  struct Pool;
+
  public:
+  /**
+   * A stub, and the lease that counts a call in flight on its channel.
+   *
+   * The call ends when the lease is destroyed. Leases can be moved but not
+   * copied, so each call is counted once, and creating a lease does not
+   * allocate.
+   */
+  class StubLease {
+   public:
+    StubLease() : index_(0), token_(0) {}
+    StubLease(StubLease&&) noexcept = default;
+    StubLease& operator=(StubLease&& rhs) noexcept {
+      Release();
+      pool_ = std::move(rhs.pool_);
+      index_ = rhs.index_;
+      token_ = rhs.token_;
+      return *this;
+    }
+    ~StubLease() { Release(); }
+
+    typename Interface::StubInterface* get() const {
+      return pool_ ? pool_->stubs[index_].get() : nullptr;
+    }
+    typename Interface::StubInterface* operator->() const { return get(); }
+
+   private:
+    friend class CommonClient;
+    StubLease(std::shared_ptr<Pool> pool, std::size_t index)
+        : pool_(std::move(pool)),
+          index_(index),
+          token_(pool_->load->Acquire(index)) {}
+
+    void Release() {
+      if (pool_) {
+        pool_->load->Release(index_, token_);
+        pool_.reset();
+      }
+    }
+
+    std::shared_ptr<Pool> pool_;
+    std::size_t index_;
+    std::uint32_t token_;
+  };
+
   //@{
   /// @name Type traits.
-  using StubPtr = std::shared_ptr<typename Interface::StubInterface>;
+  using StubPtr = StubLease;
   using ChannelPtr = std::shared_ptr<grpc::Channel>;
   //@}
 
   CommonClient(bigtable::ClientOptions options)
-      : options_(std::move(options)), current_index_(0) {}
+      : options_(std::move(options)) {
+    if (options_.preconnect_timeout().count() > 0) {
+      CheckConnections();
+    }
+  }
 
   /**
    * Reset the channel and stub.
@@ -62,74 +232,180 @@ class CommonClient {
    * the channel and stub will need to be reset under some error conditions
    * and/or when the credentials require explicit refresh.
    */
-  void reset() {
-    std::lock_guard<std::mutex> lk(mu_);
-    stubs_.clear();
-  }
+  void reset() { std::atomic_store(&pool_, std::shared_ptr<Pool>()); }
 
   /// Return the next Stub to make a call.
   StubPtr Stub() {
-    std::unique_lock<std::mutex> lk(mu_);
-    CheckConnections(lk);
-    auto stub = stubs_[GetIndex(lk)];
-    return stub;
+    auto pool = CheckConnections();
+    pool = RefreshIfExpired(std::move(pool));
+    auto index = GetIndex(*pool);
+    // The lease keeps the pool alive, and marks the end of the call when it is
+    // destroyed.
+    return StubLease(std::move(pool), index);
   }
 
   /// Return the next Channel to make a call.
   ChannelPtr Channel() {
-    std::unique_lock<std::mutex> lk(mu_);
-    CheckConnections(lk);
-    auto channel = channels_[GetIndex(lk)];
-    return channel;
+    auto pool = CheckConnections();
+    pool = RefreshIfExpired(std::move(pool));
+    return pool->channels[GetIndex(*pool)];
   }
 
  private:
-  /// Make sure the connections exit, and create them if needed.
-  void CheckConnections(std::unique_lock<std::mutex>& lk) {
-    if (not stubs_.empty()) {
-      return;
+  using Clock = std::chrono::steady_clock;
+  using StubInterfacePtr = std::shared_ptr<typename Interface::StubInterface>;
+
+  /**
+   * The channels, their stubs, and the calls in flight on each channel.
+   *
+   * A pool is immutable once published, with the exception of the pending
+   * replacement channel, which is guarded by `refresh_mu`, and the load, which
+   * is shared with the pools that replace this one.
+   */
+  struct Pool {
+    Pool(std::vector<ChannelPtr> c, std::vector<StubInterfacePtr> s,
+         std::shared_ptr<ChannelLoad> l, std::vector<Clock::time_point> e,
+         int g)
+        : channels(std::move(c)),
+          stubs(std::move(s)),
+          load(std::move(l)),
+          expiration(std::move(e)),
+          next_expiration(
+              expiration.empty()
+                  ? Clock::time_point::max()
+                  : *std::min_element(expiration.begin(), expiration.end())),
+          generation(g) {}
+
+    std::vector<ChannelPtr> channels;
+    std::vector<StubInterfacePtr> stubs;
+    std::shared_ptr<ChannelLoad> load;
+    std::vector<Clock::time_point> expiration;
+    Clock::time_point next_expiration;
+    int generation;
+
+    std::mutex refresh_mu;
+    ChannelPtr replacement;
+    std::size_t replacement_index;
+  };
+
+  static StubInterfacePtr MakeStub(ChannelPtr channel) {
+    return Interface::NewStub(std::move(channel));
+  }
+
+  /// Compute when each channel in a new pool expires.
+  std::vector<Clock::time_point> InitialExpiration(std::size_t size) const {
+    auto const max_age = options_.max_channel_age();
+    if (max_age.count() <= 0) {
+      return std::vector<Clock::time_point>(size, Clock::time_point::max());
+    }
+    // Spread the expirations over the second half of `max_age`, so the
+    // channels are not all replaced at the same time.
+    auto const now = Clock::now();
+    auto const n = static_cast<std::chrono::milliseconds::rep>(size);
+    std::vector<Clock::time_point> result;
+    for (std::size_t i = 0; i != size; ++i) {
+      auto const k = static_cast<std::chrono::milliseconds::rep>(i);
+      result.push_back(now + max_age - max_age * k / (2 * n));
+    }
+    return result;
+  }
+
+  /// Replace the oldest channel in @p pool if it has expired.
+  std::shared_ptr<Pool> RefreshIfExpired(std::shared_ptr<Pool> pool) {
+    if (pool->next_expiration == Clock::time_point::max() or
+        Clock::now() < pool->next_expiration) {
+      return pool;
+    }
+    // Only one thread needs to do the work, the others keep using the current
+    // pool.
+    std::unique_lock<std::mutex> lk(pool->refresh_mu, std::try_to_lock);
+    if (not lk.owns_lock()) {
+      return pool;
     }
-    // Release the lock while making remote calls.  gRPC uses the current
+    if (not pool->replacement) {
+      auto oldest = std::min_element(pool->expiration.begin(),
+                                     pool->expiration.end());
+      pool->replacement_index =
+          static_cast<std::size_t>(oldest - pool->expiration.begin());
+      pool->replacement =
+          CreateChannel(Traits::Endpoint(options_), options_,
+                        pool->replacement_index, pool->generation + 1);
+      // Start connecting, the channel is swapped in once it is ready.
+      pool->replacement->GetState(true);
+      return pool;
+    }
+    if (pool->replacement->GetState(true) != GRPC_CHANNEL_READY) {
+      return pool;
+    }
+    auto const index = pool->replacement_index;
+    auto channels = pool->channels;
+    auto stubs = pool->stubs;
+    auto expiration = pool->expiration;
+    channels[index] = pool->replacement;
+    stubs[index] = MakeStub(pool->replacement);
+    expiration[index] = Clock::now() + options_.max_channel_age();
+    auto refreshed = std::make_shared<Pool>(
+        std::move(channels), std::move(stubs), pool->load,
+        std::move(expiration), pool->generation + 1);
+    // The calls in flight on the other channels remain counted, only the calls
+    // on the replaced channel are forgotten.
+    pool->load->Reset(index);
+    auto expected = pool;
+    if (std::atomic_compare_exchange_strong(&pool_, &expected, refreshed)) {
+      return refreshed;
+    }
+    // The pool was reset by another thread, use whatever is installed now.
+    return expected ? expected : pool;
+  }
+
+  /// Make sure the connections exist, and create them if needed.
+  std::shared_ptr<Pool> CheckConnections() {
+    auto pool = std::atomic_load(&pool_);
+    if (pool) {
+      return pool;
+    }
+    // No lock is held while making remote calls.  gRPC uses the current
     // thread to make remote connections (and probably authenticate), holding
-    // a lock for long operations like that is a bad practice.  Releasing
-    // the lock here can result in wasted work, but that is a smaller problem
-    // than a deadlock or an unbounded priority inversion.
+    // a lock for long operations like that is a bad practice.  Multiple threads
+    // may create a pool at the same time, which results in wasted work, but
+    // that is a smaller problem than a deadlock or an unbounded priority
+    // inversion.
     // Note that only one connection per application is created by gRPC, even
     // if multiple threads are calling this function at the same time. gRPC
     // only opens one socket per destination+attributes combo, we artificially
     // introduce attributes in the implementation of CreateChannelPool() to
     // create one socket per element in the pool.
-    lk.unlock();
     auto channels = CreateChannelPool(Traits::Endpoint(options_), options_);
-    std::vector<StubPtr> tmp;
+    if (options_.preconnect_timeout().count() > 0) {
+      // Channels that are not ready by the deadline keep connecting in the
+      // background, there is no need to report an error.
+      (void)WaitForChannelsReady(channels, options_.preconnect_timeout());
+    }
+    std::vector<StubInterfacePtr> tmp;
     std::transform(channels.begin(), channels.end(), std::back_inserter(tmp),
-                   [](std::shared_ptr<grpc::Channel> ch) {
-                     return Interface::NewStub(ch);
-                   });
-    lk.lock();
-    if (stubs_.empty()) {
-      channels.swap(channels_);
-      tmp.swap(stubs_);
-      current_index_ = 0;
+                   &CommonClient::MakeStub);
+    auto expiration = InitialExpiration(channels.size());
+    auto load = std::make_shared<ChannelLoad>(channels.size());
+    auto created =
+        std::make_shared<Pool>(std::move(channels), std::move(tmp),
+                               std::move(load), std::move(expiration), 0);
+    if (std::atomic_compare_exchange_strong(&pool_, &pool, created)) {
+      return created;
     }
+    // Another thread installed its pool first, `pool` now holds that value.
+    return pool;
   }
 
-  /// Get the current index for round-robin over connections.
-  std::size_t GetIndex(std::unique_lock<std::mutex>& lk) {
-    std::size_t current = current_index_++;
-    // Round robin through the connections.
-    if (current_index_ >= stubs_.size()) {
-      current_index_ = 0;
-    }
-    return current;
+  /// Pick the channel for the next call.
+  std::size_t GetIndex(Pool& pool) {
+    return pool.load->Pick([&pool](std::size_t index) {
+      return pool.channels[index]->GetState(false) == GRPC_CHANNEL_READY;
+    });
   }
 
  private:
-  std::mutex mu_;
   ClientOptions options_;
-  std::vector<ChannelPtr> channels_;
-  std::vector<StubPtr> stubs_;
-  std::size_t current_index_;
+  std::shared_ptr<Pool> pool_;
 };
 
 }  // namespace internal
@@ -0,0 +1,187 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/common_client.h"
+#include "google/cloud/bigtable/testing/mock_response_reader.h"
+#include "google/cloud/testing_util/chrono_literals.h"
+#include <google/bigtable/v2/bigtable.grpc.pb.h>
+#include <gmock/gmock.h>
+#include <thread>
+
+namespace bigtable = google::cloud::bigtable;
+namespace btproto = google::bigtable::v2;
+using namespace google::cloud::testing_util::chrono_literals;
+
+namespace {
+struct TestTraits {
+  static std::string const& Endpoint(bigtable::ClientOptions& options) {
+    return options.data_endpoint();
+  }
+};
+
+using TestClient =
+    bigtable::internal::CommonClient<TestTraits, btproto::Bigtable>;
+
+/// Run a server that accepts connections, the tests never make any calls.
+class CommonClientTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    int port = 0;
+    grpc::ServerBuilder builder;
+    builder.AddListeningPort("localhost:0", grpc::InsecureServerCredentials(),
+                             &port);
+    builder.RegisterService(&service_);
+    server_ = builder.BuildAndStart();
+    ASSERT_NE(0, port);
+    endpoint_ = "localhost:" + std::to_string(port);
+
+    // Find a port with no server listening: start a server and shut it down.
+    int closed_port = 0;
+    grpc::ServerBuilder closed_builder;
+    closed_builder.AddListeningPort("localhost:0",
+                                    grpc::InsecureServerCredentials(),
+                                    &closed_port);
+    btproto::Bigtable::Service closed_service;
+    closed_builder.RegisterService(&closed_service);
+    auto closed = closed_builder.BuildAndStart();
+    closed->Shutdown();
+    closed.reset();
+    closed_endpoint_ = "localhost:" + std::to_string(closed_port);
+  }
+
+  void TearDown() override { server_->Shutdown(); }
+
+  bigtable::ClientOptions Options(std::string const& endpoint) {
+    bigtable::ClientOptions options(grpc::InsecureChannelCredentials());
+    options.set_data_endpoint(endpoint).set_connection_pool_size(1);
+    return options;
+  }
+
+  btproto::Bigtable::Service service_;
+  std::unique_ptr<grpc::Server> server_;
+  std::string endpoint_;
+  std::string closed_endpoint_;
+};
+}  // anonymous namespace
+
+/// @test Verify that WaitForChannelsReady() connects the channels.
+TEST_F(CommonClientTest, WaitForChannelsReady) {
+  auto options = Options(endpoint_).set_connection_pool_size(4);
+  auto channels = bigtable::internal::CreateChannelPool(endpoint_, options);
+  EXPECT_TRUE(bigtable::internal::WaitForChannelsReady(channels, 10000_ms));
+  for (auto const& c : channels) {
+    EXPECT_EQ(GRPC_CHANNEL_READY, c->GetState(false));
+  }
+}
+
+/// @test Verify that WaitForChannelsReady() gives up after the timeout.
+TEST_F(CommonClientTest, WaitForChannelsReadyTimeout) {
+  auto options = Options(closed_endpoint_).set_connection_pool_size(4);
+  auto channels =
+      bigtable::internal::CreateChannelPool(closed_endpoint_, options);
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(bigtable::internal::WaitForChannelsReady(channels, 200_ms));
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  // The channels connect in parallel, the wait is bounded by a single timeout.
+  EXPECT_LE(150_ms, elapsed);
+  EXPECT_GT(5000_ms, elapsed);
+}
+
+/// @test Verify that the constructor connects the channels if requested.
+TEST_F(CommonClientTest, Preconnect) {
+  TestClient client(Options(endpoint_).set_preconnect_timeout(10000_ms));
+  auto channel = client.Channel();
+  ASSERT_NE(nullptr, channel);
+  EXPECT_EQ(GRPC_CHANNEL_READY, channel->GetState(false));
+}
+
+/// @test Verify that the constructor respects the preconnect timeout.
+TEST_F(CommonClientTest, PreconnectTimeout) {
+  auto start = std::chrono::steady_clock::now();
+  TestClient client(Options(closed_endpoint_).set_preconnect_timeout(200_ms));
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  EXPECT_LE(150_ms, elapsed);
+  EXPECT_GT(5000_ms, elapsed);
+  // The client is usable, the channel just is not connected.
+  auto channel = client.Channel();
+  ASSERT_NE(nullptr, channel);
+  EXPECT_NE(GRPC_CHANNEL_READY, channel->GetState(false));
+}
+
+/// @test Verify that the channels are not replaced before they expire.
+TEST_F(CommonClientTest, NoRefreshBeforeExpiration) {
+  TestClient client(Options(endpoint_)
+                        .set_preconnect_timeout(10000_ms)
+                        .set_max_channel_age(std::chrono::hours(1)));
+  auto const initial = client.Channel();
+  for (int i = 0; i != 100; ++i) {
+    EXPECT_EQ(initial, client.Channel());
+    EXPECT_NE(nullptr, client.Stub().get());
+  }
+}
+
+/// @test Verify that the channels are replaced once they expire.
+TEST_F(CommonClientTest, RefreshAfterExpiration) {
+  TestClient client(Options(endpoint_)
+                        .set_preconnect_timeout(10000_ms)
+                        .set_max_channel_age(10_ms));
+  auto const initial = client.Channel();
+  std::this_thread::sleep_for(20_ms);
+  // The first call after the expiration starts connecting the replacement, a
+  // later call swaps it in once it is ready.
+  auto current = client.Channel();
+  auto const deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (current == initial and std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(10_ms);
+    current = client.Channel();
+  }
+  EXPECT_NE(initial, current);
+  EXPECT_EQ(GRPC_CHANNEL_READY, current->GetState(false));
+}
+
+/// @test Verify that expired channels are used until the replacement is ready.
+TEST_F(CommonClientTest, RefreshWaitsForReplacement) {
+  TestClient client(Options(closed_endpoint_).set_max_channel_age(10_ms));
+  auto const initial = client.Channel();
+  std::this_thread::sleep_for(20_ms);
+  // The replacement can never connect, so it is never swapped in.
+  for (int i = 0; i != 20; ++i) {
+    EXPECT_EQ(initial, client.Channel());
+    std::this_thread::sleep_for(5_ms);
+  }
+}
+
+/// @test Verify that async readers keep their stub lease until destroyed.
+TEST(LeasedClientAsyncReaderTest, HoldsLease) {
+  using Response = btproto::ReadRowsResponse;
+  using MockReader =
+      bigtable::testing::MockClientAsyncReaderInterface<Response>;
+  auto lease = std::make_shared<int>(0);
+  std::weak_ptr<int> watcher = lease;
+  auto mock = new MockReader;
+  EXPECT_CALL(*mock, Read(::testing::_, ::testing::_)).Times(1);
+  EXPECT_CALL(*mock, Finish(::testing::_, ::testing::_)).Times(1);
+
+  auto reader = bigtable::internal::MakeLeasedClientAsyncReader(
+      std::move(lease),
+      std::unique_ptr<grpc::ClientAsyncReaderInterface<Response>>(mock));
+  Response response;
+  reader->Read(&response, nullptr);
+  grpc::Status status;
+  reader->Finish(&status, nullptr);
+  EXPECT_FALSE(watcher.expired());
+  reader.reset();
+  EXPECT_TRUE(watcher.expired());
+}
@@ -15,6 +15,7 @@
 #include "google/cloud/bigtable/internal/completion_queue_impl.h"
 #include "google/cloud/internal/make_unique.h"
 #include "google/cloud/internal/throw_delegate.h"
+#include <cstdint>
 
 // There is no wait to unblock the gRPC event loop, not even calling Shutdown(),
 // so we periodically wake up from the loop to check if the application has
@@ -26,6 +27,25 @@ namespace cloud {
 namespace bigtable {
 inline namespace BIGTABLE_CLIENT_NS {
 namespace internal {
+CompletionQueueImpl::~CompletionQueueImpl() {
+  // Discard any events still queued, the operations they refer to are still
+  // registered, and therefore alive. The gRPC completion queue can only be
+  // drained after it is shutdown.
+  if (shutdown_.load()) {
+    void* tag;
+    bool ok;
+    auto deadline = std::chrono::system_clock::now();
+    while (cq_.AsyncNext(&tag, &ok, deadline) ==
+           grpc::CompletionQueue::GOT_EVENT) {
+    }
+  }
+  // Operations that never completed hold a reference to themselves, release
+  // them. Destroying an operation cancels its alarm or RPC, and releases the
+  // state captured by its callback, which may register new operations.
+  while (not PendingOperations(true).empty()) {
+  }
+}
+
 void CompletionQueueImpl::Run(CompletionQueue& cq) {
   while (not shutdown_.load()) {
     void* tag;
@@ -42,9 +62,11 @@ void CompletionQueueImpl::Run(CompletionQueue& cq) {
       google::cloud::internal::ThrowRuntimeError(
           "unexpected status from AsyncNext()");
     }
-    auto op = FindOperation(tag);
+    // The tag is the operation, and the operation keeps itself alive until
+    // ForgetOperation() is called, so no lookup is needed.
+    auto op = static_cast<AsyncGrpcOperation*>(tag);
     if (op->Notify(cq, ok)) {
-      ForgetOperation(tag);
+      ForgetOperation(op);
     }
   }
 }
@@ -60,39 +82,94 @@ std::unique_ptr<grpc::Alarm> CompletionQueueImpl::CreateAlarm() const {
 
 void* CompletionQueueImpl::RegisterOperation(
     std::shared_ptr<AsyncGrpcOperation> op) {
-  void* tag = op.get();
-  std::unique_lock<std::mutex> lk(mu_);
-  auto ins =
-      pending_ops_.emplace(reinterpret_cast<std::intptr_t>(tag), std::move(op));
-  // After this point we no longer need the lock, so release it.
-  lk.unlock();
-  if (ins.second) {
-    return tag;
+  AsyncGrpcOperation* raw = op.get();
+  auto& list = ListFor(raw);
+  std::lock_guard<std::mutex> lk(list.mu);
+  if (raw->self_) {
+    google::cloud::internal::ThrowRuntimeError(
+        "assertion failure: operation registered more than once");
+  }
+  raw->self_ = std::move(op);
+  raw->prev_pending_ = nullptr;
+  raw->next_pending_ = list.head;
+  if (list.head != nullptr) {
+    list.head->prev_pending_ = raw;
   }
-  google::cloud::internal::ThrowRuntimeError(
-      "assertion failure: insertion should succeed");
+  list.head = raw;
+  pending_count_.fetch_add(1);
+  return raw;
 }
 
 std::shared_ptr<AsyncGrpcOperation> CompletionQueueImpl::FindOperation(
     void* tag) {
-  std::lock_guard<std::mutex> lk(mu_);
-  auto loc = pending_ops_.find(reinterpret_cast<std::intptr_t>(tag));
-  if (pending_ops_.end() == loc) {
+  auto op = static_cast<AsyncGrpcOperation*>(tag);
+  auto& list = ListFor(op);
+  std::lock_guard<std::mutex> lk(list.mu);
+  if (not op->self_) {
     google::cloud::internal::ThrowRuntimeError(
         "assertion failure: searching for async op tag");
   }
-  return loc->second;
+  return op->self_;
 }
 
-void CompletionQueueImpl::ForgetOperation(void* tag) {
-  std::lock_guard<std::mutex> lk(mu_);
-  auto const num_erased =
-      pending_ops_.erase(reinterpret_cast<std::intptr_t>(tag));
-  if (1U != num_erased) {
-    google::cloud::internal::ThrowRuntimeError(
-        "assertion failure: searching for async op tag when trying to "
-        "unregister");
+void CompletionQueueImpl::ForgetOperation(AsyncGrpcOperation* op) {
+  std::shared_ptr<AsyncGrpcOperation> self;
+  {
+    auto& list = ListFor(op);
+    std::lock_guard<std::mutex> lk(list.mu);
+    if (not op->self_) {
+      google::cloud::internal::ThrowRuntimeError(
+          "assertion failure: searching for async op tag when trying to "
+          "unregister");
+    }
+    if (op->prev_pending_ != nullptr) {
+      op->prev_pending_->next_pending_ = op->next_pending_;
+    } else {
+      list.head = op->next_pending_;
+    }
+    if (op->next_pending_ != nullptr) {
+      op->next_pending_->prev_pending_ = op->prev_pending_;
+    }
+    op->prev_pending_ = nullptr;
+    op->next_pending_ = nullptr;
+    self = std::move(op->self_);
   }
+  pending_count_.fetch_sub(1);
+  // Releasing `self` may delete the operation, do not use `op` after this
+  // point.
+}
+
+CompletionQueueImpl::PendingList& CompletionQueueImpl::ListFor(
+    AsyncGrpcOperation const* op) {
+  // The low bits of the address are always zero due to alignment.
+  auto const index = (reinterpret_cast<std::uintptr_t>(op) >> 4U);
+  return pending_[index % pending_.size()];
+}
+
+std::vector<std::shared_ptr<AsyncGrpcOperation>>
+CompletionQueueImpl::PendingOperations(bool forget) {
+  std::vector<std::shared_ptr<AsyncGrpcOperation>> ops;
+  for (auto& list : pending_) {
+    std::lock_guard<std::mutex> lk(list.mu);
+    for (auto op = list.head; op != nullptr;) {
+      auto next = op->next_pending_;
+      if (forget) {
+        op->prev_pending_ = nullptr;
+        op->next_pending_ = nullptr;
+        ops.push_back(std::move(op->self_));
+      } else {
+        ops.push_back(op->self_);
+      }
+      op = next;
+    }
+    if (forget) {
+      list.head = nullptr;
+    }
+  }
+  if (forget) {
+    pending_count_.fetch_sub(ops.size());
+  }
+  return ops;
 }
 
 // This function is used in unit tests to simulate the completion of an
@@ -105,25 +182,16 @@ void CompletionQueueImpl::SimulateCompletion(CompletionQueue& cq,
   auto internal_op = FindOperation(op);
   internal_op->Cancel();
   if (internal_op->Notify(cq, ok)) {
-    ForgetOperation(op);
+    ForgetOperation(internal_op.get());
   }
 }
 
 void CompletionQueueImpl::SimulateCompletion(CompletionQueue& cq, bool ok) {
   // Make a copy to avoid race conditions or iterator invalidation.
-  std::vector<void*> tags;
-  {
-    std::lock_guard<std::mutex> lk(mu_);
-    tags.reserve(pending_ops_.size());
-    for (auto&& kv : pending_ops_) {
-      tags.push_back(reinterpret_cast<void*>(kv.first));
-    }
-  }
-  for (void* tag : tags) {
-    auto internal_op = FindOperation(tag);
+  for (auto&& internal_op : PendingOperations(false)) {
     internal_op->Cancel();
     if (internal_op->Notify(cq, ok)) {
-      ForgetOperation(tag);
+      ForgetOperation(internal_op.get());
     }
   }
 
@@ -21,9 +21,11 @@
 #include <grpcpp/alarm.h>
 #include <grpcpp/support/async_stream.h>
 #include <grpcpp/support/async_unary_call.h>
+#include <array>
 #include <atomic>
+#include <mutex>
 #include <string>
-#include <unordered_map>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -41,6 +43,12 @@ namespace internal {
  * hides it in a class derived from `AsyncOperation`. A shared pointer to the
  * `AsyncOperation` is returned by the completion queue so library developers
  * can cancel the operation if needed.
+ *
+ * The address of the operation is the tag used with `grpc::CompletionQueue`,
+ * so the completion queue does not need a map from tags to operations. While
+ * the operation is pending it holds a reference to itself, which the
+ * completion queue releases when the operation completes, or when the
+ * completion queue is destroyed.
  */
 class AsyncGrpcOperation : public AsyncOperation {
  private:
@@ -60,6 +68,17 @@ class AsyncGrpcOperation : public AsyncOperation {
    *   response, it would return true only after the stream is finished).
    */
   virtual bool Notify(CompletionQueue& cq, bool ok) = 0;
+
+  /**
+   * Keeps the operation alive while it is registered with a completion queue.
+   *
+   * Guarded by the mutex of the completion queue list holding the operation.
+   */
+  std::shared_ptr<AsyncGrpcOperation> self_;
+
+  /// Links the pending operations, guarded by the same mutex as `self_`.
+  AsyncGrpcOperation* prev_pending_ = nullptr;
+  AsyncGrpcOperation* next_pending_ = nullptr;
 };
 
 /**
@@ -95,7 +114,6 @@ class AsyncTimerFunctor : public AsyncGrpcOperation {
 
   void Set(grpc::CompletionQueue& cq,
            std::chrono::system_clock::time_point deadline, void* tag) {
-    std::unique_lock<std::mutex> lk(mu_);
     timer_.deadline = deadline;
     if (alarm_) {
       alarm_->Set(&cq, deadline, tag);
@@ -103,7 +121,6 @@ class AsyncTimerFunctor : public AsyncGrpcOperation {
   }
 
   void Cancel() override {
-    std::unique_lock<std::mutex> lk(mu_);
     if (alarm_) {
       alarm_->Cancel();
     }
@@ -111,20 +128,16 @@ class AsyncTimerFunctor : public AsyncGrpcOperation {
 
  private:
   bool Notify(CompletionQueue& cq, bool ok) override {
-    std::unique_lock<std::mutex> lk(mu_);
-    alarm_.reset();
     timer_.cancelled = not ok;
-    lk.unlock();
-    // At this point timer_ is not going to be used by any other thread, so we
-    // might use it without a lock.
     functor_(cq, timer_);
     return true;
   }
 
-  // It might not be clear why the mutex is needed.
-  // We need to make sure that `if (alarm_) { alarm_->Cancel(); }` is atomic.
-  // Without the mutex it is not because `Notify` resets `alarm_`.
-  std::mutex mu_;
+  // No mutex is needed: the alarm is created in the constructor and is only
+  // released when this object is destroyed, and `grpc::Alarm::Cancel()` is a
+  // no-op once the alarm has fired. `timer_` is written in `Set()` before the
+  // alarm is armed, and the completion queue provides the synchronization
+  // between that write and `Notify()`.
   Functor functor_;
   AsyncTimerResult timer_;
   std::unique_ptr<grpc::Alarm> alarm_;
@@ -338,6 +351,167 @@ class AsyncUnaryStreamRpcFunctor : public AsyncGrpcOperation {
   std::unique_ptr<grpc::ClientAsyncReaderInterface<Response>> response_reader_;
 };
 
+/**
+ * A streaming RPC operation where the caller controls when to `Read()`.
+ *
+ * `AsyncUnaryStreamRpcFunctor` issues the next `Read()` as soon as the data
+ * callback returns, so a slow consumer must either block the completion queue
+ * thread or buffer without bound. Operations implementing this interface only
+ * issue a `Read()` for each credit granted via `RequestRead()`.
+ */
+class AsyncFlowControlledOperation : public AsyncGrpcOperation {
+ public:
+  /**
+   * Grant one credit to read the next response.
+   *
+   * If no `Read()` is pending the operation starts one, otherwise the credit is
+   * used once the pending `Read()` completes and its data callback returns.
+   * Calling this function from the data callback is safe.
+   */
+  virtual void RequestRead() = 0;
+};
+
+/**
+ * Unary RPC with streaming response, with credit-based flow control.
+ *
+ * The state machine is the same as in `AsyncUnaryStreamRpcFunctor`, except
+ * that the stream stays idle after each response until the caller grants a
+ * credit with `RequestRead()`. Cancelling an idle stream finishes it.
+ *
+ * Note that this class lives in the `internal` namespace and thus is
+ * not intended for general use.
+ *
+ * @tparam Request the type of the RPC request.
+ * @tparam Response the type of the RPC response piece.
+ * @tparam DataFunctor the callback type for notifying about data portions.
+ * @tparam FinishedFunctor the callback type for notifying about end of stream.
+ */
+template <typename Request, typename Response, typename DataFunctor,
+          typename FinishedFunctor,
+          typename std::enable_if<
+              CheckUnaryStreamRpcDataCallback<DataFunctor, Response>::value,
+              int>::type = 0,
+          typename std::enable_if<CheckUnaryStreamRpcFinishedCallback<
+                                      FinishedFunctor, Response>::value,
+                                  int>::type = 0>
+class AsyncFlowControlledStreamRpcFunctor
+    : public AsyncFlowControlledOperation {
+ public:
+  explicit AsyncFlowControlledStreamRpcFunctor(
+      DataFunctor&& data_functor, FinishedFunctor&& finished_functor)
+      : tag_(nullptr),
+        state_(CREATING),
+        credits_(0),
+        cancelled_(false),
+        data_functor_(std::forward<DataFunctor>(data_functor)),
+        finished_functor_(std::forward<FinishedFunctor>(finished_functor)) {}
+
+  /// Make the RPC request and prepare the response callback.
+  template <typename Client, typename MemberFunction>
+  void Set(Client& client, MemberFunction Client::*call,
+           std::unique_ptr<grpc::ClientContext> context, Request const& request,
+           grpc::CompletionQueue* cq, void* tag) {
+    std::unique_lock<std::mutex> lk(mu_);
+    tag_ = tag;
+    context_ = std::move(context);
+    response_reader_ = (client.*call)(context_.get(), request, cq, tag);
+  }
+
+  void Cancel() override {
+    std::unique_lock<std::mutex> lk(mu_);
+    context_->TryCancel();
+    // Pending operations fail after `TryCancel()`, but an idle stream (or one
+    // that would go idle after the data callback) must finish on its own.
+    if (state_ == PROCESSING) {
+      cancelled_ = true;
+      return;
+    }
+    if (state_ == IDLE) {
+      response_reader_->Finish(&status_, tag_);
+      state_ = FINISHING;
+    }
+  }
+
+  void RequestRead() override {
+    std::unique_lock<std::mutex> lk(mu_);
+    ++credits_;
+    OnIdle();
+  }
+
+ private:
+  enum State { CREATING, IDLE, READING, PROCESSING, FINISHING };
+
+  /// Start the next operation if the stream is idle, must hold `mu_`.
+  void OnIdle() {
+    if (state_ != IDLE) {
+      return;
+    }
+    if (cancelled_) {
+      response_reader_->Finish(&status_, tag_);
+      state_ = FINISHING;
+      return;
+    }
+    if (credits_ == 0) {
+      return;
+    }
+    --credits_;
+    response_reader_->Read(&response_, tag_);
+    state_ = READING;
+  }
+
+  bool Notify(CompletionQueue& cq, bool ok) override {
+    std::unique_lock<std::mutex> lk(mu_);
+
+    switch (state_) {
+      case IDLE:
+      case PROCESSING:
+        // There is no pending operation in these states, this would be a bug.
+        break;
+      case CREATING:
+      case READING:
+        if (not ok) {
+          response_reader_->Finish(&status_, tag_);
+          state_ = FINISHING;
+          return false;
+        }
+        if (state_ == READING) {
+          Response received;
+          response_.Swap(&received);
+          state_ = PROCESSING;
+          lk.unlock();
+          // Credits granted from the callback are only used once it returns,
+          // so callbacks are never reordered or run concurrently.
+          data_functor_(cq, *context_, received);
+          lk.lock();
+        }
+        state_ = IDLE;
+        OnIdle();
+        return false;
+      case FINISHING:
+        lk.unlock();
+        finished_functor_(cq, *context_, status_);
+        return true;
+    }
+    google::cloud::internal::ThrowRuntimeError(
+        "unexpected state in AsyncFlowControlledStreamRpcFunctor: " +
+        std::to_string(state_));
+  }
+
+  // The mutex is used for the same reasons as in `AsyncUnaryStreamRpcFunctor`,
+  // and also protects the credits, which are granted from other threads.
+  std::mutex mu_;
+  void* tag_;
+  State state_;
+  std::size_t credits_;
+  bool cancelled_;
+  grpc::Status status_;
+  DataFunctor data_functor_;
+  FinishedFunctor finished_functor_;
+  Response response_;
+  std::unique_ptr<grpc::ClientContext> context_;
+  std::unique_ptr<grpc::ClientAsyncReaderInterface<Response>> response_reader_;
+};
+
 template <typename T>
 struct ExtractMemberFunctionType : public std::false_type {
   using ClassType = void;
@@ -407,8 +581,8 @@ using CheckRunAsyncCallback =
  */
 class CompletionQueueImpl {
  public:
-  CompletionQueueImpl() : cq_(), shutdown_(false) {}
-  virtual ~CompletionQueueImpl() = default;
+  CompletionQueueImpl() : cq_(), shutdown_(false), pending_count_(0) {}
+  virtual ~CompletionQueueImpl();
 
   /**
    * Run the event loop until Shutdown() is called.
@@ -434,8 +608,8 @@ class CompletionQueueImpl {
   /// Return the asynchronous operation associated with @p tag.
   std::shared_ptr<AsyncGrpcOperation> FindOperation(void* tag);
 
-  /// Unregister @p tag from pending operations.
-  void ForgetOperation(void* tag);
+  /// Unregister @p op from pending operations.
+  void ForgetOperation(AsyncGrpcOperation* op);
 
   /// Simulate a completed operation, provided only to support unit tests.
   void SimulateCompletion(CompletionQueue& cq, AsyncOperation* op, bool ok);
@@ -444,22 +618,35 @@ class CompletionQueueImpl {
   /// unit tests.
   void SimulateCompletion(CompletionQueue& cq, bool ok);
 
-  bool empty() const {
-    std::unique_lock<std::mutex> lk(mu_);
-    return pending_ops_.empty();
-  }
+  bool empty() const { return size() == 0; }
 
-  std::size_t size() const {
-    std::unique_lock<std::mutex> lk(mu_);
-    return pending_ops_.size();
-  }
+  std::size_t size() const { return pending_count_.load(); }
 
  private:
+  /**
+   * A list of pending operations.
+   *
+   * The operations are linked through their own `prev_pending_` and
+   * `next_pending_` members, so registering an operation does not allocate.
+   * The pending operations are spread over several lists, each with its own
+   * mutex, so threads starting and completing operations rarely contend.
+   */
+  struct PendingList {
+    std::mutex mu;
+    AsyncGrpcOperation* head = nullptr;
+  };
+
+  /// The list holding @p op.
+  PendingList& ListFor(AsyncGrpcOperation const* op);
+
+  /// Return all the pending operations, optionally unregistering them.
+  std::vector<std::shared_ptr<AsyncGrpcOperation>> PendingOperations(
+      bool forget);
+
   grpc::CompletionQueue cq_;
   std::atomic<bool> shutdown_;
-  mutable std::mutex mu_;
-  std::unordered_map<std::intptr_t, std::shared_ptr<AsyncGrpcOperation>>
-      pending_ops_;
+  std::atomic<std::size_t> pending_count_;
+  std::array<PendingList, 16> pending_;
 };
 
 }  // namespace internal
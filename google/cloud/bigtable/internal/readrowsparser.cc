@@ -50,7 +50,7 @@ void ReadRowsParser::HandleChunk(ReadRowsResponse_CellChunk chunk,
                             "New column family must specify qualifier");
       return;
     }
-    chunk.mutable_family_name()->mutable_value()->swap(cell_.family);
+    cell_.family = InternFamily(chunk.family_name().value());
   }
 
   if (chunk.has_qualifier()) {
@@ -86,9 +86,12 @@ void ReadRowsParser::HandleChunk(ReadRowsResponse_CellChunk chunk,
                               "Missing row key at last chunk in cell");
         return;
       }
-      row_key_ = cell_.row;
+      // Move the key to the shared buffer, following cells in the same row
+      // either repeat the key or leave `cell_.row` empty.
+      row_key_ = std::make_shared<std::string const>(std::move(cell_.row));
+      cell_.row.clear();
     } else {
-      if (row_key_ != cell_.row) {
+      if (not cell_.row.empty() and *row_key_ != cell_.row) {
         status = grpc::Status(grpc::StatusCode::INTERNAL,
                               "Different row key in cell chunk");
         return;
@@ -100,6 +103,7 @@ void ReadRowsParser::HandleChunk(ReadRowsResponse_CellChunk chunk,
 
   if (chunk.reset_row()) {
     cells_.clear();
+    row_key_.reset();
     cell_ = {};
     if (not cell_first_chunk_) {
       status = grpc::Status(grpc::StatusCode::INTERNAL,
@@ -118,7 +122,7 @@ void ReadRowsParser::HandleChunk(ReadRowsResponse_CellChunk chunk,
       return;
     }
     row_ready_ = true;
-    last_seen_row_key_ = row_key_;
+    last_seen_row_key_ = *row_key_;
     cell_.row.clear();
   }
 }
@@ -154,21 +158,38 @@ Row ReadRowsParser::Next(grpc::Status& status) {
   }
   row_ready_ = false;
 
-  Row row(std::move(row_key_), std::move(cells_));
-  row_key_.clear();
+  Row row(*row_key_, std::move(cells_));
+  row_key_.reset();
+  // Rows in a scan typically have a similar number of cells, reserving avoids
+  // growing the vector one cell at a time.
+  cells_.clear();
+  cells_.reserve(row.cells().size());
 
   return row;
 }
 
 Cell ReadRowsParser::MovePartialToCell() {
-  // The row, family, and column are explicitly copied because the
-  // ReadRows v2 may reuse them in future chunks. See the CellChunk
-  // message comments in bigtable.proto.
-  Cell cell(cell_.row, cell_.family, cell_.column, cell_.timestamp,
+  // The family and column are shared or copied because the ReadRows v2 may
+  // reuse them in future chunks. See the CellChunk message comments in
+  // bigtable.proto.
+  auto family = cell_.family ? cell_.family : InternFamily(std::string());
+  Cell cell(row_key_, std::move(family), cell_.column, cell_.timestamp,
             std::move(cell_.value), std::move(cell_.labels));
   cell_.value.clear();
+  cell_.labels.clear();
   return cell;
 }
+
+std::shared_ptr<std::string const> ReadRowsParser::InternFamily(
+    std::string const& family) {
+  for (auto const& f : families_) {
+    if (*f == family) {
+      return f;
+    }
+  }
+  families_.emplace_back(std::make_shared<std::string const>(family));
+  return families_.back();
+}
 }  // namespace internal
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
@@ -19,6 +19,7 @@
 #include "google/cloud/bigtable/row.h"
 #include "google/cloud/internal/make_unique.h"
 #include <google/bigtable/v2/bigtable.grpc.pb.h>
+#include <memory>
 #include <vector>
 
 namespace google {
@@ -51,7 +52,7 @@ namespace internal {
 class ReadRowsParser {
  public:
   ReadRowsParser()
-      : row_key_(""),
+      : row_key_(),
         cells_(),
         cell_first_chunk_(true),
         cell_(),
@@ -101,7 +102,7 @@ class ReadRowsParser {
   /// Holds partially formed data until a full Row is ready.
   struct ParseCell {
     std::string row;
-    std::string family;
+    std::shared_ptr<std::string const> family;
     std::string column;
     int64_t timestamp;
     std::string value;
@@ -112,13 +113,25 @@ class ReadRowsParser {
    * Moves partial results into a Cell class.
    *
    * Also helps handle string ownership correctly. The value is moved
-   * when converting to a result cell, but the key, family and column
-   * are copied, because they are possibly reused by following cells.
+   * when converting to a result cell, the row key and family are shared
+   * with the other cells, and the column is copied, because it is possibly
+   * reused by following cells.
    */
   Cell MovePartialToCell();
 
-  /// Row key for the current row.
-  std::string row_key_;
+  /**
+   * Returns the shared copy of the @p family name.
+   *
+   * Tables have few column families, and the names are short, a linear
+   * search is faster than any map.
+   */
+  std::shared_ptr<std::string const> InternFamily(std::string const& family);
+
+  /// Row key for the current row, shared by all the cells in the row.
+  std::shared_ptr<std::string const> row_key_;
+
+  /// The column family names seen so far, shared by all the cells.
+  std::vector<std::shared_ptr<std::string const>> families_;
 
   /// Parsed cells of a yet unfinished row.
   std::vector<Cell> cells_;
@@ -161,6 +161,59 @@ TEST(ReadRowsParserTest, SingleChunkValueIsMoved) {
   EXPECT_EQ(data_ptr, r.cells().begin()->value().data());
 }
 
+TEST(ReadRowsParserTest, CellsShareRowKeyAndFamily) {
+  using google::protobuf::TextFormat;
+  ReadRowsParser parser;
+  std::vector<std::string> chunk_strings = {
+      R"(row_key: "RK"
+         family_name: < value: "F">
+         qualifier: < value: "C1">
+         timestamp_micros: 42
+         value: "V1")",
+      R"(qualifier: < value: "C2">
+         timestamp_micros: 42
+         value: "V2"
+         commit_row: true)",
+      R"(row_key: "RK2"
+         family_name: < value: "F">
+         qualifier: < value: "C1">
+         timestamp_micros: 42
+         value: "V3"
+         commit_row: true)",
+  };
+
+  grpc::Status status;
+  std::vector<google::cloud::bigtable::Row> rows;
+  for (auto const& s : chunk_strings) {
+    ReadRowsResponse_CellChunk chunk;
+    ASSERT_TRUE(TextFormat::ParseFromString(s, &chunk));
+    parser.HandleChunk(std::move(chunk), status);
+    ASSERT_TRUE(status.ok());
+    if (parser.HasNext()) {
+      rows.emplace_back(parser.Next(status));
+      ASSERT_TRUE(status.ok());
+    }
+  }
+  parser.HandleEndOfStream(status);
+  ASSERT_TRUE(status.ok());
+
+  ASSERT_EQ(2U, rows.size());
+  ASSERT_EQ(2U, rows[0].cells().size());
+  ASSERT_EQ(1U, rows[1].cells().size());
+  auto const& c0 = rows[0].cells()[0];
+  auto const& c1 = rows[0].cells()[1];
+  auto const& c2 = rows[1].cells()[0];
+  EXPECT_EQ("RK", c1.row_key());
+  EXPECT_EQ("RK2", c2.row_key());
+  EXPECT_EQ("C2", c1.column_qualifier());
+  EXPECT_EQ("V2", c1.value());
+  // Cells in the same row share the row key, all cells share the family.
+  EXPECT_EQ(&c0.row_key(), &c1.row_key());
+  EXPECT_EQ(&c0.family_name(), &c1.family_name());
+  EXPECT_EQ(&c0.family_name(), &c2.family_name());
+  EXPECT_TRUE(c1.labels().empty());
+}
+
 // **** Acceptance tests helpers ****
 
 namespace google {
@@ -0,0 +1,237 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/resumable_row_set.h"
+#include <algorithm>
+
+namespace btproto = ::google::bigtable::v2;
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+namespace {
+std::string const& StartKey(btproto::RowRange const& r) {
+  if (r.start_key_case() == btproto::RowRange::kStartKeyOpen) {
+    return r.start_key_open();
+  }
+  return r.start_key_closed();
+}
+
+std::string const& EndKey(btproto::RowRange const& r) {
+  if (r.end_key_case() == btproto::RowRange::kEndKeyOpen) {
+    return r.end_key_open();
+  }
+  return r.end_key_closed();
+}
+
+/// Return true if @p a starts before @p b, used to sort the ranges.
+bool StartsBefore(btproto::RowRange const& a, btproto::RowRange const& b) {
+  // A range without a start key starts at -infinity.
+  if (b.start_key_case() == btproto::RowRange::START_KEY_NOT_SET) {
+    return false;
+  }
+  if (a.start_key_case() == btproto::RowRange::START_KEY_NOT_SET) {
+    return true;
+  }
+  int cmp = StartKey(a).compare(StartKey(b));
+  if (cmp != 0) {
+    return cmp < 0;
+  }
+  // At the same key, the range that includes the key starts first.
+  return a.start_key_case() == btproto::RowRange::kStartKeyClosed and
+         b.start_key_case() == btproto::RowRange::kStartKeyOpen;
+}
+
+/// Return true if @p a ends before @p b.
+bool EndsBefore(btproto::RowRange const& a, btproto::RowRange const& b) {
+  // A range without an end key ends at +infinity.
+  if (a.end_key_case() == btproto::RowRange::END_KEY_NOT_SET) {
+    return false;
+  }
+  if (b.end_key_case() == btproto::RowRange::END_KEY_NOT_SET) {
+    return true;
+  }
+  int cmp = EndKey(a).compare(EndKey(b));
+  if (cmp != 0) {
+    return cmp < 0;
+  }
+  return a.end_key_case() == btproto::RowRange::kEndKeyOpen and
+         b.end_key_case() == btproto::RowRange::kEndKeyClosed;
+}
+
+/**
+ * Return true if the union of @p a and @p b is a single range.
+ *
+ * Assumes that @p b does not start before @p a.
+ */
+bool Touches(btproto::RowRange const& a, btproto::RowRange const& b) {
+  if (a.end_key_case() == btproto::RowRange::END_KEY_NOT_SET or
+      b.start_key_case() == btproto::RowRange::START_KEY_NOT_SET) {
+    return true;
+  }
+  int cmp = StartKey(b).compare(EndKey(a));
+  if (cmp != 0) {
+    return cmp < 0;
+  }
+  // Only if both limits are open is the common key missing from the union.
+  return not(a.end_key_case() == btproto::RowRange::kEndKeyOpen and
+             b.start_key_case() == btproto::RowRange::kStartKeyOpen);
+}
+
+/// Extend @p a to end where @p b ends.
+void SetEnd(btproto::RowRange& a, btproto::RowRange const& b) {
+  switch (b.end_key_case()) {
+    case btproto::RowRange::END_KEY_NOT_SET:
+      a.clear_end_key();
+      break;
+    case btproto::RowRange::kEndKeyClosed:
+      a.set_end_key_closed(b.end_key_closed());
+      break;
+    case btproto::RowRange::kEndKeyOpen:
+      a.set_end_key_open(b.end_key_open());
+      break;
+  }
+}
+
+/// Return true if @p key is below the start of @p r.
+bool BelowStart(btproto::RowRange const& r, std::string const& key) {
+  switch (r.start_key_case()) {
+    case btproto::RowRange::START_KEY_NOT_SET:
+      break;
+    case btproto::RowRange::kStartKeyClosed:
+      return key < r.start_key_closed();
+    case btproto::RowRange::kStartKeyOpen:
+      return key <= r.start_key_open();
+  }
+  return false;
+}
+
+/// Return true if @p key is above the end of @p r.
+bool AboveEnd(btproto::RowRange const& r, std::string const& key) {
+  switch (r.end_key_case()) {
+    case btproto::RowRange::END_KEY_NOT_SET:
+      break;
+    case btproto::RowRange::kEndKeyClosed:
+      return key > r.end_key_closed();
+    case btproto::RowRange::kEndKeyOpen:
+      return key >= r.end_key_open();
+  }
+  return false;
+}
+
+bool IsInfinite(btproto::RowRange const& r) {
+  return r.start_key_case() == btproto::RowRange::START_KEY_NOT_SET and
+         r.end_key_case() == btproto::RowRange::END_KEY_NOT_SET;
+}
+}  // anonymous namespace
+
+ResumableRowSet::ResumableRowSet(RowSet const& row_set)
+    : next_key_(0), next_range_(0) {
+  auto const& proto = row_set.as_proto();
+  // Special case: an empty RowSet means "all rows".
+  if (proto.row_keys().empty() and proto.row_ranges().empty()) {
+    ranges_.push_back(RowRange::InfiniteRange().as_proto());
+    return;
+  }
+
+  std::vector<btproto::RowRange> ranges;
+  ranges.reserve(proto.row_ranges_size());
+  for (auto const& r : proto.row_ranges()) {
+    if (not RowRange(r).IsEmpty()) {
+      ranges.push_back(r);
+    }
+  }
+  std::sort(ranges.begin(), ranges.end(), StartsBefore);
+  for (auto& r : ranges) {
+    if (not ranges_.empty() and Touches(ranges_.back(), r)) {
+      if (EndsBefore(ranges_.back(), r)) {
+        SetEnd(ranges_.back(), r);
+      }
+      continue;
+    }
+    ranges_.push_back(std::move(r));
+  }
+
+  keys_.assign(proto.row_keys().begin(), proto.row_keys().end());
+  std::sort(keys_.begin(), keys_.end());
+  keys_.erase(std::unique(keys_.begin(), keys_.end()), keys_.end());
+  // Both the keys and the (disjoint) ranges are sorted, so a single pass finds
+  // the keys already included in some range.
+  auto range = ranges_.begin();
+  std::size_t out = 0;
+  for (std::size_t i = 0; i != keys_.size(); ++i) {
+    while (range != ranges_.end() and AboveEnd(*range, keys_[i])) {
+      ++range;
+    }
+    if (range != ranges_.end() and not BelowStart(*range, keys_[i])) {
+      continue;
+    }
+    if (out != i) {
+      keys_[out] = std::move(keys_[i]);
+    }
+    ++out;
+  }
+  keys_.resize(out);
+}
+
+void ResumableRowSet::AdvancePast(std::string const& row_key) {
+  next_key_ = static_cast<std::size_t>(
+      std::upper_bound(keys_.begin() + next_key_, keys_.end(), row_key) -
+      keys_.begin());
+
+  // The ranges are sorted and disjoint: the ranges before the first one with
+  // rows after `row_key` can be discarded, the ranges after it only contain
+  // rows after `row_key`. Only that one range needs to change.
+  auto const remaining = RowRange::Open(row_key, "");
+  for (; next_range_ != ranges_.size(); ++next_range_) {
+    auto i = remaining.Intersect(RowRange(ranges_[next_range_]));
+    if (std::get<0>(i)) {
+      ranges_[next_range_] = std::move(std::get<1>(i)).as_proto();
+      return;
+    }
+  }
+}
+
+btproto::RowSet ResumableRowSet::as_proto() const {
+  btproto::RowSet result;
+  if (IsEmpty()) {
+    // A RowSet with no entries means "all rows", but we want "no rows".
+    *result.add_row_ranges() = RowRange::Empty().as_proto();
+    return result;
+  }
+  if (next_key_ == keys_.size() and next_range_ + 1 == ranges_.size() and
+      IsInfinite(ranges_.back())) {
+    // Send "all rows" in its usual form, with no entries.
+    return result;
+  }
+  result.mutable_row_keys()->Reserve(
+      static_cast<int>(keys_.size() - next_key_));
+  for (auto i = next_key_; i != keys_.size(); ++i) {
+    *result.add_row_keys() = keys_[i];
+  }
+  result.mutable_row_ranges()->Reserve(
+      static_cast<int>(ranges_.size() - next_range_));
+  for (auto i = next_range_; i != ranges_.size(); ++i) {
+    *result.add_row_ranges() = ranges_[i];
+  }
+  return result;
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,79 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_RESUMABLE_ROW_SET_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_RESUMABLE_ROW_SET_H_
+
+#include "google/cloud/bigtable/row_set.h"
+#include <google/bigtable/v2/data.pb.h>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+/**
+ * The rows remaining in a `ReadRows` scan, in a form cheap to resume.
+ *
+ * `ReadRows` returns rows in key order, so a scan that fails after returning
+ * some rows resumes with the rows after the last key returned. Computing this
+ * with `RowSet::Intersect()` visits and copies every key and range on each
+ * retry, which is expensive for sets with many explicit keys.
+ *
+ * This class normalizes the set once: the keys are sorted and deduplicated,
+ * empty ranges are dropped, overlapping or adjacent ranges are merged, and the
+ * keys already included in some range are dropped. Resuming the scan is then
+ * just advancing a cursor over the keys and another over the ranges, only the
+ * first range remaining may need to be trimmed. The protobuf for a request is
+ * built on demand from the remaining keys and ranges.
+ *
+ * The order of the keys and ranges in the requests is different from the order
+ * in the original `RowSet`, but the set of rows is the same.
+ */
+class ResumableRowSet {
+ public:
+  explicit ResumableRowSet(RowSet const& row_set);
+
+  /// Remove @p row_key, and all the keys before it, from the set.
+  void AdvancePast(std::string const& row_key);
+
+  /**
+   * Return true if no rows remain.
+   *
+   * As with `RowSet::IsEmpty()`, a set created from a default constructed
+   * `RowSet` (meaning all rows) is not empty.
+   */
+  bool IsEmpty() const {
+    return next_key_ == keys_.size() and next_range_ == ranges_.size();
+  }
+
+  /// Return the remaining rows as a protobuf, suitable for a `ReadRows` call.
+  ::google::bigtable::v2::RowSet as_proto() const;
+
+ private:
+  std::vector<std::string> keys_;
+  std::vector<::google::bigtable::v2::RowRange> ranges_;
+  std::size_t next_key_;
+  std::size_t next_range_;
+};
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_RESUMABLE_ROW_SET_H_
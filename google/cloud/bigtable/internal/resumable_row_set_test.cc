@@ -0,0 +1,161 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/resumable_row_set.h"
+#include <gmock/gmock.h>
+
+namespace bigtable = google::cloud::bigtable;
+using bigtable::RowRange;
+using bigtable::RowSet;
+using bigtable::internal::ResumableRowSet;
+
+namespace {
+std::vector<std::string> Keys(google::bigtable::v2::RowSet const& proto) {
+  return {proto.row_keys().begin(), proto.row_keys().end()};
+}
+
+std::vector<RowRange> Ranges(google::bigtable::v2::RowSet const& proto) {
+  std::vector<RowRange> result;
+  for (auto const& r : proto.row_ranges()) {
+    result.emplace_back(r);
+  }
+  return result;
+}
+}  // anonymous namespace
+
+/// @test Verify that the keys are sorted and deduplicated.
+TEST(ResumableRowSetTest, SortsKeys) {
+  ResumableRowSet row_set(RowSet("c", "a", "b", "a"));
+  EXPECT_FALSE(row_set.IsEmpty());
+  auto proto = row_set.as_proto();
+  EXPECT_EQ((std::vector<std::string>{"a", "b", "c"}), Keys(proto));
+  EXPECT_EQ(0, proto.row_ranges_size());
+}
+
+/// @test Verify that overlapping and adjacent ranges are merged.
+TEST(ResumableRowSetTest, MergesRanges) {
+  ResumableRowSet row_set(RowSet(
+      RowRange::Range("m", "p"), RowRange::Range("a", "c"),
+      RowRange::Range("b", "d"), RowRange::Range("d", "e"),
+      RowRange::Open("p", "q"), RowRange::Empty(), RowRange::StartingAt("x")));
+  auto proto = row_set.as_proto();
+  EXPECT_EQ(0, proto.row_keys_size());
+  // ["m", "p") and ("p", "q") are not merged, they do not include "p".
+  EXPECT_EQ((std::vector<RowRange>{RowRange::Range("a", "e"),
+                                   RowRange::Range("m", "p"),
+                                   RowRange::Open("p", "q"),
+                                   RowRange::StartingAt("x")}),
+            Ranges(proto));
+}
+
+/// @test Verify that the keys included in some range are discarded.
+TEST(ResumableRowSetTest, DiscardsKeysInRanges) {
+  ResumableRowSet row_set(
+      RowSet("a", "b", "c", "p", "z", RowRange::Closed("b", "c"),
+             RowRange::Open("p", "x")));
+  auto proto = row_set.as_proto();
+  EXPECT_EQ((std::vector<std::string>{"a", "p", "z"}), Keys(proto));
+  EXPECT_EQ(2, proto.row_ranges_size());
+}
+
+/// @test Verify that resuming removes the rows already returned.
+TEST(ResumableRowSetTest, AdvancePast) {
+  ResumableRowSet row_set(RowSet("a", "c", "g", "k", RowRange::Range("d", "f"),
+                                 RowRange::Range("h", "j")));
+
+  row_set.AdvancePast("b");
+  auto proto = row_set.as_proto();
+  EXPECT_EQ((std::vector<std::string>{"c", "g", "k"}), Keys(proto));
+  EXPECT_EQ((std::vector<RowRange>{RowRange::Range("d", "f"),
+                                   RowRange::Range("h", "j")}),
+            Ranges(proto));
+
+  row_set.AdvancePast("e");
+  proto = row_set.as_proto();
+  EXPECT_EQ((std::vector<std::string>{"g", "k"}), Keys(proto));
+  EXPECT_EQ((std::vector<RowRange>{RowRange::Open("e", "f"),
+                                   RowRange::Range("h", "j")}),
+            Ranges(proto));
+
+  row_set.AdvancePast("i");
+  proto = row_set.as_proto();
+  EXPECT_EQ((std::vector<std::string>{"k"}), Keys(proto));
+  EXPECT_EQ((std::vector<RowRange>{RowRange::Open("i", "j")}), Ranges(proto));
+  EXPECT_FALSE(row_set.IsEmpty());
+
+  row_set.AdvancePast("k");
+  EXPECT_TRUE(row_set.IsEmpty());
+}
+
+/// @test Verify that an exhausted set never means "all rows".
+TEST(ResumableRowSetTest, EmptyAfterAdvance) {
+  ResumableRowSet row_set(RowSet("a", "b"));
+  row_set.AdvancePast("b");
+  EXPECT_TRUE(row_set.IsEmpty());
+  auto proto = row_set.as_proto();
+  EXPECT_EQ(0, proto.row_keys_size());
+  EXPECT_EQ(std::vector<RowRange>{RowRange::Empty()}, Ranges(proto));
+}
+
+/// @test Verify that a set with only empty ranges is empty.
+TEST(ResumableRowSetTest, OnlyEmptyRanges) {
+  ResumableRowSet row_set(RowSet(RowRange::Empty(), RowRange::Range("b", "a")));
+  EXPECT_TRUE(row_set.IsEmpty());
+}
+
+/// @test Verify that "all rows" is preserved, and can be resumed.
+TEST(ResumableRowSetTest, AllRows) {
+  ResumableRowSet row_set((RowSet()));
+  EXPECT_FALSE(row_set.IsEmpty());
+  auto proto = row_set.as_proto();
+  EXPECT_EQ(0, proto.row_keys_size());
+  EXPECT_EQ(0, proto.row_ranges_size());
+
+  row_set.AdvancePast("m");
+  EXPECT_FALSE(row_set.IsEmpty());
+  EXPECT_EQ(std::vector<RowRange>{RowRange::Open("m", "")},
+            Ranges(row_set.as_proto()));
+}
+
+/// @test Verify that resuming gives the same rows as RowSet::Intersect().
+TEST(ResumableRowSetTest, MatchesIntersect) {
+  RowSet original("k05", "k12", "k20", "k33", RowRange::Range("k10", "k15"),
+                  RowRange::Closed("k14", "k18"), RowRange::Prefix("k3"));
+  ResumableRowSet resumable(original);
+  auto const contains = [](google::bigtable::v2::RowSet const& proto,
+                           std::string const& key) {
+    for (auto const& k : proto.row_keys()) {
+      if (k == key) {
+        return true;
+      }
+    }
+    for (auto const& r : proto.row_ranges()) {
+      if (RowRange(r).Contains(key)) {
+        return true;
+      }
+    }
+    return false;
+  };
+  for (auto const& last : {"k00", "k05", "k11", "k15", "k18", "k21", "k35"}) {
+    original = original.Intersect(RowRange::Open(last, ""));
+    resumable.AdvancePast(last);
+    EXPECT_EQ(original.IsEmpty(), resumable.IsEmpty());
+    for (int i = 0; i != 50; ++i) {
+      auto key = "k" + std::string(i < 10 ? "0" : "") + std::to_string(i);
+      EXPECT_EQ(contains(original.as_proto(), key),
+                contains(resumable.as_proto(), key))
+          << "last=" << last << ", key=" << key;
+    }
+  }
+}
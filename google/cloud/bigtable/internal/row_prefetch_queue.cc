@@ -0,0 +1,77 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/row_prefetch_queue.h"
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+bool RowPrefetchQueue::Push(Row row) {
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] { return cancelled_ or rows_.size() < capacity_; });
+  if (cancelled_) {
+    return false;
+  }
+  rows_.emplace_back(std::move(row));
+  cv_.notify_all();
+  return true;
+}
+
+void RowPrefetchQueue::Close(std::exception_ptr exception) {
+  std::lock_guard<std::mutex> lk(mu_);
+  closed_ = true;
+  exception_ = std::move(exception);
+  context_ = nullptr;
+  cv_.notify_all();
+}
+
+bool RowPrefetchQueue::Pop(OptionalRow& row) {
+  row.reset();
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] { return closed_ or not rows_.empty(); });
+  if (rows_.empty()) {
+    return false;
+  }
+  row.emplace(std::move(rows_.front()));
+  rows_.pop_front();
+  cv_.notify_all();
+  return true;
+}
+
+bool RowPrefetchQueue::SetContext(grpc::ClientContext* context) {
+  std::lock_guard<std::mutex> lk(mu_);
+  if (cancelled_) {
+    context_ = nullptr;
+    return false;
+  }
+  context_ = context;
+  return true;
+}
+
+void RowPrefetchQueue::Cancel() {
+  std::lock_guard<std::mutex> lk(mu_);
+  cancelled_ = true;
+  if (context_ != nullptr) {
+    context_->TryCancel();
+  }
+  cv_.notify_all();
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,114 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ROW_PREFETCH_QUEUE_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ROW_PREFETCH_QUEUE_H_
+
+#include "google/cloud/bigtable/internal/rowreaderiterator.h"
+#include "google/cloud/bigtable/row.h"
+#include <grpcpp/grpcpp.h>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+/**
+ * A bounded queue of rows between a prefetching thread and the application.
+ *
+ * `RowReader` uses this class when prefetching is enabled. A background thread
+ * (the producer) reads and parses rows and pushes them into the queue, blocking
+ * when the queue is full. The application thread (the consumer) pops rows,
+ * blocking when the queue is empty.
+ *
+ * The consumer may cancel the queue at any time. That wakes up the producer if
+ * it is blocked on a full queue, and cancels the request the producer
+ * registered with `SetContext()`, in case it is blocked reading the stream.
+ */
+class RowPrefetchQueue {
+ public:
+  explicit RowPrefetchQueue(std::size_t capacity)
+      : capacity_(capacity == 0 ? 1 : capacity),
+        closed_(false),
+        cancelled_(false),
+        context_(nullptr) {}
+
+  /**
+   * Append a row, blocking while the queue is full.
+   *
+   * @return false if the queue was cancelled, the producer should stop.
+   */
+  bool Push(Row row);
+
+  /**
+   * Signal that the producer will not push more rows.
+   *
+   * @param exception an exception raised by the producer, if any. The consumer
+   *     rethrows it after consuming all the rows pushed before this call.
+   */
+  void Close(std::exception_ptr exception);
+
+  /**
+   * Remove the next row, blocking until a row is available.
+   *
+   * @return false, and reset @p row, if the queue is closed and all the rows
+   *     have been consumed.
+   */
+  bool Pop(OptionalRow& row);
+
+  /// The exception passed to `Close()`.
+  std::exception_ptr exception() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    return exception_;
+  }
+
+  /**
+   * Register the context of the producer's current request.
+   *
+   * @return false if the queue was already cancelled, the caller should cancel
+   *     @p context itself.
+   */
+  bool SetContext(grpc::ClientContext* context);
+
+  /// Stop the producer, cancelling its current request.
+  void Cancel();
+
+  /// Return true if `Cancel()` has been called.
+  bool cancelled() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    return cancelled_;
+  }
+
+ private:
+  std::size_t const capacity_;
+  mutable std::mutex mu_;
+  std::condition_variable cv_;
+  std::deque<Row> rows_;
+  bool closed_;
+  bool cancelled_;
+  std::exception_ptr exception_;
+  grpc::ClientContext* context_;
+};
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ROW_PREFETCH_QUEUE_H_
@@ -0,0 +1,99 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/row_prefetch_queue.h"
+#include <gmock/gmock.h>
+#include <future>
+
+namespace bigtable = google::cloud::bigtable;
+using bigtable::Row;
+using bigtable::internal::OptionalRow;
+using bigtable::internal::RowPrefetchQueue;
+
+namespace {
+Row MakeRow(std::string key) {
+  return Row(std::move(key), std::vector<bigtable::Cell>());
+}
+}  // anonymous namespace
+
+/// @test Verify rows are returned in order, and the end is reported.
+TEST(RowPrefetchQueueTest, PushPopClose) {
+  RowPrefetchQueue queue(4);
+  EXPECT_TRUE(queue.Push(MakeRow("r1")));
+  EXPECT_TRUE(queue.Push(MakeRow("r2")));
+  queue.Close(nullptr);
+
+  OptionalRow row;
+  ASSERT_TRUE(queue.Pop(row));
+  EXPECT_EQ("r1", row->row_key());
+  ASSERT_TRUE(queue.Pop(row));
+  EXPECT_EQ("r2", row->row_key());
+  EXPECT_FALSE(queue.Pop(row));
+  EXPECT_FALSE(row.has_value());
+  EXPECT_FALSE(queue.exception());
+}
+
+/// @test Verify the producer blocks while the queue is full.
+TEST(RowPrefetchQueueTest, PushBlocksWhenFull) {
+  RowPrefetchQueue queue(1);
+  EXPECT_TRUE(queue.Push(MakeRow("r1")));
+
+  auto pushed = std::async(std::launch::async,
+                           [&queue] { return queue.Push(MakeRow("r2")); });
+  EXPECT_EQ(std::future_status::timeout,
+            pushed.wait_for(std::chrono::milliseconds(50)));
+
+  OptionalRow row;
+  ASSERT_TRUE(queue.Pop(row));
+  EXPECT_EQ("r1", row->row_key());
+  EXPECT_TRUE(pushed.get());
+  ASSERT_TRUE(queue.Pop(row));
+  EXPECT_EQ("r2", row->row_key());
+}
+
+/// @test Verify Cancel() wakes up a blocked producer.
+TEST(RowPrefetchQueueTest, CancelUnblocksPush) {
+  RowPrefetchQueue queue(1);
+  EXPECT_TRUE(queue.Push(MakeRow("r1")));
+
+  auto pushed = std::async(std::launch::async,
+                           [&queue] { return queue.Push(MakeRow("r2")); });
+  queue.Cancel();
+  EXPECT_FALSE(pushed.get());
+  EXPECT_TRUE(queue.cancelled());
+}
+
+/// @test Verify the consumer blocks until the producer closes the queue.
+TEST(RowPrefetchQueueTest, PopBlocksUntilClose) {
+  RowPrefetchQueue queue(1);
+  auto popped = std::async(std::launch::async, [&queue] {
+    OptionalRow row;
+    return queue.Pop(row);
+  });
+  EXPECT_EQ(std::future_status::timeout,
+            popped.wait_for(std::chrono::milliseconds(50)));
+  queue.Close(std::make_exception_ptr(std::runtime_error("test-error")));
+  EXPECT_FALSE(popped.get());
+  EXPECT_TRUE(queue.exception());
+}
+
+/// @test Verify SetContext() fails after Cancel().
+TEST(RowPrefetchQueueTest, SetContextAfterCancel) {
+  RowPrefetchQueue queue(1);
+  grpc::ClientContext context;
+  EXPECT_TRUE(queue.SetContext(&context));
+  queue.Cancel();
+  grpc::ClientContext retry_context;
+  EXPECT_FALSE(queue.SetContext(&retry_context));
+}
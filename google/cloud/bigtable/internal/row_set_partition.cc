@@ -0,0 +1,55 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/row_set_partition.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+std::vector<RowSet> PartitionRowSet(RowSet const& row_set,
+                                    std::vector<RowKeySample> const& samples) {
+  std::vector<std::string> split_points;
+  split_points.reserve(samples.size());
+  for (auto const& s : samples) {
+    if (not s.row_key.empty()) {
+      split_points.push_back(s.row_key);
+    }
+  }
+  std::sort(split_points.begin(), split_points.end());
+  split_points.erase(std::unique(split_points.begin(), split_points.end()),
+                     split_points.end());
+
+  std::vector<RowSet> shards;
+  // An empty end key means "infinity", so the last range reaches the end of
+  // the table.
+  split_points.emplace_back();
+  std::string begin;
+  for (auto& end : split_points) {
+    auto shard = row_set.Intersect(RowRange::RightOpen(begin, end));
+    if (not shard.IsEmpty()) {
+      shards.emplace_back(std::move(shard));
+    }
+    begin = std::move(end);
+  }
+  return shards;
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,76 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/row_set_partition.h"
+#include <gmock/gmock.h>
+#include <algorithm>
+
+namespace bigtable = google::cloud::bigtable;
+using bigtable::RowKeySample;
+using bigtable::RowRange;
+using bigtable::RowSet;
+using bigtable::internal::PartitionRowSet;
+
+namespace {
+/// Return true if @p row_set contains @p key.
+bool Contains(RowSet const& row_set, std::string const& key) {
+  return not row_set.Intersect(RowRange::Closed(key, key)).IsEmpty();
+}
+
+/// Return the number of shards that contain @p key.
+int CountShardsWithKey(std::vector<RowSet> const& shards,
+                       std::string const& key) {
+  return static_cast<int>(
+      std::count_if(shards.begin(), shards.end(),
+                    [&key](RowSet const& s) { return Contains(s, key); }));
+}
+}  // anonymous namespace
+
+/// @test Verify that the full table is split at each sample.
+TEST(RowSetPartitionTest, FullTable) {
+  std::vector<RowKeySample> samples = {{"d", 100}, {"m", 200}, {"", 300}};
+  auto shards = PartitionRowSet(RowSet(), samples);
+  ASSERT_EQ(3U, shards.size());
+  for (auto const& key : {"a", "d", "e", "m", "z"}) {
+    EXPECT_EQ(1, CountShardsWithKey(shards, key)) << "key=" << key;
+  }
+  EXPECT_FALSE(Contains(shards[0], "d"));
+  EXPECT_TRUE(Contains(shards[1], "d"));
+  EXPECT_TRUE(Contains(shards[2], "z"));
+}
+
+/// @test Verify that ranges and keys are split, and empty shards omitted.
+TEST(RowSetPartitionTest, RangesAndKeys) {
+  std::vector<RowKeySample> samples = {
+      {"m", 200}, {"d", 100}, {"d", 100}, {"t", 300}};
+  RowSet row_set(RowRange::Range("b", "f"), "p", "q");
+  auto shards = PartitionRowSet(row_set, samples);
+  // The shards are [b, d), [d, f), and {p, q}, the range after "t" is empty.
+  ASSERT_EQ(3U, shards.size());
+  EXPECT_TRUE(Contains(shards[0], "c"));
+  EXPECT_TRUE(Contains(shards[1], "e"));
+  EXPECT_FALSE(Contains(shards[1], "f"));
+  EXPECT_TRUE(Contains(shards[2], "p"));
+  EXPECT_TRUE(Contains(shards[2], "q"));
+  EXPECT_EQ(0, CountShardsWithKey(shards, "a"));
+  EXPECT_EQ(0, CountShardsWithKey(shards, "u"));
+}
+
+/// @test Verify that without samples the result is a single shard.
+TEST(RowSetPartitionTest, NoSamples) {
+  auto shards = PartitionRowSet(RowSet("a", "b"), {});
+  ASSERT_EQ(1U, shards.size());
+  EXPECT_EQ(1, CountShardsWithKey(shards, "a"));
+  EXPECT_EQ(1, CountShardsWithKey(shards, "b"));
+}
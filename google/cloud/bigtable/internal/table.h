@@ -23,6 +23,7 @@
 #include "google/cloud/bigtable/internal/async_bulk_apply.h"
 #include "google/cloud/bigtable/internal/async_read_row_operation.h"
 #include "google/cloud/bigtable/internal/async_retry_unary_rpc.h"
+#include "google/cloud/bigtable/internal/async_row_stream.h"
 #include "google/cloud/bigtable/internal/async_sample_row_keys.h"
 #include "google/cloud/bigtable/internal/bulk_mutator.h"
 #include "google/cloud/bigtable/metadata_update_policy.h"
@@ -370,6 +371,36 @@ class Table {
                          raise_on_error);
   }
 
+  /**
+   * Reads a set of rows asynchronously, in batches, with flow control.
+   *
+   * Unlike `AsyncReadRows()`, the rows are not pushed to a callback. The
+   * application pulls batches of rows with `AsyncNext()` on the returned
+   * stream, and the stream stops reading from the server while
+   * @p max_buffered_rows rows are waiting to be consumed.
+   *
+   * @param cq the completion queue that will execute the asynchronous calls,
+   *     the application must ensure that one or more threads are blocked on
+   *     `cq.Run()`.
+   * @param row_set the rows to read from.
+   * @param rows_limit the maximum number of rows to read, use
+   *     `RowReader::NO_ROWS_LIMIT` to read all matching rows.
+   * @param filter is applied on the server-side to data in the rows.
+   * @param max_buffered_rows the number of rows buffered before the stream
+   *     stops reading from the server.
+   */
+  std::shared_ptr<internal::AsyncRowStream> AsyncReadRowsStream(
+      CompletionQueue& cq, RowSet row_set, std::int64_t rows_limit,
+      Filter filter, std::size_t max_buffered_rows) {
+    return internal::AsyncRowStream::Create(
+        cq, client_, app_profile_id_, table_name_, std::move(row_set),
+        rows_limit, std::move(filter), rpc_retry_policy_->clone(),
+        rpc_backoff_policy_->clone(), metadata_update_policy_,
+        google::cloud::internal::make_unique<
+            bigtable::internal::ReadRowsParserFactory>(),
+        max_buffered_rows);
+  }
+
   bool CheckAndMutateRow(std::string row_key, Filter filter,
                          std::vector<Mutation> true_mutations,
                          std::vector<Mutation> false_mutations,
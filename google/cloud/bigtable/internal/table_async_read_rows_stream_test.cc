@@ -0,0 +1,307 @@
+// Copyright 2018 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/table.h"
+#include "google/cloud/bigtable/testing/internal_table_test_fixture.h"
+#include "google/cloud/bigtable/testing/mock_completion_queue.h"
+#include "google/cloud/bigtable/testing/mock_data_client.h"
+#include "google/cloud/bigtable/testing/mock_response_reader.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace noex {
+namespace {
+
+namespace bt = ::google::cloud::bigtable;
+namespace btproto = google::bigtable::v2;
+using namespace ::testing;
+using bigtable::testing::MockClientAsyncReaderInterface;
+
+class NoexTableAsyncReadRowsStreamTest
+    : public bigtable::testing::internal::TableTestFixture {};
+
+void AddRow(btproto::ReadRowsResponse& r, std::string row_key) {
+  auto c = r.add_chunks();
+  c->set_row_key(std::move(row_key));
+  c->set_timestamp_micros(1000);
+  c->set_value("test");
+  c->set_value_size(0);
+  c->set_commit_row(true);
+}
+
+/// @test Verify that noex::Table::AsyncReadRowsStream() works in a simple case.
+TEST_F(NoexTableAsyncReadRowsStreamTest, Simple) {
+  auto reader = new MockClientAsyncReaderInterface<btproto::ReadRowsResponse>;
+  std::unique_ptr<MockClientAsyncReaderInterface<btproto::ReadRowsResponse>>
+      reader_deleter(reader);
+
+  EXPECT_CALL(*reader, Read(_, _))
+      .WillOnce(Invoke([](btproto::ReadRowsResponse* r, void*) {
+        AddRow(*r, "0001");
+        AddRow(*r, "0002");
+      }))
+      .WillOnce(Invoke([](btproto::ReadRowsResponse*, void*) {}));
+  EXPECT_CALL(*reader, Finish(_, _))
+      .WillOnce(Invoke([](grpc::Status* status, void*) {
+        *status = grpc::Status(grpc::StatusCode::OK, "mocked-status");
+      }));
+
+  EXPECT_CALL(*client_, AsyncReadRows(_, _, _, _))
+      .WillOnce(Invoke([&reader_deleter](grpc::ClientContext*,
+                                         btproto::ReadRowsRequest const&,
+                                         grpc::CompletionQueue*, void*) {
+        return std::move(reader_deleter);
+      }));
+
+  auto impl = std::make_shared<bigtable::testing::MockCompletionQueue>();
+  bigtable::CompletionQueue cq(impl);
+
+  auto stream = table_.AsyncReadRowsStream(cq, bt::RowSet(),
+                                           bt::RowReader::NO_ROWS_LIMIT,
+                                           bt::Filter::PassAllFilter(), 10);
+
+  auto f1 = stream->AsyncNext();
+  EXPECT_FALSE(f1.is_ready());
+  impl->SimulateCompletion(cq, true);
+  // state == IDLE, then READING
+  EXPECT_FALSE(f1.is_ready());
+  impl->SimulateCompletion(cq, true);
+  // received 2 rows
+  ASSERT_TRUE(f1.is_ready());
+  auto rows = f1.get();
+  ASSERT_EQ(2U, rows.size());
+  EXPECT_EQ("0001", rows[0].row_key());
+  EXPECT_EQ("0002", rows[1].row_key());
+
+  auto f2 = stream->AsyncNext();
+  impl->SimulateCompletion(cq, false);
+  // state == FINISHING
+  EXPECT_FALSE(f2.is_ready());
+  impl->SimulateCompletion(cq, true);
+  ASSERT_TRUE(f2.is_ready());
+  EXPECT_TRUE(f2.get().empty());
+  EXPECT_TRUE(impl->empty());
+}
+
+/// @test Verify that AsyncReadRowsStream() stops reading when the buffer is
+/// full.
+TEST_F(NoexTableAsyncReadRowsStreamTest, FlowControl) {
+  auto reader = new MockClientAsyncReaderInterface<btproto::ReadRowsResponse>;
+  std::unique_ptr<MockClientAsyncReaderInterface<btproto::ReadRowsResponse>>
+      reader_deleter(reader);
+
+  int read_count = 0;
+  EXPECT_CALL(*reader, Read(_, _))
+      .WillOnce(Invoke([&read_count](btproto::ReadRowsResponse* r, void*) {
+        ++read_count;
+        AddRow(*r, "0001");
+      }))
+      .WillOnce(Invoke([&read_count](btproto::ReadRowsResponse* r, void*) {
+        ++read_count;
+        AddRow(*r, "0002");
+      }))
+      .WillOnce(Invoke([&read_count](btproto::ReadRowsResponse*, void*) {
+        ++read_count;
+      }));
+  EXPECT_CALL(*reader, Finish(_, _))
+      .WillOnce(Invoke([](grpc::Status* status, void*) {
+        *status = grpc::Status::OK;
+      }));
+
+  EXPECT_CALL(*client_, AsyncReadRows(_, _, _, _))
+      .WillOnce(Invoke([&reader_deleter](grpc::ClientContext*,
+                                         btproto::ReadRowsRequest const&,
+                                         grpc::CompletionQueue*, void*) {
+        return std::move(reader_deleter);
+      }));
+
+  auto impl = std::make_shared<bigtable::testing::MockCompletionQueue>();
+  bigtable::CompletionQueue cq(impl);
+
+  auto stream = table_.AsyncReadRowsStream(cq, bt::RowSet(),
+                                           bt::RowReader::NO_ROWS_LIMIT,
+                                           bt::Filter::PassAllFilter(), 1);
+
+  impl->SimulateCompletion(cq, true);
+  EXPECT_EQ(1, read_count);
+  impl->SimulateCompletion(cq, true);
+  // The buffer is full, the stream must not read more data.
+  EXPECT_EQ(1, read_count);
+
+  auto f1 = stream->AsyncNext();
+  ASSERT_TRUE(f1.is_ready());
+  auto rows = f1.get();
+  ASSERT_EQ(1U, rows.size());
+  EXPECT_EQ("0001", rows[0].row_key());
+  // Consuming the rows grants a new credit.
+  EXPECT_EQ(2, read_count);
+
+  impl->SimulateCompletion(cq, true);
+  EXPECT_EQ(2, read_count);
+  auto f2 = stream->AsyncNext();
+  ASSERT_TRUE(f2.is_ready());
+  rows = f2.get();
+  ASSERT_EQ(1U, rows.size());
+  EXPECT_EQ("0002", rows[0].row_key());
+  EXPECT_EQ(3, read_count);
+
+  impl->SimulateCompletion(cq, false);
+  // state == FINISHING
+  impl->SimulateCompletion(cq, true);
+  auto f3 = stream->AsyncNext();
+  ASSERT_TRUE(f3.is_ready());
+  EXPECT_TRUE(f3.get().empty());
+  EXPECT_TRUE(impl->empty());
+}
+
+/// @test Verify that AsyncReadRowsStream() resumes after the last row returned.
+TEST_F(NoexTableAsyncReadRowsStreamTest, Retry) {
+  auto reader1 = new MockClientAsyncReaderInterface<btproto::ReadRowsResponse>;
+  std::unique_ptr<MockClientAsyncReaderInterface<btproto::ReadRowsResponse>>
+      reader_deleter1(reader1);
+  auto reader2 = new MockClientAsyncReaderInterface<btproto::ReadRowsResponse>;
+  std::unique_ptr<MockClientAsyncReaderInterface<btproto::ReadRowsResponse>>
+      reader_deleter2(reader2);
+
+  EXPECT_CALL(*reader1, Read(_, _))
+      .WillOnce(Invoke(
+          [](btproto::ReadRowsResponse* r, void*) { AddRow(*r, "0001"); }))
+      .WillOnce(Invoke([](btproto::ReadRowsResponse*, void*) {}));
+  EXPECT_CALL(*reader1, Finish(_, _))
+      .WillOnce(Invoke([](grpc::Status* status, void*) {
+        *status = grpc::Status(grpc::StatusCode::UNAVAILABLE, "try-again");
+      }));
+  EXPECT_CALL(*reader2, Read(_, _))
+      .WillOnce(Invoke(
+          [](btproto::ReadRowsResponse* r, void*) { AddRow(*r, "0002"); }))
+      .WillOnce(Invoke([](btproto::ReadRowsResponse*, void*) {}));
+  EXPECT_CALL(*reader2, Finish(_, _))
+      .WillOnce(Invoke([](grpc::Status* status, void*) {
+        *status = grpc::Status::OK;
+      }));
+
+  EXPECT_CALL(*client_, AsyncReadRows(_, _, _, _))
+      .WillOnce(Invoke([&reader_deleter1](grpc::ClientContext*,
+                                          btproto::ReadRowsRequest const& r,
+                                          grpc::CompletionQueue*, void*) {
+        EXPECT_EQ("0000", r.rows().row_ranges(0).start_key_closed());
+        EXPECT_EQ("0005", r.rows().row_ranges(0).end_key_open());
+        return std::move(reader_deleter1);
+      }))
+      .WillOnce(Invoke([&reader_deleter2](grpc::ClientContext*,
+                                          btproto::ReadRowsRequest const& r,
+                                          grpc::CompletionQueue*, void*) {
+        // The second attempt requests the rows that have not been returned.
+        EXPECT_EQ("0001", r.rows().row_ranges(0).start_key_open());
+        EXPECT_EQ("0005", r.rows().row_ranges(0).end_key_open());
+        return std::move(reader_deleter2);
+      }));
+
+  auto impl = std::make_shared<bigtable::testing::MockCompletionQueue>();
+  bigtable::CompletionQueue cq(impl);
+
+  auto stream = table_.AsyncReadRowsStream(
+      cq, bt::RowSet(bt::RowRange::Range("0000", "0005")),
+      bt::RowReader::NO_ROWS_LIMIT, bt::Filter::PassAllFilter(), 10);
+
+  impl->SimulateCompletion(cq, true);
+  // state == READING
+  impl->SimulateCompletion(cq, true);
+  // received 1 row
+  impl->SimulateCompletion(cq, false);
+  // state == FINISHING
+  impl->SimulateCompletion(cq, true);
+  // finished, scheduled timer
+  impl->SimulateCompletion(cq, true);
+  // timer finished, retry
+  impl->SimulateCompletion(cq, true);
+  // state == READING
+  impl->SimulateCompletion(cq, true);
+  // received 1 row
+  impl->SimulateCompletion(cq, false);
+  // state == FINISHING
+  impl->SimulateCompletion(cq, true);
+  EXPECT_TRUE(impl->empty());
+
+  auto f1 = stream->AsyncNext();
+  ASSERT_TRUE(f1.is_ready());
+  auto rows = f1.get();
+  ASSERT_EQ(2U, rows.size());
+  EXPECT_EQ("0001", rows[0].row_key());
+  EXPECT_EQ("0002", rows[1].row_key());
+
+  auto f2 = stream->AsyncNext();
+  ASSERT_TRUE(f2.is_ready());
+  EXPECT_TRUE(f2.get().empty());
+}
+
+/// @test Verify that cancelling an idle AsyncReadRowsStream() finishes it.
+TEST_F(NoexTableAsyncReadRowsStreamTest, Cancelled) {
+  auto reader = new MockClientAsyncReaderInterface<btproto::ReadRowsResponse>;
+  std::unique_ptr<MockClientAsyncReaderInterface<btproto::ReadRowsResponse>>
+      reader_deleter(reader);
+
+  EXPECT_CALL(*reader, Read(_, _))
+      .WillOnce(Invoke(
+          [](btproto::ReadRowsResponse* r, void*) { AddRow(*r, "0001"); }));
+  EXPECT_CALL(*reader, Finish(_, _))
+      .WillOnce(Invoke([](grpc::Status* status, void*) {
+        *status = grpc::Status(grpc::StatusCode::CANCELLED, "cancelled");
+      }));
+
+  EXPECT_CALL(*client_, AsyncReadRows(_, _, _, _))
+      .WillOnce(Invoke([&reader_deleter](grpc::ClientContext*,
+                                         btproto::ReadRowsRequest const&,
+                                         grpc::CompletionQueue*, void*) {
+        return std::move(reader_deleter);
+      }));
+
+  auto impl = std::make_shared<bigtable::testing::MockCompletionQueue>();
+  bigtable::CompletionQueue cq(impl);
+
+  auto stream = table_.AsyncReadRowsStream(cq, bt::RowSet(),
+                                           bt::RowReader::NO_ROWS_LIMIT,
+                                           bt::Filter::PassAllFilter(), 1);
+
+  impl->SimulateCompletion(cq, true);
+  impl->SimulateCompletion(cq, true);
+  // The buffer is full and the stream is idle, cancelling it calls Finish().
+  stream->Cancel();
+  auto f1 = stream->AsyncNext();
+  EXPECT_FALSE(f1.is_ready());
+  impl->SimulateCompletion(cq, true);
+  ASSERT_TRUE(f1.is_ready());
+  EXPECT_TRUE(impl->empty());
+
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  EXPECT_THROW(
+      try { f1.get(); } catch (GRpcError const& ex) {
+        EXPECT_EQ(grpc::StatusCode::CANCELLED, ex.error_code());
+        throw;
+      },
+      GRpcError);
+#else
+  EXPECT_DEATH_IF_SUPPORTED(f1.get(), "exceptions are disabled");
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+}
+
+}  // namespace
+}  // namespace noex
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,262 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/mutation_batcher.h"
+#include "google/cloud/bigtable/internal/async_batcher.h"
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+// MutateRows requests are limited to 100,000 mutations and the default gRPC
+// messages are limited to 4 MiB, the defaults stay well below both limits.
+std::size_t const kDefaultMaxMutationsPerBatch = 1000;
+std::size_t const kDefaultMaxSizePerBatch = 2 * 1024 * 1024;
+std::size_t const kDefaultMaxBatches = 4;
+std::size_t const kDefaultMaxOutstandingSize = 32 * 1024 * 1024;
+std::chrono::milliseconds const kDefaultMaxBatchLatency(10);
+}  // anonymous namespace
+
+MutationBatcher::Options::Options()
+    : max_mutations_per_batch_(kDefaultMaxMutationsPerBatch),
+      max_size_per_batch_(kDefaultMaxSizePerBatch),
+      max_batches_(kDefaultMaxBatches),
+      max_outstanding_size_(kDefaultMaxOutstandingSize),
+      max_batch_latency_(kDefaultMaxBatchLatency) {}
+
+MutationBatcher::Options& MutationBatcher::Options::set_max_mutations_per_batch(
+    std::size_t max_mutations_per_batch) {
+  max_mutations_per_batch_ =
+      std::max(max_mutations_per_batch, std::size_t(1));
+  return *this;
+}
+
+MutationBatcher::Options& MutationBatcher::Options::set_max_size_per_batch(
+    std::size_t max_size_per_batch) {
+  max_size_per_batch_ = max_size_per_batch;
+  return *this;
+}
+
+MutationBatcher::Options& MutationBatcher::Options::set_max_batches(
+    std::size_t max_batches) {
+  max_batches_ = std::max(max_batches, std::size_t(1));
+  return *this;
+}
+
+MutationBatcher::Options& MutationBatcher::Options::set_max_outstanding_size(
+    std::size_t max_outstanding_size) {
+  max_outstanding_size_ = max_outstanding_size;
+  return *this;
+}
+
+MutationBatcher::Options& MutationBatcher::Options::set_max_batch_latency(
+    std::chrono::milliseconds max_batch_latency) {
+  max_batch_latency_ = max_batch_latency;
+  return *this;
+}
+
+namespace {
+/// A mutation waiting for admission.
+struct PendingMutation {
+  google::bigtable::v2::MutateRowsRequest::Entry entry;
+  std::size_t size;
+  promise<void> admitted;
+  promise<grpc::Status> completed;
+};
+
+/// The mutations admitted into a batch.
+struct MutationBatch {
+  MutationBatch() : size(0) {}
+
+  bool empty() const { return completed.empty(); }
+
+  BulkMutation mutations;
+  std::vector<promise<grpc::Status>> completed;
+  std::size_t size;
+};
+}  // anonymous namespace
+
+/**
+ * The state shared between a `MutationBatcher` and its pending operations.
+ *
+ * The callbacks for timers and `MutateRows` requests hold a `shared_ptr` to
+ * this object, so it remains valid until they all complete, even if the
+ * `MutationBatcher` is destroyed first.
+ */
+class MutationBatcher::Impl
+    : public internal::AsyncBatcher<MutationBatcher::Impl, PendingMutation,
+                                    MutationBatch> {
+ public:
+  Impl(noex::Table table, Options options)
+      : AsyncBatcher(options.max_batches(), options.max_batch_latency()),
+        table_(std::move(table)),
+        options_(std::move(options)) {}
+
+  std::pair<future<void>, future<grpc::Status>> AsyncApply(
+      CompletionQueue& cq, SingleRowMutation mut) {
+    PendingMutation pending;
+    mut.MoveTo(&pending.entry);
+    pending.size = pending.entry.ByteSizeLong();
+    auto result = std::make_pair(pending.admitted.get_future(),
+                                 pending.completed.get_future());
+    Enqueue(cq, std::move(pending));
+    return result;
+  }
+
+  future<void> AsyncWaitForNoPendingRequests(CompletionQueue& cq) {
+    promise<void> p;
+    auto f = p.get_future();
+    std::unique_lock<std::mutex> lk(mu_);
+    no_pending_.push_back(std::move(p));
+    if (not current_.empty()) {
+      current_ready_ = true;
+    }
+    AdmitAndFlush(cq, std::move(lk));
+    return f;
+  }
+
+ private:
+  friend class internal::AsyncBatcher<Impl, PendingMutation, MutationBatch>;
+
+  /// The promises satisfied after a flush.
+  struct Notifications {
+    std::vector<promise<void>> admitted;
+    std::vector<promise<void>> no_pending;
+  };
+
+  bool HasRoom(MutationBatch const& batch, PendingMutation const& next) const {
+    if (batch.empty()) {
+      return true;
+    }
+    return batch.completed.size() < options_.max_mutations_per_batch() and
+           batch.size + next.size <= options_.max_size_per_batch();
+  }
+
+  bool IsFull(MutationBatch const& batch) const {
+    return batch.completed.size() >= options_.max_mutations_per_batch() or
+           batch.size > options_.max_size_per_batch();
+  }
+
+  bool CanAdmit(PendingMutation const& next) const {
+    // Always admit something when nothing is outstanding, otherwise a single
+    // mutation larger than the limit would block the batcher forever.
+    return outstanding_size_ == 0 or
+           outstanding_size_ + next.size <= options_.max_outstanding_size();
+  }
+
+  void Admit(MutationBatch& batch, PendingMutation& next) {
+    outstanding_size_ += next.size;
+    batch.size += next.size;
+    batch.mutations.emplace_back(SingleRowMutation(std::move(next.entry)));
+    batch.completed.push_back(std::move(next.completed));
+    admitted_.push_back(std::move(next.admitted));
+  }
+
+  void Discard(MutationBatch& batch) { outstanding_size_ -= batch.size; }
+
+  Notifications TakeNotifications() {
+    Notifications n;
+    n.admitted.swap(admitted_);
+    if (IsIdle()) {
+      n.no_pending.swap(no_pending_);
+    }
+    return n;
+  }
+
+  void Notify(Notifications& n) {
+    for (auto& p : n.admitted) {
+      p.set_value();
+    }
+    for (auto& p : n.no_pending) {
+      p.set_value();
+    }
+  }
+
+  void Send(CompletionQueue& cq, std::shared_ptr<MutationBatch> batch) {
+    auto self = shared_from_this();
+    table_.AsyncBulkApply(
+        cq,
+        [self, batch](CompletionQueue& cq,
+                      std::vector<FailedMutation>& failures,
+                      grpc::Status& status) {
+          self->OnBatchComplete(cq, *batch, failures, status);
+        },
+        std::move(batch->mutations));
+  }
+
+  void OnBatchComplete(CompletionQueue& cq, MutationBatch& batch,
+                       std::vector<FailedMutation>& failures,
+                       grpc::Status& status) {
+    std::vector<grpc::Status> results(batch.completed.size());
+    for (auto const& f : failures) {
+      auto index = f.original_index();
+      if (index < 0 or static_cast<std::size_t>(index) >= results.size()) {
+        continue;
+      }
+      if (not f.status().ok()) {
+        results[index] = f.status();
+      } else if (not status.ok()) {
+        // The request failed before this mutation had a result.
+        results[index] = status;
+      } else {
+        results[index] = grpc::Status(grpc::StatusCode::UNKNOWN,
+                                      "mutation outcome is unknown");
+      }
+    }
+
+    std::unique_lock<std::mutex> lk(mu_);
+    outstanding_size_ -= batch.size;
+    BatchCompleted(cq, std::move(lk));
+
+    for (std::size_t i = 0; i != results.size(); ++i) {
+      batch.completed[i].set_value(std::move(results[i]));
+    }
+  }
+
+  void Fail(MutationBatch& batch, grpc::Status const& status) {
+    for (auto& p : batch.completed) {
+      p.set_value(status);
+    }
+  }
+
+  noex::Table table_;
+  Options const options_;
+
+  std::size_t outstanding_size_ = 0;
+  /// The admitted promises not yet satisfied, guarded by `mu_`.
+  std::vector<promise<void>> admitted_;
+  std::vector<promise<void>> no_pending_;
+};
+
+MutationBatcher::MutationBatcher(noex::Table table, Options options)
+    : impl_(std::make_shared<Impl>(std::move(table), std::move(options))) {}
+
+std::pair<future<void>, future<grpc::Status>> MutationBatcher::AsyncApply(
+    CompletionQueue& cq, SingleRowMutation mut) {
+  return impl_->AsyncApply(cq, std::move(mut));
+}
+
+future<void> MutationBatcher::AsyncWaitForNoPendingRequests(
+    CompletionQueue& cq) {
+  return impl_->AsyncWaitForNoPendingRequests(cq);
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
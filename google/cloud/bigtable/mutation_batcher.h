@@ -0,0 +1,133 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_MUTATION_BATCHER_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_MUTATION_BATCHER_H_
+
+#include "google/cloud/bigtable/completion_queue.h"
+#include "google/cloud/bigtable/internal/table.h"
+#include "google/cloud/bigtable/mutations.h"
+#include "google/cloud/future.h"
+#include <chrono>
+#include <memory>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * Combine mutations from many callers into large `MutateRows` requests.
+ *
+ * Applications that write many small mutations get much better throughput if
+ * the mutations are sent in large `MutateRows` requests. This class collects
+ * `SingleRowMutation`s, from any number of threads, and sends a batch when it
+ * has enough mutations, enough bytes, or when its oldest mutation has waited
+ * longer than a configurable period.
+ *
+ * The batcher also limits the resources used by pending mutations: it caps the
+ * number of batches in flight, and the total size of the mutations admitted
+ * but not yet completed. Mutations over those limits wait in a queue until
+ * earlier batches complete. `AsyncApply()` returns a future that is satisfied
+ * when the mutation is admitted, applications should wait on it before
+ * submitting more work if they want to bound their memory usage.
+ *
+ * @par Thread-safety
+ * Instances of this class are safe to use from multiple threads.
+ *
+ * @par Example
+ * @code
+ * bigtable::MutationBatcher batcher(table);
+ * for (auto& m : mutations) {
+ *   auto futures = batcher.AsyncApply(cq, std::move(m));
+ *   futures.first.get();  // wait until the batcher has room for more work
+ *   results.emplace_back(std::move(futures.second));
+ * }
+ * batcher.AsyncWaitForNoPendingRequests(cq).get();
+ * @endcode
+ */
+class MutationBatcher {
+ public:
+  /// Configure the batching and admission limits.
+  class Options {
+   public:
+    Options();
+
+    /// A batch is sent once it has this many mutations.
+    Options& set_max_mutations_per_batch(std::size_t max_mutations_per_batch);
+    std::size_t max_mutations_per_batch() const {
+      return max_mutations_per_batch_;
+    }
+
+    /// A batch is sent before its size in bytes would exceed this value.
+    Options& set_max_size_per_batch(std::size_t max_size_per_batch);
+    std::size_t max_size_per_batch() const { return max_size_per_batch_; }
+
+    /// The maximum number of batches in flight.
+    Options& set_max_batches(std::size_t max_batches);
+    std::size_t max_batches() const { return max_batches_; }
+
+    /// The maximum size, in bytes, of the mutations admitted but not completed.
+    Options& set_max_outstanding_size(std::size_t max_outstanding_size);
+    std::size_t max_outstanding_size() const { return max_outstanding_size_; }
+
+    /// A batch is sent once its oldest mutation has waited this long.
+    Options& set_max_batch_latency(std::chrono::milliseconds max_batch_latency);
+    std::chrono::milliseconds max_batch_latency() const {
+      return max_batch_latency_;
+    }
+
+   private:
+    std::size_t max_mutations_per_batch_;
+    std::size_t max_size_per_batch_;
+    std::size_t max_batches_;
+    std::size_t max_outstanding_size_;
+    std::chrono::milliseconds max_batch_latency_;
+  };
+
+  explicit MutationBatcher(noex::Table table, Options options = Options());
+
+  /**
+   * Queue a mutation to be sent in one of the next batches.
+   *
+   * @param cq the completion queue used to send the batches and to run the
+   *     timers that flush partial batches.
+   * @param mut the mutation.
+   * @return two futures: the first is satisfied when the mutation is admitted
+   *     into a batch, the second when the mutation completes. The second
+   *     future holds the status of this mutation, the other mutations in the
+   *     same batch may succeed or fail independently.
+   */
+  std::pair<future<void>, future<grpc::Status>> AsyncApply(
+      CompletionQueue& cq, SingleRowMutation mut);
+
+  /**
+   * Send any partial batch and wait until all mutations complete.
+   *
+   * The returned future is satisfied once there are no queued, batched, or in
+   * flight mutations. Mutations submitted after this call also delay it.
+   */
+  future<void> AsyncWaitForNoPendingRequests(CompletionQueue& cq);
+
+ private:
+  class Impl;
+  std::shared_ptr<Impl> impl_;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_MUTATION_BATCHER_H_
@@ -0,0 +1,252 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/mutation_batcher.h"
+#include "google/cloud/bigtable/testing/batcher_test_fixture.h"
+#include "google/cloud/bigtable/testing/mock_mutate_rows_reader.h"
+#include "google/cloud/testing_util/chrono_literals.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+
+namespace btproto = google::bigtable::v2;
+using namespace google::cloud::testing_util::chrono_literals;
+using ::testing::_;
+using ::testing::Invoke;
+
+using MutationBatcherTest = bigtable::testing::internal::BatcherTestFixture;
+
+using AsyncReader =
+    grpc::ClientAsyncReaderInterface<btproto::MutateRowsResponse>;
+using MockAsyncReader = bigtable::testing::MockClientAsyncReaderInterface<
+    btproto::MutateRowsResponse>;
+
+/**
+ * Create a reader that reports the status of all the @p request entries.
+ *
+ * The entries whose row key contains "fail" fail with `PERMISSION_DENIED`, the
+ * rest succeed.
+ */
+std::unique_ptr<AsyncReader> MakeReader(
+    btproto::MutateRowsRequest const& request) {
+  std::unique_ptr<MockAsyncReader> reader(new MockAsyncReader);
+  auto size = request.entries_size();
+  std::vector<bool> fail;
+  for (auto const& e : request.entries()) {
+    fail.push_back(e.row_key().find("fail") != std::string::npos);
+  }
+  EXPECT_CALL(*reader, Read(_, _))
+      .WillOnce(Invoke([size, fail](btproto::MutateRowsResponse* r, void*) {
+        for (int i = 0; i != size; ++i) {
+          auto& e = *r->add_entries();
+          e.set_index(i);
+          e.mutable_status()->set_code(fail[i]
+                                           ? grpc::StatusCode::PERMISSION_DENIED
+                                           : grpc::StatusCode::OK);
+        }
+      }))
+      .WillOnce(Invoke([](btproto::MutateRowsResponse*, void*) {}));
+  EXPECT_CALL(*reader, Finish(_, _))
+      .WillOnce(Invoke(
+          [](grpc::Status* status, void*) { *status = grpc::Status::OK; }));
+  return std::unique_ptr<AsyncReader>(reader.release());
+}
+
+SingleRowMutation MakeMutation(std::string row_key) {
+  return SingleRowMutation(std::move(row_key),
+                           {SetCell("fam", "col", 0_ms, "value")});
+}
+
+TEST(MutationBatcherOptionsTest, Defaults) {
+  MutationBatcher::Options options;
+  EXPECT_LT(0U, options.max_mutations_per_batch());
+  EXPECT_LT(0U, options.max_size_per_batch());
+  EXPECT_LT(0U, options.max_batches());
+  EXPECT_LT(options.max_size_per_batch(), options.max_outstanding_size());
+
+  options.set_max_mutations_per_batch(0).set_max_batches(0);
+  EXPECT_EQ(1U, options.max_mutations_per_batch());
+  EXPECT_EQ(1U, options.max_batches());
+}
+
+/// @test Verify that a full batch is sent right away.
+TEST_F(MutationBatcherTest, SendsFullBatch) {
+  EXPECT_CALL(*client_, AsyncMutateRows(_, _, _, _))
+      .WillOnce(Invoke([](grpc::ClientContext*,
+                          btproto::MutateRowsRequest const& r,
+                          grpc::CompletionQueue*, void*) {
+        EXPECT_EQ(2, r.entries_size());
+        return MakeReader(r);
+      }));
+
+  MutationBatcher batcher(
+      table_, MutationBatcher::Options()
+                  .set_max_mutations_per_batch(2)
+                  .set_max_batch_latency(std::chrono::hours(1)));
+  auto f0 = batcher.AsyncApply(cq_, MakeMutation("r0"));
+  auto f1 = batcher.AsyncApply(cq_, MakeMutation("r1"));
+  EXPECT_TRUE(f0.first.is_ready());
+  EXPECT_TRUE(f1.first.is_ready());
+  EXPECT_FALSE(f0.second.is_ready());
+
+  CompleteRequest();
+  ASSERT_TRUE(f0.second.is_ready());
+  ASSERT_TRUE(f1.second.is_ready());
+  EXPECT_TRUE(f0.second.get().ok());
+  EXPECT_TRUE(f1.second.get().ok());
+  EXPECT_TRUE(batcher.AsyncWaitForNoPendingRequests(cq_).is_ready());
+}
+
+/// @test Verify that a partial batch is sent when its timer expires.
+TEST_F(MutationBatcherTest, SendsPartialBatchOnTimer) {
+  int calls = 0;
+  EXPECT_CALL(*client_, AsyncMutateRows(_, _, _, _))
+      .WillOnce(Invoke([&calls](grpc::ClientContext*,
+                                btproto::MutateRowsRequest const& r,
+                                grpc::CompletionQueue*, void*) {
+        ++calls;
+        EXPECT_EQ(1, r.entries_size());
+        return MakeReader(r);
+      }));
+
+  MutationBatcher batcher(table_);
+  auto f0 = batcher.AsyncApply(cq_, MakeMutation("r0"));
+  EXPECT_TRUE(f0.first.is_ready());
+  EXPECT_EQ(0, calls);
+
+  FireTimers();
+  EXPECT_EQ(1, calls);
+
+  CompleteRequest();
+  ASSERT_TRUE(f0.second.is_ready());
+  EXPECT_TRUE(f0.second.get().ok());
+}
+
+/// @test Verify that each mutation gets its own status.
+TEST_F(MutationBatcherTest, ReportsStatusPerMutation) {
+  EXPECT_CALL(*client_, AsyncMutateRows(_, _, _, _))
+      .WillOnce(Invoke([](grpc::ClientContext*,
+                          btproto::MutateRowsRequest const& r,
+                          grpc::CompletionQueue*, void*) {
+        return MakeReader(r);
+      }));
+
+  MutationBatcher batcher(
+      table_, MutationBatcher::Options().set_max_batch_latency(
+                  std::chrono::hours(1)));
+  auto f0 = batcher.AsyncApply(cq_, MakeMutation("r0"));
+  auto f1 = batcher.AsyncApply(cq_, MakeMutation("r1-fail"));
+  auto done = batcher.AsyncWaitForNoPendingRequests(cq_);
+  EXPECT_FALSE(done.is_ready());
+
+  CompleteRequest();
+  EXPECT_TRUE(done.is_ready());
+  EXPECT_TRUE(f0.second.get().ok());
+  EXPECT_EQ(grpc::StatusCode::PERMISSION_DENIED,
+            f1.second.get().error_code());
+}
+
+/// @test Verify that mutations wait for admission when too many batches are
+/// in flight.
+TEST_F(MutationBatcherTest, LimitsBatchesInFlight) {
+  std::vector<std::string> sent;
+  EXPECT_CALL(*client_, AsyncMutateRows(_, _, _, _))
+      .Times(3)
+      .WillRepeatedly(Invoke([&sent](grpc::ClientContext*,
+                                     btproto::MutateRowsRequest const& r,
+                                     grpc::CompletionQueue*, void*) {
+        EXPECT_EQ(1, r.entries_size());
+        sent.push_back(r.entries(0).row_key());
+        return MakeReader(r);
+      }));
+
+  MutationBatcher batcher(table_, MutationBatcher::Options()
+                                      .set_max_mutations_per_batch(1)
+                                      .set_max_batches(1));
+  auto f0 = batcher.AsyncApply(cq_, MakeMutation("r0"));
+  auto f1 = batcher.AsyncApply(cq_, MakeMutation("r1"));
+  auto f2 = batcher.AsyncApply(cq_, MakeMutation("r2"));
+  EXPECT_TRUE(f0.first.is_ready());
+  // "r1" fills the next batch, but the batch cannot be sent yet.
+  EXPECT_TRUE(f1.first.is_ready());
+  EXPECT_FALSE(f2.first.is_ready());
+  EXPECT_EQ(std::vector<std::string>{"r0"}, sent);
+
+  CompleteRequest();
+  EXPECT_TRUE(f0.second.is_ready());
+  EXPECT_TRUE(f2.first.is_ready());
+  EXPECT_EQ((std::vector<std::string>{"r0", "r1"}), sent);
+
+  CompleteRequest();
+  EXPECT_TRUE(f1.second.is_ready());
+  EXPECT_EQ((std::vector<std::string>{"r0", "r1", "r2"}), sent);
+
+  CompleteRequest();
+  EXPECT_TRUE(f2.second.is_ready());
+  EXPECT_TRUE(batcher.AsyncWaitForNoPendingRequests(cq_).is_ready());
+}
+
+/// @test Verify that mutations wait for admission when too many bytes are
+/// outstanding.
+TEST_F(MutationBatcherTest, LimitsOutstandingSize) {
+  EXPECT_CALL(*client_, AsyncMutateRows(_, _, _, _))
+      .Times(2)
+      .WillRepeatedly(Invoke([](grpc::ClientContext*,
+                                btproto::MutateRowsRequest const& r,
+                                grpc::CompletionQueue*, void*) {
+        EXPECT_EQ(1, r.entries_size());
+        return MakeReader(r);
+      }));
+
+  // Each mutation is larger than the limit, so only one fits at a time.
+  MutationBatcher batcher(table_, MutationBatcher::Options()
+                                      .set_max_mutations_per_batch(1)
+                                      .set_max_outstanding_size(1));
+  auto f0 = batcher.AsyncApply(cq_, MakeMutation("r0"));
+  auto f1 = batcher.AsyncApply(cq_, MakeMutation("r1"));
+  EXPECT_TRUE(f0.first.is_ready());
+  EXPECT_FALSE(f1.first.is_ready());
+
+  CompleteRequest();
+  EXPECT_TRUE(f0.second.is_ready());
+  EXPECT_TRUE(f1.first.is_ready());
+
+  CompleteRequest();
+  EXPECT_TRUE(f1.second.is_ready());
+}
+
+/// @test Verify that pending mutations fail if the timer is cancelled.
+TEST_F(MutationBatcherTest, CancelledTimerFailsMutations) {
+  EXPECT_CALL(*client_, AsyncMutateRows(_, _, _, _)).Times(0);
+
+  MutationBatcher batcher(table_);
+  auto f0 = batcher.AsyncApply(cq_, MakeMutation("r0"));
+  EXPECT_TRUE(f0.first.is_ready());
+  EXPECT_FALSE(f0.second.is_ready());
+
+  CancelTimers();
+  ASSERT_TRUE(f0.second.is_ready());
+  EXPECT_EQ(grpc::StatusCode::CANCELLED, f0.second.get().error_code());
+  EXPECT_TRUE(batcher.AsyncWaitForNoPendingRequests(cq_).is_ready());
+}
+
+}  // namespace
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,192 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/read_row_batcher.h"
+#include "google/cloud/bigtable/grpc_error.h"
+#include "google/cloud/bigtable/internal/async_batcher.h"
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+// Point lookups are latency sensitive, the defaults trade at most a
+// millisecond of latency for much larger requests.
+std::size_t const kDefaultMaxKeysPerBatch = 100;
+std::size_t const kDefaultMaxBatches = 8;
+std::chrono::microseconds const kDefaultMaxBatchLatency(1000);
+}  // anonymous namespace
+
+ReadRowBatcher::Options::Options()
+    : max_keys_per_batch_(kDefaultMaxKeysPerBatch),
+      max_batches_(kDefaultMaxBatches),
+      max_batch_latency_(kDefaultMaxBatchLatency) {}
+
+ReadRowBatcher::Options& ReadRowBatcher::Options::set_max_keys_per_batch(
+    std::size_t max_keys_per_batch) {
+  max_keys_per_batch_ = std::max(max_keys_per_batch, std::size_t(1));
+  return *this;
+}
+
+ReadRowBatcher::Options& ReadRowBatcher::Options::set_max_batches(
+    std::size_t max_batches) {
+  max_batches_ = std::max(max_batches, std::size_t(1));
+  return *this;
+}
+
+ReadRowBatcher::Options& ReadRowBatcher::Options::set_max_batch_latency(
+    std::chrono::microseconds max_batch_latency) {
+  max_batch_latency_ = max_batch_latency;
+  return *this;
+}
+
+namespace {
+using Result = std::pair<bool, Row>;
+
+/// A lookup waiting for a batch with room for its key.
+struct Lookup {
+  std::string row_key;
+  promise<Result> result;
+};
+
+/// The lookups in a batch, indexed by row key.
+struct LookupBatch {
+  bool empty() const { return lookups.empty(); }
+
+  /// Concurrent lookups for the same key share a single entry.
+  std::unordered_map<std::string, std::vector<promise<Result>>> lookups;
+};
+}  // anonymous namespace
+
+/**
+ * The state shared between a `ReadRowBatcher` and its pending operations.
+ *
+ * The callbacks for timers and `ReadRows` requests hold a `shared_ptr` to this
+ * object, so it remains valid until they all complete, even if the
+ * `ReadRowBatcher` is destroyed first.
+ */
+class ReadRowBatcher::Impl
+    : public internal::AsyncBatcher<ReadRowBatcher::Impl, Lookup, LookupBatch> {
+ public:
+  Impl(noex::Table table, Filter filter, Options options)
+      : AsyncBatcher(options.max_batches(), options.max_batch_latency()),
+        table_(std::move(table)),
+        filter_(std::move(filter)),
+        options_(std::move(options)) {}
+
+  future<Result> AsyncReadRow(CompletionQueue& cq, std::string row_key) {
+    Lookup lookup;
+    lookup.row_key = std::move(row_key);
+    auto f = lookup.result.get_future();
+    Enqueue(cq, std::move(lookup));
+    return f;
+  }
+
+ private:
+  friend class internal::AsyncBatcher<Impl, Lookup, LookupBatch>;
+
+  bool HasRoom(LookupBatch const& batch, Lookup const& next) const {
+    return batch.lookups.size() < options_.max_keys_per_batch() or
+           batch.lookups.count(next.row_key) != 0;
+  }
+
+  bool IsFull(LookupBatch const& batch) const {
+    return batch.lookups.size() >= options_.max_keys_per_batch();
+  }
+
+  void Admit(LookupBatch& batch, Lookup& next) {
+    batch.lookups[std::move(next.row_key)].push_back(std::move(next.result));
+  }
+
+  void Send(CompletionQueue& cq, std::shared_ptr<LookupBatch> batch) {
+    RowSet row_set;
+    for (auto const& kv : batch->lookups) {
+      row_set.Append(kv.first);
+    }
+    auto self = shared_from_this();
+    table_.AsyncReadRows(
+        cq,
+        [batch](CompletionQueue&, Row row, grpc::Status&) {
+          OnRow(*batch, std::move(row));
+        },
+        [self, batch](CompletionQueue& cq, bool&, grpc::Status const& status) {
+          self->OnBatchComplete(cq, *batch, status);
+        },
+        std::move(row_set), RowReader::NO_ROWS_LIMIT, filter_);
+  }
+
+  /// Deliver @p row to the lookups that requested it.
+  static void OnRow(LookupBatch& batch, Row row) {
+    auto loc = batch.lookups.find(row.row_key());
+    if (loc == batch.lookups.end()) {
+      return;
+    }
+    auto promises = std::move(loc->second);
+    batch.lookups.erase(loc);
+    // Only one lookup can take ownership of the row, the others get copies.
+    for (std::size_t i = 1; i < promises.size(); ++i) {
+      promises[i].set_value(Result(true, row));
+    }
+    promises.front().set_value(Result(true, std::move(row)));
+  }
+
+  void OnBatchComplete(CompletionQueue& cq, LookupBatch& batch,
+                       grpc::Status const& status) {
+    BatchCompleted(cq, std::unique_lock<std::mutex>(mu_));
+    // The rows that were not returned do not exist, unless the request failed.
+    if (status.ok()) {
+      for (auto& kv : batch.lookups) {
+        for (auto& p : kv.second) {
+          p.set_value(Result(false, Row(kv.first, {})));
+        }
+      }
+      batch.lookups.clear();
+      return;
+    }
+    Fail(batch, status);
+  }
+
+  void Fail(LookupBatch& batch, grpc::Status const& status) {
+    for (auto& kv : batch.lookups) {
+      for (auto& p : kv.second) {
+        p.set_exception(std::make_exception_ptr(
+            GRpcError("ReadRowBatcher::AsyncReadRow()", status)));
+      }
+    }
+    batch.lookups.clear();
+  }
+
+  noex::Table table_;
+  Filter const filter_;
+  Options const options_;
+};
+
+ReadRowBatcher::ReadRowBatcher(noex::Table table, Filter filter,
+                               Options options)
+    : impl_(std::make_shared<Impl>(std::move(table), std::move(filter),
+                                   std::move(options))) {}
+
+future<std::pair<bool, Row>> ReadRowBatcher::AsyncReadRow(CompletionQueue& cq,
+                                                          std::string row_key) {
+  return impl_->AsyncReadRow(cq, std::move(row_key));
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
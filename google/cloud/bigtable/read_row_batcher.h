@@ -0,0 +1,114 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_READ_ROW_BATCHER_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_READ_ROW_BATCHER_H_
+
+#include "google/cloud/bigtable/completion_queue.h"
+#include "google/cloud/bigtable/filters.h"
+#include "google/cloud/bigtable/internal/table.h"
+#include "google/cloud/bigtable/row.h"
+#include "google/cloud/future.h"
+#include <chrono>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * Combine point lookups from many callers into `ReadRows` requests.
+ *
+ * Each `Table::ReadRow()` call makes a separate `ReadRows` request. Services
+ * that make many concurrent point lookups against the same table get much
+ * higher throughput if the lookups are combined: this class collects the row
+ * keys requested from any number of threads, and reads them with a single
+ * `ReadRows` request over a `RowSet` of those keys. It sends a request when it
+ * has enough keys, or when its oldest lookup has waited longer than a (short)
+ * configurable period. The rows returned by the request are delivered to the
+ * futures of the callers that requested them.
+ *
+ * All the lookups use the filter provided in the constructor, applications
+ * that need several filters should create one batcher for each.
+ *
+ * @par Thread-safety
+ * Instances of this class are safe to use from multiple threads.
+ *
+ * @par Example
+ * @code
+ * bigtable::ReadRowBatcher batcher(table, bigtable::Filter::Latest(1));
+ * auto f = batcher.AsyncReadRow(cq, "row-key");
+ * std::pair<bool, bigtable::Row> result = f.get();
+ * if (result.first) {
+ *   // use result.second
+ * }
+ * @endcode
+ */
+class ReadRowBatcher {
+ public:
+  /// Configure the batching limits.
+  class Options {
+   public:
+    Options();
+
+    /// A request is sent once it has this many distinct row keys.
+    Options& set_max_keys_per_batch(std::size_t max_keys_per_batch);
+    std::size_t max_keys_per_batch() const { return max_keys_per_batch_; }
+
+    /// The maximum number of requests in flight.
+    Options& set_max_batches(std::size_t max_batches);
+    std::size_t max_batches() const { return max_batches_; }
+
+    /// A request is sent once its oldest lookup has waited this long.
+    Options& set_max_batch_latency(
+        std::chrono::microseconds max_batch_latency);
+    std::chrono::microseconds max_batch_latency() const {
+      return max_batch_latency_;
+    }
+
+   private:
+    std::size_t max_keys_per_batch_;
+    std::size_t max_batches_;
+    std::chrono::microseconds max_batch_latency_;
+  };
+
+  ReadRowBatcher(noex::Table table, Filter filter,
+                 Options options = Options());
+
+  /**
+   * Read a single row as part of one of the next batches.
+   *
+   * @param cq the completion queue used to send the requests and to run the
+   *     timers that flush partial batches.
+   * @param row_key the key of the row to read.
+   * @return a future satisfied with the same values as `Table::ReadRow()`:
+   *     `first` is false if the row does not exist. If the request fails
+   *     (after all retries) the future holds a `bigtable::GRpcError` exception.
+   */
+  future<std::pair<bool, Row>> AsyncReadRow(CompletionQueue& cq,
+                                            std::string row_key);
+
+ private:
+  class Impl;
+  std::shared_ptr<Impl> impl_;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_READ_ROW_BATCHER_H_
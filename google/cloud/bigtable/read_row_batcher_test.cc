@@ -0,0 +1,258 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/read_row_batcher.h"
+#include "google/cloud/bigtable/grpc_error.h"
+#include "google/cloud/bigtable/testing/batcher_test_fixture.h"
+#include "google/cloud/bigtable/testing/mock_response_reader.h"
+#include <gmock/gmock.h>
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+
+namespace btproto = google::bigtable::v2;
+using ::testing::_;
+using ::testing::Invoke;
+
+using ReadRowBatcherTest = bigtable::testing::internal::BatcherTestFixture;
+
+using AsyncReader = grpc::ClientAsyncReaderInterface<btproto::ReadRowsResponse>;
+using MockAsyncReader = bigtable::testing::MockClientAsyncReaderInterface<
+    btproto::ReadRowsResponse>;
+
+/**
+ * Create a reader that returns the rows in @p request.
+ *
+ * The rows whose key contains "missing" are not returned, and the request
+ * finishes with @p status.
+ */
+std::unique_ptr<AsyncReader> MakeReader(btproto::ReadRowsRequest const& request,
+                                        grpc::Status status = grpc::Status()) {
+  std::unique_ptr<MockAsyncReader> reader(new MockAsyncReader);
+  std::vector<std::string> keys;
+  for (auto const& k : request.rows().row_keys()) {
+    if (k.find("missing") == std::string::npos) {
+      keys.push_back(k);
+    }
+  }
+  std::sort(keys.begin(), keys.end());
+  EXPECT_CALL(*reader, Read(_, _))
+      .WillOnce(Invoke([keys](btproto::ReadRowsResponse* r, void*) {
+        for (auto const& k : keys) {
+          auto& c = *r->add_chunks();
+          c.set_row_key(k);
+          c.mutable_family_name()->set_value("fam");
+          c.mutable_qualifier()->set_value("col");
+          c.set_timestamp_micros(1000);
+          c.set_value("value-" + k);
+          c.set_commit_row(true);
+        }
+      }))
+      .WillOnce(Invoke([](btproto::ReadRowsResponse*, void*) {}));
+  EXPECT_CALL(*reader, Finish(_, _))
+      .WillOnce(Invoke([status](grpc::Status* s, void*) { *s = status; }));
+  return std::unique_ptr<AsyncReader>(reader.release());
+}
+
+TEST(ReadRowBatcherOptionsTest, Defaults) {
+  ReadRowBatcher::Options options;
+  EXPECT_LT(0U, options.max_keys_per_batch());
+  EXPECT_LT(0U, options.max_batches());
+  EXPECT_LT(0, options.max_batch_latency().count());
+
+  options.set_max_keys_per_batch(0).set_max_batches(0);
+  EXPECT_EQ(1U, options.max_keys_per_batch());
+  EXPECT_EQ(1U, options.max_batches());
+}
+
+/// @test Verify that a full batch is sent right away, as a single request.
+TEST_F(ReadRowBatcherTest, SendsFullBatch) {
+  EXPECT_CALL(*client_, AsyncReadRows(_, _, _, _))
+      .WillOnce(Invoke([](grpc::ClientContext*,
+                          btproto::ReadRowsRequest const& r,
+                          grpc::CompletionQueue*, void*) {
+        EXPECT_EQ(2, r.rows().row_keys_size());
+        EXPECT_EQ(0, r.rows_limit());
+        return MakeReader(r);
+      }));
+
+  ReadRowBatcher batcher(table_, Filter::PassAllFilter(),
+                         ReadRowBatcher::Options()
+                             .set_max_keys_per_batch(2)
+                             .set_max_batch_latency(std::chrono::hours(1)));
+  auto f0 = batcher.AsyncReadRow(cq_, "r0");
+  auto f1 = batcher.AsyncReadRow(cq_, "r1-missing");
+  EXPECT_FALSE(f0.is_ready());
+
+  CompleteRequest();
+  ASSERT_TRUE(f0.is_ready());
+  ASSERT_TRUE(f1.is_ready());
+  auto r0 = f0.get();
+  EXPECT_TRUE(r0.first);
+  EXPECT_EQ("r0", r0.second.row_key());
+  ASSERT_EQ(1U, r0.second.cells().size());
+  EXPECT_EQ("value-r0", r0.second.cells()[0].value());
+  auto r1 = f1.get();
+  EXPECT_FALSE(r1.first);
+}
+
+/// @test Verify that a partial batch is sent when its timer expires.
+TEST_F(ReadRowBatcherTest, SendsPartialBatchOnTimer) {
+  int calls = 0;
+  EXPECT_CALL(*client_, AsyncReadRows(_, _, _, _))
+      .WillOnce(Invoke([&calls](grpc::ClientContext*,
+                                btproto::ReadRowsRequest const& r,
+                                grpc::CompletionQueue*, void*) {
+        ++calls;
+        EXPECT_EQ(1, r.rows().row_keys_size());
+        return MakeReader(r);
+      }));
+
+  ReadRowBatcher batcher(table_, Filter::PassAllFilter());
+  auto f0 = batcher.AsyncReadRow(cq_, "r0");
+  EXPECT_EQ(0, calls);
+
+  FireTimers();
+  EXPECT_EQ(1, calls);
+
+  CompleteRequest();
+  ASSERT_TRUE(f0.is_ready());
+  EXPECT_TRUE(f0.get().first);
+}
+
+/// @test Verify that concurrent lookups for the same key share the request.
+TEST_F(ReadRowBatcherTest, SharesDuplicateKeys) {
+  EXPECT_CALL(*client_, AsyncReadRows(_, _, _, _))
+      .WillOnce(Invoke([](grpc::ClientContext*,
+                          btproto::ReadRowsRequest const& r,
+                          grpc::CompletionQueue*, void*) {
+        EXPECT_EQ(2, r.rows().row_keys_size());
+        return MakeReader(r);
+      }));
+
+  ReadRowBatcher batcher(table_, Filter::PassAllFilter(),
+                         ReadRowBatcher::Options()
+                             .set_max_keys_per_batch(2)
+                             .set_max_batch_latency(std::chrono::hours(1)));
+  auto f0 = batcher.AsyncReadRow(cq_, "r0");
+  auto f1 = batcher.AsyncReadRow(cq_, "r0");
+  auto f2 = batcher.AsyncReadRow(cq_, "r1");
+
+  CompleteRequest();
+  ASSERT_TRUE(f0.is_ready());
+  ASSERT_TRUE(f1.is_ready());
+  ASSERT_TRUE(f2.is_ready());
+  EXPECT_EQ("r0", f0.get().second.row_key());
+  EXPECT_EQ("r0", f1.get().second.row_key());
+  EXPECT_EQ("r1", f2.get().second.row_key());
+}
+
+/// @test Verify that lookups wait when too many requests are in flight.
+TEST_F(ReadRowBatcherTest, LimitsBatchesInFlight) {
+  std::vector<std::string> sent;
+  EXPECT_CALL(*client_, AsyncReadRows(_, _, _, _))
+      .Times(2)
+      .WillRepeatedly(Invoke([&sent](grpc::ClientContext*,
+                                     btproto::ReadRowsRequest const& r,
+                                     grpc::CompletionQueue*, void*) {
+        EXPECT_EQ(1, r.rows().row_keys_size());
+        sent.push_back(r.rows().row_keys(0));
+        return MakeReader(r);
+      }));
+
+  ReadRowBatcher batcher(table_, Filter::PassAllFilter(),
+                         ReadRowBatcher::Options()
+                             .set_max_keys_per_batch(1)
+                             .set_max_batches(1)
+                             .set_max_batch_latency(std::chrono::hours(1)));
+  auto f0 = batcher.AsyncReadRow(cq_, "r0");
+  auto f1 = batcher.AsyncReadRow(cq_, "r1");
+  EXPECT_EQ(std::vector<std::string>{"r0"}, sent);
+
+  CompleteRequest();
+  EXPECT_TRUE(f0.is_ready());
+  EXPECT_FALSE(f1.is_ready());
+  EXPECT_EQ((std::vector<std::string>{"r0", "r1"}), sent);
+
+  CompleteRequest();
+  EXPECT_TRUE(f1.is_ready());
+}
+
+/// @test Verify that a failed request is reported to all its lookups.
+TEST_F(ReadRowBatcherTest, ReportsErrors) {
+  EXPECT_CALL(*client_, AsyncReadRows(_, _, _, _))
+      .WillOnce(Invoke([](grpc::ClientContext*,
+                          btproto::ReadRowsRequest const& r,
+                          grpc::CompletionQueue*, void*) {
+        return MakeReader(r, grpc::Status(grpc::StatusCode::PERMISSION_DENIED,
+                                          "uh-oh"));
+      }));
+
+  ReadRowBatcher batcher(table_, Filter::PassAllFilter(),
+                         ReadRowBatcher::Options()
+                             .set_max_keys_per_batch(2)
+                             .set_max_batch_latency(std::chrono::hours(1)));
+  auto f0 = batcher.AsyncReadRow(cq_, "r0");
+  auto f1 = batcher.AsyncReadRow(cq_, "r1-missing");
+
+  CompleteRequest();
+  // "r0" was returned before the request failed.
+  ASSERT_TRUE(f0.is_ready());
+  EXPECT_TRUE(f0.get().first);
+  ASSERT_TRUE(f1.is_ready());
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  EXPECT_THROW(
+      try { f1.get(); } catch (GRpcError const& ex) {
+        EXPECT_EQ(grpc::StatusCode::PERMISSION_DENIED, ex.error_code());
+        throw;
+      },
+      GRpcError);
+#else
+  EXPECT_DEATH_IF_SUPPORTED(f1.get(), "exceptions are disabled");
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+}
+
+/// @test Verify that pending lookups fail if the timer is cancelled.
+TEST_F(ReadRowBatcherTest, CancelledTimerFailsLookups) {
+  EXPECT_CALL(*client_, AsyncReadRows(_, _, _, _)).Times(0);
+
+  ReadRowBatcher batcher(table_, Filter::PassAllFilter());
+  auto f0 = batcher.AsyncReadRow(cq_, "r0");
+  auto f1 = batcher.AsyncReadRow(cq_, "r0");
+  EXPECT_FALSE(f0.is_ready());
+
+  CancelTimers();
+  ASSERT_TRUE(f0.is_ready());
+  ASSERT_TRUE(f1.is_ready());
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  EXPECT_THROW(
+      try { f0.get(); } catch (GRpcError const& ex) {
+        EXPECT_EQ(grpc::StatusCode::CANCELLED, ex.error_code());
+        throw;
+      },
+      GRpcError);
+#else
+  EXPECT_DEATH_IF_SUPPORTED(f0.get(), "exceptions are disabled");
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+}
+
+}  // namespace
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
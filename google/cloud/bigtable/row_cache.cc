@@ -0,0 +1,224 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/row_cache.h"
+#include <iterator>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+std::size_t const kDefaultMaxSize = 16 * 1024 * 1024;
+std::chrono::milliseconds const kDefaultTtl(1000);
+// Reads rarely last long enough to overlap more invalidations than this.
+std::size_t const kMaxInvalidatedRows = 4096;
+
+/// Estimate the memory used by a cached row.
+std::size_t EstimateSize(std::pair<bool, Row> const& value) {
+  auto const& row = value.second;
+  std::size_t size = sizeof(value) + row.row_key().size();
+  for (auto const& cell : row.cells()) {
+    // The family names are shared by the cells in a row, but counting them
+    // for each cell keeps the estimate simple and conservative.
+    size += sizeof(cell) + cell.family_name().size() +
+            cell.column_qualifier().size() + cell.value().size();
+    for (auto const& label : cell.labels()) {
+      size += sizeof(label) + label.size();
+    }
+  }
+  return size;
+}
+}  // anonymous namespace
+
+RowCache::Options::Options()
+    : max_size_(kDefaultMaxSize), ttl_(kDefaultTtl) {}
+
+RowCache::Options& RowCache::Options::set_max_size(std::size_t max_size) {
+  max_size_ = max_size;
+  return *this;
+}
+
+RowCache::Options& RowCache::Options::set_ttl(std::chrono::milliseconds ttl) {
+  ttl_ = ttl;
+  return *this;
+}
+
+RowCache::RowCache(Options options)
+    : options_(std::move(options)),
+      generation_(0),
+      oldest_generation_(0),
+      stats_() {}
+
+optional<std::pair<bool, Row>> RowCache::Lookup(std::string const& table_name,
+                                                std::string const& row_key,
+                                                Filter const& filter) {
+  auto row_id = RowId(table_name, row_key);
+  auto filter_id = FilterId(filter);
+  auto now = Clock::now();
+
+  std::lock_guard<std::mutex> lk(mu_);
+  auto row = index_.find(row_id);
+  if (row == index_.end()) {
+    ++stats_.misses;
+    return optional<std::pair<bool, Row>>();
+  }
+  auto loc = row->second.find(filter_id);
+  if (loc == row->second.end()) {
+    ++stats_.misses;
+    return optional<std::pair<bool, Row>>();
+  }
+  auto it = loc->second;
+  if (it->expiration <= now) {
+    ++stats_.misses;
+    ++stats_.expirations;
+    Erase(it);
+    return optional<std::pair<bool, Row>>();
+  }
+  ++stats_.hits;
+  lru_.splice(lru_.begin(), lru_, it);
+  return optional<std::pair<bool, Row>>(it->value);
+}
+
+std::uint64_t RowCache::generation() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return generation_;
+}
+
+void RowCache::Insert(std::string const& table_name,
+                      std::string const& row_key, Filter const& filter,
+                      std::uint64_t generation, std::pair<bool, Row> value) {
+  auto row_id = RowId(table_name, row_key);
+  auto filter_id = FilterId(filter);
+  auto size = EstimateSize(value) + sizeof(Entry) + row_id.size() +
+              filter_id.size();
+  if (size > options_.max_size()) {
+    return;
+  }
+  Entry entry{std::move(row_id), std::move(filter_id), std::move(value), size,
+              Clock::now() + options_.ttl()};
+
+  std::lock_guard<std::mutex> lk(mu_);
+  if (IsStale(entry.row_id, generation)) {
+    return;
+  }
+  auto& row = index_[entry.row_id];
+  auto loc = row.find(entry.filter_id);
+  if (loc != row.end()) {
+    stats_.size -= loc->second->size;
+    lru_.erase(loc->second);
+    row.erase(loc);
+  }
+  while (not lru_.empty() and
+         stats_.size + entry.size > options_.max_size()) {
+    auto last = std::prev(lru_.end());
+    if (last->row_id == entry.row_id) {
+      // Do not invalidate `row` by erasing the last entry for it.
+      stats_.size -= last->size;
+      row.erase(last->filter_id);
+      lru_.erase(last);
+    } else {
+      Erase(last);
+    }
+    ++stats_.evictions;
+  }
+
+  stats_.size += entry.size;
+  ++stats_.insertions;
+  lru_.push_front(std::move(entry));
+  row.emplace(lru_.front().filter_id, lru_.begin());
+}
+
+void RowCache::Invalidate(std::string const& table_name,
+                          std::string const& row_key) {
+  auto row_id = RowId(table_name, row_key);
+
+  std::lock_guard<std::mutex> lk(mu_);
+  ++generation_;
+  if (invalidated_.size() >= kMaxInvalidatedRows) {
+    // Forget the invalidations, and discard any reads that may overlap them.
+    invalidated_.clear();
+    oldest_generation_ = generation_;
+  }
+  invalidated_[row_id] = generation_;
+  auto row = index_.find(row_id);
+  if (row == index_.end()) {
+    return;
+  }
+  for (auto& kv : row->second) {
+    stats_.size -= kv.second->size;
+    ++stats_.invalidations;
+    lru_.erase(kv.second);
+  }
+  index_.erase(row);
+}
+
+void RowCache::Clear() {
+  std::lock_guard<std::mutex> lk(mu_);
+  ++generation_;
+  invalidated_.clear();
+  oldest_generation_ = generation_;
+  lru_.clear();
+  index_.clear();
+  stats_.size = 0;
+}
+
+RowCache::Stats RowCache::stats() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  auto stats = stats_;
+  stats.entries = lru_.size();
+  return stats;
+}
+
+std::string RowCache::RowId(std::string const& table_name,
+                            std::string const& row_key) {
+  // Table names cannot contain NUL characters, so the separator makes the id
+  // unambiguous.
+  std::string id;
+  id.reserve(table_name.size() + 1 + row_key.size());
+  id.append(table_name);
+  id.push_back('\0');
+  id.append(row_key);
+  return id;
+}
+
+std::string RowCache::FilterId(Filter const& filter) {
+  return filter.as_proto().SerializeAsString();
+}
+
+void RowCache::Erase(EntryList::iterator it) {
+  stats_.size -= it->size;
+  auto row = index_.find(it->row_id);
+  if (row != index_.end()) {
+    row->second.erase(it->filter_id);
+    if (row->second.empty()) {
+      index_.erase(row);
+    }
+  }
+  lru_.erase(it);
+}
+
+bool RowCache::IsStale(std::string const& row_id,
+                       std::uint64_t generation) const {
+  if (generation < oldest_generation_) {
+    return true;
+  }
+  auto loc = invalidated_.find(row_id);
+  return loc != invalidated_.end() and loc->second > generation;
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,183 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ROW_CACHE_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ROW_CACHE_H_
+
+#include "google/cloud/bigtable/filters.h"
+#include "google/cloud/bigtable/row.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/optional.h"
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * An in-process cache for the results of `Table::ReadRow()`.
+ *
+ * Applications that read some rows much more often than they write them can
+ * avoid most of the `ReadRows` requests for those rows by caching the results.
+ * The entries are keyed by table name, row key and filter, and include the
+ * results for rows that do not exist.
+ *
+ * The cache has a bounded size, the least recently used entries are evicted
+ * when new entries would exceed it. Entries also expire after a fixed time to
+ * live, which bounds how long changes made by other processes (or other
+ * `Table` objects not sharing this cache) remain invisible.
+ *
+ * When a `Table` with a cache applies a mutation to a row, via `Apply()`,
+ * `BulkApply()`, `CheckAndMutateRow()` or `ReadModifyWriteRow()`, it
+ * invalidates all the entries for that row, with any filter. Reads of a row
+ * that started before it was invalidated do not insert their (possibly stale)
+ * results, reads of other rows are not affected.
+ *
+ * @par Thread-safety
+ * Instances of this class are safe to use from multiple threads, the same
+ * cache can be shared by many `Table` objects.
+ *
+ * @par Example
+ * @code
+ * auto cache = std::make_shared<bigtable::RowCache>(
+ *     bigtable::RowCache::Options().set_max_size(64 * 1024 * 1024));
+ * bigtable::Table table(client, "my-table");
+ * table.EnableRowCache(cache);
+ * auto row = table.ReadRow("hot-row", bigtable::Filter::Latest(1));
+ * std::cout << cache->stats().hits << "\n";
+ * @endcode
+ */
+class RowCache {
+ public:
+  /// Configure the size and expiration of the cache entries.
+  class Options {
+   public:
+    Options();
+
+    /// The maximum (estimated) memory used by the cached rows, in bytes.
+    Options& set_max_size(std::size_t max_size);
+    std::size_t max_size() const { return max_size_; }
+
+    /// How long an entry remains valid after it is inserted.
+    Options& set_ttl(std::chrono::milliseconds ttl);
+    std::chrono::milliseconds ttl() const { return ttl_; }
+
+   private:
+    std::size_t max_size_;
+    std::chrono::milliseconds ttl_;
+  };
+
+  /// Counters to monitor the effectiveness and memory usage of the cache.
+  struct Stats {
+    std::uint64_t hits;
+    std::uint64_t misses;
+    std::uint64_t insertions;
+    /// Entries removed to make room for new entries.
+    std::uint64_t evictions;
+    /// Entries found (and removed) after their time to live.
+    std::uint64_t expirations;
+    /// Entries removed because their row was mutated.
+    std::uint64_t invalidations;
+    /// The number of entries currently in the cache.
+    std::size_t entries;
+    /// The (estimated) memory used by the current entries, in bytes.
+    std::size_t size;
+  };
+
+  explicit RowCache(Options options = Options());
+
+  RowCache(RowCache const&) = delete;
+  RowCache& operator=(RowCache const&) = delete;
+
+  /// Return the cached result for a row, if present and not expired.
+  optional<std::pair<bool, Row>> Lookup(std::string const& table_name,
+                                        std::string const& row_key,
+                                        Filter const& filter);
+
+  /**
+   * Return a token to insert the results of a read starting now.
+   *
+   * Callers should obtain a token before sending the read request and pass it
+   * to `Insert()`, the cache discards the results if the row was invalidated
+   * in between, as they may be stale.
+   */
+  std::uint64_t generation() const;
+
+  /// Insert the result of reading a row, unless it was invalidated since
+  /// @p generation was obtained, or it is larger than the cache.
+  void Insert(std::string const& table_name, std::string const& row_key,
+              Filter const& filter, std::uint64_t generation,
+              std::pair<bool, Row> value);
+
+  /// Remove the entries for a row, with any filter.
+  void Invalidate(std::string const& table_name, std::string const& row_key);
+
+  /// Remove all the entries.
+  void Clear();
+
+  Stats stats() const;
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Entry {
+    std::string row_id;
+    std::string filter_id;
+    std::pair<bool, Row> value;
+    std::size_t size;
+    Clock::time_point expiration;
+  };
+  using EntryList = std::list<Entry>;
+  /// The entries for a single row, indexed by filter.
+  using RowEntries = std::unordered_map<std::string, EntryList::iterator>;
+
+  static std::string RowId(std::string const& table_name,
+                           std::string const& row_key);
+  static std::string FilterId(Filter const& filter);
+
+  /// Remove @p it from the cache, must hold `mu_`.
+  void Erase(EntryList::iterator it);
+
+  /// Return true if reads of @p row_id starting at @p generation may be
+  /// stale, must hold `mu_`.
+  bool IsStale(std::string const& row_id, std::uint64_t generation) const;
+
+  Options const options_;
+
+  mutable std::mutex mu_;
+  /// The most recently used entries are at the front.
+  EntryList lru_;
+  std::unordered_map<std::string, RowEntries> index_;
+  std::uint64_t generation_;
+  /// The generation of the most recent invalidation of each row, only the
+  /// recent invalidations are kept.
+  std::unordered_map<std::string, std::uint64_t> invalidated_;
+  /// Reads older than this generation may have missed a forgotten
+  /// invalidation.
+  std::uint64_t oldest_generation_;
+  Stats stats_;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ROW_CACHE_H_
@@ -0,0 +1,190 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/row_cache.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+
+std::pair<bool, Row> MakeRow(std::string row_key, std::string value) {
+  std::vector<Cell> cells;
+  cells.emplace_back(row_key, "fam", "col", 0, std::move(value),
+                     std::vector<std::string>{});
+  return std::make_pair(true, Row(std::move(row_key), std::move(cells)));
+}
+
+/// @test Verify that RowCache stores and returns rows.
+TEST(RowCacheTest, Simple) {
+  RowCache cache;
+  auto filter = Filter::PassAllFilter();
+  EXPECT_FALSE(cache.Lookup("t0", "r0", filter));
+
+  cache.Insert("t0", "r0", filter, cache.generation(), MakeRow("r0", "v0"));
+  auto cached = cache.Lookup("t0", "r0", filter);
+  ASSERT_TRUE(cached);
+  EXPECT_TRUE(cached->first);
+  EXPECT_EQ("r0", cached->second.row_key());
+  ASSERT_EQ(1U, cached->second.cells().size());
+  EXPECT_EQ("v0", cached->second.cells()[0].value());
+
+  // Different tables, rows, and filters do not share entries.
+  EXPECT_FALSE(cache.Lookup("t1", "r0", filter));
+  EXPECT_FALSE(cache.Lookup("t0", "r1", filter));
+  EXPECT_FALSE(cache.Lookup("t0", "r0", Filter::Latest(1)));
+
+  auto stats = cache.stats();
+  EXPECT_EQ(1U, stats.hits);
+  EXPECT_EQ(4U, stats.misses);
+  EXPECT_EQ(1U, stats.insertions);
+  EXPECT_EQ(1U, stats.entries);
+  EXPECT_LT(0U, stats.size);
+}
+
+/// @test Verify that RowCache also stores rows that do not exist.
+TEST(RowCacheTest, CachesMissingRows) {
+  RowCache cache;
+  auto filter = Filter::PassAllFilter();
+  cache.Insert("t0", "r0", filter, cache.generation(),
+               std::make_pair(false, Row("r0", {})));
+  auto cached = cache.Lookup("t0", "r0", filter);
+  ASSERT_TRUE(cached);
+  EXPECT_FALSE(cached->first);
+}
+
+/// @test Verify that RowCache discards expired entries.
+TEST(RowCacheTest, Expiration) {
+  RowCache cache(RowCache::Options().set_ttl(std::chrono::milliseconds(0)));
+  auto filter = Filter::PassAllFilter();
+  cache.Insert("t0", "r0", filter, cache.generation(), MakeRow("r0", "v0"));
+  EXPECT_FALSE(cache.Lookup("t0", "r0", filter));
+
+  auto stats = cache.stats();
+  EXPECT_EQ(1U, stats.expirations);
+  EXPECT_EQ(0U, stats.entries);
+  EXPECT_EQ(0U, stats.size);
+}
+
+/// @test Verify that RowCache evicts the least recently used entries first.
+TEST(RowCacheTest, EvictsLeastRecentlyUsed) {
+  auto filter = Filter::PassAllFilter();
+  std::size_t entry_size;
+  {
+    RowCache probe;
+    probe.Insert("t0", "r0", filter, probe.generation(), MakeRow("r0", "v0"));
+    entry_size = probe.stats().size;
+  }
+
+  // Room for two entries, all the test entries have the same size.
+  RowCache cache(RowCache::Options().set_max_size(2 * entry_size + 1));
+  cache.Insert("t0", "r0", filter, cache.generation(), MakeRow("r0", "v0"));
+  cache.Insert("t0", "r1", filter, cache.generation(), MakeRow("r1", "v1"));
+  // Make "r0" the most recently used entry.
+  EXPECT_TRUE(cache.Lookup("t0", "r0", filter));
+  cache.Insert("t0", "r2", filter, cache.generation(), MakeRow("r2", "v2"));
+
+  EXPECT_TRUE(cache.Lookup("t0", "r0", filter));
+  EXPECT_FALSE(cache.Lookup("t0", "r1", filter));
+  EXPECT_TRUE(cache.Lookup("t0", "r2", filter));
+
+  auto stats = cache.stats();
+  EXPECT_EQ(1U, stats.evictions);
+  EXPECT_EQ(2U, stats.entries);
+  EXPECT_GE(2 * entry_size + 1, stats.size);
+}
+
+/// @test Verify that invalidating a row discards the entries for all filters.
+TEST(RowCacheTest, InvalidateAllFilters) {
+  RowCache cache;
+  cache.Insert("t0", "r0", Filter::PassAllFilter(), cache.generation(),
+               MakeRow("r0", "v0"));
+  cache.Insert("t0", "r0", Filter::Latest(1), cache.generation(),
+               MakeRow("r0", "v0"));
+  cache.Insert("t0", "r1", Filter::Latest(1), cache.generation(),
+               MakeRow("r1", "v1"));
+
+  cache.Invalidate("t0", "r0");
+  EXPECT_FALSE(cache.Lookup("t0", "r0", Filter::PassAllFilter()));
+  EXPECT_FALSE(cache.Lookup("t0", "r0", Filter::Latest(1)));
+  EXPECT_TRUE(cache.Lookup("t0", "r1", Filter::Latest(1)));
+
+  auto stats = cache.stats();
+  EXPECT_EQ(2U, stats.invalidations);
+  EXPECT_EQ(1U, stats.entries);
+}
+
+/// @test Verify that RowCache discards reads started before an invalidation.
+TEST(RowCacheTest, DiscardsReadsOlderThanInvalidation) {
+  RowCache cache;
+  auto filter = Filter::PassAllFilter();
+  auto generation = cache.generation();
+  // The row is mutated while the read is in progress.
+  cache.Invalidate("t0", "r0");
+  cache.Insert("t0", "r0", filter, generation, MakeRow("r0", "stale"));
+  EXPECT_FALSE(cache.Lookup("t0", "r0", filter));
+  EXPECT_EQ(0U, cache.stats().insertions);
+}
+
+/// @test Verify that invalidating a row does not discard reads of other rows.
+TEST(RowCacheTest, InvalidationDoesNotAffectOtherRows) {
+  RowCache cache;
+  auto filter = Filter::PassAllFilter();
+  auto generation = cache.generation();
+  // Other rows, in this table and others, are mutated while the read is in
+  // progress.
+  cache.Invalidate("t0", "r1");
+  cache.Invalidate("t1", "r0");
+  cache.Insert("t0", "r0", filter, generation, MakeRow("r0", "v0"));
+  auto cached = cache.Lookup("t0", "r0", filter);
+  ASSERT_TRUE(cached);
+  EXPECT_EQ("v0", cached->second.cells()[0].value());
+
+  // A read of the invalidated row that started before the invalidation is
+  // still discarded.
+  cache.Insert("t0", "r1", filter, generation, MakeRow("r1", "stale"));
+  EXPECT_FALSE(cache.Lookup("t0", "r1", filter));
+  EXPECT_EQ(1U, cache.stats().insertions);
+}
+
+/// @test Verify that RowCache discards reads started before a Clear().
+TEST(RowCacheTest, DiscardsReadsOlderThanClear) {
+  RowCache cache;
+  auto filter = Filter::PassAllFilter();
+  auto generation = cache.generation();
+  cache.Clear();
+  cache.Insert("t0", "r0", filter, generation, MakeRow("r0", "stale"));
+  EXPECT_FALSE(cache.Lookup("t0", "r0", filter));
+
+  cache.Insert("t0", "r0", filter, cache.generation(), MakeRow("r0", "v0"));
+  EXPECT_TRUE(cache.Lookup("t0", "r0", filter));
+}
+
+/// @test Verify that RowCache::Clear() discards all the entries.
+TEST(RowCacheTest, Clear) {
+  RowCache cache;
+  auto filter = Filter::PassAllFilter();
+  cache.Insert("t0", "r0", filter, cache.generation(), MakeRow("r0", "v0"));
+  cache.Clear();
+  EXPECT_FALSE(cache.Lookup("t0", "r0", filter));
+  EXPECT_EQ(0U, cache.stats().size);
+}
+
+}  // namespace
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
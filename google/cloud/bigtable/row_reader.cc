@@ -108,7 +108,7 @@ RowReader::RowReader(
     : client_(std::move(client)),
       app_profile_id_(std::move(app_profile_id)),
       table_name_(std::move(table_name)),
-      row_set_(std::move(row_set)),
+      row_set_(row_set),
       rows_limit_(rows_limit),
       filter_(std::move(filter)),
       retry_policy_(std::move(retry_policy)),
@@ -122,7 +122,8 @@ RowReader::RowReader(
       rows_count_(0),
       status_(grpc::Status::OK),
       raise_on_error_(raise_on_error),
-      error_retrieved_(raise_on_error) {}
+      error_retrieved_(raise_on_error),
+      prefetch_rows_(0) {}
 
 // The name must be all lowercase to work with range-for loops.
 // NOLINTNEXTLINE(readability-identifier-naming)
@@ -137,7 +138,14 @@ RowReader::iterator RowReader::begin() {
     }
   }
   if (not stream_) {
+    if (prefetch_rows_ != 0) {
+      prefetch_queue_ = google::cloud::internal::make_unique<
+          internal::RowPrefetchQueue>(prefetch_rows_);
+    }
     MakeRequest();
+    if (prefetch_queue_) {
+      prefetch_thread_ = std::thread(&RowReader::PrefetchLoop, this);
+    }
   }
   // Increment the iterator to read a row.
   return ++internal::RowReaderIterator(this, false);
@@ -168,10 +176,16 @@ void RowReader::MakeRequest() {
     request.set_rows_limit(rows_limit_ - rows_count_);
   }
 
-  context_ = google::cloud::internal::make_unique<grpc::ClientContext>();
-  retry_policy_->Setup(*context_);
-  backoff_policy_->Setup(*context_);
-  metadata_update_policy_.Setup(*context_);
+  auto context = google::cloud::internal::make_unique<grpc::ClientContext>();
+  retry_policy_->Setup(*context);
+  backoff_policy_->Setup(*context);
+  metadata_update_policy_.Setup(*context);
+  // When prefetching, Cancel() may be called from the application thread at
+  // any time, register the new context before releasing the old one.
+  if (prefetch_queue_ and not prefetch_queue_->SetContext(context.get())) {
+    context->TryCancel();
+  }
+  context_ = std::move(context);
   stream_ = client_->ReadRows(context_.get(), request);
   stream_is_open_ = true;
 
@@ -192,6 +206,14 @@ bool RowReader::NextChunk() {
 }
 
 void RowReader::Advance(internal::OptionalRow& row) {
+  if (prefetch_queue_) {
+    PopPrefetchedRow(row);
+    return;
+  }
+  ReadNextRow(row);
+}
+
+void RowReader::ReadNextRow(internal::OptionalRow& row) {
   while (true) {
     grpc::Status status;
     status_ = status = AdvanceOrFail(row);
@@ -199,6 +221,11 @@ void RowReader::Advance(internal::OptionalRow& row) {
       return;
     }
 
+    // The application cancelled a prefetching reader, do not retry.
+    if (prefetch_queue_ and prefetch_queue_->cancelled()) {
+      return;
+    }
+
     // In the unlikely case when we have already reached the requested
     // number of rows and still receive an error (the parser can throw
     // an error at end of stream for example), there is no need to
@@ -210,7 +237,7 @@ void RowReader::Advance(internal::OptionalRow& row) {
     if (not last_read_row_key_.empty()) {
       // We've returned some rows and need to make sure we don't
       // request them again.
-      row_set_ = row_set_.Intersect(RowRange::Open(last_read_row_key_, ""));
+      row_set_.AdvancePast(last_read_row_key_);
     }
 
     // If we receive an error, but the retriable set is empty, stop.
@@ -235,6 +262,42 @@ void RowReader::Advance(internal::OptionalRow& row) {
   }
 }
 
+void RowReader::PopPrefetchedRow(internal::OptionalRow& row) {
+  if (prefetch_queue_->Pop(row)) {
+    return;
+  }
+  // The background thread has finished, once it is joined `status_` holds the
+  // final status of the read.
+  if (prefetch_thread_.joinable()) {
+    prefetch_thread_.join();
+  }
+  if (auto exception = prefetch_queue_->exception()) {
+    std::rethrow_exception(exception);
+  }
+}
+
+void RowReader::PrefetchLoop() {
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  try {
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    internal::OptionalRow row;
+    while (true) {
+      ReadNextRow(row);
+      if (not row.has_value()) {
+        break;
+      }
+      if (not prefetch_queue_->Push(*std::move(row))) {
+        break;
+      }
+    }
+    prefetch_queue_->Close(nullptr);
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  } catch (...) {
+    prefetch_queue_->Close(std::current_exception());
+  }
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+}
+
 grpc::Status RowReader::AdvanceOrFail(internal::OptionalRow& row) {
   grpc::Status status;
   row.reset();
@@ -275,6 +338,11 @@ grpc::Status RowReader::AdvanceOrFail(internal::OptionalRow& row) {
 
 void RowReader::Cancel() {
   operation_cancelled_ = true;
+  if (prefetch_thread_.joinable()) {
+    // Stop the background thread before touching the stream.
+    prefetch_queue_->Cancel();
+    prefetch_thread_.join();
+  }
   if (not stream_is_open_) {
     return;
   }
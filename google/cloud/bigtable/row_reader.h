@@ -19,6 +19,8 @@
 #include "google/cloud/bigtable/data_client.h"
 #include "google/cloud/bigtable/filters.h"
 #include "google/cloud/bigtable/internal/readrowsparser.h"
+#include "google/cloud/bigtable/internal/resumable_row_set.h"
+#include "google/cloud/bigtable/internal/row_prefetch_queue.h"
 #include "google/cloud/bigtable/internal/rowreaderiterator.h"
 #include "google/cloud/bigtable/metadata_update_policy.h"
 #include "google/cloud/bigtable/row.h"
@@ -30,6 +32,7 @@
 #include <grpcpp/grpcpp.h>
 #include <cinttypes>
 #include <iterator>
+#include <thread>
 
 namespace google {
 namespace cloud {
@@ -109,6 +112,27 @@ class RowReader {
   /// End iterator over the rows in the response.
   iterator end();
 
+  /**
+   * Read and parse rows in a background thread.
+   *
+   * By default the rows are read from the stream, and parsed, when the
+   * application advances the iterator. With prefetching enabled, a background
+   * thread reads and parses up to @p max_buffered_rows rows ahead of the
+   * application. Receiving the data overlaps with processing the rows, so a
+   * scan runs at the rate of the slower of the two, not at the rate of their
+   * sum.
+   *
+   * The retry and backoff policies are applied by the background thread, the
+   * application sees the same rows, and the same errors, as without
+   * prefetching.
+   *
+   * Must be called before `begin()`. The RowReader must not be moved after
+   * `begin()` is called.
+   */
+  void EnablePrefetch(std::size_t max_buffered_rows) {
+    prefetch_rows_ = max_buffered_rows;
+  }
+
   /**
    * Gracefully terminate a streaming read.
    *
@@ -132,7 +156,16 @@ class RowReader {
    */
   void Advance(internal::OptionalRow& row);
 
-  /// Called by Advance(), does not handle retries.
+  /// Called by Advance(), reads the next row from the stream with retries.
+  void ReadNextRow(internal::OptionalRow& row);
+
+  /// Called by Advance() when prefetching, takes the next prefetched row.
+  void PopPrefetchedRow(internal::OptionalRow& row);
+
+  /// The body of the prefetching thread.
+  void PrefetchLoop();
+
+  /// Called by ReadNextRow(), does not handle retries.
   grpc::Status AdvanceOrFail(internal::OptionalRow& row);
 
   /**
@@ -154,7 +187,7 @@ class RowReader {
   std::shared_ptr<DataClient> client_;
   bigtable::AppProfileId app_profile_id_;
   bigtable::TableId table_name_;
-  RowSet row_set_;
+  internal::ResumableRowSet row_set_;
   std::int64_t rows_limit_;
   Filter filter_;
   std::unique_ptr<RPCRetryPolicy> retry_policy_;
@@ -184,6 +217,11 @@ class RowReader {
   grpc::Status status_;
   bool raise_on_error_;
   bool error_retrieved_;
+
+  /// The maximum number of prefetched rows, zero disables prefetching.
+  std::size_t prefetch_rows_;
+  std::unique_ptr<internal::RowPrefetchQueue> prefetch_queue_;
+  std::thread prefetch_thread_;
 };
 
 }  // namespace BIGTABLE_CLIENT_NS
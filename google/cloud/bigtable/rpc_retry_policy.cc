@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "google/cloud/bigtable/rpc_retry_policy.h"
+#include <algorithm>
 #include <sstream>
 
 namespace google {
@@ -55,6 +56,48 @@ bool LimitedTimeRetryPolicy::OnFailure(grpc::Status const& status) {
   return impl_.OnFailure(status);
 }
 
+RetryBudget::RetryBudget(double max_tokens, double tokens_per_second)
+    : max_tokens_(max_tokens),
+      tokens_per_second_(tokens_per_second),
+      tokens_(max_tokens),
+      last_refill_(std::chrono::steady_clock::now()) {}
+
+bool RetryBudget::TryConsume() {
+  std::lock_guard<std::mutex> lk(mu_);
+  Refill(std::chrono::steady_clock::now());
+  if (tokens_ < 1.0) {
+    return false;
+  }
+  tokens_ -= 1.0;
+  return true;
+}
+
+double RetryBudget::available() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  Refill(std::chrono::steady_clock::now());
+  return tokens_;
+}
+
+void RetryBudget::Refill(std::chrono::steady_clock::time_point now) const {
+  std::chrono::duration<double> elapsed = now - last_refill_;
+  last_refill_ = now;
+  tokens_ =
+      std::min(max_tokens_, tokens_ + elapsed.count() * tokens_per_second_);
+}
+
+std::unique_ptr<RPCRetryPolicy> RetryBudgetPolicy::clone() const {
+  return std::unique_ptr<RPCRetryPolicy>(new RetryBudgetPolicy(*this));
+}
+
+void RetryBudgetPolicy::Setup(grpc::ClientContext& context) const {
+  policy_->Setup(context);
+}
+
+bool RetryBudgetPolicy::OnFailure(grpc::Status const& status) {
+  // Only consume tokens for failures the wrapped policy would retry.
+  return policy_->OnFailure(status) and budget_->TryConsume();
+}
+
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
 }  // namespace cloud
@@ -21,6 +21,7 @@
 #include <grpcpp/grpcpp.h>
 #include <chrono>
 #include <memory>
+#include <mutex>
 
 namespace google {
 namespace cloud {
@@ -135,6 +136,81 @@ class LimitedTimeRetryPolicy : public RPCRetryPolicy {
   Impl impl_;
 };
 
+/**
+ * A limit on the rate of retries, shared by many operations.
+ *
+ * During a partial outage every pending operation retries, and the retries can
+ * become a large fraction of the traffic sent to the service, which makes the
+ * outage worse. A `RetryBudget` limits the aggregate rate of retries: each
+ * retry consumes a token, tokens are replenished at a fixed rate, and the
+ * number of accumulated tokens is capped. An operation that finds no tokens
+ * fails instead of retrying.
+ *
+ * This class is thread-safe, share a single instance (via
+ * `RetryBudgetPolicy`) across all the tables using the same client.
+ */
+class RetryBudget {
+ public:
+  /**
+   * Create a budget with @p max_tokens tokens.
+   *
+   * @param max_tokens the maximum number of retries that can happen in a burst.
+   * @param tokens_per_second how fast the budget recovers after a burst.
+   */
+  RetryBudget(double max_tokens, double tokens_per_second);
+
+  /// Return true and consume a token if the budget allows one more retry.
+  bool TryConsume();
+
+  /// The number of retries that would be allowed right now.
+  double available() const;
+
+ private:
+  /// Add the tokens accumulated since the last refill.
+  void Refill(std::chrono::steady_clock::time_point now) const;
+
+  double const max_tokens_;
+  double const tokens_per_second_;
+  mutable std::mutex mu_;
+  mutable double tokens_;
+  mutable std::chrono::steady_clock::time_point last_refill_;
+};
+
+/**
+ * Limit the retries of another policy with a shared `RetryBudget`.
+ *
+ * The wrapped policy decides if a given failure is retryable, and how many
+ * times each operation may retry. In addition, every retry must consume a
+ * token from the budget. All the copies created by `clone()` share the same
+ * budget, so configuring all the tables of a client with the same
+ * `RetryBudgetPolicy` caps the total retry traffic of that client.
+ *
+ * @par Example
+ * @code
+ * auto budget = std::make_shared<bigtable::RetryBudget>(100, 10);
+ * bigtable::Table table(
+ *     client, "my-table",
+ *     bigtable::RetryBudgetPolicy(
+ *         bigtable::LimitedTimeRetryPolicy(std::chrono::minutes(5)), budget));
+ * @endcode
+ */
+class RetryBudgetPolicy : public RPCRetryPolicy {
+ public:
+  RetryBudgetPolicy(RPCRetryPolicy const& policy,
+                    std::shared_ptr<RetryBudget> budget)
+      : policy_(policy.clone()), budget_(std::move(budget)) {}
+  RetryBudgetPolicy(RetryBudgetPolicy const& rhs)
+      : policy_(rhs.policy_->clone()), budget_(rhs.budget_) {}
+
+  std::unique_ptr<RPCRetryPolicy> clone() const override;
+  void Setup(grpc::ClientContext& context) const override;
+  bool OnFailure(grpc::Status const& status) override;
+
+ private:
+  std::unique_ptr<RPCRetryPolicy> policy_;
+  std::shared_ptr<RetryBudget> budget_;
+};
+
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
 }  // namespace cloud
@@ -111,3 +111,50 @@ TEST(LimitedErrorCountRetryPolicy, OnNonRetryable) {
   bigtable::LimitedErrorCountRetryPolicy tested(3);
   EXPECT_FALSE(tested.OnFailure(CreatePermanentError()));
 }
+
+/// @test Verify that RetryBudget limits the number of retries in a burst.
+TEST(RetryBudget, Simple) {
+  bigtable::RetryBudget budget(2, 0);
+  EXPECT_TRUE(budget.TryConsume());
+  EXPECT_TRUE(budget.TryConsume());
+  EXPECT_FALSE(budget.TryConsume());
+  EXPECT_DOUBLE_EQ(0.0, budget.available());
+}
+
+/// @test Verify that RetryBudget recovers after a burst.
+TEST(RetryBudget, Refill) {
+  using namespace google::cloud::testing_util::chrono_literals;
+  bigtable::RetryBudget budget(1, 1000);
+  EXPECT_TRUE(budget.TryConsume());
+  std::this_thread::sleep_for(10_ms);
+  EXPECT_TRUE(budget.TryConsume());
+  // The budget never exceeds its maximum.
+  std::this_thread::sleep_for(10_ms);
+  EXPECT_DOUBLE_EQ(1.0, budget.available());
+}
+
+/// @test Verify that RetryBudgetPolicy clones share the budget.
+TEST(RetryBudgetPolicy, ClonesShareBudget) {
+  auto budget = std::make_shared<bigtable::RetryBudget>(3, 0);
+  bigtable::RetryBudgetPolicy original(
+      bigtable::LimitedErrorCountRetryPolicy(10), budget);
+  auto c1 = original.clone();
+  auto c2 = original.clone();
+  EXPECT_TRUE(c1->OnFailure(CreateTransientError()));
+  EXPECT_TRUE(c2->OnFailure(CreateTransientError()));
+  EXPECT_TRUE(c1->OnFailure(CreateTransientError()));
+  EXPECT_FALSE(c2->OnFailure(CreateTransientError()));
+  EXPECT_FALSE(c1->OnFailure(CreateTransientError()));
+}
+
+/// @test Verify that RetryBudgetPolicy respects the wrapped policy.
+TEST(RetryBudgetPolicy, OnNonRetryable) {
+  auto budget = std::make_shared<bigtable::RetryBudget>(3, 0);
+  bigtable::RetryBudgetPolicy tested(bigtable::LimitedErrorCountRetryPolicy(1),
+                                     budget);
+  EXPECT_FALSE(tested.OnFailure(CreatePermanentError()));
+  EXPECT_TRUE(tested.OnFailure(CreateTransientError()));
+  EXPECT_FALSE(tested.OnFailure(CreateTransientError()));
+  // Neither the permanent error nor the exhausted policy consume tokens.
+  EXPECT_DOUBLE_EQ(2.0, budget->available());
+}
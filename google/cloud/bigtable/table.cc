@@ -15,6 +15,10 @@
 #include "google/cloud/bigtable/table.h"
 #include "google/cloud/bigtable/internal/bulk_mutator.h"
 #include "google/cloud/bigtable/internal/grpc_error_delegate.h"
+#include "google/cloud/bigtable/internal/row_set_partition.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <thread>
 #include <type_traits>
 
@@ -49,7 +53,12 @@ static_assert(std::is_copy_assignable<bigtable::Table>::value,
               "bigtable::Table must be CopyAssignable");
 
 void Table::Apply(SingleRowMutation&& mut) {
+  std::string cached_key = row_cache_ ? mut.row_key() : std::string();
   std::vector<FailedMutation> failures = impl_.Apply(std::move(mut));
+  // Invalidate even if the mutation failed, it may have been applied anyway.
+  if (row_cache_) {
+    row_cache_->Invalidate(table_name(), cached_key);
+  }
   if (not failures.empty()) {
     grpc::Status status = failures.front().status();
     ReportPermanentFailures(status.error_message().c_str(), status, failures);
@@ -57,9 +66,22 @@ void Table::Apply(SingleRowMutation&& mut) {
 }
 
 void Table::BulkApply(BulkMutation&& mut) {
+  std::vector<std::string> cached_keys;
+  if (row_cache_) {
+    // BulkMutation does not expose its contents, rebuild it to find the keys.
+    google::bigtable::v2::MutateRowsRequest request;
+    mut.MoveTo(&request);
+    for (auto& entry : *request.mutable_entries()) {
+      cached_keys.push_back(entry.row_key());
+      mut.emplace_back(SingleRowMutation(std::move(entry)));
+    }
+  }
   grpc::Status status;
   std::vector<FailedMutation> failures =
       impl_.BulkApply(std::move(mut), status);
+  for (auto const& key : cached_keys) {
+    row_cache_->Invalidate(table_name(), key);
+  }
   if (not status.ok()) {
     ReportPermanentFailures(status.error_message().c_str(), status, failures);
   }
@@ -75,7 +97,76 @@ RowReader Table::ReadRows(RowSet row_set, std::int64_t rows_limit,
                         true);
 }
 
+void Table::ParallelReadRows(RowSet row_set, Filter filter,
+                             std::size_t concurrency,
+                             std::function<void(Row)> const& callback) {
+  auto shards = internal::PartitionRowSet(row_set, SampleRows<std::vector>());
+  concurrency = std::max(std::min(concurrency, shards.size()), std::size_t(1));
+
+  std::mutex mu;
+  std::size_t next_shard = 0;
+  std::atomic<bool> failed(false);
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  std::exception_ptr error;
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+
+  auto read_one_shard = [&](Table& table, RowSet shard) {
+    auto reader = table.ReadRows(std::move(shard), filter);
+    for (auto& row : reader) {
+      if (failed.load()) {
+        reader.Cancel();
+        return;
+      }
+      callback(std::move(row));
+    }
+  };
+  auto worker = [&](Table table) {
+    while (not failed.load()) {
+      RowSet shard;
+      {
+        std::lock_guard<std::mutex> lk(mu);
+        if (next_shard == shards.size()) {
+          return;
+        }
+        shard = std::move(shards[next_shard++]);
+      }
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+      try {
+        read_one_shard(table, std::move(shard));
+      } catch (...) {
+        std::lock_guard<std::mutex> lk(mu);
+        if (not error) {
+          error = std::current_exception();
+        }
+        failed.store(true);
+        return;
+      }
+#else
+      read_one_shard(table, std::move(shard));
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    }
+  };
+
+  // Each thread gets its own copy of the table, the copies share the client.
+  std::vector<std::thread> threads;
+  for (std::size_t i = 1; i < concurrency; ++i) {
+    threads.emplace_back(worker, *this);
+  }
+  worker(*this);
+  for (auto& t : threads) {
+    t.join();
+  }
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  if (error) {
+    std::rethrow_exception(error);
+  }
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+}
+
 std::pair<bool, Row> Table::ReadRow(std::string row_key, Filter filter) {
+  if (row_cache_) {
+    return CachedReadRow(std::move(row_key), std::move(filter));
+  }
   grpc::Status status;
   auto result = impl_.ReadRow(std::move(row_key), std::move(filter), status);
   if (not status.ok()) {
@@ -84,13 +175,34 @@ std::pair<bool, Row> Table::ReadRow(std::string row_key, Filter filter) {
   return result;
 }
 
+std::pair<bool, Row> Table::CachedReadRow(std::string row_key, Filter filter) {
+  // Hold a reference, the cache may be replaced while the read runs.
+  auto cache = row_cache_;
+  auto cached = cache->Lookup(table_name(), row_key, filter);
+  if (cached) {
+    return *std::move(cached);
+  }
+  auto generation = cache->generation();
+  grpc::Status status;
+  auto result = impl_.ReadRow(row_key, filter, status);
+  if (not status.ok()) {
+    google::cloud::internal::ThrowRuntimeError(status.error_message());
+  }
+  cache->Insert(table_name(), row_key, filter, generation, result);
+  return result;
+}
+
 bool Table::CheckAndMutateRow(std::string row_key, Filter filter,
                               std::vector<Mutation> true_mutations,
                               std::vector<Mutation> false_mutations) {
   grpc::Status status;
+  std::string cached_key = row_cache_ ? row_key : std::string();
   bool value = impl_.CheckAndMutateRow(std::move(row_key), std::move(filter),
                                        std::move(true_mutations),
                                        std::move(false_mutations), status);
+  if (row_cache_) {
+    row_cache_->Invalidate(table_name(), cached_key);
+  }
   if (not status.ok()) {
     bigtable::internal::ThrowRpcError(status, status.error_message());
   }
@@ -17,6 +17,8 @@
 
 #include "google/cloud/bigtable/internal/grpc_error_delegate.h"
 #include "google/cloud/bigtable/internal/table.h"
+#include "google/cloud/bigtable/row_cache.h"
+#include <memory>
 
 namespace google {
 namespace cloud {
@@ -183,6 +185,23 @@ class Table {
   std::string const& table_name() const { return impl_.table_name(); }
   std::string const& app_profile_id() const { return impl_.app_profile_id(); }
 
+  /**
+   * Serve `ReadRow()` from @p cache when possible.
+   *
+   * The results of `ReadRow()` are stored in the cache, and later calls with
+   * the same row key and filter return the cached result until it expires. The
+   * mutations applied through this object invalidate the cached entries for the
+   * mutated rows. `ReadRows()` always reads from the server.
+   *
+   * Copies of this object share the cache, and the same cache can be used by
+   * many tables.
+   *
+   * @param cache the cache, use `nullptr` to disable caching.
+   */
+  void EnableRowCache(std::shared_ptr<RowCache> cache) {
+    row_cache_ = std::move(cache);
+  }
+
   /**
    * Attempts to apply the mutation to a row.
    *
@@ -250,6 +269,32 @@ class Table {
    */
   RowReader ReadRows(RowSet row_set, std::int64_t rows_limit, Filter filter);
 
+  /**
+   * Reads a set of rows from the table using multiple concurrent streams.
+   *
+   * The function splits @p row_set into shards at the row keys returned by
+   * `SampleRows()`, and reads the shards using up to @p concurrency streams,
+   * each one in a separate thread (the calling thread is one of them). The
+   * shards are assigned dynamically: a thread starts reading the next unread
+   * shard as soon as it finishes the previous one, so shards that finish early
+   * do not leave threads idle. The function returns once all the shards are
+   * read.
+   *
+   * @param row_set the rows to read from.
+   * @param filter is applied on the server-side to data in the rows.
+   * @param concurrency the maximum number of concurrent streams, zero is
+   *     treated as one.
+   * @param callback called for each row. It is called from multiple threads
+   *     concurrently, it must be thread-safe. The rows in each shard are
+   *     delivered in order, but there is no ordering across shards.
+   *
+   * @throws std::runtime_error if sampling the row keys, or reading any shard,
+   *     fails after retries. The remaining shards are not read, and the other
+   *     streams are cancelled, before the exception is raised.
+   */
+  void ParallelReadRows(RowSet row_set, Filter filter, std::size_t concurrency,
+                        std::function<void(Row)> const& callback);
+
   /**
    * Read and return a single row from the table.
    *
@@ -336,9 +381,13 @@ class Table {
   Row ReadModifyWriteRow(std::string row_key,
                          bigtable::ReadModifyWriteRule rule, Args&&... rules) {
     grpc::Status status;
+    std::string cached_key = row_cache_ ? row_key : std::string();
     Row row =
         impl_.ReadModifyWriteRow(std::move(row_key), status, std::move(rule),
                                  std::forward<Args>(rules)...);
+    if (row_cache_) {
+      row_cache_->Invalidate(table_name(), cached_key);
+    }
     if (not status.ok()) {
       internal::ThrowRpcError(status, status.error_message());
     }
@@ -346,7 +395,10 @@ class Table {
   }
 
  private:
+  std::pair<bool, Row> CachedReadRow(std::string row_key, Filter filter);
+
   noex::Table impl_;
+  std::shared_ptr<RowCache> row_cache_;
 };
 
 }  // namespace BIGTABLE_CLIENT_NS
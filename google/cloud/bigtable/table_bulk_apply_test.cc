@@ -298,3 +298,84 @@ TEST_F(TableBulkApplyTest, FailedRPC) {
   }
 }
 #endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+
+/// @test Verify that Table::BulkApply() invalidates the cached rows.
+TEST_F(TableBulkApplyTest, InvalidatesRowCache) {
+  auto reader = google::cloud::internal::make_unique<MockMutateRowsReader>();
+  EXPECT_CALL(*reader, Read(_))
+      .WillOnce(Invoke([](btproto::MutateRowsResponse* r) {
+        for (int i = 0; i != 2; ++i) {
+          auto& e = *r->add_entries();
+          e.set_index(i);
+          e.mutable_status()->set_code(grpc::StatusCode::OK);
+        }
+        return true;
+      }))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*reader, Finish()).WillOnce(Return(grpc::Status::OK));
+
+  EXPECT_CALL(*client_, MutateRows(_, _))
+      .WillOnce(Invoke(reader.release()->MakeMockReturner()));
+
+  auto cache = std::make_shared<bt::RowCache>();
+  table_.EnableRowCache(cache);
+  auto filter = bt::Filter::PassAllFilter();
+  for (std::string key : {"foo", "bar", "baz"}) {
+    cache->Insert(table_.table_name(), key, filter, cache->generation(),
+                  std::make_pair(false, bt::Row(key, {})));
+  }
+
+  table_.BulkApply(bt::BulkMutation(
+      bt::SingleRowMutation("foo", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+      bt::SingleRowMutation("bar", {bt::SetCell("fam", "col", 0_ms, "qux")})));
+  EXPECT_EQ(2U, cache->stats().invalidations);
+  EXPECT_FALSE(cache->Lookup(table_.table_name(), "foo", filter));
+  EXPECT_FALSE(cache->Lookup(table_.table_name(), "bar", filter));
+  EXPECT_TRUE(cache->Lookup(table_.table_name(), "baz", filter));
+}
+
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+/// @test Verify that Table::BulkApply() invalidates the cached rows for all
+/// the mutations, even if some fail.
+TEST_F(TableBulkApplyTest, PartialFailureInvalidatesRowCache) {
+  auto reader = google::cloud::internal::make_unique<MockMutateRowsReader>();
+  EXPECT_CALL(*reader, Read(_))
+      .WillOnce(Invoke([](btproto::MutateRowsResponse* r) {
+        {
+          auto& e = *r->add_entries();
+          e.set_index(0);
+          e.mutable_status()->set_code(grpc::StatusCode::OK);
+        }
+        {
+          auto& e = *r->add_entries();
+          e.set_index(1);
+          e.mutable_status()->set_code(grpc::StatusCode::OUT_OF_RANGE);
+        }
+        return true;
+      }))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*reader, Finish()).WillOnce(Return(grpc::Status::OK));
+
+  EXPECT_CALL(*client_, MutateRows(_, _))
+      .WillOnce(Invoke(reader.release()->MakeMockReturner()));
+
+  auto cache = std::make_shared<bt::RowCache>();
+  table_.EnableRowCache(cache);
+  auto filter = bt::Filter::PassAllFilter();
+  for (std::string key : {"foo", "bar", "baz"}) {
+    cache->Insert(table_.table_name(), key, filter, cache->generation(),
+                  std::make_pair(false, bt::Row(key, {})));
+  }
+
+  EXPECT_THROW(table_.BulkApply(bt::BulkMutation(
+                   bt::SingleRowMutation(
+                       "foo", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+                   bt::SingleRowMutation(
+                       "bar", {bt::SetCell("fam", "col", 0_ms, "qux")}))),
+               std::exception);
+  EXPECT_EQ(2U, cache->stats().invalidations);
+  EXPECT_FALSE(cache->Lookup(table_.table_name(), "foo", filter));
+  EXPECT_FALSE(cache->Lookup(table_.table_name(), "bar", filter));
+  EXPECT_TRUE(cache->Lookup(table_.table_name(), "baz", filter));
+}
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
@@ -61,3 +61,53 @@ TEST_F(TableCheckAndMutateRowTest, Failure) {
       "exceptions are disabled");
 #endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
 }
+
+/// @test Verify that Table::CheckAndMutateRow() invalidates the cached row.
+TEST_F(TableCheckAndMutateRowTest, InvalidatesRowCache) {
+  using namespace ::testing;
+
+  EXPECT_CALL(*client_, CheckAndMutateRow(_, _, _))
+      .WillOnce(Return(grpc::Status::OK));
+
+  auto cache = std::make_shared<bigtable::RowCache>();
+  table_.EnableRowCache(cache);
+  auto filter = bigtable::Filter::PassAllFilter();
+  for (std::string key : {"foo", "bar"}) {
+    cache->Insert(table_.table_name(), key, filter, cache->generation(),
+                  std::make_pair(false, bigtable::Row(key, {})));
+  }
+
+  table_.CheckAndMutateRow(
+      "foo", bigtable::Filter::PassAllFilter(),
+      {bigtable::SetCell("fam", "col", 0_ms, "it was true")},
+      {bigtable::SetCell("fam", "col", 0_ms, "it was false")});
+  EXPECT_EQ(1U, cache->stats().invalidations);
+  EXPECT_FALSE(cache->Lookup(table_.table_name(), "foo", filter));
+  EXPECT_TRUE(cache->Lookup(table_.table_name(), "bar", filter));
+}
+
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+/// @test Verify that Table::CheckAndMutateRow() invalidates the cached row
+/// even if the request fails.
+TEST_F(TableCheckAndMutateRowTest, FailureInvalidatesRowCache) {
+  using namespace ::testing;
+
+  EXPECT_CALL(*client_, CheckAndMutateRow(_, _, _))
+      .WillRepeatedly(
+          Return(grpc::Status(grpc::StatusCode::UNAVAILABLE, "try-again")));
+
+  auto cache = std::make_shared<bigtable::RowCache>();
+  table_.EnableRowCache(cache);
+  auto filter = bigtable::Filter::PassAllFilter();
+  cache->Insert(table_.table_name(), "foo", filter, cache->generation(),
+                std::make_pair(false, bigtable::Row("foo", {})));
+
+  EXPECT_THROW(table_.CheckAndMutateRow(
+                   "foo", bigtable::Filter::PassAllFilter(),
+                   {bigtable::SetCell("fam", "col", 0_ms, "it was true")},
+                   {bigtable::SetCell("fam", "col", 0_ms, "it was false")}),
+               std::exception);
+  EXPECT_EQ(1U, cache->stats().invalidations);
+  EXPECT_FALSE(cache->Lookup(table_.table_name(), "foo", filter));
+}
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
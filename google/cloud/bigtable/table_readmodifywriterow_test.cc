@@ -276,3 +276,47 @@ TEST_F(TableReadModifyWriteTest, UnrecoverableFailureTest) {
       "exceptions are disabled");
 #endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
 }
+
+/// @test Verify that Table::ReadModifyWriteRow() invalidates the cached row.
+TEST_F(TableReadModifyWriteTest, InvalidatesRowCache) {
+  EXPECT_CALL(*client_, ReadModifyWriteRow(_, _, _))
+      .WillOnce(Return(grpc::Status::OK));
+
+  auto cache = std::make_shared<bigtable::RowCache>();
+  table_.EnableRowCache(cache);
+  auto filter = bigtable::Filter::PassAllFilter();
+  for (std::string key : {"row-key", "other-key"}) {
+    cache->Insert(table_.table_name(), key, filter, cache->generation(),
+                  std::make_pair(false, bigtable::Row(key, {})));
+  }
+
+  table_.ReadModifyWriteRow(
+      "row-key",
+      bigtable::ReadModifyWriteRule::AppendValue("family1", "colid1", "v1"));
+  EXPECT_EQ(1U, cache->stats().invalidations);
+  EXPECT_FALSE(cache->Lookup(table_.table_name(), "row-key", filter));
+  EXPECT_TRUE(cache->Lookup(table_.table_name(), "other-key", filter));
+}
+
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+/// @test Verify that Table::ReadModifyWriteRow() invalidates the cached row
+/// even if the request fails.
+TEST_F(TableReadModifyWriteTest, FailureInvalidatesRowCache) {
+  EXPECT_CALL(*client_, ReadModifyWriteRow(_, _, _))
+      .WillRepeatedly(
+          Return(grpc::Status(grpc::StatusCode::PERMISSION_DENIED, "uh oh")));
+
+  auto cache = std::make_shared<bigtable::RowCache>();
+  table_.EnableRowCache(cache);
+  auto filter = bigtable::Filter::PassAllFilter();
+  cache->Insert(table_.table_name(), "row-key", filter, cache->generation(),
+                std::make_pair(false, bigtable::Row("row-key", {})));
+
+  EXPECT_THROW(table_.ReadModifyWriteRow(
+                   "row-key", bigtable::ReadModifyWriteRule::AppendValue(
+                                  "family1", "colid1", "v1")),
+               std::exception);
+  EXPECT_EQ(1U, cache->stats().invalidations);
+  EXPECT_FALSE(cache->Lookup(table_.table_name(), "row-key", filter));
+}
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
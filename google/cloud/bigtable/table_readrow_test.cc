@@ -112,3 +112,66 @@ TEST_F(TableReadRowTest, UnrecoverableFailure) {
       "exceptions are disabled");
 #endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
 }
+
+/// @test Verify that Table::ReadRow() uses the row cache and that mutations
+/// invalidate it.
+TEST_F(TableReadRowTest, ReadRowCached) {
+  using namespace ::testing;
+  namespace btproto = ::google::bigtable::v2;
+
+  auto response = bigtable::testing::ReadRowsResponseFromString(R"(
+      chunks {
+        row_key: "r1"
+        family_name { value: "fam" }
+        qualifier { value: "col" }
+        timestamp_micros: 42000
+        value: "value"
+        commit_row: true
+      }
+)");
+
+  auto make_stream = [&response]() {
+    auto stream = google::cloud::internal::make_unique<MockReadRowsReader>();
+    EXPECT_CALL(*stream, Read(_))
+        .WillOnce(Invoke([&response](btproto::ReadRowsResponse* r) {
+          *r = response;
+          return true;
+        }))
+        .WillOnce(Return(false));
+    EXPECT_CALL(*stream, Finish()).WillOnce(Return(grpc::Status::OK));
+    return stream;
+  };
+  auto stream1 = make_stream();
+  auto stream2 = make_stream();
+
+  EXPECT_CALL(*client_, ReadRows(_, _))
+      .WillOnce(Invoke([&stream1](grpc::ClientContext*,
+                                  btproto::ReadRowsRequest const&) {
+        return stream1.release()->AsUniqueMocked();
+      }))
+      .WillOnce(Invoke([&stream2](grpc::ClientContext*,
+                                  btproto::ReadRowsRequest const&) {
+        return stream2.release()->AsUniqueMocked();
+      }));
+  EXPECT_CALL(*client_, MutateRow(_, _, _)).WillOnce(Return(grpc::Status::OK));
+
+  auto cache = std::make_shared<bigtable::RowCache>();
+  table_.EnableRowCache(cache);
+
+  auto result = table_.ReadRow("r1", bigtable::Filter::PassAllFilter());
+  EXPECT_TRUE(result.first);
+  result = table_.ReadRow("r1", bigtable::Filter::PassAllFilter());
+  EXPECT_TRUE(result.first);
+  EXPECT_EQ("r1", result.second.row_key());
+  EXPECT_EQ(1U, cache->stats().hits);
+
+  table_.Apply(bigtable::SingleRowMutation(
+      "r1", {bigtable::SetCell("fam", "col", std::chrono::milliseconds(0),
+                               "new-value")}));
+  EXPECT_EQ(1U, cache->stats().invalidations);
+
+  result = table_.ReadRow("r1", bigtable::Filter::PassAllFilter());
+  EXPECT_TRUE(result.first);
+  EXPECT_EQ(1U, cache->stats().hits);
+  EXPECT_EQ(2U, cache->stats().misses);
+}
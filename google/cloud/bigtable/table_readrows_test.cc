@@ -14,7 +14,9 @@
 
 #include "google/cloud/bigtable/table.h"
 #include "google/cloud/bigtable/testing/mock_read_rows_reader.h"
+#include "google/cloud/bigtable/testing/mock_sample_row_keys_reader.h"
 #include "google/cloud/bigtable/testing/table_test_fixture.h"
+#include <mutex>
 
 namespace bigtable = google::cloud::bigtable;
 using testing::_;
@@ -27,6 +29,41 @@ using testing::SetArgPointee;
 namespace {
 class TableReadRowsTest : public bigtable::testing::TableTestFixture {};
 using bigtable::testing::MockReadRowsReader;
+using bigtable::testing::MockSampleRowKeysReader;
+namespace btproto = ::google::bigtable::v2;
+
+/// Configure @p client to return a single sample at @p key.
+void ExpectSampleAt(bigtable::testing::MockDataClient& client,
+                    std::string key) {
+  auto reader = new MockSampleRowKeysReader;
+  EXPECT_CALL(client, SampleRowKeys(_, _))
+      .WillOnce(Invoke(reader->MakeMockReturner()));
+  EXPECT_CALL(*reader, Read(_))
+      .WillOnce(Invoke([key](btproto::SampleRowKeysResponse* r) {
+        r->set_row_key(key);
+        r->set_offset_bytes(1000);
+        return true;
+      }))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*reader, Finish()).WillOnce(Return(grpc::Status::OK));
+}
+
+/// Return a stream with one row, keyed after the start of the requested range.
+std::unique_ptr<grpc::ClientReaderInterface<btproto::ReadRowsResponse>>
+ReturnFirstKeyInRange(grpc::ClientContext*,
+                      btproto::ReadRowsRequest const& request) {
+  auto key = request.rows().row_ranges(0).start_key_closed() + "-row";
+  auto response = bigtable::testing::ReadRowsResponseFromString(
+      "chunks { row_key: '" + key +
+      "' family_name { value: 'fam' } qualifier { value: 'qual' }"
+      " timestamp_micros: 42000 value: 'value' commit_row: true }");
+  auto stream = new MockReadRowsReader;
+  EXPECT_CALL(*stream, Read(_))
+      .WillOnce(DoAll(SetArgPointee<0>(response), Return(true)))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*stream, Finish()).WillOnce(Return(grpc::Status::OK));
+  return stream->AsUniqueMocked();
+}
 }  // anonymous namespace
 
 TEST_F(TableReadRowsTest, ReadRowsCanReadOneRow) {
@@ -139,3 +176,60 @@ TEST_F(TableReadRowsTest, ReadRowsThrowsWhenTooManyErrors) {
   EXPECT_THROW(reader.begin(), std::exception);
 }
 #endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+
+TEST_F(TableReadRowsTest, ParallelReadRowsReadsAllShards) {
+  ExpectSampleAt(*client_, "m");
+  EXPECT_CALL(*client_, ReadRows(_, _))
+      .Times(2)
+      .WillRepeatedly(Invoke(ReturnFirstKeyInRange));
+
+  std::mutex mu;
+  std::vector<std::string> keys;
+  table_.ParallelReadRows(
+      bigtable::RowSet(bigtable::RowRange::InfiniteRange()),
+      bigtable::Filter::PassAllFilter(), 4, [&](bigtable::Row row) {
+        std::lock_guard<std::mutex> lk(mu);
+        keys.push_back(row.row_key());
+      });
+
+  std::sort(keys.begin(), keys.end());
+  EXPECT_EQ((std::vector<std::string>{"-row", "m-row"}), keys);
+}
+
+TEST_F(TableReadRowsTest, ParallelReadRowsWithoutSamples) {
+  auto reader = new MockSampleRowKeysReader;
+  EXPECT_CALL(*client_, SampleRowKeys(_, _))
+      .WillOnce(Invoke(reader->MakeMockReturner()));
+  EXPECT_CALL(*reader, Read(_)).WillOnce(Return(false));
+  EXPECT_CALL(*reader, Finish()).WillOnce(Return(grpc::Status::OK));
+  EXPECT_CALL(*client_, ReadRows(_, _))
+      .WillOnce(Invoke(ReturnFirstKeyInRange));
+
+  std::vector<std::string> keys;
+  table_.ParallelReadRows(
+      bigtable::RowSet(bigtable::RowRange::StartingAt("a")),
+      bigtable::Filter::PassAllFilter(), 0,
+      [&](bigtable::Row row) { keys.push_back(row.row_key()); });
+
+  EXPECT_EQ(std::vector<std::string>{"a-row"}, keys);
+}
+
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+TEST_F(TableReadRowsTest, ParallelReadRowsThrowsWhenShardFails) {
+  ExpectSampleAt(*client_, "m");
+  EXPECT_CALL(*client_, ReadRows(_, _))
+      .WillRepeatedly(testing::WithoutArgs(testing::Invoke([] {
+        auto stream = new MockReadRowsReader;
+        EXPECT_CALL(*stream, Read(_)).WillOnce(Return(false));
+        EXPECT_CALL(*stream, Finish())
+            .WillOnce(Return(
+                grpc::Status(grpc::StatusCode::PERMISSION_DENIED, "uh oh")));
+        return stream->AsUniqueMocked();
+      })));
+
+  EXPECT_THROW(table_.ParallelReadRows(
+                   bigtable::RowSet(bigtable::RowRange::InfiniteRange()),
+                   bigtable::Filter::PassAllFilter(), 2, [](bigtable::Row) {}),
+               std::exception);
+}
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
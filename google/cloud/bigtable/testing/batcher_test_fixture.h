@@ -0,0 +1,59 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_TESTING_BATCHER_TEST_FIXTURE_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_TESTING_BATCHER_TEST_FIXTURE_H_
+
+#include "google/cloud/bigtable/completion_queue.h"
+#include "google/cloud/bigtable/testing/internal_table_test_fixture.h"
+#include "google/cloud/bigtable/testing/mock_completion_queue.h"
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+namespace testing {
+namespace internal {
+
+/// Common fixture for the `MutationBatcher` and `ReadRowBatcher` tests.
+class BatcherTestFixture : public TableTestFixture {
+ protected:
+  BatcherTestFixture()
+      : cq_impl_(std::make_shared<MockCompletionQueue>()), cq_(cq_impl_) {}
+
+  /// Simulate the completion of a streaming request without retries.
+  void CompleteRequest() {
+    cq_impl_->SimulateCompletion(cq_, true);
+    cq_impl_->SimulateCompletion(cq_, true);
+    cq_impl_->SimulateCompletion(cq_, false);
+    cq_impl_->SimulateCompletion(cq_, false);
+  }
+
+  /// Simulate the expiration of the pending timers.
+  void FireTimers() { cq_impl_->SimulateCompletion(cq_, true); }
+
+  /// Simulate the cancellation of the pending timers, as in a shutdown.
+  void CancelTimers() { cq_impl_->SimulateCompletion(cq_, false); }
+
+  std::shared_ptr<MockCompletionQueue> cq_impl_;
+  bigtable::CompletionQueue cq_;
+};
+
+}  // namespace internal
+}  // namespace testing
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_TESTING_BATCHER_TEST_FIXTURE_H_
@@ -0,0 +1,140 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/future.h"
+#include "google/cloud/testing_util/allocation_counter.h"
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+
+/**
+ * @file
+ *
+ * Measure the cost of `google::cloud::future<T>`.
+ *
+ * For each scenario the benchmark runs the given number of iterations and
+ * reports the average time and the number of heap allocations per iteration.
+ * The scenarios are:
+ *
+ * - `SetGet`: create a promise, get its future, set the value and get it.
+ * - `Then`: as above, with a `.then()` continuation attached before the value
+ *   is set.
+ * - `ThenChain`: a chain of 4 continuations.
+ * - `CrossThread`: the value is set by another thread while the caller is
+ *   blocked in `.get()`.
+ *
+ * Usage: future_benchmark [iterations]
+ */
+
+namespace {
+using google::cloud::future;
+using google::cloud::promise;
+using google::cloud::testing_util::AllocationCount;
+
+constexpr int kDefaultIterations = 1000000;
+
+long SetGet() {
+  promise<int> p;
+  auto f = p.get_future();
+  p.set_value(42);
+  return f.get();
+}
+
+long Then() {
+  promise<int> p;
+  auto f = p.get_future().then([](future<int> g) { return g.get() + 1; });
+  p.set_value(42);
+  return f.get();
+}
+
+long ThenChain() {
+  promise<int> p;
+  auto f = p.get_future()
+               .then([](future<int> g) { return g.get() + 1; })
+               .then([](future<int> g) { return g.get() + 1; })
+               .then([](future<int> g) { return g.get() + 1; })
+               .then([](future<int> g) { return g.get() + 1; });
+  p.set_value(42);
+  return f.get();
+}
+
+/// Report the cost of calling @p function @p iterations times.
+template <typename Function>
+void Run(std::string const& name, int iterations, Function&& function) {
+  long checksum = 0;
+  long const before = AllocationCount();
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i != iterations; ++i) {
+    checksum += function();
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  long const allocations = AllocationCount() - before;
+
+  using std::chrono::nanoseconds;
+  auto ns = std::chrono::duration_cast<nanoseconds>(elapsed).count();
+  std::cout << name << "," << iterations << "," << std::fixed
+            << std::setprecision(1) << static_cast<double>(ns) / iterations
+            << "," << static_cast<double>(allocations) / iterations << ","
+            << checksum << std::endl;
+}
+
+/// Set the value of a promise from a second thread, while `get()` blocks.
+void RunCrossThread(int iterations) {
+  std::atomic<promise<int>*> pending(nullptr);
+  std::atomic<bool> done(false);
+  std::thread setter([&] {
+    while (not done.load()) {
+      auto* p = pending.exchange(nullptr);
+      if (p != nullptr) {
+        p->set_value(42);
+      }
+    }
+  });
+  Run("CrossThread", iterations, [&] {
+    promise<int> p;
+    auto f = p.get_future();
+    pending.store(&p);
+    return f.get();
+  });
+  done.store(true);
+  setter.join();
+}
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) try {
+  int iterations = kDefaultIterations;
+  if (argc > 1) {
+    iterations = std::stoi(argv[1]);
+  }
+  if (iterations <= 0) {
+    std::cerr << "Usage: " << argv[0] << " [iterations]" << std::endl;
+    return 1;
+  }
+
+  std::cout << "Scenario,Iterations,NanosecondsPerIteration,"
+               "AllocationsPerIteration,Checksum"
+            << std::endl;
+  Run("SetGet", iterations, SetGet);
+  Run("Then", iterations, Then);
+  Run("ThenChain", iterations, ThenChain);
+  RunCrossThread(iterations / 10 + 1);
+
+  return 0;
+} catch (std::exception const& ex) {
+  std::cerr << "Standard exception raised: " << ex.what() << std::endl;
+  return 1;
+}
@@ -23,10 +23,13 @@
 #include "google/cloud/internal/future_then_meta.h"
 #include "google/cloud/internal/make_unique.h"
 #include "google/cloud/terminate_handler.h"
+#include <atomic>
 #include <condition_variable>
+#include <cstddef>
 #include <exception>
 #include <future>
 #include <mutex>
+#include <type_traits>
 
 namespace google {
 namespace cloud {
@@ -53,6 +56,29 @@ class continuation_base {
   virtual void execute() = 0;
 };
 
+/**
+ * Releases a continuation stored in a shared state.
+ *
+ * Continuations are usually stored in a buffer inside the shared state, and
+ * only allocated on the heap if they do not fit. This deleter knows which case
+ * applies.
+ */
+struct continuation_deleter {
+  void operator()(continuation_base* c) const {
+    if (is_inline) {
+      c->~continuation_base();
+      return;
+    }
+    delete c;
+  }
+
+  bool is_inline;
+};
+
+/// A pointer to a continuation stored inline or on the heap.
+using continuation_ptr =
+    std::unique_ptr<continuation_base, continuation_deleter>;
+
 /**
  * Common base class for all shared state classes.
  *
@@ -60,6 +86,14 @@ class continuation_base {
  * future<void> share a lot of code. This class refactors that code, it
  * represents a shared state of unknown type.
  *
+ * The state of the shared state (not ready, being satisfied, or holding a
+ * value or an exception), and whether it has a continuation or threads blocked
+ * on it, are kept in a single atomic word. Satisfying the shared state, adding
+ * a continuation and checking if it is ready do not need a mutex. The mutex and
+ * condition variable are only used by threads that block in `wait()` (or
+ * `get()`), and those first spin for a short time, as most futures are
+ * satisfied quickly.
+ *
  * @note While most of the invariants for promises and futures are implemented
  *   by this class, not all of them are. Notably, future values can only be
  *   retrieved once, but this is enforced because calling .get() or .then() on a
@@ -68,18 +102,21 @@ class continuation_base {
  */
 class future_shared_state_base {
  public:
-  future_shared_state_base() : mu_(), cv_(), current_state_(state::not_ready) {}
+  future_shared_state_base() : current_state_(not_ready) {}
 
   /// Return true if the shared state has a value or an exception.
   bool is_ready() const {
-    std::unique_lock<std::mutex> lk(mu_);
-    return is_ready_unlocked();
+    return is_ready(current_state_.load(std::memory_order_acquire));
   }
 
   /// Block until is_ready() returns true ...
   void wait() {
+    if (spin_until_ready()) {
+      return;
+    }
     std::unique_lock<std::mutex> lk(mu_);
-    cv_.wait(lk, [this] { return is_ready_unlocked(); });
+    add_waiter(lk);
+    cv_.wait(lk, [this] { return is_ready(); });
   }
 
   /**
@@ -106,16 +143,13 @@ class future_shared_state_base {
    */
   template <typename Rep, typename Period>
   std::future_status wait_for(std::chrono::duration<Rep, Period> duration) {
-    std::unique_lock<std::mutex> lk(mu_);
-    bool result =
-        cv_.wait_for(lk, duration, [this] { return is_ready_unlocked(); });
-    if (result) {
+    if (is_ready()) {
       return std::future_status::ready;
     }
-    if (continuation_) {
-      return std::future_status::deferred;
-    }
-    return std::future_status::timeout;
+    std::unique_lock<std::mutex> lk(mu_);
+    add_waiter(lk);
+    bool result = cv_.wait_for(lk, duration, [this] { return is_ready(); });
+    return wait_result(result);
   }
 
   /**
@@ -136,26 +170,20 @@ class future_shared_state_base {
    */
   template <typename Clock>
   std::future_status wait_until(std::chrono::time_point<Clock> deadline) {
-    std::unique_lock<std::mutex> lk(mu_);
-    if (not lk.owns_lock()) {
-      return std::future_status::timeout;
-    }
-    bool result =
-        cv_.wait_until(lk, deadline, [this] { return is_ready_unlocked(); });
-    if (result) {
+    if (is_ready()) {
       return std::future_status::ready;
     }
-    if (continuation_) {
-      return std::future_status::deferred;
-    }
-    return std::future_status::timeout;
+    std::unique_lock<std::mutex> lk(mu_);
+    add_waiter(lk);
+    bool result = cv_.wait_until(lk, deadline, [this] { return is_ready(); });
+    return wait_result(result);
   }
 
   /// Set the shared state to hold an exception and notify immediately.
   void set_exception(std::exception_ptr ex) {
-    std::unique_lock<std::mutex> lk(mu_);
-    set_exception(std::move(ex), lk);
-    notify_now(std::move(lk));
+    start_satisfy(__func__);
+    exception_ = std::move(ex);
+    finish_satisfy(has_exception, true);
   }
 
   /**
@@ -167,62 +195,197 @@ class future_shared_state_base {
    * `std::future_errc::broken_promise`.
    */
   void abandon() {
-    std::unique_lock<std::mutex> lk(mu_);
-    if (is_ready_unlocked()) {
+    if (not try_start_satisfy()) {
       return;
     }
-    set_exception(std::make_exception_ptr(
-                      std::future_error(std::future_errc::broken_promise)),
-                  lk);
-    cv_.notify_all();
+    exception_ = std::make_exception_ptr(
+        std::future_error(std::future_errc::broken_promise));
+    finish_satisfy(has_exception, false);
   }
 
   void set_continuation(std::unique_ptr<continuation_base> c) {
-    std::unique_lock<std::mutex> lk(mu_);
-    if (continuation_) {
+    install_continuation(continuation_ptr(c.release(), {false}));
+  }
+
+  /**
+   * Create a continuation of type @p C.
+   *
+   * The continuation is created in a buffer inside the shared state if it fits
+   * and the buffer is not in use, otherwise it is allocated on the heap. The
+   * caller must pass the result to `install_continuation()`.
+   */
+  template <typename C, typename... Args>
+  continuation_ptr allocate_continuation(Args&&... args) {
+    using fits = std::integral_constant<
+        bool, sizeof(C) <= sizeof(continuation_buffer_t) and
+                  alignof(C) <= alignof(continuation_buffer_t)>;
+    return allocate_continuation<C>(fits{}, std::forward<Args>(args)...);
+  }
+
+  /**
+   * Set the continuation, or invoke it if the shared state is satisfied.
+   *
+   * @throws std::future_error if the shared state already has a continuation.
+   */
+  void install_continuation(continuation_ptr c) {
+    auto state = current_state_.load(std::memory_order_acquire);
+    if ((state & has_continuation) != 0) {
       ThrowFutureError(std::future_errc::future_already_retrieved, __func__);
     }
-    // If the future is already satisfied, invoke the continuation immediately.
-    if (is_ready_unlocked()) {
-      // Release the lock before calling the user's code, holding locks during
-      // callbacks is a bad practice.
-      lk.unlock();
-      c->execute();
-      return;
-    }
+    // The thread satisfying the shared state only reads `continuation_` after
+    // it observes the `has_continuation` bit, which is set after this write.
     continuation_ = std::move(c);
+    while (not is_ready(state)) {
+      if (current_state_.compare_exchange_weak(state, state | has_continuation,
+                                               std::memory_order_acq_rel,
+                                               std::memory_order_acquire)) {
+        return;
+      }
+    }
+    // If the future is already satisfied, invoke the continuation immediately.
+    auto local = std::move(continuation_);
+    local->execute();
   }
 
  protected:
-  bool is_ready_unlocked() const { return current_state_ != state::not_ready; }
+  /// Bits and values stored in `current_state_`.
+  enum : unsigned {
+    // The low bits hold the state of the value.
+    not_ready = 0,
+    satisfying = 1,
+    has_exception = 2,
+    has_value = 3,
+    value_mask = 3,
+    // A continuation is set.
+    has_continuation = 4,
+    // At least one thread is (or was) blocked waiting for the value.
+    has_waiters = 8,
+  };
+
+  static bool is_ready(unsigned state) {
+    auto const value = state & value_mask;
+    return value == has_exception or value == has_value;
+  }
 
-  /// Satisfy the shared state using an exception.
-  void set_exception(std::exception_ptr ex, std::unique_lock<std::mutex>& lk) {
-    if (is_ready_unlocked()) {
-      ThrowFutureError(std::future_errc::promise_already_satisfied, __func__);
+  /// Return the state of the value, which is terminal once the state is ready.
+  unsigned value_state() const {
+    return current_state_.load(std::memory_order_acquire) & value_mask;
+  }
+
+  /**
+   * Claim the right to satisfy the shared state.
+   *
+   * @throws std::future_error if the shared state is already satisfied.
+   */
+  void start_satisfy(char const* msg) {
+    if (not try_start_satisfy()) {
+      ThrowFutureError(std::future_errc::promise_already_satisfied, msg);
     }
-    exception_ = std::move(ex);
-    current_state_ = state::has_exception;
   }
 
-  /// If needed, notify any waiting threads that the shared state is satisfied.
-  void notify_now(std::unique_lock<std::mutex>&& lk) {
-    if (continuation_) {
-      // Release the lock before calling the continuation because the
-      // continuation will likely call get() to fetch the state of the future.
-      lk.unlock();
-      continuation_->execute();
+  /// Claim the right to satisfy the shared state, return false if satisfied.
+  bool try_start_satisfy() {
+    auto state = current_state_.load(std::memory_order_relaxed);
+    do {
+      if ((state & value_mask) != not_ready) {
+        return false;
+      }
+    } while (not current_state_.compare_exchange_weak(
+        state, state | satisfying, std::memory_order_acquire,
+        std::memory_order_relaxed));
+    return true;
+  }
+
+  /// Undo `start_satisfy()` if storing the value fails.
+  void cancel_satisfy() {
+    auto state = current_state_.load(std::memory_order_relaxed);
+    while (not current_state_.compare_exchange_weak(
+        state, state & ~value_mask, std::memory_order_release,
+        std::memory_order_relaxed)) {
+    }
+  }
+
+  /**
+   * Mark the shared state as satisfied, and notify the continuation or any
+   * blocked threads.
+   *
+   * The destructor of `promise<T>` does not run continuations, it only wakes up
+   * blocked threads, so @p run_continuation is false in that case.
+   */
+  void finish_satisfy(unsigned value, bool run_continuation) {
+    auto state = current_state_.load(std::memory_order_relaxed);
+    while (not current_state_.compare_exchange_weak(
+        state, (state & ~value_mask) | value, std::memory_order_acq_rel,
+        std::memory_order_relaxed)) {
+    }
+    if ((state & has_continuation) != 0) {
+      if (run_continuation) {
+        continuation_->execute();
+      }
       // If there is a continuation there can be no threads blocked on get() or
       // wait() because then() invalidates the future. Therefore we can return
       // without notifying any other threads.
       return;
     }
-    // Unlock first to avoid waking up a thread which becomes immediately
-    // blocked on the mutex.
-    lk.unlock();
+    if ((state & has_waiters) == 0) {
+      return;
+    }
+    // The waiters set `has_waiters` and test `is_ready()` while holding the
+    // mutex, acquiring it here guarantees that they are blocked on the
+    // condition variable (or have seen the new state) before the notification.
+    { std::lock_guard<std::mutex> lk(mu_); }
     cv_.notify_all();
   }
 
+  /// Create the continuation in `continuation_buffer_` if it is not in use.
+  template <typename C, typename... Args>
+  continuation_ptr allocate_continuation(std::true_type, Args&&... args) {
+    if ((current_state_.load(std::memory_order_acquire) & has_continuation) !=
+        0) {
+      return continuation_ptr(new C(std::forward<Args>(args)...), {false});
+    }
+    return continuation_ptr(
+        new (&continuation_buffer_) C(std::forward<Args>(args)...), {true});
+  }
+
+  /// Create the continuation on the heap, it does not fit the buffer.
+  template <typename C, typename... Args>
+  continuation_ptr allocate_continuation(std::false_type, Args&&... args) {
+    return continuation_ptr(new C(std::forward<Args>(args)...), {false});
+  }
+
+  /**
+   * Spin for a short time waiting for the shared state to become ready.
+   *
+   * The spin is short and does not yield: yielding to a thread that does not
+   * block (such as a busy event loop) can delay the waiter for a full
+   * scheduling quantum, blocking on the condition variable does not.
+   */
+  bool spin_until_ready() const {
+    for (int i = 0; i != spin_iterations; ++i) {
+      if (is_ready()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// Record that a thread is about to block waiting for the value.
+  void add_waiter(std::unique_lock<std::mutex> const&) {
+    current_state_.fetch_or(has_waiters, std::memory_order_acq_rel);
+  }
+
+  std::future_status wait_result(bool ready) const {
+    if (ready) {
+      return std::future_status::ready;
+    }
+    if ((current_state_.load(std::memory_order_acquire) & has_continuation) !=
+        0) {
+      return std::future_status::deferred;
+    }
+    return std::future_status::timeout;
+  }
+
   /**
    * The implementation details for `promise<T>::get_future()`.
    *
@@ -260,24 +423,30 @@ class future_shared_state_base {
   /// Keep track of whether `get_future()` has been called.
   std::atomic_flag retrieved_ = ATOMIC_FLAG_INIT;
 
-  mutable std::mutex mu_;
-  std::condition_variable cv_;
-  enum class state {
-    not_ready,
-    has_exception,
-    has_value,
-  };
-  state current_state_;
+  /// How many times `wait()` checks the state before blocking.
+  static constexpr int spin_iterations = 64;
+
+  std::atomic<unsigned> current_state_;
   std::exception_ptr exception_;
 
+  // Only used by threads blocked in `wait()`, `wait_for()` and `wait_until()`.
+  std::mutex mu_;
+  std::condition_variable cv_;
+
+  // Most continuations created by `.then()` fit in this buffer, which saves a
+  // heap allocation for each call.
+  using continuation_buffer_t =
+      std::aligned_storage<96, alignof(std::max_align_t)>::type;
+  continuation_buffer_t continuation_buffer_;
+
   /**
    * The continuation, if any, associated with this shared state.
    *
    * Note that continuations may be set independently of having a value or
-   * exception. Setting a continuation does not change the `current_state_`
-   * member variable and does not satisfy the shared state.
+   * exception. Setting a continuation does not change the state of the value
+   * and does not satisfy the shared state.
    */
-  std::unique_ptr<continuation_base> continuation_;
+  continuation_ptr continuation_;
 };
 
 /**
@@ -306,7 +475,7 @@ class future_shared_state final : private future_shared_state_base {
  public:
   future_shared_state() : future_shared_state_base(), buffer_() {}
   ~future_shared_state() {
-    if (current_state_ == state::has_value) {
+    if (value_state() == has_value) {
       // Recall that state::has_value is a terminal state, once a value is
       // stored in this class nothing else (no exceptions nor continuations)
       // can be stored.  And if a value was stored then we need to call the
@@ -317,6 +486,8 @@ class future_shared_state final : private future_shared_state_base {
   }
 
   using future_shared_state_base::abandon;
+  using future_shared_state_base::allocate_continuation;
+  using future_shared_state_base::install_continuation;
   using future_shared_state_base::is_ready;
   using future_shared_state_base::set_continuation;
   using future_shared_state_base::set_exception;
@@ -326,9 +497,8 @@ class future_shared_state final : private future_shared_state_base {
 
   /// The implementation details for `future<T>::get()`
   T get() {
-    std::unique_lock<std::mutex> lk(mu_);
-    cv_.wait(lk, [this] { return is_ready_unlocked(); });
-    if (current_state_ == state::has_exception) {
+    wait();
+    if (value_state() == has_exception) {
 #if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
       std::rethrow_exception(exception_);
 #else
@@ -353,21 +523,22 @@ class future_shared_state final : private future_shared_state_base {
    *     error code is `std::future_errc::promise_already_satisfied`.
    */
   void set_value(T&& value) {
-    std::unique_lock<std::mutex> lk(mu_);
-    if (is_ready_unlocked()) {
-      ThrowFutureError(std::future_errc::promise_already_satisfied, __func__);
-    }
+    start_satisfy(__func__);
     // We can only reach this point once, all other states are terminal.
     // Therefore we know that `buffer_` has not been initialized and calling
     // placement new via the move constructor is the best way to initialize the
-    // buffer.
-
-    // TODO(#1405) - this is calling application code while holding a lock.
-    // That could result in a deadlock (or at least unbounded priority
-    // inversions) if the move constructor for `T` takes a long time to execute.
+    // buffer. No locks are held while the move constructor runs.
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    try {
+      new (reinterpret_cast<T*>(&buffer_)) T(std::move(value));
+    } catch (...) {
+      cancel_satisfy();
+      throw;
+    }
+#else
     new (reinterpret_cast<T*>(&buffer_)) T(std::move(value));
-    current_state_ = state::has_value;
-    notify_now(std::move(lk));
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    finish_satisfy(has_value, true);
   }
 
   /**
@@ -442,6 +613,8 @@ class future_shared_state<void> final : private future_shared_state_base {
   future_shared_state() : future_shared_state_base() {}
 
   using future_shared_state_base::abandon;
+  using future_shared_state_base::allocate_continuation;
+  using future_shared_state_base::install_continuation;
   using future_shared_state_base::is_ready;
   using future_shared_state_base::set_continuation;
   using future_shared_state_base::set_exception;
@@ -451,9 +624,8 @@ class future_shared_state<void> final : private future_shared_state_base {
 
   /// The implementation details for `future<void>::get()`
   void get() {
-    std::unique_lock<std::mutex> lk(mu_);
-    cv_.wait(lk, [this] { return is_ready_unlocked(); });
-    if (current_state_ == state::has_exception) {
+    wait();
+    if (value_state() == has_exception) {
 #if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
       std::rethrow_exception(exception_);
 #else
@@ -465,9 +637,8 @@ class future_shared_state<void> final : private future_shared_state_base {
 
   /// The implementation details for `promise<void>::set_value()`
   void set_value() {
-    std::unique_lock<std::mutex> lk(mu_);
-    set_value(lk);
-    notify_now(std::move(lk));
+    start_satisfy(__func__);
+    finish_satisfy(has_value, true);
   }
 
   /**
@@ -531,14 +702,6 @@ class future_shared_state<void> final : private future_shared_state_base {
   static void mark_retrieved(std::shared_ptr<future_shared_state> const& sh) {
     future_shared_state_base::mark_retrieved(sh.get());
   }
-
- private:
-  void set_value(std::unique_lock<std::mutex> const& lk) {
-    if (is_ready_unlocked()) {
-      ThrowFutureError(std::future_errc::promise_already_satisfied, __func__);
-    }
-    current_state_ = state::has_value;
-  }
 };
 
 /**
@@ -722,13 +885,13 @@ struct unwrapping_continuation : public continuation_base {
       return r->get();
     };
     using continuation_type = internal::continuation<decltype(unwrapper), R>;
-    auto continuation = google::cloud::internal::make_unique<continuation_type>(
-        std::move(unwrapper), intermediate, output);
+    auto continuation =
+        intermediate->template allocate_continuation<continuation_type>(
+            std::move(unwrapper), intermediate, output);
     // assert(intermediate->continuation_ == nullptr)
     // If intermediate has a continuation then the associated future would have
     // been invalid, and we never get here.
-    intermediate->set_continuation(
-        std::unique_ptr<continuation_base>(std::move(continuation)));
+    intermediate->install_continuation(std::move(continuation));
   }
 
   /// The functor called when `input` is satisfied.
@@ -751,11 +914,11 @@ std::shared_ptr<typename internal::continuation_helper<F, T>::state_t>
 future_shared_state<T>::make_continuation(
     std::shared_ptr<future_shared_state<T>> self, F&& functor) {
   using continuation_type = internal::continuation<F, T>;
-  auto continuation = google::cloud::internal::make_unique<continuation_type>(
+  auto continuation = self->template allocate_continuation<continuation_type>(
       std::forward<F>(functor), self);
-  auto result = continuation->output;
-  self->set_continuation(
-      std::unique_ptr<continuation_base>(std::move(continuation)));
+  auto result =
+      static_cast<continuation_type*>(continuation.get())->output;
+  self->install_continuation(std::move(continuation));
   return result;
 }
 
@@ -773,13 +936,13 @@ future_shared_state<T>::make_continuation(
 
   // First create a continuation that calls the functor, and stores the result
   // in a `future_shared_state<future_shared_state<R>>`
-  auto continuation = google::cloud::internal::make_unique<continuation_type>(
+  auto continuation = self->template allocate_continuation<continuation_type>(
       std::forward<F>(functor), self);
   // Save the value of `continuation->output`, because the move will make it
   // inaccessible.
-  std::shared_ptr<future_shared_state<R>> result = continuation->output;
-  self->set_continuation(
-      std::unique_ptr<continuation_base>(std::move(continuation)));
+  std::shared_ptr<future_shared_state<R>> result =
+      static_cast<continuation_type*>(continuation.get())->output;
+  self->install_continuation(std::move(continuation));
   return result;
 }
 
@@ -789,13 +952,13 @@ std::shared_ptr<typename internal::continuation_helper<F, void>::state_t>
 future_shared_state<void>::make_continuation(
     std::shared_ptr<future_shared_state<void>> self, F&& functor) {
   using continuation_type = internal::continuation<F, void>;
-  auto continuation = google::cloud::internal::make_unique<continuation_type>(
+  auto continuation = self->template allocate_continuation<continuation_type>(
       std::forward<F>(functor), self);
   // Save the value of `continuation->output`, because the move will make it
   // inaccessible.
-  auto result = continuation->output;
-  self->set_continuation(
-      std::unique_ptr<continuation_base>(std::move(continuation)));
+  auto result =
+      static_cast<continuation_type*>(continuation.get())->output;
+  self->install_continuation(std::move(continuation));
   return result;
 }
 
@@ -815,13 +978,13 @@ future_shared_state<void>::make_continuation(
 
   // First create a continuation that calls the functor, and stores the result
   // in a `future_shared_state<future_shared_state<R>>`
-  auto continuation = google::cloud::internal::make_unique<continuation_type>(
+  auto continuation = self->template allocate_continuation<continuation_type>(
       std::forward<F>(functor), self);
   // Save the value of `continuation->output`, because the move will make it
   // inaccessible.
-  std::shared_ptr<future_shared_state<R>> result = continuation->output;
-  self->set_continuation(
-      std::unique_ptr<continuation_base>(std::move(continuation)));
+  std::shared_ptr<future_shared_state<R>> result =
+      static_cast<continuation_type*>(continuation.get())->output;
+  self->install_continuation(std::move(continuation));
   return result;
 }
 
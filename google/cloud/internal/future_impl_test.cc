@@ -18,6 +18,8 @@
 #include "google/cloud/testing_util/expect_future_error.h"
 #include "google/cloud/testing_util/testing_types.h"
 #include <gmock/gmock.h>
+#include <array>
+#include <thread>
 
 namespace google {
 namespace cloud {
@@ -579,6 +581,79 @@ TEST(FutureImplObservable, SetValue) {
   EXPECT_EQ(3, Observable::destructor);
 }
 
+/// @test Verify that a thread blocked in get() is woken up by set_value().
+TEST(FutureImplInt, GetBlocksUntilSetValue) {
+  future_shared_state<int> shared_state;
+  std::thread t([&shared_state] {
+    std::this_thread::sleep_for(10_ms);
+    shared_state.set_value(42);
+  });
+  EXPECT_EQ(42, shared_state.get());
+  t.join();
+}
+
+/// @test Verify that wait_for() returns when another thread sets the value.
+TEST(FutureImplInt, WaitForWakesUp) {
+  future_shared_state<int> shared_state;
+  std::thread t([&shared_state] {
+    std::this_thread::sleep_for(10_ms);
+    shared_state.set_value(42);
+  });
+  EXPECT_EQ(std::future_status::ready, shared_state.wait_for(10000_ms));
+  EXPECT_EQ(42, shared_state.get());
+  t.join();
+}
+
+/// @test Verify that continuations too large for the inline buffer work.
+TEST(ContinuationIntTest, LargeContinuation) {
+  std::array<int, 64> captured;
+  captured.fill(1);
+  auto functor = [captured](std::shared_ptr<future_shared_state<int>> state) {
+    return state->get() + captured[63];
+  };
+
+  auto input = std::make_shared<future_shared_state<int>>();
+  std::shared_ptr<future_shared_state<int>> output =
+      input->make_continuation(input, std::move(functor));
+  EXPECT_FALSE(output->is_ready());
+  input->set_value(41);
+  EXPECT_TRUE(output->is_ready());
+  EXPECT_EQ(42, output->get());
+}
+
+/// @test Verify that continuations are invoked when set from another thread.
+TEST(ContinuationIntTest, SetValueFromOtherThread) {
+  for (int i = 0; i != 100; ++i) {
+    auto input = std::make_shared<future_shared_state<int>>();
+    std::thread t([input, i] {
+      int value = i;
+      input->set_value(std::move(value));
+    });
+    std::shared_ptr<future_shared_state<int>> output = input->make_continuation(
+        input, [](std::shared_ptr<future_shared_state<int>> state) {
+          return state->get() + 1;
+        });
+    EXPECT_EQ(i + 1, output->get());
+    t.join();
+  }
+}
+
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+/// @test Verify that a failed set_value() does not satisfy the shared state.
+TEST(FutureImplThrowingMove, SetValueThrows) {
+  struct ThrowingMove {
+    ThrowingMove() = default;
+    ThrowingMove(ThrowingMove&&) { throw std::runtime_error("move failed"); }
+  };
+  future_shared_state<ThrowingMove> shared_state;
+  EXPECT_THROW(shared_state.set_value(ThrowingMove{}), std::runtime_error);
+  EXPECT_FALSE(shared_state.is_ready());
+  shared_state.set_exception(
+      std::make_exception_ptr(std::runtime_error("test message")));
+  EXPECT_TRUE(shared_state.is_ready());
+}
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+
 }  // namespace
 }  // namespace internal
 }  // namespace GOOGLE_CLOUD_CPP_NS
@@ -56,6 +56,11 @@ run_example ./storage_throughput_benchmark \
       --object-chunk-count=10 \
       "${FAKE_REGION}"
 
+run_example ./storage_http2_benchmark \
+      --object-count=10 \
+      --request-count=100 \
+      "${FAKE_REGION}"
+
 if [ "${EXIT_STATUS}" = "0" ]; then
   TESTBENCH_DUMP_LOG=no
 fi
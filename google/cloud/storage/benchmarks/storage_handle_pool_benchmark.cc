@@ -0,0 +1,167 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/build_info.h"
+#include "google/cloud/storage/internal/curl_handle_factory.h"
+#include "google/cloud/storage/version.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+/**
+ * @file
+ *
+ * Measure the contention in the pool of CURL handles.
+ *
+ * This program does not contact GCS. Each thread repeatedly takes a handle (and
+ * a multi handle) from a `PooledCurlHandleFactory` and returns it, which is
+ * what every request does. The program reports the average latency for each
+ * create+cleanup cycle, for different numbers of threads, using a pool with a
+ * single shard (all the threads compete for the same mutex) and a pool with
+ * the default number of shards.
+ */
+
+namespace {
+namespace gcs = google::cloud::storage;
+
+struct Options {
+  int maximum_thread_count = 64;
+  int iterations = 100000;
+  std::size_t pool_size = 4 * std::max(1U, std::thread::hardware_concurrency());
+
+  void ParseArgs(int& argc, char* argv[]);
+};
+
+/// Returns the average latency of a create+cleanup cycle in nanoseconds.
+double RunTest(gcs::internal::CurlHandleFactory& factory, int thread_count,
+               int iterations);
+
+}  // namespace
+
+int main(int argc, char* argv[]) try {
+  Options options;
+  options.ParseArgs(argc, argv);
+
+  std::string notes = google::cloud::storage::version_string() + ";" +
+                      google::cloud::internal::compiler() + ";" +
+                      google::cloud::internal::compiler_flags();
+  std::transform(notes.begin(), notes.end(), notes.begin(),
+                 [](char c) { return c == '\n' ? ';' : c; });
+  std::cout << "# Maximum Thread Count: " << options.maximum_thread_count
+            << "\n# Iterations: " << options.iterations
+            << "\n# Pool Size: " << options.pool_size
+            << "\n# Build info: " << notes << std::endl;
+
+  std::cout << "ThreadCount,ShardCount,LatencyNs" << std::endl;
+  for (int thread_count = 1; thread_count <= options.maximum_thread_count;
+       thread_count *= 2) {
+    for (std::size_t shard_count : {std::size_t(1), std::size_t(0)}) {
+      gcs::internal::PooledCurlHandleFactory factory(options.pool_size,
+                                                     shard_count);
+      auto latency = RunTest(factory, thread_count, options.iterations);
+      std::cout << thread_count << "," << factory.shard_count() << ","
+                << std::fixed << std::setprecision(1) << latency << std::endl;
+    }
+  }
+
+  return 0;
+} catch (std::exception const& ex) {
+  std::cerr << "Standard exception raised: " << ex.what() << std::endl;
+  return 1;
+}
+
+namespace {
+double RunTest(gcs::internal::CurlHandleFactory& factory, int thread_count,
+               int iterations) {
+  auto worker = [&factory, iterations] {
+    for (int i = 0; i != iterations; ++i) {
+      auto handle = factory.CreateHandle();
+      auto multi = factory.CreateMultiHandle();
+      factory.CleanupMultiHandle(std::move(multi));
+      factory.CleanupHandle(std::move(handle));
+    }
+  };
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (int i = 0; i != thread_count; ++i) {
+    threads.emplace_back(worker);
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start);
+  // Each thread runs `iterations` cycles, the average latency for each cycle
+  // is the elapsed time divided by the number of cycles per thread.
+  return static_cast<double>(elapsed.count()) / iterations;
+}
+
+void Options::ParseArgs(int& argc, char* argv[]) {
+  std::string const maximum_thread_count = "--maximum-thread-count=";
+  std::string const iterations = "--iterations=";
+  std::string const pool_size = "--pool-size=";
+
+  std::string const usage = R""(
+[options]
+The options are:
+    --help: produce this message.
+    --maximum-thread-count: the test runs with 1, 2, 4, ... up to this many
+        threads.
+    --iterations: the number of create+cleanup cycles in each thread.
+    --pool-size: the maximum number of handles in the pool.
+)"";
+
+  auto parse_positive = [](std::string const& arg, char const* name) {
+    auto val = std::stol(arg);
+    if (val <= 0) {
+      throw std::runtime_error(std::string("Invalid ") + name + " argument (" +
+                               arg + ")");
+    }
+    return val;
+  };
+
+  while (argc >= 2) {
+    std::string argument(argv[1]);
+    std::copy(argv + 2, argv + argc, argv + 1);
+    argc--;
+    if (argument == "--help") {
+      std::ostringstream os;
+      os << "Usage: " << argv[0] << usage << std::endl;
+      throw std::runtime_error(os.str());
+    }
+    if (0 == argument.rfind(maximum_thread_count, 0)) {
+      this->maximum_thread_count = static_cast<int>(parse_positive(
+          argument.substr(maximum_thread_count.size()),
+          "maximum-thread-count"));
+    } else if (0 == argument.rfind(iterations, 0)) {
+      this->iterations = static_cast<int>(
+          parse_positive(argument.substr(iterations.size()), "iterations"));
+    } else if (0 == argument.rfind(pool_size, 0)) {
+      this->pool_size = static_cast<std::size_t>(
+          parse_positive(argument.substr(pool_size.size()), "pool-size"));
+    } else {
+      std::ostringstream os;
+      os << "Unknown argument " << argument << "\nUsage: " << argv[0] << usage
+         << std::endl;
+      throw std::runtime_error(os.str());
+    }
+  }
+}
+
+}  // namespace
@@ -0,0 +1,281 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/build_info.h"
+#include "google/cloud/internal/make_unique.h"
+#include "google/cloud/internal/random.h"
+#include "google/cloud/storage/internal/crc32c.h"
+#include "google/cloud/storage/internal/hash_validator.h"
+#include "google/cloud/storage/version.h"
+#include <crc32c/crc32c.h>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+/**
+ * @file
+ *
+ * Measure the throughput of the hash validators used in uploads and downloads.
+ *
+ * This program does not contact GCS, it feeds a buffer of random data to each
+ * validator, in chunks of the same size used by the client library, and reports
+ * the throughput in GB/s. The results help decide whether it is worthwhile to
+ * disable MD5 hashes, or to compute the hashes in the background.
+ *
+ * It also measures the throughput of computing the CRC32C checksum over
+ * several slices in parallel and combining the results, as is done by
+ * `Client::DownloadToFile()` and `Client::UploadFile()` with parallel
+ * transfers.
+ */
+
+namespace {
+namespace gcs = google::cloud::storage;
+
+constexpr long kMiB = 1024 * 1024;
+constexpr long kDefaultTotalSize = 1024 * kMiB;
+constexpr long kDefaultChunkSize = 2 * kMiB;
+constexpr int kDefaultIterations = 5;
+
+struct Options {
+  long total_size;
+  long chunk_size;
+  int iterations;
+  int thread_count;
+
+  Options()
+      : total_size(kDefaultTotalSize),
+        chunk_size(kDefaultChunkSize),
+        iterations(kDefaultIterations),
+        thread_count(4) {}
+
+  void ParseArgs(int& argc, char* argv[]);
+};
+
+std::string MakeRandomData(std::size_t desired_size);
+
+/// Returns the best throughput, in GB/s, from several runs of @p test.
+double MeasureThroughput(Options const& options, std::function<void()> test);
+
+/// Feeds @p data to @p validator in chunks of `options.chunk_size` bytes.
+void HashData(Options const& options, std::string const& data,
+              gcs::internal::HashValidator& validator);
+
+/// Computes the CRC32C checksum of @p data using several threads.
+std::uint32_t ParallelCrc32c(Options const& options, std::string const& data);
+
+}  // namespace
+
+int main(int argc, char* argv[]) try {
+  Options options;
+  options.ParseArgs(argc, argv);
+
+  std::string notes = google::cloud::storage::version_string() + ";" +
+                      google::cloud::internal::compiler() + ";" +
+                      google::cloud::internal::compiler_flags();
+  std::transform(notes.begin(), notes.end(), notes.begin(),
+                 [](char c) { return c == '\n' ? ';' : c; });
+  std::cout << "# Total Size: " << options.total_size
+            << "\n# Chunk Size: " << options.chunk_size
+            << "\n# Iterations: " << options.iterations
+            << "\n# Thread Count: " << options.thread_count
+            << "\n# Build info: " << notes << std::endl;
+
+  auto const data =
+      MakeRandomData(static_cast<std::size_t>(options.total_size));
+
+  using ValidatorFactory =
+      std::function<std::unique_ptr<gcs::internal::HashValidator>()>;
+  auto crc32c = [] {
+    return google::cloud::internal::make_unique<
+        gcs::internal::Crc32cHashValidator>();
+  };
+  auto md5 = [] {
+    return google::cloud::internal::make_unique<
+        gcs::internal::MD5HashValidator>();
+  };
+  auto background = [](ValidatorFactory const& f) {
+    return [f]() -> std::unique_ptr<gcs::internal::HashValidator> {
+      return google::cloud::internal::make_unique<
+          gcs::internal::BackgroundHashValidator>(f());
+    };
+  };
+  auto composite = [](ValidatorFactory const& l, ValidatorFactory const& r) {
+    return [l, r]() -> std::unique_ptr<gcs::internal::HashValidator> {
+      return google::cloud::internal::make_unique<
+          gcs::internal::CompositeValidator>(l(), r());
+    };
+  };
+
+  std::vector<std::pair<std::string, ValidatorFactory>> validators{
+      {"crc32c", crc32c},
+      {"md5", md5},
+      {"crc32c+md5", composite(crc32c, md5)},
+      {"background-crc32c", background(crc32c)},
+      {"background-md5", background(md5)},
+      {"background-crc32c+md5", composite(background(crc32c), background(md5))},
+  };
+
+  std::cout << "Validator,GB/s" << std::endl;
+  for (auto const& v : validators) {
+    auto throughput = MeasureThroughput(options, [&] {
+      auto validator = v.second();
+      HashData(options, data, *validator);
+      (void)std::move(*validator).Finish();
+    });
+    std::cout << v.first << "," << std::fixed << std::setprecision(3)
+              << throughput << std::endl;
+  }
+
+  std::uint32_t expected = 0;
+  std::uint32_t actual = 0;
+  auto throughput = MeasureThroughput(options, [&] {
+    expected = crc32c::Crc32c(data.data(), data.size());
+  });
+  std::cout << "crc32c-raw," << throughput << std::endl;
+  throughput = MeasureThroughput(
+      options, [&] { actual = ParallelCrc32c(options, data); });
+  std::cout << "crc32c-parallel-combine," << throughput << std::endl;
+  if (expected != actual) {
+    std::cerr << "Mismatched CRC32C values from parallel computation"
+              << std::endl;
+    return 1;
+  }
+
+  return 0;
+} catch (std::exception const& ex) {
+  std::cerr << "Standard exception raised: " << ex.what() << std::endl;
+  return 1;
+}
+
+namespace {
+std::string MakeRandomData(std::size_t desired_size) {
+  auto gen = google::cloud::internal::MakeDefaultPRNG();
+  std::uniform_int_distribution<int> dist(0, 255);
+  // Generating random data byte by byte is slow, repeat a random block.
+  std::string block(kMiB, '\0');
+  std::generate(block.begin(), block.end(),
+                [&] { return static_cast<char>(dist(gen)); });
+  std::string result;
+  result.reserve(desired_size);
+  while (result.size() < desired_size) {
+    auto const n = std::min(block.size(), desired_size - result.size());
+    result.append(block, 0, n);
+  }
+  return result;
+}
+
+double MeasureThroughput(Options const& options, std::function<void()> test) {
+  using std::chrono::duration;
+  duration<double> best(0);
+  for (int i = 0; i != options.iterations; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    test();
+    duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    if (i == 0 or elapsed < best) {
+      best = elapsed;
+    }
+  }
+  return static_cast<double>(options.total_size) / best.count() / 1.0E9;
+}
+
+void HashData(Options const& options, std::string const& data,
+              gcs::internal::HashValidator& validator) {
+  auto const chunk_size = static_cast<std::size_t>(options.chunk_size);
+  for (std::size_t offset = 0; offset < data.size(); offset += chunk_size) {
+    validator.Update(data.data() + offset,
+                     std::min(chunk_size, data.size() - offset));
+  }
+}
+
+std::uint32_t ParallelCrc32c(Options const& options, std::string const& data) {
+  auto const thread_count = static_cast<std::size_t>(options.thread_count);
+  auto const slice_size = (data.size() + thread_count - 1) / thread_count;
+  std::vector<std::future<std::uint32_t>> tasks;
+  for (std::size_t offset = 0; offset < data.size(); offset += slice_size) {
+    auto const size = std::min(slice_size, data.size() - offset);
+    tasks.emplace_back(std::async(std::launch::async, [&data, offset, size] {
+      return crc32c::Crc32c(data.data() + offset, size);
+    }));
+  }
+  std::uint32_t crc = 0;
+  for (std::size_t i = 0; i != tasks.size(); ++i) {
+    auto const size = std::min(slice_size, data.size() - i * slice_size);
+    crc = gcs::internal::Crc32cCombine(crc, tasks[i].get(), size);
+  }
+  return crc;
+}
+
+void Options::ParseArgs(int& argc, char* argv[]) {
+  std::string const total_size = "--total-size=";
+  std::string const chunk_size = "--chunk-size=";
+  std::string const iterations = "--iterations=";
+  std::string const thread_count = "--thread-count=";
+
+  std::string const usage = R""(
+[options]
+The options are:
+    --help: produce this message.
+    --total-size (in MiB): the amount of data hashed in each iteration.
+    --chunk-size (in KiB): the size of each call to HashValidator::Update().
+    --iterations: the number of iterations, the best result is reported.
+    --thread-count: the number of threads for the parallel CRC32C test.
+)"";
+
+  auto parse_positive = [](std::string const& arg, char const* name) {
+    auto val = std::stol(arg);
+    if (val <= 0) {
+      throw std::runtime_error(std::string("Invalid ") + name + " argument (" +
+                               arg + ")");
+    }
+    return val;
+  };
+
+  while (argc >= 2) {
+    std::string argument(argv[1]);
+    std::copy(argv + 2, argv + argc, argv + 1);
+    argc--;
+    if (argument == "--help") {
+      std::ostringstream os;
+      os << "Usage: " << argv[0] << usage << std::endl;
+      throw std::runtime_error(os.str());
+    }
+    if (0 == argument.rfind(total_size, 0)) {
+      this->total_size =
+          parse_positive(argument.substr(total_size.size()), "total-size") *
+          kMiB;
+    } else if (0 == argument.rfind(chunk_size, 0)) {
+      this->chunk_size =
+          parse_positive(argument.substr(chunk_size.size()), "chunk-size") *
+          1024;
+    } else if (0 == argument.rfind(iterations, 0)) {
+      this->iterations = static_cast<int>(
+          parse_positive(argument.substr(iterations.size()), "iterations"));
+    } else if (0 == argument.rfind(thread_count, 0)) {
+      this->thread_count = static_cast<int>(
+          parse_positive(argument.substr(thread_count.size()), "thread-count"));
+    } else {
+      std::ostringstream os;
+      os << "Unknown argument " << argument << "\nUsage: " << argv[0] << usage
+         << std::endl;
+      throw std::runtime_error(os.str());
+    }
+  }
+}
+
+}  // namespace
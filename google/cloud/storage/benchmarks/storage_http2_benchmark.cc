@@ -0,0 +1,306 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/build_info.h"
+#include "google/cloud/internal/getenv.h"
+#include "google/cloud/internal/random.h"
+#include "google/cloud/storage/client.h"
+#include "google/cloud/storage/internal/curl_client.h"
+#include "google/cloud/storage/internal/format_rfc3339.h"
+#include <algorithm>
+#include <condition_variable>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+
+/**
+ * @file
+ *
+ * Compare the latency of concurrent requests over HTTP/1.1 and HTTP/2.
+ *
+ * The program first creates a Bucket and a number of small Objects in it, both
+ * with random names. Then, for each protocol, it creates a new client and
+ * issues a prescribed number of `AsyncGetObjectMetadata()` requests, keeping
+ * at most `--max-in-flight` of them pending at any time. With HTTP/1.1 each
+ * pending request needs its own connection, with HTTP/2 the requests are
+ * multiplexed over a few connections.
+ *
+ * For each protocol the program reports the number of requests, the number of
+ * failures, the p50, p99 and maximum latency (in microseconds), and the
+ * number of connections opened by the client.
+ *
+ * Note that libcurl only negotiates HTTP/2 over TLS, against the (plain HTTP)
+ * testbench both runs use HTTP/1.1.
+ */
+
+namespace {
+namespace gcs = google::cloud::storage;
+
+constexpr long kDefaultObjectCount = 100;
+constexpr long kDefaultRequestCount = 1000;
+constexpr int kDefaultMaxInFlight = 32;
+constexpr long kObjectSize = 1024;
+
+struct Options {
+  std::string region;
+  long object_count = kDefaultObjectCount;
+  long request_count = kDefaultRequestCount;
+  int max_in_flight = kDefaultMaxInFlight;
+
+  void ParseArgs(int& argc, char* argv[]);
+  std::string ConsumeArg(int& argc, char* argv[], char const* arg_name);
+};
+
+std::string MakeRandomBucketName(google::cloud::internal::DefaultPRNG& gen);
+std::string MakeRandomObjectName(google::cloud::internal::DefaultPRNG& gen);
+
+struct TestResult {
+  std::vector<std::chrono::microseconds> latencies;
+  long failures = 0;
+  std::size_t connection_count = 0;
+};
+
+TestResult RunTest(bool enable_http2, std::string const& bucket_name,
+                   Options const& options,
+                   std::vector<std::string> const& object_names);
+void PrintResult(bool enable_http2, TestResult result);
+
+}  // namespace
+
+int main(int argc, char* argv[]) try {
+  Options options;
+  options.ParseArgs(argc, argv);
+
+  if (not google::cloud::internal::GetEnv("GOOGLE_CLOUD_PROJECT").has_value()) {
+    std::cerr << "GOOGLE_CLOUD_PROJECT environment variable must be set"
+              << std::endl;
+    return 1;
+  }
+
+  gcs::Client client;
+
+  google::cloud::internal::DefaultPRNG generator =
+      google::cloud::internal::MakeDefaultPRNG();
+
+  auto bucket_name = MakeRandomBucketName(generator);
+  auto meta =
+      client.CreateBucket(bucket_name,
+                          gcs::BucketMetadata()
+                              .set_storage_class(gcs::storage_class::Regional())
+                              .set_location(options.region),
+                          gcs::PredefinedAcl("private"),
+                          gcs::PredefinedDefaultObjectAcl("projectPrivate"),
+                          gcs::Projection("full"))
+          .value();
+  std::cout << "# Running test on bucket: " << meta.name() << std::endl;
+  std::string notes = google::cloud::storage::version_string() + ";" +
+                      google::cloud::internal::compiler() + ";" +
+                      google::cloud::internal::compiler_flags();
+  std::transform(notes.begin(), notes.end(), notes.begin(),
+                 [](char c) { return c == '\n' ? ';' : c; });
+  std::cout << "# Start time: "
+            << gcs::internal::FormatRfc3339(std::chrono::system_clock::now())
+            << "\n# Region: " << options.region
+            << "\n# Object Count: " << options.object_count
+            << "\n# Request Count: " << options.request_count
+            << "\n# Max In Flight: " << options.max_in_flight
+            << "\n# Build info: " << notes << std::endl;
+
+  std::string const contents =
+      google::cloud::internal::Sample(generator, kObjectSize, "0123456789");
+  std::vector<std::string> object_names;
+  for (long i = 0; i != options.object_count; ++i) {
+    auto name = MakeRandomObjectName(generator);
+    client.InsertObject(bucket_name, name, contents).value();
+    object_names.emplace_back(std::move(name));
+  }
+
+  std::cout << "Protocol,RequestCount,FailureCount,P50Us,P99Us,MaxUs"
+            << ",ConnectionCount" << std::endl;
+  for (bool enable_http2 : {false, true}) {
+    PrintResult(enable_http2,
+                RunTest(enable_http2, bucket_name, options, object_names));
+  }
+
+  std::cout << "# Deleting test objects" << std::endl;
+  for (auto const& name : object_names) {
+    client.DeleteObject(bucket_name, name);
+  }
+  std::cout << "# Deleting " << bucket_name << std::endl;
+  client.DeleteBucket(bucket_name);
+
+  return 0;
+} catch (std::exception const& ex) {
+  std::cerr << "Standard exception raised: " << ex.what() << std::endl;
+  return 1;
+}
+
+namespace {
+std::string Basename(std::string const& path) {
+  // Sure would be nice to be using C++17 where std::filesytem is a thing.
+#if _WIN32
+  return path.substr(path.find_last_of('\\') + 1);
+#else
+  return path.substr(path.find_last_of('/') + 1);
+#endif  // _WIN32
+}
+
+std::string MakeRandomBucketName(google::cloud::internal::DefaultPRNG& gen) {
+  // The total length of this bucket name must be <= 63 characters,
+  static std::string const prefix = "gcs-cpp-http2-";
+  static std::size_t const kMaxBucketNameLength = 63;
+  std::size_t const max_random_characters =
+      kMaxBucketNameLength - prefix.size();
+  return prefix + google::cloud::internal::Sample(
+                      gen, static_cast<int>(max_random_characters),
+                      "abcdefghijklmnopqrstuvwxyz012456789");
+}
+
+std::string MakeRandomObjectName(google::cloud::internal::DefaultPRNG& gen) {
+  return google::cloud::internal::Sample(gen, 128,
+                                         "abcdefghijklmnopqrstuvwxyz"
+                                         "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                                         "0123456789");
+}
+
+TestResult RunTest(bool enable_http2, std::string const& bucket_name,
+                   Options const& options,
+                   std::vector<std::string> const& object_names) {
+  // Use a new client for each protocol, so the connection counts do not mix.
+  auto curl = gcs::internal::CurlClient::Create(
+      gcs::ClientOptions().set_enable_http2(enable_http2));
+  gcs::Client client(curl);
+
+  std::mutex mu;
+  std::condition_variable cv;
+  int in_flight = 0;
+  TestResult result;
+  result.latencies.reserve(static_cast<std::size_t>(options.request_count));
+
+  for (long i = 0; i != options.request_count; ++i) {
+    auto const& object_name = object_names[i % object_names.size()];
+    {
+      std::unique_lock<std::mutex> lk(mu);
+      cv.wait(lk, [&] { return in_flight < options.max_in_flight; });
+      ++in_flight;
+    }
+    auto start = std::chrono::steady_clock::now();
+    client.AsyncGetObjectMetadata(bucket_name, object_name)
+        .then([&, start](google::cloud::future<
+                         google::cloud::StatusOr<gcs::ObjectMetadata>>
+                             f) {
+          auto metadata = f.get();
+          auto elapsed = std::chrono::steady_clock::now() - start;
+          // Notify while holding the lock, once it is released the waiting
+          // thread may return and destroy `mu` and `cv`.
+          std::lock_guard<std::mutex> lk(mu);
+          result.latencies.push_back(
+              std::chrono::duration_cast<std::chrono::microseconds>(elapsed));
+          if (not metadata) {
+            ++result.failures;
+          }
+          --in_flight;
+          cv.notify_all();
+        });
+  }
+  {
+    std::unique_lock<std::mutex> lk(mu);
+    cv.wait(lk, [&] { return in_flight == 0; });
+  }
+  result.connection_count = curl->EventLoopConnectionCount();
+  return result;
+}
+
+void PrintResult(bool enable_http2, TestResult result) {
+  auto& latencies = result.latencies;
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&latencies](int p) -> long {
+    if (latencies.empty()) {
+      return 0;
+    }
+    auto index = (latencies.size() - 1) * p / 100;
+    return static_cast<long>(latencies[index].count());
+  };
+  std::cout << (enable_http2 ? "HTTP/2" : "HTTP/1.1") << ","
+            << latencies.size() << "," << result.failures << ","
+            << percentile(50) << "," << percentile(99) << ","
+            << percentile(100) << "," << result.connection_count << std::endl;
+}
+
+void Options::ParseArgs(int& argc, char* argv[]) {
+  region = ConsumeArg(argc, argv, "region");
+}
+
+std::string Options::ConsumeArg(int& argc, char* argv[], char const* arg_name) {
+  std::string const object_count = "--object-count=";
+  std::string const request_count = "--request-count=";
+  std::string const max_in_flight = "--max-in-flight=";
+
+  std::string const usage = R""(
+[options] <region>
+The options are:
+    --help: produce this message.
+    --object-count: the number of objects to use in the benchmark.
+    --request-count: the number of requests issued with each protocol.
+    --max-in-flight: the maximum number of pending requests.
+
+    region: a Google Cloud Storage region where all the objects used in this
+       test will be located.
+)"";
+
+  std::string error;
+  while (argc >= 2) {
+    std::string argument(argv[1]);
+    std::copy(argv + 2, argv + argc, argv + 1);
+    argc--;
+    if (argument == "--help") {
+    } else if (0 == argument.rfind(object_count, 0)) {
+      auto arg = argument.substr(object_count.size());
+      auto val = std::stol(arg);
+      if (val <= 0) {
+        error = "Invalid object-count argument (" + arg + ")";
+        break;
+      }
+      this->object_count = val;
+    } else if (0 == argument.rfind(request_count, 0)) {
+      auto arg = argument.substr(request_count.size());
+      auto val = std::stol(arg);
+      if (val <= 0) {
+        error = "Invalid request-count argument (" + arg + ")";
+        break;
+      }
+      this->request_count = val;
+    } else if (0 == argument.rfind(max_in_flight, 0)) {
+      auto arg = argument.substr(max_in_flight.size());
+      auto val = std::stoi(arg);
+      if (val <= 0) {
+        error = "Invalid max-in-flight argument (" + arg + ")";
+        break;
+      }
+      this->max_in_flight = val;
+    } else {
+      return argument;
+    }
+  }
+  std::ostringstream os;
+  if (not error.empty()) {
+    os << error << "\n";
+  } else {
+    os << "Missing argument " << arg_name << "\n";
+  }
+  os << "Usage: " << Basename(argv[0]) << usage << std::endl;
+  throw std::runtime_error(os.str());
+}
+
+}  // namespace
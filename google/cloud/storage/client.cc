@@ -14,14 +14,28 @@
 
 #include "google/cloud/storage/client.h"
 #include "google/cloud/internal/filesystem.h"
+#include "google/cloud/internal/random.h"
 #include "google/cloud/log.h"
+#include "google/cloud/storage/internal/crc32c.h"
 #include "google/cloud/storage/internal/curl_client.h"
 #include "google/cloud/storage/internal/curl_handle.h"
 #include "google/cloud/storage/internal/openssl_util.h"
 #include "google/cloud/storage/oauth2/service_account_credentials.h"
+#include <crc32c/crc32c.h>
 #include <openssl/md5.h>
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
 #include <fstream>
+#include <future>
+#include <mutex>
 #include <thread>
+#include <vector>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif  // _WIN32
 
 namespace google {
 namespace cloud {
@@ -32,6 +46,272 @@ static_assert(std::is_copy_constructible<storage::Client>::value,
 static_assert(std::is_copy_assignable<storage::Client>::value,
               "storage::Client must be assignable");
 
+namespace {
+/// The maximum number of source objects in a single `ComposeObject()` call.
+std::size_t const kMaximumComposeSources = 32;
+
+struct PartUploadResult {
+  ObjectMetadata metadata;
+  std::uint32_t crc32c;
+  std::int64_t size;
+};
+
+/**
+ * Uploads the [offset, offset + size) portion of a file to a new object.
+ *
+ * The data is uploaded using a resumable session, so a part can be larger than
+ * any single buffer. The CRC32C checksum of the part is computed as the data
+ * is read, and compared against the value reported by the service.
+ */
+StatusOr<PartUploadResult> UploadPart(
+    std::shared_ptr<internal::RawClient> const& client,
+    internal::ResumableUploadRequest const& request,
+    std::string const& file_name, std::int64_t offset, std::int64_t size) {
+  std::ifstream source(file_name, std::ios::binary);
+  if (not source.is_open()) {
+    return Status(StatusCode::kNotFound,
+                  "cannot open source file " + file_name);
+  }
+  auto session = client->CreateResumableSession(request);
+  if (not session.ok()) {
+    return std::move(session).status();
+  }
+
+  // GCS requires chunks to be a multiple of 256KiB.
+  auto const chunk_size = internal::UploadChunkRequest::RoundUpToQuantum(
+      client->client_options().upload_buffer_size());
+  auto const upload_size = static_cast<std::uint64_t>(size);
+  std::string buffer;
+  std::uint32_t crc32c = 0;
+  // The number of bytes included in `crc32c`. If the service asks us to resend
+  // some data we do not want to include it in the checksum twice.
+  std::uint64_t hashed_size = 0;
+  StatusOr<internal::ResumableUploadResponse> response(
+      internal::ResumableUploadResponse{});
+  while (response->payload.empty()) {
+    auto const position = (*session)->next_expected_byte();
+    auto const n = std::min(static_cast<std::uint64_t>(chunk_size),
+                             upload_size - position);
+    buffer.resize(static_cast<std::size_t>(n));
+    source.seekg(offset + static_cast<std::int64_t>(position), std::ios::beg);
+    source.read(&buffer[0], buffer.size());
+    if (static_cast<std::uint64_t>(source.gcount()) != n) {
+      return Status(StatusCode::kUnknown,
+                    "short read from source file " + file_name);
+    }
+    if (position + n > hashed_size) {
+      auto const skip = static_cast<std::size_t>(hashed_size - position);
+      crc32c = crc32c::Extend(
+          crc32c, reinterpret_cast<std::uint8_t const*>(buffer.data()) + skip,
+          buffer.size() - skip);
+      hashed_size = position + n;
+    }
+    response = (*session)->UploadChunk(buffer, upload_size);
+    if (not response.ok()) {
+      return std::move(response).status();
+    }
+  }
+
+  auto metadata = ObjectMetadata::ParseFromString(response->payload);
+  if (not metadata.ok()) {
+    return std::move(metadata).status();
+  }
+  auto computed = internal::Crc32cToBase64(crc32c);
+  if (not metadata->crc32c().empty() and metadata->crc32c() != computed) {
+    return Status(StatusCode::kDataLoss,
+                  "mismatched checksums in part " + request.object_name() +
+                      ", computed=" + computed +
+                      ", received=" + metadata->crc32c());
+  }
+  return PartUploadResult{*std::move(metadata), crc32c, size};
+}
+
+/// Reads up to @p chunk_size bytes from @p source into @p buffer.
+void ReadChunk(std::istream& source, std::string& buffer,
+               std::size_t chunk_size) {
+  buffer.resize(chunk_size);
+  source.read(&buffer[0], buffer.size());
+  buffer.resize(static_cast<std::size_t>(source.gcount()));
+}
+
+/**
+ * Reads chunks from a stream in a background thread.
+ *
+ * `Client::UploadStreamResumable()` reads the next chunk while the current one
+ * is sent to the service. A single thread does all the reads for the upload,
+ * each `Start()` call hands it the buffer to fill.
+ */
+class ChunkReader {
+ public:
+  ChunkReader(std::istream& source, std::size_t chunk_size)
+      : source_(source), chunk_size_(chunk_size), thread_([this] { Run(); }) {}
+
+  ~ChunkReader() {
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      shutdown_ = true;
+    }
+    cv_.notify_all();
+    thread_.join();
+  }
+
+  /// Start reading the next chunk into @p buffer.
+  void Start(std::string& buffer) {
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      buffer_ = &buffer;
+    }
+    cv_.notify_all();
+  }
+
+  /// Block until the read started by the last `Start()` call completes.
+  void Wait() {
+    std::unique_lock<std::mutex> lk(mu_);
+    cv_.wait(lk, [this] { return buffer_ == nullptr; });
+  }
+
+ private:
+  void Run() {
+    std::unique_lock<std::mutex> lk(mu_);
+    while (true) {
+      cv_.wait(lk, [this] { return shutdown_ or buffer_ != nullptr; });
+      if (buffer_ == nullptr) {
+        return;
+      }
+      // Do not hold the lock while reading, the reads may be slow.
+      auto* buffer = buffer_;
+      lk.unlock();
+      ReadChunk(source_, *buffer, chunk_size_);
+      lk.lock();
+      buffer_ = nullptr;
+      cv_.notify_all();
+    }
+  }
+
+  std::istream& source_;
+  std::size_t const chunk_size_;
+  std::mutex mu_;
+  std::condition_variable cv_;
+  std::string* buffer_ = nullptr;
+  bool shutdown_ = false;
+  // Declared last, the thread uses all the other members.
+  std::thread thread_;
+};
+
+/// Deletes the temporary objects created by `Client::UploadFileParallel()`.
+void DeleteTemporaryObjects(internal::RawClient& client,
+                            internal::ResumableUploadRequest const& request,
+                            std::vector<ComposeSourceObject> const& objects) {
+  for (auto const& object : objects) {
+    internal::DeleteObjectRequest delete_request(request.bucket_name(),
+                                                 object.object_name);
+    delete_request.set_multiple_options(Generation(*object.generation),
+                                        request.GetOption<UserProject>());
+    auto response = client.DeleteObject(delete_request);
+    if (not response.ok()) {
+      GCP_LOG(WARNING) << "Cannot delete temporary object "
+                       << object.object_name << " in bucket "
+                       << request.bucket_name()
+                       << ", status=" << response.status();
+    }
+  }
+}
+
+#ifndef _WIN32
+/// The number of times each slice is attempted by `DownloadFileParallel()`.
+int const kMaximumSliceAttempts = 3;
+
+struct SliceResult {
+  Status status;
+  std::uint32_t crc32c;
+  std::int64_t size;
+};
+
+Status ErrnoToStatus(char const* where) {
+  std::string msg = where;
+  msg += "() failed: ";
+  msg += std::strerror(errno);
+  return Status(StatusCode::kUnknown, std::move(msg));
+}
+
+/// Writes all the bytes in [data, data + size) at @p offset in @p fd.
+Status WriteAt(int fd, char const* data, std::size_t size,
+               std::int64_t offset) {
+  while (size != 0) {
+    auto n = ::pwrite(fd, data, size, static_cast<off_t>(offset));
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return ErrnoToStatus("pwrite");
+    }
+    data += n;
+    size -= static_cast<std::size_t>(n);
+    offset += n;
+  }
+  return Status();
+}
+
+/**
+ * Downloads the [begin, end) range of an object into @p fd.
+ *
+ * The data is written at `offset - file_begin` in the file. If the download
+ * stream fails before reaching @p end the slice is resumed, with a new range
+ * request, from the last byte received.
+ */
+SliceResult DownloadSlice(std::shared_ptr<internal::RawClient> const& client,
+                          internal::ReadObjectRangeRequest request, int fd,
+                          std::int64_t file_begin, std::int64_t begin,
+                          std::int64_t end, std::size_t buffer_size) {
+  SliceResult result{Status(), 0, end - begin};
+  std::vector<char> buffer(buffer_size);
+  std::int64_t offset = begin;
+  for (int attempt = 0; attempt != kMaximumSliceAttempts and offset < end;
+       ++attempt) {
+    request.set_option(ReadRange(offset, end));
+    auto streambuf = client->ReadObject(request);
+    if (not streambuf.ok()) {
+      // The client already retried this operation, as configured by the retry
+      // policy, do not retry it again.
+      result.status = std::move(streambuf).status();
+      return result;
+    }
+    ObjectReadStream stream(std::move(*streambuf));
+    while (offset < end and stream.good()) {
+      auto const n = std::min(static_cast<std::int64_t>(buffer.size()),
+                              end - offset);
+      stream.read(buffer.data(), n);
+      auto const count = static_cast<std::size_t>(stream.gcount());
+      auto status = WriteAt(fd, buffer.data(), count, offset - file_begin);
+      if (not status.ok()) {
+        result.status = std::move(status);
+        return result;
+      }
+      result.crc32c = crc32c::Extend(
+          result.crc32c, reinterpret_cast<std::uint8_t const*>(buffer.data()),
+          count);
+      offset += static_cast<std::int64_t>(count);
+    }
+    if (offset >= end) {
+      break;
+    }
+    result.status = stream.status();
+    if (result.status.ok()) {
+      result.status = Status(StatusCode::kUnavailable,
+                             "download stream ended before the slice end");
+    }
+    GCP_LOG(INFO) << __func__ << "() slice [" << begin << ", " << end
+                  << ") interrupted at " << offset
+                  << ", status=" << result.status;
+  }
+  if (offset >= end) {
+    result.status = Status();
+  }
+  return result;
+}
+#endif  // _WIN32
+}  // namespace
+
 std::shared_ptr<internal::RawClient> Client::CreateDefaultClient(
     ClientOptions options) {
   return internal::CurlClient::Create(std::move(options));
@@ -92,6 +372,16 @@ integrity checks using the DisableMD5Hash() and DisableCrc32cChecksum() options.
   // class checks before calling it.
   std::uint64_t source_size = google::cloud::internal::file_size(file_name);
 
+  bool const restore_session =
+      request.HasOption<UseResumableUploadSession>() and
+      not request.GetOption<UseResumableUploadSession>().value().empty();
+  if (is_regular(status) and not restore_session and
+      request.HasOption<ParallelUpload>() and
+      request.GetOption<ParallelUpload>().value().stream_count > 1) {
+    source.close();
+    return UploadFileParallel(file_name, source_size, request).value();
+  }
+
   return UploadStreamResumable(source, source_size, request).value();
 }
 
@@ -110,32 +400,61 @@ StatusOr<ObjectMetadata> Client::UploadStreamResumable(
   auto chunk_size = internal::UploadChunkRequest::RoundUpToQuantum(
       raw_client()->client_options().upload_buffer_size());
 
+  // The upload is pipelined: while one buffer is sent to the service the next
+  // one is read from `source` in a separate thread. The two buffers and the
+  // thread are reused for the whole upload.
+  std::string buffer;
+  std::string next_buffer;
+  buffer.reserve(chunk_size);
+  next_buffer.reserve(chunk_size);
+  // Declared after the buffers, the thread must stop before they are deleted.
+  ChunkReader reader(source, chunk_size);
+
+  // A restored session may have committed some data already.
+  auto position = session->next_expected_byte();
+  if (position != 0) {
+    source.seekg(position, std::ios::beg);
+  }
+  ReadChunk(source, buffer, chunk_size);
+
   StatusOr<internal::ResumableUploadResponse> upload_response(
       internal::ResumableUploadResponse{});
-  // We iterate while `source` is good and the retry policy has not been
-  // exhausted.
-  while (not source.eof() and upload_response.ok() and
-         upload_response->payload.empty()) {
-    // Read a chunk of data from the source file.
-    std::string buffer(chunk_size, '\0');
-    source.read(&buffer[0], buffer.size());
-    auto gcount = static_cast<std::size_t>(source.gcount());
-    if (gcount < buffer.size()) {
-      source_size = session->next_expected_byte() + gcount;
+  // We iterate while the retry policy has not been exhausted and the service
+  // has not returned the object metadata.
+  while (upload_response.ok() and upload_response->payload.empty()) {
+    bool const last_chunk = buffer.size() < chunk_size;
+    if (last_chunk) {
+      source_size = position + buffer.size();
+    }
+    if (not last_chunk) {
+      reader.Start(next_buffer);
     }
-    buffer.resize(gcount);
 
-    auto expected = session->next_expected_byte() + gcount - 1;
+    auto expected = position + buffer.size();
     upload_response = session->UploadChunk(buffer, source_size);
-    if (not upload_response.ok()) {
-      return std::move(upload_response).status();
+    if (not last_chunk) {
+      reader.Wait();
+    }
+    if (not upload_response.ok() or not upload_response->payload.empty()) {
+      break;
     }
-    if (session->next_expected_byte() != expected) {
-      GCP_LOG(WARNING) << "unexpected last committed byte "
-                       << " expected=" << expected
-                       << " got=" << session->next_expected_byte();
-      source.seekg(session->next_expected_byte(), std::ios::beg);
+    position = session->next_expected_byte();
+    if (position == expected) {
+      if (last_chunk) {
+        // The service did not return the object metadata after receiving all
+        // the data, ParseFromString() reports the error below.
+        break;
+      }
+      buffer.swap(next_buffer);
+      continue;
     }
+    // The service did not commit all the data, discard the prefetched buffer
+    // and send the data again starting at the first uncommitted byte.
+    GCP_LOG(WARNING) << "unexpected last committed byte "
+                     << " expected=" << expected << " got=" << position;
+    source.clear();
+    source.seekg(position, std::ios::beg);
+    ReadChunk(source, buffer, chunk_size);
   }
 
   if (not upload_response.ok()) {
@@ -145,8 +464,180 @@ StatusOr<ObjectMetadata> Client::UploadStreamResumable(
   return ObjectMetadata::ParseFromString(upload_response->payload);
 }
 
+StatusOr<ObjectMetadata> Client::UploadFileParallel(
+    std::string const& file_name, std::uint64_t file_size,
+    internal::ResumableUploadRequest const& request) {
+  auto const options = request.GetOption<ParallelUpload>().value();
+  auto const size = static_cast<std::int64_t>(file_size);
+  auto const minimum_part_size =
+      std::max(options.minimum_part_size, std::int64_t(1));
+  auto const part_count = std::max(
+      std::int64_t(1),
+      std::min(std::int64_t(options.stream_count),
+               (size + minimum_part_size - 1) / minimum_part_size));
+  // Composite objects do not have an MD5 hash, and ComposeObject() does not
+  // support the `*NotMatch` pre-conditions, use a single stream to honor them.
+  if (part_count == 1 or request.HasOption<MD5HashValue>() or
+      request.HasOption<IfGenerationNotMatch>() or
+      request.HasOption<IfMetagenerationNotMatch>()) {
+    auto single_stream = request;
+    single_stream.set_option(ParallelUpload());
+    std::ifstream source(file_name, std::ios::binary);
+    return UploadStreamResumable(source, file_size, single_stream);
+  }
+  auto const part_size = (size + part_count - 1) / part_count;
+
+  // The temporary objects are named after the destination, with a random
+  // component to avoid collisions with concurrent uploads.
+  auto generator = google::cloud::internal::MakeDefaultPRNG();
+  auto const prefix =
+      request.object_name() + ".upload-" +
+      google::cloud::internal::Sample(generator, 16,
+                                      "abcdefghijklmnopqrstuvwxyz0123456789");
+
+  std::vector<std::future<StatusOr<PartUploadResult>>> parts;
+  for (std::int64_t offset = 0; offset < size; offset += part_size) {
+    internal::ResumableUploadRequest part_request(
+        request.bucket_name(),
+        prefix + "-part-" + std::to_string(parts.size()));
+    part_request.set_multiple_options(
+        IfGenerationMatch(0), request.GetOption<EncryptionKey>(),
+        request.GetOption<KmsKeyName>(), request.GetOption<UserProject>());
+    parts.emplace_back(std::async(std::launch::async, &UploadPart, raw_client_,
+                                  std::move(part_request), file_name, offset,
+                                  std::min(part_size, size - offset)));
+  }
+
+  Status status;
+  std::uint32_t crc32c = 0;
+  std::vector<ComposeSourceObject> sources;
+  for (auto& part : parts) {
+    auto result = part.get();
+    if (not result.ok()) {
+      if (status.ok()) {
+        status = std::move(result).status();
+      }
+      continue;
+    }
+    sources.emplace_back(ComposeSourceObject{
+        result->metadata.name(),
+        google::cloud::optional<long>(result->metadata.generation()), {}});
+    crc32c = internal::Crc32cCombine(crc32c, result->crc32c,
+                                     static_cast<std::uint64_t>(result->size));
+  }
+  // Every object created along the way is deleted once the upload completes.
+  auto temporary_objects = sources;
+  if (not status.ok()) {
+    DeleteTemporaryObjects(*raw_client_, request, temporary_objects);
+    return status;
+  }
+  auto computed = internal::Crc32cToBase64(crc32c);
+  // The application provided the checksum for the full file, verify it before
+  // creating the destination object.
+  if (request.HasOption<Crc32cChecksumValue>() and
+      request.GetOption<Crc32cChecksumValue>().value() != computed) {
+    DeleteTemporaryObjects(*raw_client_, request, temporary_objects);
+    return Status(StatusCode::kDataLoss,
+                  std::string(__func__) + "() - mismatched checksums in " +
+                      request.object_name() + ", computed=" + computed +
+                      ", expected=" +
+                      request.GetOption<Crc32cChecksumValue>().value());
+  }
+
+  // A single ComposeObject() call accepts at most kMaximumComposeSources
+  // objects. With more parts, compose them in a tree: each level combines
+  // groups of parts into new temporary objects, until the remaining objects
+  // can be composed into the destination.
+  for (int level = 0; sources.size() > kMaximumComposeSources; ++level) {
+    std::vector<std::future<StatusOr<ObjectMetadata>>> composes;
+    for (std::size_t i = 0; i < sources.size(); i += kMaximumComposeSources) {
+      auto const end = std::min(sources.size(), i + kMaximumComposeSources);
+      internal::ComposeObjectRequest compose_request(
+          request.bucket_name(),
+          std::vector<ComposeSourceObject>(sources.begin() + i,
+                                           sources.begin() + end),
+          prefix + "-compose-" + std::to_string(level) + "-" +
+              std::to_string(composes.size()));
+      compose_request.set_multiple_options(
+          IfGenerationMatch(0), request.GetOption<EncryptionKey>(),
+          request.GetOption<KmsKeyName>(), request.GetOption<UserProject>());
+      composes.emplace_back(
+          std::async(std::launch::async, [this, compose_request] {
+            return raw_client_->ComposeObject(compose_request);
+          }));
+    }
+    std::vector<ComposeSourceObject> next;
+    for (auto& compose : composes) {
+      auto result = compose.get();
+      if (not result.ok()) {
+        if (status.ok()) {
+          status = std::move(result).status();
+        }
+        continue;
+      }
+      next.emplace_back(ComposeSourceObject{
+          result->name(), google::cloud::optional<long>(result->generation()),
+          {}});
+      temporary_objects.push_back(next.back());
+    }
+    if (not status.ok()) {
+      DeleteTemporaryObjects(*raw_client_, request, temporary_objects);
+      return status;
+    }
+    sources = std::move(next);
+  }
+
+  // The destination object gets the metadata, ACLs, and pre-conditions in the
+  // original request.
+  ObjectMetadata destination;
+  if (request.HasOption<WithObjectMetadata>()) {
+    destination = request.GetOption<WithObjectMetadata>().value();
+  }
+  if (request.HasOption<ContentType>()) {
+    destination.set_content_type(request.GetOption<ContentType>().value());
+  }
+  if (request.HasOption<ContentEncoding>()) {
+    destination.set_content_encoding(
+        request.GetOption<ContentEncoding>().value());
+  }
+  internal::ComposeObjectRequest compose_request(
+      request.bucket_name(), std::move(sources), request.object_name());
+  compose_request.set_multiple_options(
+      request.GetOption<EncryptionKey>(), request.GetOption<KmsKeyName>(),
+      request.GetOption<IfGenerationMatch>(),
+      request.GetOption<IfMetagenerationMatch>(),
+      request.GetOption<UserProject>(), WithObjectMetadata(destination));
+  if (request.HasOption<PredefinedAcl>()) {
+    compose_request.set_option(
+        DestinationPredefinedAcl(request.GetOption<PredefinedAcl>().value()));
+  }
+  auto result = raw_client_->ComposeObject(compose_request);
+  DeleteTemporaryObjects(*raw_client_, request, temporary_objects);
+  if (not result.ok()) {
+    return result;
+  }
+
+  bool const disable_crc32c =
+      request.HasOption<DisableCrc32cChecksum>() and
+      request.GetOption<DisableCrc32cChecksum>().value();
+  if (not disable_crc32c and not result->crc32c().empty() and
+      result->crc32c() != computed) {
+    return Status(StatusCode::kDataLoss,
+                  std::string(__func__) + "() - mismatched checksums in " +
+                      request.object_name() + ", computed=" + computed +
+                      ", received=" + result->crc32c());
+  }
+  return result;
+}
+
 void Client::DownloadFileImpl(internal::ReadObjectRangeRequest const& request,
                               std::string const& file_name) {
+  if (request.HasOption<ParallelDownload>() and
+      request.GetOption<ParallelDownload>().value().stream_count > 1) {
+    DownloadFileParallel(request, file_name);
+    return;
+  }
+
   // TODO(#1665) - use Status to report errors.
   std::unique_ptr<internal::ObjectReadStreambuf> streambuf =
       raw_client_->ReadObject(request).value();
@@ -184,6 +675,116 @@ void Client::DownloadFileImpl(internal::ReadObjectRangeRequest const& request,
   }
 }
 
+void Client::DownloadFileParallel(
+    internal::ReadObjectRangeRequest const& request,
+    std::string const& file_name) {
+#if _WIN32
+  // pwrite() is not available, fallback to a single stream.
+  auto single_stream = request;
+  single_stream.set_option(ParallelDownload());
+  DownloadFileImpl(single_stream, file_name);
+#else
+  auto report_error = [&](char const* func, char const* what,
+                          Status const& status) {
+    std::ostringstream msg;
+    msg << func << "(" << request << ", " << file_name << "): " << what
+        << " - status=" << status;
+    google::cloud::internal::ThrowRuntimeError(std::move(msg).str());
+  };
+
+  // Fetch the object size, and pin the generation so all the slices read the
+  // same data.
+  internal::GetObjectMetadataRequest metadata_request(request.bucket_name(),
+                                                      request.object_name());
+  metadata_request.set_multiple_options(
+      request.GetOption<Generation>(), request.GetOption<IfGenerationMatch>(),
+      request.GetOption<IfGenerationNotMatch>(),
+      request.GetOption<IfMetagenerationMatch>(),
+      request.GetOption<IfMetagenerationNotMatch>(),
+      request.GetOption<UserProject>());
+  auto metadata = raw_client_->GetObjectMetadata(metadata_request);
+  if (not metadata.ok()) {
+    report_error(__func__, "cannot get object metadata", metadata.status());
+  }
+  auto const object_size = static_cast<std::int64_t>(metadata->size());
+  std::int64_t begin = 0;
+  std::int64_t end = object_size;
+  if (request.HasOption<ReadRange>()) {
+    auto const& range = request.GetOption<ReadRange>().value();
+    begin = std::min(range.begin, object_size);
+    end = std::max(begin, std::min(range.end, object_size));
+  }
+
+  // Open the destination file and preallocate it, so each slice can write at
+  // its own offset.
+  int fd = ::open(file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+  if (fd < 0) {
+    report_error(__func__, "cannot open destination file",
+                 ErrnoToStatus("open"));
+  }
+  if (::ftruncate(fd, static_cast<off_t>(end - begin)) != 0) {
+    auto status = ErrnoToStatus("ftruncate");
+    (void)::close(fd);
+    report_error(__func__, "cannot preallocate destination file", status);
+  }
+
+  auto const options = request.GetOption<ParallelDownload>().value();
+  auto const minimum_slice_size =
+      std::max(options.minimum_slice_size, std::int64_t(1));
+  auto const slice_count =
+      std::max(std::int64_t(1),
+               std::min(std::int64_t(options.stream_count),
+                        (end - begin + minimum_slice_size - 1) /
+                            minimum_slice_size));
+  auto const slice_size = (end - begin + slice_count - 1) / slice_count;
+
+  auto slice_request = request;
+  slice_request.set_multiple_options(Generation(metadata->generation()),
+                                     ParallelDownload());
+  auto const buffer_size = raw_client_->client_options().download_buffer_size();
+  std::vector<std::future<SliceResult>> slices;
+  for (auto offset = begin; offset < end; offset += slice_size) {
+    slices.emplace_back(std::async(
+        std::launch::async, &DownloadSlice, raw_client_, slice_request, fd,
+        begin, offset, std::min(end, offset + slice_size), buffer_size));
+  }
+
+  // Wait for all the slices (they use `fd`), and combine their checksums.
+  Status status;
+  std::uint32_t crc32c = 0;
+  for (auto& slice : slices) {
+    auto result = slice.get();
+    if (status.ok()) {
+      status = std::move(result.status);
+    }
+    crc32c = internal::Crc32cCombine(crc32c, result.crc32c,
+                                     static_cast<std::uint64_t>(result.size));
+  }
+  if (::close(fd) != 0 and status.ok()) {
+    status = ErrnoToStatus("close");
+  }
+  if (not status.ok()) {
+    report_error(__func__, "error in download stream", status);
+  }
+
+  // The checksum can only be verified if we downloaded the full object.
+  bool const disable_crc32c =
+      request.HasOption<DisableCrc32cChecksum>() and
+      request.GetOption<DisableCrc32cChecksum>().value();
+  if (disable_crc32c or begin != 0 or end != object_size or
+      metadata->crc32c().empty()) {
+    return;
+  }
+  auto computed = internal::Crc32cToBase64(crc32c);
+  if (computed != metadata->crc32c()) {
+    report_error(__func__, "mismatched checksums in download",
+                 Status(StatusCode::kDataLoss,
+                        "computed=" + computed +
+                            ", received=" + metadata->crc32c()));
+  }
+#endif  // _WIN32
+}
+
 std::string Client::SignUrl(internal::SignUrlRequest const& request) {
   auto base_credentials = raw_client()->client_options().credentials();
   auto credentials = dynamic_cast<oauth2::ServiceAccountCredentials<>*>(
@@ -674,6 +674,42 @@ class Client {
     return raw_client_->InsertObjectMedia(request);
   }
 
+  /**
+   * Creates an object given its name and media (contents), asynchronously.
+   *
+   * The transfer runs in a background thread owned by the client, see
+   * `ClientOptions::event_loop_thread_count()`. Retries, if any, are scheduled
+   * in that thread too, the function returns immediately.
+   *
+   * @param bucket_name the name of the bucket that will contain the object.
+   * @param object_name the name of the object to be created.
+   * @param contents the contents (media) for the new object.
+   * @param options a list of optional query parameters and/or request headers.
+   *     Valid types for this operation include `ContentEncoding`,
+   *     `ContentType`, `Crc32cChecksumValue`, `DisableCrc32cChecksum`,
+   *     `DisableMD5Hash`, `EncryptionKey`, `IfGenerationMatch`,
+   *     `IfGenerationNotMatch`, `IfMetagenerationMatch`,
+   *     `IfMetagenerationNotMatch`, `KmsKeyName`, `MD5HashValue`,
+   *     `PredefinedAcl`, `Projection`, `UserProject`, and `WithObjectMetadata`.
+   *
+   * @return a future satisfied with the metadata of the new object, or the
+   *     error. Continuations attached to the future run in the background
+   *     thread, they should not block.
+   *
+   * @par Idempotency
+   * This operation is only idempotent if restricted by pre-conditions, in this
+   * case, `IfGenerationMatch`.
+   */
+  template <typename... Options>
+  future<StatusOr<ObjectMetadata>> AsyncInsertObject(
+      std::string const& bucket_name, std::string const& object_name,
+      std::string contents, Options&&... options) {
+    internal::InsertObjectMediaRequest request(bucket_name, object_name,
+                                               std::move(contents));
+    request.set_multiple_options(std::forward<Options>(options)...);
+    return raw_client_->AsyncInsertObjectMedia(request);
+  }
+
   /**
    * Copies an existing object.
    *
@@ -759,6 +795,32 @@ class Client {
     return raw_client_->GetObjectMetadata(request).value();
   }
 
+  /**
+   * Fetches the object metadata asynchronously.
+   *
+   * @param bucket_name the bucket containing the object.
+   * @param object_name the object name.
+   * @param options a list of optional query parameters and/or request headers.
+   *     Valid types for this operation include `Generation`,
+   *     `IfGenerationMatch`, `IfGenerationNotMatch`, `IfMetagenerationMatch`,
+   *     `IfMetagenerationNotMatch`, `Projection`, and `UserProject`.
+   *
+   * @return a future satisfied with the object metadata, or the error.
+   *     Continuations attached to the future run in the background thread
+   *     that completes the request, they should not block.
+   *
+   * @par Idempotency
+   * This is a read-only operation and is always idempotent.
+   */
+  template <typename... Options>
+  future<StatusOr<ObjectMetadata>> AsyncGetObjectMetadata(
+      std::string const& bucket_name, std::string const& object_name,
+      Options&&... options) {
+    internal::GetObjectMetadataRequest request(bucket_name, object_name);
+    request.set_multiple_options(std::forward<Options>(options)...);
+    return raw_client_->AsyncGetObjectMetadata(request);
+  }
+
   /**
    * Lists the objects in a bucket.
    *
@@ -798,9 +860,10 @@ class Client {
    * @param bucket_name the name of the bucket that contains the object.
    * @param object_name the name of the object to be read.
    * @param options a list of optional query parameters and/or request headers.
-   *     Valid types for this operation include `DisableCrc32cChecksum`,
-   *     `DisableMD5Hash`, `IfGenerationMatch`, `EncryptionKey`, `Generation`,
-   *     `IfGenerationMatch`, `IfGenerationNotMatch`, `IfMetagenerationMatch`,
+   *     Valid types for this operation include `ComputeHashesInBackground`,
+   *     `DisableCrc32cChecksum`, `DisableMD5Hash`, `IfGenerationMatch`,
+   *     `EncryptionKey`, `Generation`, `IfGenerationMatch`,
+   *     `IfGenerationNotMatch`, `IfMetagenerationMatch`,
    *     `IfMetagenerationNotMatch`, `ReadRange`, and `UserProject`.
    *
    * @throw std::runtime_error if there is a permanent failure, or if there were
@@ -824,6 +887,37 @@ class Client {
     return ObjectReadStream(raw_client_->ReadObject(request).value());
   }
 
+  /**
+   * Reads the contents of an object asynchronously.
+   *
+   * Unlike `ReadObject()` the full contents (or the requested `ReadRange`) are
+   * downloaded into memory, use this function for small objects.
+   *
+   * @param bucket_name the name of the bucket that contains the object.
+   * @param object_name the name of the object to be read.
+   * @param options a list of optional query parameters and/or request headers.
+   *     Valid types for this operation include `DisableCrc32cChecksum`,
+   *     `DisableMD5Hash`, `EncryptionKey`, `Generation`, `IfGenerationMatch`,
+   *     `IfGenerationNotMatch`, `IfMetagenerationMatch`,
+   *     `IfMetagenerationNotMatch`, `ReadRange`, and `UserProject`.
+   *
+   * @return a future satisfied with the object contents, or the error. If the
+   *     hashes do not match the error is `StatusCode::kDataLoss`.
+   *     Continuations attached to the future run in the background thread
+   *     that completes the request, they should not block.
+   *
+   * @par Idempotency
+   * This is a read-only operation and is always idempotent.
+   */
+  template <typename... Options>
+  future<StatusOr<std::string>> AsyncReadObject(std::string const& bucket_name,
+                                                std::string const& object_name,
+                                                Options&&... options) {
+    internal::ReadObjectRangeRequest request(bucket_name, object_name);
+    request.set_multiple_options(std::forward<Options>(options)...);
+    return raw_client_->AsyncReadObject(request);
+  }
+
   /**
    * Writes contents into an object.
    *
@@ -858,12 +952,13 @@ class Client {
    * @param bucket_name the name of the bucket that contains the object.
    * @param object_name the name of the object to be read.
    * @param options a list of optional query parameters and/or request headers.
-   *   Valid types for this operation include `ContentEncoding`, `ContentType`,
-   *   `Crc32cChecksumValue`, `DisableCrc32cChecksum`, `DisableMD5Hash`,
-   *   `EncryptionKey`, `IfGenerationMatch`, `IfGenerationNotMatch`,
-   *   `IfMetagenerationMatch`, `IfMetagenerationNotMatch`, `KmsKeyName`,
-   *   `MD5HashValue`, `PredefinedAcl`, `Projection`,
-   *   `UseResumableUploadSession`, `UserProject`, and `WithObjectMetadata`.
+   *   Valid types for this operation include `ComputeHashesInBackground`,
+   *   `ContentEncoding`, `ContentType`, `Crc32cChecksumValue`,
+   *   `DisableCrc32cChecksum`, `DisableMD5Hash`, `EncryptionKey`,
+   *   `IfGenerationMatch`, `IfGenerationNotMatch`, `IfMetagenerationMatch`,
+   *   `IfMetagenerationNotMatch`, `KmsKeyName`, `MD5HashValue`,
+   *   `PredefinedAcl`, `Projection`, `UseResumableUploadSession`,
+   *   `UserProject`, and `WithObjectMetadata`.
    *
    * @throw std::runtime_error if there is a permanent failure, or if there were
    *     more transient failures than allowed by the current retry policy.
@@ -910,8 +1005,8 @@ class Client {
    *   `Crc32cChecksumValue`, `DisableCrc32cChecksum`, `DisableMD5Hash`,
    *   `EncryptionKey`, `IfGenerationMatch`, `IfGenerationNotMatch`,
    *   `IfMetagenerationMatch`, `IfMetagenerationNotMatch`, `KmsKeyName`,
-   *   `MD5HashValue`, `PredefinedAcl`, `Projection`, `UserProject`, and
-   *   `WithObjectMetadata`.
+   *   `MD5HashValue`, `ParallelUpload`, `PredefinedAcl`, `Projection`,
+   *   `UserProject`, and `WithObjectMetadata`.
    *
    * @par Idempotency
    * This operation is only idempotent if restricted by pre-conditions, in this
@@ -925,6 +1020,9 @@ class Client {
    *
    * @par Example: manually selecting a resumable upload
    * @snippet storage_object_samples.cc upload file resumable
+   *
+   * @par Example: upload using multiple streams
+   * @snippet storage_object_samples.cc upload file parallel
    */
   template <typename... Options>
   ObjectMetadata UploadFile(std::string const& file_name,
@@ -934,9 +1032,10 @@ class Client {
     // Determine, at compile time, which version of UploadFileImpl we should
     // call. This needs to be done at compile time because ObjectInsertMedia
     // does not support (nor should it support) the UseResumableUploadSession
-    // option.
+    // or ParallelUpload options.
     using HasUseResumableUpload = google::cloud::internal::disjunction<
-        std::is_same<UseResumableUploadSession, Options>...>;
+        std::is_same<UseResumableUploadSession, Options>...,
+        std::is_same<ParallelUpload, Options>...>;
     return UploadFileImpl(file_name, bucket_name, object_name,
                           HasUseResumableUpload{},
                           std::forward<Options>(options)...);
@@ -952,7 +1051,8 @@ class Client {
    * @param options a list of optional query parameters and/or request headers.
    *   Valid types for this operation include `IfGenerationMatch`,
    *   `IfGenerationNotMatch`, `IfMetagenerationMatch`,
-   *   `IfMetagenerationNotMatch`, `Generation`, `ReadRange`, and `UserProject`.
+   *   `IfMetagenerationNotMatch`, `Generation`, `ParallelDownload`,
+   *   `ReadRange`, and `UserProject`.
    *
    * @throw std::runtime_error if there is a permanent failure, or if there were
    *     more transient failures than allowed by the current retry policy.
@@ -962,6 +1062,9 @@ class Client {
    *
    * @par Example
    * @snippet storage_object_samples.cc download file
+   *
+   * @par Example: download using multiple streams
+   * @snippet storage_object_samples.cc download file parallel
    */
   template <typename... Options>
   void DownloadToFile(std::string const& bucket_name,
@@ -2365,8 +2468,9 @@ class Client {
     return retry;
   }
 
-  // The version of UploadFile() where UseResumableUploadSession is one of the
-  // options. Note how this does not use InsertObjectMedia at all.
+  // The version of UploadFile() where UseResumableUploadSession (or
+  // ParallelUpload) is one of the options. Note how this does not use
+  // InsertObjectMedia at all.
   template <typename... Options>
   ObjectMetadata UploadFileImpl(std::string const& file_name,
                                 std::string const& bucket_name,
@@ -2378,9 +2482,9 @@ class Client {
     return UploadFileResumable(file_name, request);
   }
 
-  // The version of UploadFile() where UseResumableUploadSession is *not* one of
-  // the options. In this case we can use InsertObjectMediaRequest because it
-  // is safe.
+  // The version of UploadFile() where neither UseResumableUploadSession nor
+  // ParallelUpload are one of the options. In this case we can use
+  // InsertObjectMediaRequest because it is safe.
   template <typename... Options>
   ObjectMetadata UploadFileImpl(std::string const& file_name,
                                 std::string const& bucket_name,
@@ -2407,6 +2511,10 @@ class Client {
       std::string const& file_name,
       internal::ResumableUploadRequest const& request);
 
+  StatusOr<ObjectMetadata> UploadFileParallel(
+      std::string const& file_name, std::uint64_t file_size,
+      internal::ResumableUploadRequest const& request);
+
   StatusOr<ObjectMetadata> UploadStreamResumable(
       std::istream& source, std::uint64_t source_size,
       internal::ResumableUploadRequest const& request);
@@ -2414,6 +2522,9 @@ class Client {
   void DownloadFileImpl(internal::ReadObjectRangeRequest const& request,
                         std::string const& file_name);
 
+  void DownloadFileParallel(internal::ReadObjectRangeRequest const& request,
+                            std::string const& file_name);
+
   std::string SignUrl(internal::SignUrlRequest const& request);
 
   std::shared_ptr<internal::RawClient> raw_client_;
@@ -0,0 +1,252 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/random.h"
+#include "google/cloud/storage/client.h"
+#include "google/cloud/storage/internal/hash_validator.h"
+#include "google/cloud/storage/oauth2/google_credentials.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include <gmock/gmock.h>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+using ::testing::_;
+using ::testing::HasSubstr;
+using ::testing::Invoke;
+using ::testing::ReturnRef;
+using testing::canonical_errors::TransientError;
+
+/// A streambuf that returns a fixed string, and then reports @p status.
+class FakeReadStreambuf : public internal::ObjectReadStreambuf {
+ public:
+  FakeReadStreambuf(std::string contents, Status status)
+      : contents_(std::move(contents)), status_(std::move(status)) {
+    char* data = &contents_[0];
+    setg(data, data, data + contents_.size());
+  }
+
+  void Close() override {}
+  bool IsOpen() const override { return false; }
+  Status const& status() const override { return status_; }
+  std::string const& received_hash() const override { return hash_; }
+  std::string const& computed_hash() const override { return hash_; }
+  std::multimap<std::string, std::string> const& headers() const override {
+    return headers_;
+  }
+
+ protected:
+  int_type underflow() override { return traits_type::eof(); }
+
+ private:
+  std::string contents_;
+  Status status_;
+  std::string hash_;
+  std::multimap<std::string, std::string> headers_;
+};
+
+/**
+ * Test Client::DownloadToFile() using multiple streams.
+ */
+class DownloadFileTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    mock = std::make_shared<testing::MockClient>();
+    EXPECT_CALL(*mock, client_options())
+        .WillRepeatedly(ReturnRef(client_options));
+    client.reset(new Client{std::shared_ptr<internal::RawClient>(mock)});
+
+    for (int i = 0; i != 1000; ++i) {
+      contents += "line " + std::to_string(i) + ": lorem ipsum dolor sit\n";
+    }
+    auto generator = google::cloud::internal::MakeDefaultPRNG();
+    file_name = ::testing::TempDir() + "download-file-test-" +
+                google::cloud::internal::Sample(
+                    generator, 16, "abcdefghijklmnopqrstuvwxyz0123456789");
+  }
+  void TearDown() override {
+    (void)std::remove(file_name.c_str());
+    client.reset();
+    mock.reset();
+  }
+
+  ObjectMetadata CreateMetadata(std::string const& crc32c) {
+    internal::nl::json metadata{
+        {"bucket", "test-bucket-name"},
+        {"name", "test-object-name"},
+        {"generation", "42"},
+        {"size", std::to_string(contents.size())},
+        {"crc32c", crc32c},
+    };
+    return ObjectMetadata::ParseFromJson(metadata).value();
+  }
+
+  std::string ExpectedCrc32c() {
+    internal::Crc32cHashValidator validator;
+    validator.Update(contents);
+    return std::move(validator).Finish().computed;
+  }
+
+  /// Returns the requested range of `contents`.
+  StatusOr<std::unique_ptr<internal::ObjectReadStreambuf>> ReadRange(
+      internal::ReadObjectRangeRequest const& request) {
+    EXPECT_TRUE(request.HasOption<Generation>());
+    EXPECT_EQ(42, request.GetOption<Generation>().value());
+    EXPECT_TRUE(request.HasOption<storage::ReadRange>());
+    auto range = request.GetOption<storage::ReadRange>().value();
+    std::unique_ptr<internal::ObjectReadStreambuf> result(new FakeReadStreambuf(
+        contents.substr(range.begin, range.end - range.begin), Status()));
+    return result;
+  }
+
+  std::string ReadFile() {
+    std::ifstream is(file_name);
+    return std::string(std::istreambuf_iterator<char>{is}, {});
+  }
+
+  std::shared_ptr<testing::MockClient> mock;
+  std::unique_ptr<Client> client;
+  ClientOptions client_options =
+      ClientOptions(oauth2::CreateAnonymousCredentials());
+  std::string contents;
+  std::string file_name;
+};
+
+TEST_F(DownloadFileTest, Parallel) {
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Invoke([this](internal::GetObjectMetadataRequest const& r) {
+        EXPECT_EQ("test-bucket-name", r.bucket_name());
+        EXPECT_EQ("test-object-name", r.object_name());
+        return make_status_or(CreateMetadata(ExpectedCrc32c()));
+      }));
+  std::atomic<int> read_count(0);
+  EXPECT_CALL(*mock, ReadObject(_))
+      .WillRepeatedly(Invoke(
+          [this, &read_count](internal::ReadObjectRangeRequest const& r) {
+            ++read_count;
+            return ReadRange(r);
+          }));
+
+  client->DownloadToFile("test-bucket-name", "test-object-name", file_name,
+                         ParallelDownload(4, 1024));
+  EXPECT_EQ(4, read_count.load());
+  auto actual = ReadFile();
+  ASSERT_EQ(contents.size(), actual.size());
+  EXPECT_TRUE(contents == actual);
+}
+
+TEST_F(DownloadFileTest, ParallelSmallObjectUsesFewerStreams) {
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Invoke([this](internal::GetObjectMetadataRequest const&) {
+        return make_status_or(CreateMetadata(ExpectedCrc32c()));
+      }));
+  std::atomic<int> read_count(0);
+  EXPECT_CALL(*mock, ReadObject(_))
+      .WillRepeatedly(Invoke(
+          [this, &read_count](internal::ReadObjectRangeRequest const& r) {
+            ++read_count;
+            return ReadRange(r);
+          }));
+
+  auto const minimum_slice_size =
+      static_cast<std::int64_t>(contents.size() / 2 + 1);
+  client->DownloadToFile("test-bucket-name", "test-object-name", file_name,
+                         ParallelDownload(8, minimum_slice_size));
+  EXPECT_EQ(2, read_count.load());
+  EXPECT_TRUE(contents == ReadFile());
+}
+
+TEST_F(DownloadFileTest, ParallelResumesInterruptedSlice) {
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Invoke([this](internal::GetObjectMetadataRequest const&) {
+        return make_status_or(CreateMetadata(ExpectedCrc32c()));
+      }));
+  // The first request for the slice starting at 0 fails half way through, the
+  // download should resume from the last byte received.
+  std::atomic<bool> interrupted(false);
+  EXPECT_CALL(*mock, ReadObject(_))
+      .WillRepeatedly(Invoke([this, &interrupted](
+                                 internal::ReadObjectRangeRequest const& r) {
+        auto range = r.GetOption<storage::ReadRange>().value();
+        if (range.begin != 0 or interrupted.exchange(true)) {
+          return ReadRange(r);
+        }
+        auto const half = (range.end - range.begin) / 2;
+        std::unique_ptr<internal::ObjectReadStreambuf> result(
+            new FakeReadStreambuf(contents.substr(0, half), TransientError()));
+        return make_status_or(std::move(result));
+      }));
+
+  client->DownloadToFile("test-bucket-name", "test-object-name", file_name,
+                         ParallelDownload(4, 1024));
+  EXPECT_TRUE(interrupted.load());
+  EXPECT_TRUE(contents == ReadFile());
+}
+
+TEST_F(DownloadFileTest, ParallelRange) {
+  // The object checksum does not apply to a range, a bad value is ignored.
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Invoke([this](internal::GetObjectMetadataRequest const&) {
+        return make_status_or(CreateMetadata("AAAAAA=="));
+      }));
+  EXPECT_CALL(*mock, ReadObject(_))
+      .WillRepeatedly(Invoke([this](internal::ReadObjectRangeRequest const& r) {
+        return ReadRange(r);
+      }));
+
+  client->DownloadToFile("test-bucket-name", "test-object-name", file_name,
+                         ParallelDownload(4, 1024),
+                         storage::ReadRange(100, 9000));
+  EXPECT_TRUE(contents.substr(100, 8900) == ReadFile());
+}
+
+TEST_F(DownloadFileTest, ParallelChecksumMismatch) {
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Invoke([this](internal::GetObjectMetadataRequest const&) {
+        return make_status_or(CreateMetadata("AAAAAA=="));
+      }));
+  EXPECT_CALL(*mock, ReadObject(_))
+      .WillRepeatedly(Invoke([this](internal::ReadObjectRangeRequest const& r) {
+        return ReadRange(r);
+      }));
+
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  EXPECT_THROW(
+      try {
+        client->DownloadToFile("test-bucket-name", "test-object-name",
+                               file_name, ParallelDownload(4, 1024));
+      } catch (std::runtime_error const& ex) {
+        EXPECT_THAT(ex.what(), HasSubstr("mismatched checksums"));
+        throw;
+      },
+      std::runtime_error);
+#else
+  EXPECT_DEATH_IF_SUPPORTED(
+      client->DownloadToFile("test-bucket-name", "test-object-name", file_name,
+                             ParallelDownload(4, 1024)),
+      "exceptions are disabled");
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+}
+
+}  // namespace
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -17,6 +17,7 @@
 
 #include "google/cloud/internal/throw_delegate.h"
 #include "google/cloud/storage/oauth2/credentials.h"
+#include <chrono>
 #include <memory>
 
 namespace google {
@@ -88,6 +89,109 @@ class ClientOptions {
     return *this;
   }
 
+  /**
+   * Open the connections to the service when the client is created.
+   *
+   * By default connections are opened on demand, so the first requests pay for
+   * the DNS lookup, and the TCP and TLS handshakes. When enabled, the client
+   * opens `connection_pool_size()` connections (at least one) to `endpoint()`
+   * before the constructor returns. Failures are logged and otherwise ignored.
+   *
+   * @see `connection_pool_prewarm_timeout()` bounds the time spent.
+   */
+  bool enable_connection_pool_prewarm() const {
+    return enable_connection_pool_prewarm_;
+  }
+  ClientOptions& set_enable_connection_pool_prewarm(bool enable) {
+    enable_connection_pool_prewarm_ = enable;
+    return *this;
+  }
+
+  /**
+   * The maximum time spent opening connections when the client is created.
+   *
+   * The prewarm requests give up on connections not established (and
+   * requests not completed) within this time, so an unreachable endpoint does
+   * not block the construction of a client for the operating system connect
+   * timeout. The default is two seconds.
+   */
+  std::chrono::milliseconds connection_pool_prewarm_timeout() const {
+    return connection_pool_prewarm_timeout_;
+  }
+  ClientOptions& set_connection_pool_prewarm_timeout(
+      std::chrono::milliseconds timeout) {
+    connection_pool_prewarm_timeout_ = timeout;
+    return *this;
+  }
+
+  /**
+   * The interval between TCP keep-alive probes on idle connections.
+   *
+   * Keep-alive probes detect connections dropped without notice, and prevent
+   * some middleboxes from closing idle connections. A value of zero (the
+   * default) disables TCP keep-alive.
+   */
+  std::chrono::seconds tcp_keepalive_interval() const {
+    return tcp_keepalive_interval_;
+  }
+  ClientOptions& set_tcp_keepalive_interval(std::chrono::seconds interval) {
+    tcp_keepalive_interval_ = interval;
+    return *this;
+  }
+
+  /**
+   * Close, instead of reuse, connections idle for longer than this value.
+   *
+   * Load balancers and NAT gateways often drop idle connections without
+   * notice. Reusing one of these connections results in a failed request, and
+   * a retry. A value of zero (the default) uses the libcurl default. This
+   * option requires libcurl >= 7.65.0, it is ignored with older versions.
+   */
+  std::chrono::seconds maximum_connection_idle_time() const {
+    return maximum_connection_idle_time_;
+  }
+  ClientOptions& set_maximum_connection_idle_time(std::chrono::seconds v) {
+    maximum_connection_idle_time_ = v;
+    return *this;
+  }
+
+  /**
+   * Use HTTP/2, when the server supports it, instead of HTTP/1.1.
+   *
+   * With HTTP/1.1 each connection carries one request at a time, so many
+   * concurrent requests need many connections, and many TLS sessions. With
+   * HTTP/2 the requests that run in the same event loop (the asynchronous
+   * operations, and the streaming transfers when `event_loop_thread_count()`
+   * is set) are multiplexed over a few connections. HTTP/2 is only negotiated
+   * over TLS, requests to `http://` endpoints always use HTTP/1.1. This option
+   * requires a libcurl built with HTTP/2 support, it is ignored otherwise.
+   */
+  bool enable_http2() const { return enable_http2_; }
+  ClientOptions& set_enable_http2(bool enable) {
+    enable_http2_ = enable;
+    return *this;
+  }
+
+  /**
+   * The number of background threads used to run streaming transfers.
+   *
+   * When set to 0 (the default) each `ObjectReadStream` and `ObjectWriteStream`
+   * runs its transfer in the thread that reads from, or writes to, the stream.
+   * Otherwise all the streaming transfers are multiplexed over this many
+   * background threads, which is more efficient when the application has many
+   * concurrent streams. A good value is `std::thread::hardware_concurrency()`.
+   *
+   * The asynchronous operations (e.g. `Client::AsyncReadObject()`) also use
+   * these threads. When set to 0 they share a single background thread.
+   */
+  std::size_t event_loop_thread_count() const {
+    return event_loop_thread_count_;
+  }
+  ClientOptions& set_event_loop_thread_count(std::size_t count) {
+    event_loop_thread_count_ = count;
+    return *this;
+  }
+
   std::size_t download_buffer_size() const { return download_buffer_size_; }
   ClientOptions& SetDownloadBufferSize(std::size_t size);
 
@@ -136,6 +240,12 @@ class ClientOptions {
   bool enable_raw_client_tracing_;
   std::string project_id_;
   std::size_t connection_pool_size_;
+  bool enable_connection_pool_prewarm_ = false;
+  std::chrono::milliseconds connection_pool_prewarm_timeout_{2000};
+  std::chrono::seconds tcp_keepalive_interval_{0};
+  std::chrono::seconds maximum_connection_idle_time_{0};
+  bool enable_http2_ = false;
+  std::size_t event_loop_thread_count_ = 0;
   std::size_t download_buffer_size_;
   std::size_t upload_buffer_size_;
   std::string user_agent_prefix_;
@@ -0,0 +1,452 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/random.h"
+#include "google/cloud/storage/client.h"
+#include "google/cloud/storage/internal/hash_validator.h"
+#include "google/cloud/storage/oauth2/google_credentials.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include <gmock/gmock.h>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <mutex>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+using ::testing::_;
+using ::testing::HasSubstr;
+using ::testing::Invoke;
+using ::testing::ReturnRef;
+using testing::canonical_errors::PermanentError;
+
+std::string ComputeCrc32c(std::string const& data) {
+  internal::Crc32cHashValidator validator;
+  validator.Update(data);
+  return std::move(validator).Finish().computed;
+}
+
+/// Simulates the objects stored in a bucket.
+class FakeBucket {
+ public:
+  ObjectMetadata Insert(std::string const& name, std::string contents) {
+    return ObjectMetadata::ParseFromJson(InsertJson(name, std::move(contents)))
+        .value();
+  }
+
+  internal::nl::json InsertJson(std::string const& name, std::string contents) {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto crc32c = ComputeCrc32c(contents);
+    auto size = contents.size();
+    objects_[name] = std::move(contents);
+    internal::nl::json metadata{
+        {"bucket", "test-bucket-name"},
+        {"name", name},
+        {"generation", std::to_string(++generation_)},
+        {"size", std::to_string(size)},
+        {"crc32c", crc32c},
+    };
+    return metadata;
+  }
+
+  std::string Get(std::string const& name) {
+    std::lock_guard<std::mutex> lk(mu_);
+    return objects_[name];
+  }
+
+  void Delete(std::string const& name) {
+    std::lock_guard<std::mutex> lk(mu_);
+    objects_.erase(name);
+  }
+
+  void RecordChunk() { ++chunk_count_; }
+  int chunk_count() const { return chunk_count_.load(); }
+
+  std::vector<std::string> Names() {
+    std::lock_guard<std::mutex> lk(mu_);
+    std::vector<std::string> names;
+    for (auto const& kv : objects_) {
+      names.push_back(kv.first);
+    }
+    return names;
+  }
+
+ private:
+  std::mutex mu_;
+  std::map<std::string, std::string> objects_;
+  long generation_ = 0;
+  std::atomic<int> chunk_count_{0};
+};
+
+/// A resumable upload session that stores the data in a FakeBucket.
+class FakeUploadSession : public internal::ResumableUploadSession {
+ public:
+  FakeUploadSession(FakeBucket& bucket, std::string object_name,
+                    std::string committed = std::string{})
+      : bucket_(bucket),
+        object_name_(std::move(object_name)),
+        contents_(std::move(committed)) {}
+
+  /// Simulate a partial failure: only commit part of the next chunk.
+  void DropBytesOnce(std::size_t count) { drop_bytes_ = count; }
+
+  StatusOr<internal::ResumableUploadResponse> UploadChunk(
+      std::string const& buffer, std::uint64_t upload_size) override {
+    bucket_.RecordChunk();
+    if (drop_bytes_ != 0) {
+      contents_ += buffer.substr(0, buffer.size() - drop_bytes_);
+      drop_bytes_ = 0;
+      return internal::ResumableUploadResponse{"fake-session-id",
+                                               contents_.size() - 1, ""};
+    }
+    contents_ += buffer;
+    std::string payload;
+    if (contents_.size() == upload_size) {
+      payload = bucket_.InsertJson(object_name_, contents_).dump();
+    }
+    return internal::ResumableUploadResponse{"fake-session-id",
+                                             contents_.size() - 1, payload};
+  }
+  StatusOr<internal::ResumableUploadResponse> ResetSession() override {
+    return internal::ResumableUploadResponse{"fake-session-id",
+                                             contents_.size() - 1, ""};
+  }
+  std::uint64_t next_expected_byte() const override {
+    return contents_.size();
+  }
+  std::string const& session_id() const override { return session_id_; }
+
+ private:
+  FakeBucket& bucket_;
+  std::string object_name_;
+  std::string contents_;
+  std::string session_id_ = "fake-session-id";
+  std::size_t drop_bytes_ = 0;
+};
+
+/**
+ * Test Client::UploadFile() using multiple streams.
+ */
+class UploadFileTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    mock = std::make_shared<testing::MockClient>();
+    client_options.SetUploadBufferSize(256 * 1024);
+    EXPECT_CALL(*mock, client_options())
+        .WillRepeatedly(ReturnRef(client_options));
+    client.reset(new Client{std::shared_ptr<internal::RawClient>(mock)});
+
+    for (int i = 0; i != 10000; ++i) {
+      contents += "line " + std::to_string(i) + ": lorem ipsum dolor sit\n";
+    }
+    auto generator = google::cloud::internal::MakeDefaultPRNG();
+    file_name = ::testing::TempDir() + "upload-file-test-" +
+                google::cloud::internal::Sample(
+                    generator, 16, "abcdefghijklmnopqrstuvwxyz0123456789");
+    std::ofstream(file_name, std::ios::binary) << contents;
+  }
+  void TearDown() override {
+    (void)std::remove(file_name.c_str());
+    client.reset();
+    mock.reset();
+  }
+
+  /// Configures the mock to store the parts and composed objects in `bucket`.
+  void UseFakeBucket() {
+    EXPECT_CALL(*mock, CreateResumableSession(_))
+        .WillRepeatedly(Invoke([this](internal::ResumableUploadRequest const&
+                                          r) {
+          EXPECT_EQ("test-bucket-name", r.bucket_name());
+          EXPECT_TRUE(r.HasOption<IfGenerationMatch>());
+          std::unique_ptr<internal::ResumableUploadSession> session(
+              new FakeUploadSession(bucket, r.object_name()));
+          return make_status_or(std::move(session));
+        }));
+    EXPECT_CALL(*mock, ComposeObject(_))
+        .WillRepeatedly(Invoke(
+            [this](internal::ComposeObjectRequest const& r) {
+              return Compose(r);
+            }));
+    EXPECT_CALL(*mock, DeleteObject(_))
+        .WillRepeatedly(Invoke([this](internal::DeleteObjectRequest const& r) {
+          EXPECT_TRUE(r.HasOption<Generation>());
+          bucket.Delete(r.object_name());
+          return make_status_or(internal::EmptyResponse{});
+        }));
+  }
+
+  StatusOr<ObjectMetadata> Compose(internal::ComposeObjectRequest const& r) {
+    auto payload = internal::nl::json::parse(r.JsonPayload());
+    auto const& sources = payload["sourceObjects"];
+    EXPECT_GE(32U, sources.size());
+    {
+      std::lock_guard<std::mutex> lk(mu);
+      compose_count++;
+    }
+    std::string composed;
+    for (auto const& source : sources) {
+      composed += bucket.Get(source["name"].get<std::string>());
+    }
+    return bucket.Insert(r.object_name(), std::move(composed));
+  }
+
+  std::shared_ptr<testing::MockClient> mock;
+  std::unique_ptr<Client> client;
+  ClientOptions client_options =
+      ClientOptions(oauth2::CreateAnonymousCredentials());
+  std::string contents;
+  std::string file_name;
+  FakeBucket bucket;
+  std::mutex mu;
+  int compose_count = 0;
+};
+
+TEST_F(UploadFileTest, Resumable) {
+  EXPECT_CALL(*mock, CreateResumableSession(_))
+      .WillOnce(Invoke([this](internal::ResumableUploadRequest const& r) {
+        std::unique_ptr<internal::ResumableUploadSession> session(
+            new FakeUploadSession(bucket, r.object_name()));
+        return make_status_or(std::move(session));
+      }));
+
+  auto metadata =
+      client->UploadFile(file_name, "test-bucket-name", "test-object-name",
+                         NewResumableUploadSession());
+  EXPECT_EQ(ComputeCrc32c(contents), metadata.crc32c());
+  EXPECT_TRUE(contents == bucket.Get("test-object-name"));
+  auto const chunk_size = client_options.upload_buffer_size();
+  EXPECT_EQ(static_cast<int>((contents.size() + chunk_size - 1) / chunk_size),
+            bucket.chunk_count());
+}
+
+TEST_F(UploadFileTest, ResumableResendsUncommittedData) {
+  EXPECT_CALL(*mock, CreateResumableSession(_))
+      .WillOnce(Invoke([this](internal::ResumableUploadRequest const& r) {
+        auto session = new FakeUploadSession(bucket, r.object_name());
+        // The service only commits part of the first chunk, the client must
+        // discard the prefetched data and resend the missing bytes.
+        session->DropBytesOnce(1000);
+        std::unique_ptr<internal::ResumableUploadSession> result(session);
+        return make_status_or(std::move(result));
+      }));
+
+  auto metadata =
+      client->UploadFile(file_name, "test-bucket-name", "test-object-name",
+                         NewResumableUploadSession());
+  EXPECT_EQ(ComputeCrc32c(contents), metadata.crc32c());
+  EXPECT_TRUE(contents == bucket.Get("test-object-name"));
+}
+
+TEST_F(UploadFileTest, ResumableRestoredSession) {
+  auto const committed = client_options.upload_buffer_size();
+  EXPECT_CALL(*mock, CreateResumableSession(_))
+      .WillOnce(
+          Invoke([this, committed](internal::ResumableUploadRequest const& r) {
+            EXPECT_EQ("test-session-id",
+                      r.GetOption<UseResumableUploadSession>().value());
+            std::unique_ptr<internal::ResumableUploadSession> result(
+                new FakeUploadSession(bucket, r.object_name(),
+                                      contents.substr(0, committed)));
+            return make_status_or(std::move(result));
+          }));
+
+  auto metadata =
+      client->UploadFile(file_name, "test-bucket-name", "test-object-name",
+                         RestoreResumableUploadSession("test-session-id"));
+  EXPECT_EQ(ComputeCrc32c(contents), metadata.crc32c());
+  EXPECT_TRUE(contents == bucket.Get("test-object-name"));
+}
+
+TEST_F(UploadFileTest, Parallel) {
+  UseFakeBucket();
+
+  auto metadata = client->UploadFile(file_name, "test-bucket-name",
+                                     "test-object-name", ParallelUpload(4, 1));
+  EXPECT_EQ("test-object-name", metadata.name());
+  EXPECT_EQ(ComputeCrc32c(contents), metadata.crc32c());
+  EXPECT_EQ(1, compose_count);
+  EXPECT_TRUE(contents == bucket.Get("test-object-name"));
+  // Only the destination remains, all the temporary objects are deleted.
+  EXPECT_EQ(std::vector<std::string>{"test-object-name"}, bucket.Names());
+}
+
+TEST_F(UploadFileTest, ParallelComposesInTree) {
+  UseFakeBucket();
+
+  // With 100 parts the library needs 4 intermediate compose operations, and
+  // then a final operation to create the destination.
+  auto metadata =
+      client->UploadFile(file_name, "test-bucket-name", "test-object-name",
+                         ParallelUpload(100, 1));
+  EXPECT_EQ(ComputeCrc32c(contents), metadata.crc32c());
+  EXPECT_EQ(5, compose_count);
+  EXPECT_TRUE(contents == bucket.Get("test-object-name"));
+  EXPECT_EQ(std::vector<std::string>{"test-object-name"}, bucket.Names());
+}
+
+TEST_F(UploadFileTest, ParallelSmallFileUsesSingleStream) {
+  EXPECT_CALL(*mock, CreateResumableSession(_))
+      .WillOnce(Invoke([this](internal::ResumableUploadRequest const& r) {
+        EXPECT_EQ("test-object-name", r.object_name());
+        std::unique_ptr<internal::ResumableUploadSession> session(
+            new FakeUploadSession(bucket, r.object_name()));
+        return make_status_or(std::move(session));
+      }));
+  EXPECT_CALL(*mock, ComposeObject(_)).Times(0);
+
+  auto metadata = client->UploadFile(
+      file_name, "test-bucket-name", "test-object-name",
+      ParallelUpload(4, static_cast<std::int64_t>(contents.size())));
+  EXPECT_EQ(ComputeCrc32c(contents), metadata.crc32c());
+  EXPECT_TRUE(contents == bucket.Get("test-object-name"));
+}
+
+TEST_F(UploadFileTest, ParallelComposeFailureDeletesParts) {
+  UseFakeBucket();
+  EXPECT_CALL(*mock, ComposeObject(_))
+      .WillOnce(Invoke([](internal::ComposeObjectRequest const&) {
+        return StatusOr<ObjectMetadata>(PermanentError());
+      }));
+
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  EXPECT_THROW(
+      try {
+        client->UploadFile(file_name, "test-bucket-name", "test-object-name",
+                           ParallelUpload(4, 1));
+      } catch (std::runtime_error const& ex) {
+        EXPECT_THAT(ex.what(), HasSubstr("Permanent"));
+        throw;
+      },
+      std::runtime_error);
+#else
+  EXPECT_DEATH_IF_SUPPORTED(
+      client->UploadFile(file_name, "test-bucket-name", "test-object-name",
+                         ParallelUpload(4, 1)),
+      "exceptions are disabled");
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  EXPECT_TRUE(bucket.Names().empty());
+}
+
+TEST_F(UploadFileTest, ParallelChecksumMismatch) {
+  UseFakeBucket();
+  EXPECT_CALL(*mock, ComposeObject(_))
+      .WillOnce(Invoke([this](internal::ComposeObjectRequest const& r) {
+        return bucket.Insert(r.object_name(), "not the right contents");
+      }));
+
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  EXPECT_THROW(
+      try {
+        client->UploadFile(file_name, "test-bucket-name", "test-object-name",
+                           ParallelUpload(4, 1));
+      } catch (std::runtime_error const& ex) {
+        EXPECT_THAT(ex.what(), HasSubstr("mismatched checksums"));
+        throw;
+      },
+      std::runtime_error);
+#else
+  EXPECT_DEATH_IF_SUPPORTED(
+      client->UploadFile(file_name, "test-bucket-name", "test-object-name",
+                         ParallelUpload(4, 1)),
+      "exceptions are disabled");
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+}
+
+TEST_F(UploadFileTest, ParallelVerifiesCrc32cChecksumValue) {
+  UseFakeBucket();
+
+  auto metadata = client->UploadFile(
+      file_name, "test-bucket-name", "test-object-name", ParallelUpload(4, 1),
+      Crc32cChecksumValue(ComputeCrc32c(contents)));
+  EXPECT_EQ(ComputeCrc32c(contents), metadata.crc32c());
+  EXPECT_EQ(1, compose_count);
+  EXPECT_EQ(std::vector<std::string>{"test-object-name"}, bucket.Names());
+}
+
+TEST_F(UploadFileTest, ParallelCrc32cChecksumValueMismatch) {
+  UseFakeBucket();
+  // The destination is never created, the mismatch is detected before the
+  // parts are composed.
+  EXPECT_CALL(*mock, ComposeObject(_)).Times(0);
+
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  EXPECT_THROW(
+      try {
+        client->UploadFile(file_name, "test-bucket-name", "test-object-name",
+                           ParallelUpload(4, 1),
+                           Crc32cChecksumValue(ComputeCrc32c("bad")));
+      } catch (std::runtime_error const& ex) {
+        EXPECT_THAT(ex.what(), HasSubstr("mismatched checksums"));
+        throw;
+      },
+      std::runtime_error);
+#else
+  EXPECT_DEATH_IF_SUPPORTED(
+      client->UploadFile(file_name, "test-bucket-name", "test-object-name",
+                         ParallelUpload(4, 1),
+                         Crc32cChecksumValue(ComputeCrc32c("bad"))),
+      "exceptions are disabled");
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  EXPECT_TRUE(bucket.Names().empty());
+}
+
+TEST_F(UploadFileTest, ParallelMD5HashValueUsesSingleStream) {
+  auto const md5 = ComputeMD5Hash(contents);
+  EXPECT_CALL(*mock, CreateResumableSession(_))
+      .WillOnce(Invoke([this, md5](internal::ResumableUploadRequest const& r) {
+        EXPECT_EQ("test-object-name", r.object_name());
+        EXPECT_EQ(md5, r.GetOption<MD5HashValue>().value());
+        std::unique_ptr<internal::ResumableUploadSession> session(
+            new FakeUploadSession(bucket, r.object_name()));
+        return make_status_or(std::move(session));
+      }));
+  EXPECT_CALL(*mock, ComposeObject(_)).Times(0);
+
+  auto metadata =
+      client->UploadFile(file_name, "test-bucket-name", "test-object-name",
+                         ParallelUpload(4, 1), MD5HashValue(md5));
+  EXPECT_EQ(ComputeCrc32c(contents), metadata.crc32c());
+  EXPECT_TRUE(contents == bucket.Get("test-object-name"));
+  EXPECT_EQ(std::vector<std::string>{"test-object-name"}, bucket.Names());
+}
+
+TEST_F(UploadFileTest, ParallelNotMatchPreconditionsUseSingleStream) {
+  EXPECT_CALL(*mock, CreateResumableSession(_))
+      .WillOnce(Invoke([this](internal::ResumableUploadRequest const& r) {
+        EXPECT_EQ("test-object-name", r.object_name());
+        EXPECT_EQ(7, r.GetOption<IfGenerationNotMatch>().value());
+        EXPECT_EQ(3, r.GetOption<IfMetagenerationNotMatch>().value());
+        std::unique_ptr<internal::ResumableUploadSession> session(
+            new FakeUploadSession(bucket, r.object_name()));
+        return make_status_or(std::move(session));
+      }));
+  EXPECT_CALL(*mock, ComposeObject(_)).Times(0);
+
+  auto metadata = client->UploadFile(
+      file_name, "test-bucket-name", "test-object-name", ParallelUpload(4, 1),
+      IfGenerationNotMatch(7), IfMetagenerationNotMatch(3));
+  EXPECT_EQ(ComputeCrc32c(contents), metadata.crc32c());
+  EXPECT_TRUE(contents == bucket.Get("test-object-name"));
+}
+
+}  // namespace
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -47,6 +47,41 @@ inline std::ostream& operator<<(std::ostream& os, ReadRangeData const& rhs) {
             << "}";
 }
 
+struct ParallelDownloadData {
+  int stream_count;
+  std::int64_t minimum_slice_size;
+};
+
+/**
+ * Download an object to a file using multiple concurrent streams.
+ *
+ * By default `Client::DownloadToFile()` reads the object using a single
+ * stream. With this option the object is split into (at most) `stream_count`
+ * slices, each one is downloaded using a separate range request and written
+ * at its offset in the destination file. Slices are never smaller than
+ * `minimum_slice_size`, so small objects use fewer streams.
+ *
+ * Each slice is retried independently, resuming from the last byte received.
+ * The CRC32C checksums of the slices are combined, and compared against the
+ * object checksum when the full object is downloaded.
+ *
+ * This option is ignored by `Client::ReadObject()`.
+ */
+struct ParallelDownload
+    : public internal::ComplexOption<ParallelDownload, ParallelDownloadData> {
+  ParallelDownload() : ComplexOption() {}
+  explicit ParallelDownload(int stream_count,
+                            std::int64_t minimum_slice_size = 16 * 1024 * 1024)
+      : ComplexOption(ParallelDownloadData{stream_count, minimum_slice_size}) {}
+  static char const* name() { return "parallel-download"; }
+};
+
+inline std::ostream& operator<<(std::ostream& os,
+                                ParallelDownloadData const& rhs) {
+  return os << "ParallelDownloadData={stream_count=" << rhs.stream_count
+            << ", minimum_slice_size=" << rhs.minimum_slice_size << "}";
+}
+
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
 }  // namespace cloud
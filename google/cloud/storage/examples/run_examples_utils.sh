@@ -369,6 +369,9 @@ _EOF_
   run_example ./storage_object_samples download-file \
       "${bucket_name}" "${object_name}" "${download_file_name}"
   diff "${upload_file_name}" "${download_file_name}"
+  run_example ./storage_object_samples download-file-parallel \
+      "${bucket_name}" "${object_name}" "${download_file_name}" 4
+  diff "${upload_file_name}" "${download_file_name}"
 
   run_example ./storage_object_samples delete-object \
       "${bucket_name}" "${object_name}"
@@ -406,6 +409,15 @@ _EOF_
       "${bucket_name}" "${object_name}" "${download_file_name}"
   diff "${upload_file_name}" "${download_file_name}"
 
+  run_example ./storage_object_samples delete-object \
+      "${bucket_name}" "${object_name}"
+
+  run_example ./storage_object_samples upload-file-parallel \
+      "${upload_file_name}" "${bucket_name}" "${object_name}" 4
+  run_example ./storage_object_samples download-file \
+      "${bucket_name}" "${object_name}" "${download_file_name}"
+  diff "${upload_file_name}" "${download_file_name}"
+
   run_example ./storage_object_samples delete-object \
       "${bucket_name}" "${object_name}"
 }
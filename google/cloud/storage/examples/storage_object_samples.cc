@@ -463,6 +463,34 @@ void UploadFileResumable(google::cloud::storage::Client client, int& argc,
   (std::move(client), file_name, bucket_name, object_name);
 }
 
+void UploadFileParallel(google::cloud::storage::Client client, int& argc,
+                        char* argv[]) {
+  if (argc != 5) {
+    throw Usage{
+        "upload-file-parallel <file-name> <bucket-name> <object-name>"
+        " <stream-count>"};
+  }
+  auto file_name = ConsumeArg(argc, argv);
+  auto bucket_name = ConsumeArg(argc, argv);
+  auto object_name = ConsumeArg(argc, argv);
+  auto stream_count = std::stoi(ConsumeArg(argc, argv));
+
+  //! [upload file parallel]
+  namespace gcs = google::cloud::storage;
+  [](gcs::Client client, std::string file_name, std::string bucket_name,
+     std::string object_name, int stream_count) {
+    // The file is uploaded as up to `stream_count` temporary objects, which are
+    // then composed into the destination and deleted.
+    gcs::ObjectMetadata meta = client.UploadFile(
+        file_name, bucket_name, object_name, gcs::IfGenerationMatch(0),
+        gcs::ParallelUpload(stream_count));
+    std::cout << "Uploaded " << file_name << " to " << object_name
+              << " using up to " << stream_count << " streams" << std::endl;
+  }
+  //! [upload file parallel]
+  (std::move(client), file_name, bucket_name, object_name, stream_count);
+}
+
 void DownloadFile(google::cloud::storage::Client client, int& argc,
                   char* argv[]) {
   if (argc != 4) {
@@ -484,6 +512,31 @@ void DownloadFile(google::cloud::storage::Client client, int& argc,
   (std::move(client), bucket_name, object_name, file_name);
 }
 
+void DownloadFileParallel(google::cloud::storage::Client client, int& argc,
+                          char* argv[]) {
+  if (argc != 5) {
+    throw Usage{
+        "download-file-parallel <bucket-name> <object-name> <file-name>"
+        " <stream-count>"};
+  }
+  auto bucket_name = ConsumeArg(argc, argv);
+  auto object_name = ConsumeArg(argc, argv);
+  auto file_name = ConsumeArg(argc, argv);
+  auto stream_count = std::stoi(ConsumeArg(argc, argv));
+
+  //! [download file parallel]
+  namespace gcs = google::cloud::storage;
+  [](gcs::Client client, std::string bucket_name, std::string object_name,
+     std::string file_name, int stream_count) {
+    client.DownloadToFile(bucket_name, object_name, file_name,
+                          gcs::ParallelDownload(stream_count));
+    std::cout << "Downloaded " << object_name << " to " << file_name
+              << " using up to " << stream_count << " streams" << std::endl;
+  }
+  //! [download file parallel]
+  (std::move(client), bucket_name, object_name, file_name, stream_count);
+}
+
 void UpdateObjectMetadata(google::cloud::storage::Client client, int& argc,
                           char* argv[]) {
   if (argc != 5) {
@@ -1171,7 +1224,9 @@ int main(int argc, char* argv[]) try {
       {"resume-resumable-upload", &ResumeResumableUpload},
       {"upload-file", &UploadFile},
       {"upload-file-resumable", &UploadFileResumable},
+      {"upload-file-parallel", &UploadFileParallel},
       {"download-file", &DownloadFile},
+      {"download-file-parallel", &DownloadFileParallel},
       {"update-object-metadata", &UpdateObjectMetadata},
       {"patch-object-delete-metadata", &PatchObjectDeleteMetadata},
       {"patch-object-content-type", &PatchObjectContentType},
@@ -93,6 +93,25 @@ struct DisableCrc32cChecksum
   static char const* name() { return "disable-crc32c-checksum"; }
 };
 
+/**
+ * Compute the MD5 hashes and CRC32C checksums in a separate thread.
+ *
+ * By default the GCS client library computes hashes and checksums in the same
+ * thread that sends or receives the data. For very fast transfers this can
+ * become the bottleneck. With this option each hash is computed in a separate
+ * worker thread, overlapping the computation with the transfer, and computing
+ * the MD5 hash and CRC32C checksum in parallel.
+ *
+ * The data is copied before it is handed to the worker threads. The library
+ * limits the amount of pending data, blocking the transfer if the workers fall
+ * behind.
+ */
+struct ComputeHashesInBackground
+    : public internal::ComplexOption<ComputeHashesInBackground, bool> {
+  using ComplexOption<ComputeHashesInBackground, bool>::ComplexOption;
+  static char const* name() { return "compute-hashes-in-background"; }
+};
+
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
 }  // namespace cloud
@@ -0,0 +1,110 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/crc32c.h"
+#include "google/cloud/internal/big_endian.h"
+#include "google/cloud/storage/internal/openssl_util.h"
+#include <array>
+#include <cstring>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+// The CRC32C polynomial, in the reversed bit order used by the checksum.
+std::uint32_t const kCrc32cPolynomial = 0x82F63B78U;
+
+using Gf2Matrix = std::array<std::uint32_t, 32>;
+
+/// Multiplies the 32x32 matrix @p mat over GF(2) by the vector @p vec.
+std::uint32_t Gf2MatrixTimes(Gf2Matrix const& mat, std::uint32_t vec) {
+  std::uint32_t sum = 0;
+  for (auto const& row : mat) {
+    if (vec == 0) {
+      break;
+    }
+    if ((vec & 1U) != 0) {
+      sum ^= row;
+    }
+    vec >>= 1U;
+  }
+  return sum;
+}
+
+/// Computes `mat * mat` over GF(2).
+Gf2Matrix Gf2MatrixSquare(Gf2Matrix const& mat) {
+  Gf2Matrix square;
+  for (std::size_t n = 0; n != square.size(); ++n) {
+    square[n] = Gf2MatrixTimes(mat, mat[n]);
+  }
+  return square;
+}
+}  // namespace
+
+std::uint32_t Crc32cCombine(std::uint32_t crc1, std::uint32_t crc2,
+                            std::uint64_t len2) {
+  if (len2 == 0) {
+    return crc1;
+  }
+  // This is the algorithm used by zlib's crc32_combine(): appending `len2`
+  // zero bytes to a message is a linear operation on its CRC, represented by a
+  // matrix over GF(2). The operator for a single zero bit is easy to compute,
+  // the operator for `len2` zero bytes is computed by repeated squaring.
+  Gf2Matrix odd;
+  odd[0] = kCrc32cPolynomial;
+  std::uint32_t row = 1;
+  for (std::size_t n = 1; n != odd.size(); ++n) {
+    odd[n] = row;
+    row <<= 1U;
+  }
+  // The operators for two and four zero bits.
+  Gf2Matrix even = Gf2MatrixSquare(odd);
+  odd = Gf2MatrixSquare(even);
+
+  // Each iteration squares the operator (i.e., doubles the number of zero
+  // bytes), and applies it to `crc1` if the corresponding bit in `len2` is set.
+  // The first iteration computes the operator for one zero byte.
+  do {
+    even = Gf2MatrixSquare(odd);
+    if ((len2 & 1U) != 0) {
+      crc1 = Gf2MatrixTimes(even, crc1);
+    }
+    len2 >>= 1U;
+    if (len2 == 0) {
+      break;
+    }
+    odd = Gf2MatrixSquare(even);
+    if ((len2 & 1U) != 0) {
+      crc1 = Gf2MatrixTimes(odd, crc1);
+    }
+    len2 >>= 1U;
+  } while (len2 != 0);
+
+  return crc1 ^ crc2;
+}
+
+std::string Crc32cToBase64(std::uint32_t crc) {
+  std::uint32_t big_endian = google::cloud::internal::ToBigEndian(crc);
+  std::string hash(sizeof(big_endian), '\0');
+  std::memcpy(&hash[0], &big_endian, sizeof(big_endian));
+  return OpenSslUtils::Base64Encode(hash);
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
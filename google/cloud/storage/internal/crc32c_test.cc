@@ -0,0 +1,64 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/crc32c.h"
+#include <crc32c/crc32c.h>
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+std::uint32_t Crc32c(std::string const& data) {
+  return crc32c::Extend(
+      0, reinterpret_cast<std::uint8_t const*>(data.data()), data.size());
+}
+
+TEST(Crc32cTest, CombineEmpty) {
+  auto const crc = Crc32c("The quick brown fox jumps over the lazy dog");
+  EXPECT_EQ(crc, Crc32cCombine(crc, Crc32c(""), 0));
+  EXPECT_EQ(crc, Crc32cCombine(Crc32c(""), crc, 43));
+}
+
+TEST(Crc32cTest, CombineSimple) {
+  std::string const a = "The quick brown fox";
+  std::string const b = " jumps over the lazy dog";
+  EXPECT_EQ(Crc32c(a + b), Crc32cCombine(Crc32c(a), Crc32c(b), b.size()));
+}
+
+TEST(Crc32cTest, CombineManySlices) {
+  std::string data;
+  for (int i = 0; i != 10000; ++i) {
+    data += "line " + std::to_string(i) + ": lorem ipsum dolor sit amet\n";
+  }
+  auto const expected = Crc32c(data);
+  for (std::size_t slice_size : {1U, 7U, 4096U, 100000U}) {
+    std::uint32_t actual = 0;
+    for (std::size_t offset = 0; offset < data.size(); offset += slice_size) {
+      auto slice = data.substr(offset, slice_size);
+      actual = Crc32cCombine(actual, Crc32c(slice), slice.size());
+    }
+    EXPECT_EQ(expected, actual) << "slice_size=" << slice_size;
+  }
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -21,6 +21,7 @@
 #include "google/cloud/storage/internal/curl_streambuf.h"
 #include "google/cloud/storage/internal/generate_message_boundary.h"
 #include "google/cloud/storage/object_stream.h"
+#include <algorithm>
 
 namespace google {
 namespace cloud {
@@ -29,15 +30,16 @@ inline namespace STORAGE_CLIENT_NS {
 namespace internal {
 namespace {
 
-extern "C" void CurlShareLockCallback(CURL*, curl_lock_data, curl_lock_access,
-                                      void* userptr) {
+extern "C" void CurlShareLockCallback(CURL*, curl_lock_data data,
+                                      curl_lock_access, void* userptr) {
   auto* client = reinterpret_cast<CurlClient*>(userptr);
-  client->LockShared();
+  client->LockShared(data);
 }
 
-extern "C" void CurlShareUnlockCallback(CURL*, curl_lock_data, void* userptr) {
+extern "C" void CurlShareUnlockCallback(CURL*, curl_lock_data data,
+                                        void* userptr) {
   auto* client = reinterpret_cast<CurlClient*>(userptr);
-  client->UnlockShared();
+  client->UnlockShared(data);
 }
 
 std::shared_ptr<CurlHandleFactory> CreateHandleFactory(
@@ -50,19 +52,36 @@ std::shared_ptr<CurlHandleFactory> CreateHandleFactory(
 }
 
 std::unique_ptr<HashValidator> CreateHashValidator(bool disable_md5,
-                                                   bool disable_crc32c) {
+                                                   bool disable_crc32c,
+                                                   bool background) {
   if (disable_md5 and disable_crc32c) {
     return google::cloud::internal::make_unique<NullHashValidator>();
   }
+  // Each hash runs in its own worker thread when computed in the background,
+  // that way the MD5 hash and CRC32C checksum are computed in parallel.
+  auto wrap = [background](std::unique_ptr<HashValidator> validator) {
+    if (not background) {
+      return validator;
+    }
+    return std::unique_ptr<HashValidator>(new BackgroundHashValidator(
+        std::move(validator)));
+  };
   if (disable_md5) {
-    return google::cloud::internal::make_unique<Crc32cHashValidator>();
+    return wrap(google::cloud::internal::make_unique<Crc32cHashValidator>());
   }
   if (disable_crc32c) {
-    return google::cloud::internal::make_unique<MD5HashValidator>();
+    return wrap(google::cloud::internal::make_unique<MD5HashValidator>());
   }
   return google::cloud::internal::make_unique<CompositeValidator>(
-      google::cloud::internal::make_unique<Crc32cHashValidator>(),
-      google::cloud::internal::make_unique<MD5HashValidator>());
+      wrap(google::cloud::internal::make_unique<Crc32cHashValidator>()),
+      wrap(google::cloud::internal::make_unique<MD5HashValidator>()));
+}
+
+/// Returns true if the request asks for hashes to be computed in background.
+template <typename Request>
+bool ComputeInBackground(Request const& request) {
+  return request.template HasOption<ComputeHashesInBackground>() and
+         request.template GetOption<ComputeHashesInBackground>().value();
 }
 
 /// Create a HashValidator for a download request.
@@ -72,14 +91,16 @@ std::unique_ptr<HashValidator> CreateHashValidator(
     return google::cloud::internal::make_unique<NullHashValidator>();
   }
   return CreateHashValidator(request.HasOption<DisableMD5Hash>(),
-                             request.HasOption<DisableCrc32cChecksum>());
+                             request.HasOption<DisableCrc32cChecksum>(),
+                             ComputeInBackground(request));
 }
 
 /// Create a HashValidator for an upload request.
 std::unique_ptr<HashValidator> CreateHashValidator(
     InsertObjectStreamingRequest const& request) {
   return CreateHashValidator(request.HasOption<DisableMD5Hash>(),
-                             request.HasOption<DisableCrc32cChecksum>());
+                             request.HasOption<DisableCrc32cChecksum>(),
+                             ComputeInBackground(request));
 }
 
 /// Create a HashValidator for an insert request.
@@ -109,6 +130,13 @@ std::string UrlEscapeString(std::string const& value) {
   return std::string(handle.MakeEscapedString(value).get());
 }
 
+template <typename T>
+future<T> MakeReadyFuture(T value) {
+  promise<T> p;
+  p.set_value(std::move(value));
+  return p.get_future();
+}
+
 template <typename ReturnType>
 StatusOr<ReturnType> ParseFromString(StatusOr<HttpResponse> response) {
   if (not response.ok()) {
@@ -149,9 +177,16 @@ Status CurlClient::SetupBuilderCommon(CurlRequestBuilder& builder,
   if (not auth_header.ok()) {
     return std::move(auth_header).status();
   }
+  if (not event_loops_.empty()) {
+    auto index = next_event_loop_.fetch_add(1) % event_loops_.size();
+    builder.SetEventLoop(event_loops_[index]);
+  }
   builder.SetMethod(method)
       .SetDebugLogging(options_.enable_http_tracing())
       .SetCurlShare(share_.get())
+      .SetTcpKeepAlive(options_.tcp_keepalive_interval())
+      .SetMaximumConnectionIdleTime(options_.maximum_connection_idle_time())
+      .SetHttp2(options_.enable_http2())
       .AddUserAgentPrefix(options_.user_agent_prefix())
       .AddHeader(auth_header.value());
   return Status();
@@ -231,6 +266,7 @@ CurlClient::CurlClient(ClientOptions options)
     : options_(std::move(options)),
       share_(curl_share_init(), &curl_share_cleanup),
       generator_(google::cloud::internal::MakeDefaultPRNG()),
+      next_event_loop_(0),
       storage_factory_(CreateHandleFactory(options_)),
       upload_factory_(CreateHandleFactory(options_)),
       xml_upload_factory_(CreateHandleFactory(options_)),
@@ -258,6 +294,77 @@ CurlClient::CurlClient(ClientOptions options)
   curl_share_setopt(share_.get(), CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
 
   CurlInitializeOnce(options.enable_ssl_locking_callbacks());
+
+  for (std::size_t i = 0; i != options_.event_loop_thread_count(); ++i) {
+    event_loops_.emplace_back(CurlEventLoop::Create());
+  }
+
+  if (options_.enable_connection_pool_prewarm()) {
+    (void)PrewarmConnectionPool();
+  }
+}
+
+std::size_t CurlClient::PrewarmConnectionPool() {
+  // All the handles share the connection cache in `share_`, so the connections
+  // opened here are available to any request. The requests are HEAD requests,
+  // the responses are ignored.
+  auto const count = std::max(options_.connection_pool_size(),
+                              static_cast<std::size_t>(1));
+  auto const timeout_ms =
+      static_cast<long>(options_.connection_pool_prewarm_timeout().count());
+  auto multi = storage_factory_->CreateMultiHandle();
+  std::vector<CurlPtr> handles;
+  for (std::size_t i = 0; i != count; ++i) {
+    auto handle = storage_factory_->CreateHandle();
+    (void)curl_easy_setopt(handle.get(), CURLOPT_URL,
+                           storage_endpoint_.c_str());
+    (void)curl_easy_setopt(handle.get(), CURLOPT_NOBODY, 1L);
+    (void)curl_easy_setopt(handle.get(), CURLOPT_SHARE, share_.get());
+    // This runs in the constructor, do not wait for the OS connect timeout if
+    // the endpoint is unreachable.
+    (void)curl_easy_setopt(handle.get(), CURLOPT_CONNECTTIMEOUT_MS, timeout_ms);
+    (void)curl_easy_setopt(handle.get(), CURLOPT_TIMEOUT_MS, timeout_ms);
+    (void)curl_easy_setopt(handle.get(), CURLOPT_NOSIGNAL, 1L);
+    SetCurlTcpKeepAlive(handle.get(), options_.tcp_keepalive_interval());
+    SetCurlMaximumConnectionIdleTime(handle.get(),
+                                     options_.maximum_connection_idle_time());
+    SetCurlHttp2(handle.get(), options_.enable_http2());
+    (void)curl_multi_add_handle(multi.get(), handle.get());
+    handles.push_back(std::move(handle));
+  }
+
+  int running_handles = static_cast<int>(handles.size());
+  while (running_handles != 0) {
+    auto result = curl_multi_perform(multi.get(), &running_handles);
+    if (result != CURLM_OK) {
+      GCP_LOG(INFO) << "Error prewarming connection pool: "
+                    << curl_multi_strerror(result);
+      break;
+    }
+    if (running_handles != 0) {
+      (void)curl_multi_wait(multi.get(), nullptr, 0, 1000, nullptr);
+    }
+  }
+  std::size_t connected = 0;
+  int remaining;
+  while (auto* msg = curl_multi_info_read(multi.get(), &remaining)) {
+    if (msg->msg != CURLMSG_DONE) {
+      continue;
+    }
+    if (msg->data.result == CURLE_OK) {
+      ++connected;
+      continue;
+    }
+    GCP_LOG(INFO) << "Error prewarming connection to " << storage_endpoint_
+                  << ": " << curl_easy_strerror(msg->data.result);
+  }
+
+  for (auto& handle : handles) {
+    (void)curl_multi_remove_handle(multi.get(), handle.get());
+    storage_factory_->CleanupHandle(std::move(handle));
+  }
+  storage_factory_->CleanupMultiHandle(std::move(multi));
+  return connected;
 }
 
 StatusOr<ResumableUploadResponse> CurlClient::UploadChunk(
@@ -692,6 +799,140 @@ CurlClient::RestoreResumableSession(std::string const& session_id) {
   return std::move(response).status();
 }
 
+future<StatusOr<ObjectMetadata>> CurlClient::AsyncInsertObjectMedia(
+    InsertObjectMediaRequest const& request) {
+  // The asynchronous version always uses a multipart upload, which supports
+  // all the request options, and formats the full payload before starting the
+  // transfer.
+  CurlRequestBuilder builder(
+      upload_endpoint_ + "/b/" + request.bucket_name() + "/o", upload_factory_);
+  auto status = SetupBuilder(builder, request, "POST");
+  if (not status.ok()) {
+    return MakeReadyFuture(StatusOr<ObjectMetadata>(std::move(status)));
+  }
+  auto boundary = PickBoundary(request.contents());
+  builder.AddHeader("content-type: multipart/related; boundary=" + boundary);
+  builder.AddQueryParameter("uploadType", "multipart");
+  builder.AddQueryParameter("name", request.object_name());
+
+  nl::json metadata = nl::json::object();
+  if (request.HasOption<WithObjectMetadata>()) {
+    metadata = request.GetOption<WithObjectMetadata>().value().JsonForUpdate();
+  }
+  if (request.HasOption<MD5HashValue>()) {
+    metadata["md5Hash"] = request.GetOption<MD5HashValue>().value();
+  } else if (not request.HasOption<DisableMD5Hash>()) {
+    metadata["md5Hash"] = ComputeMD5Hash(request.contents());
+  }
+  if (request.HasOption<Crc32cChecksumValue>()) {
+    metadata["crc32c"] = request.GetOption<Crc32cChecksumValue>().value();
+  } else if (not request.HasOption<DisableCrc32cChecksum>()) {
+    metadata["crc32c"] = ComputeCrc32cChecksum(request.contents());
+  }
+
+  std::string content_type = "application/octet-stream";
+  if (request.HasOption<ContentType>()) {
+    content_type = request.GetOption<ContentType>().value();
+  } else if (metadata.count("contentType") != 0) {
+    content_type = metadata.value("contentType", content_type);
+  }
+
+  std::string const crlf = "\r\n";
+  std::string const marker = "--" + boundary;
+  std::string payload;
+  payload.reserve(request.contents().size() + 1024);
+  payload += marker + crlf;
+  payload += "content-type: application/json; charset=UTF-8" + crlf + crlf;
+  payload += metadata.dump() + crlf;
+  payload += marker + crlf;
+  payload += "content-type: " + content_type + crlf + crlf;
+  payload += request.contents();
+  payload += crlf + marker + "--" + crlf;
+
+  auto self = shared_from_this();
+  return CurlRequest::MakeRequestAsync(builder.BuildRequest(), AsyncEventLoop(),
+                                       std::move(payload))
+      .then([self](future<StatusOr<HttpResponse>> f) {
+        return ParseFromString<ObjectMetadata>(f.get());
+      });
+}
+
+future<StatusOr<ObjectMetadata>> CurlClient::AsyncGetObjectMetadata(
+    GetObjectMetadataRequest const& request) {
+  CurlRequestBuilder builder(storage_endpoint_ + "/b/" + request.bucket_name() +
+                                 "/o/" + UrlEscapeString(request.object_name()),
+                             storage_factory_);
+  auto status = SetupBuilder(builder, request, "GET");
+  if (not status.ok()) {
+    return MakeReadyFuture(StatusOr<ObjectMetadata>(std::move(status)));
+  }
+  auto self = shared_from_this();
+  return CurlRequest::MakeRequestAsync(builder.BuildRequest(), AsyncEventLoop(),
+                                       std::string{})
+      .then([self](future<StatusOr<HttpResponse>> f) {
+        return ParseFromString<ObjectMetadata>(f.get());
+      });
+}
+
+future<StatusOr<std::string>> CurlClient::AsyncReadObject(
+    ReadObjectRangeRequest const& request) {
+  CurlRequestBuilder builder(storage_endpoint_ + "/b/" + request.bucket_name() +
+                                 "/o/" + UrlEscapeString(request.object_name()),
+                             storage_factory_);
+  auto status = SetupBuilder(builder, request, "GET");
+  if (not status.ok()) {
+    return MakeReadyFuture(StatusOr<std::string>(std::move(status)));
+  }
+  builder.AddQueryParameter("alt", "media");
+  if (request.HasOption<ReadRange>()) {
+    auto range = request.GetOption<ReadRange>().value();
+    std::string header = "Range: bytes=" + std::to_string(range.begin) + "-" +
+                         std::to_string(range.end - 1);
+    builder.AddHeader(header);
+    // Range reads do not work with decompressive transcoding, see ReadObject().
+    builder.AddHeader("Cache-Control: no-transform");
+  }
+
+  auto self = shared_from_this();
+  std::shared_ptr<HashValidator> validator = CreateHashValidator(request);
+  return CurlRequest::MakeRequestAsync(builder.BuildRequest(), AsyncEventLoop(),
+                                       std::string{})
+      .then([self, validator](future<StatusOr<HttpResponse>> f)
+                -> StatusOr<std::string> {
+        auto response = f.get();
+        if (not response.ok()) {
+          return std::move(response).status();
+        }
+        if (response->status_code >= 300) {
+          return AsStatus(*response);
+        }
+        for (auto const& kv : response->headers) {
+          validator->ProcessHeader(kv.first, kv.second);
+        }
+        validator->Update(response->payload);
+        auto result = std::move(*validator).Finish();
+        if (result.is_mismatch) {
+          std::string msg = "AsyncReadObject() - mismatched hashes in download";
+          msg += ", expected=";
+          msg += result.computed;
+          msg += ", received=";
+          msg += result.received;
+          return Status(StatusCode::kDataLoss, std::move(msg));
+        }
+        return std::move(response->payload);
+      });
+}
+
+future<void> CurlClient::AsyncSleep(std::chrono::milliseconds duration) {
+  // std::function<> must be copyable, wrap the promise in a shared_ptr<>.
+  auto done = std::make_shared<promise<void>>();
+  auto f = done->get_future();
+  auto self = shared_from_this();
+  AsyncEventLoop()->AddTimer(std::chrono::steady_clock::now() + duration,
+                             [self, done] { done->set_value(); });
+  return f;
+}
+
 StatusOr<ListBucketAclResponse> CurlClient::ListBucketAcl(
     ListBucketAclRequest const& request) {
   CurlRequestBuilder builder(
@@ -1041,9 +1282,37 @@ StatusOr<EmptyResponse> CurlClient::DeleteNotification(
   return ReturnEmptyResponse(builder.BuildRequest().MakeRequest(std::string{}));
 }
 
-void CurlClient::LockShared() { mu_.lock(); }
+std::size_t CurlClient::EventLoopConnectionCount() {
+  std::size_t count = 0;
+  for (auto const& loop : event_loops_) {
+    count += loop->connection_count();
+  }
+  std::lock_guard<std::mutex> lk(async_mu_);
+  if (async_event_loop_) {
+    count += async_event_loop_->connection_count();
+  }
+  return count;
+}
+
+std::shared_ptr<CurlEventLoop> CurlClient::AsyncEventLoop() {
+  if (not event_loops_.empty()) {
+    auto index = next_event_loop_.fetch_add(1) % event_loops_.size();
+    return event_loops_[index];
+  }
+  std::lock_guard<std::mutex> lk(async_mu_);
+  if (not async_event_loop_) {
+    async_event_loop_ = CurlEventLoop::Create();
+  }
+  return async_event_loop_;
+}
 
-void CurlClient::UnlockShared() { mu_.unlock(); }
+void CurlClient::LockShared(curl_lock_data data) {
+  share_mu_[data % CURL_LOCK_DATA_LAST].lock();
+}
+
+void CurlClient::UnlockShared(curl_lock_data data) {
+  share_mu_[data % CURL_LOCK_DATA_LAST].unlock();
+}
 
 StatusOr<ObjectMetadata> CurlClient::InsertObjectMediaXml(
     InsertObjectMediaRequest const& request) {
@@ -16,11 +16,14 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_CLIENT_H_
 
 #include "google/cloud/internal/random.h"
+#include "google/cloud/storage/internal/curl_event_loop.h"
 #include "google/cloud/storage/internal/curl_handle_factory.h"
 #include "google/cloud/storage/internal/raw_client.h"
 #include "google/cloud/storage/internal/resumable_upload_session.h"
 #include "google/cloud/storage/oauth2/credentials.h"
+#include <atomic>
 #include <mutex>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -111,6 +114,14 @@ class CurlClient : public RawClient,
   StatusOr<std::unique_ptr<ResumableUploadSession>> RestoreResumableSession(
       std::string const& session_id) override;
 
+  future<StatusOr<ObjectMetadata>> AsyncInsertObjectMedia(
+      InsertObjectMediaRequest const& request) override;
+  future<StatusOr<ObjectMetadata>> AsyncGetObjectMetadata(
+      GetObjectMetadataRequest const& request) override;
+  future<StatusOr<std::string>> AsyncReadObject(
+      ReadObjectRangeRequest const& request) override;
+  future<void> AsyncSleep(std::chrono::milliseconds duration) override;
+
   StatusOr<ListBucketAclResponse> ListBucketAcl(
       ListBucketAclRequest const& request) override;
   StatusOr<ObjectMetadata> CopyObject(
@@ -169,8 +180,19 @@ class CurlClient : public RawClient,
   StatusOr<std::string> AuthorizationHeader(
       std::shared_ptr<google::cloud::storage::oauth2::Credentials> const&);
 
-  void LockShared();
-  void UnlockShared();
+  void LockShared(curl_lock_data data);
+  void UnlockShared(curl_lock_data data);
+
+  /**
+   * Opens connections to the storage endpoint before they are needed.
+   *
+   * @return the number of prewarm requests that completed, each left an open
+   *     connection in the connection cache.
+   */
+  std::size_t PrewarmConnectionPool();
+
+  /// The number of connections opened by transfers in the event loops.
+  std::size_t EventLoopConnectionCount();
 
  protected:
   // The constructor is private because the class must always be created
@@ -214,6 +236,9 @@ class CurlClient : public RawClient,
   StatusOr<std::unique_ptr<ResumableUploadSession>>
   CreateResumableSessionGeneric(RequestType const& request);
 
+  /// Returns the event loop for the next asynchronous operation.
+  std::shared_ptr<CurlEventLoop> AsyncEventLoop();
+
   ClientOptions options_;
   std::string storage_endpoint_;
   std::string upload_endpoint_;
@@ -221,9 +246,22 @@ class CurlClient : public RawClient,
   std::string xml_download_endpoint_;
 
   std::mutex mu_;
-  CurlShare share_ /* GUARDED_BY(mu_) */;
+  // libcurl may hold the lock for one kind of shared data while it acquires
+  // the lock for another kind, so each kind needs its own mutex.
+  std::mutex share_mu_[CURL_LOCK_DATA_LAST];
+  CurlShare share_ /* GUARDED_BY(share_mu_) */;
   google::cloud::internal::DefaultPRNG generator_;
 
+  // Streaming transfers are assigned to the event loops in round-robin order.
+  // Empty unless `ClientOptions::event_loop_thread_count()` is set.
+  std::vector<std::shared_ptr<CurlEventLoop>> event_loops_;
+  std::atomic<std::size_t> next_event_loop_;
+
+  // The asynchronous operations use `event_loops_` when available, otherwise
+  // they share this event loop, which is created on first use.
+  std::mutex async_mu_;
+  std::shared_ptr<CurlEventLoop> async_event_loop_;  // GUARDED_BY(async_mu_)
+
   // The factories must be listed *after* the CurlShare. libcurl keeps a
   // usage count on each CURLSH* handle, which is only released once the CURL*
   // handle is *closed*. So we want the order of destruction to be (1)
@@ -20,9 +20,16 @@
 #include "google/cloud/storage/oauth2/google_credentials.h"
 #include "google/cloud/testing_util/environment_variable_restore.h"
 #include <gmock/gmock.h>
+#include <chrono>
 #include <memory>
 #include <utility>
 #include <vector>
+#if GTEST_OS_LINUX
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif  // GTEST_OS_LINUX
 
 namespace google {
 namespace cloud {
@@ -401,6 +408,60 @@ TEST_P(CurlClientTest, DeleteNotification) {
   TestCorrectFailureStatus(status_or_foo.status());
 }
 
+/// @test Verify that a failed prewarm does not break the client creation.
+TEST(CurlClientPrewarmTest, FailureDoesNotBreakConstruction) {
+  auto client =
+      CurlClient::Create(ClientOptions(oauth2::CreateAnonymousCredentials())
+                             .set_endpoint("http://localhost:0")
+                             .set_connection_pool_size(4)
+                             .set_enable_connection_pool_prewarm(true));
+  ASSERT_NE(nullptr, client.get());
+  EXPECT_EQ(0U, client->PrewarmConnectionPool());
+  auto status = client->ListBuckets(ListBucketsRequest("project")).status();
+  EXPECT_EQ(StatusCode::kUnknown, status.status_code());
+}
+
+/// @test Verify that prewarming an unresponsive endpoint respects the timeout.
+TEST(CurlClientPrewarmTest, UnresponsiveEndpointTimesOut) {
+#if GTEST_OS_LINUX
+  // The kernel completes the connections to a listening socket, but nothing
+  // ever reads the requests or sends a response.
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  ASSERT_NE(-1, fd);
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  address.sin_port = 0;
+  ASSERT_EQ(0, bind(fd, reinterpret_cast<sockaddr*>(&address),
+                    sizeof(address)));
+  ASSERT_EQ(0, listen(fd, 16));
+  socklen_t length = sizeof(address);
+  ASSERT_EQ(0, getsockname(fd, reinterpret_cast<sockaddr*>(&address),
+                           &length));
+  auto const endpoint =
+      "http://127.0.0.1:" + std::to_string(ntohs(address.sin_port));
+#else
+  // Without a listener the connections fail right away.
+  std::string const endpoint = "http://localhost:0";
+#endif  // GTEST_OS_LINUX
+
+  auto const start = std::chrono::steady_clock::now();
+  auto client =
+      CurlClient::Create(ClientOptions(oauth2::CreateAnonymousCredentials())
+                             .set_endpoint(endpoint)
+                             .set_connection_pool_size(4)
+                             .set_enable_connection_pool_prewarm(true)
+                             .set_connection_pool_prewarm_timeout(
+                                 std::chrono::milliseconds(100)));
+  auto const elapsed = std::chrono::steady_clock::now() - start;
+  ASSERT_NE(nullptr, client.get());
+  EXPECT_GT(std::chrono::seconds(10), elapsed);
+  EXPECT_EQ(0U, client->PrewarmConnectionPool());
+#if GTEST_OS_LINUX
+  EXPECT_NE(-1, close(fd));
+#endif  // GTEST_OS_LINUX
+}
+
 INSTANTIATE_TEST_CASE_P(CredentialsFailure, CurlClientTest,
                         ::testing::Values("credentials-failure"));
 
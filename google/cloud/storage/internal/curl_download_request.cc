@@ -38,6 +38,9 @@ CurlDownloadRequest::CurlDownloadRequest(std::size_t initial_buffer_size)
 }
 
 StatusOr<HttpResponse> CurlDownloadRequest::Close() {
+  if (event_loop_) {
+    return CloseOnEventLoop();
+  }
   // Set the the closing_ flag to trigger a return 0 from the next read
   // callback, see the comments in the header file for more details.
   closing_ = true;
@@ -63,6 +66,9 @@ StatusOr<HttpResponse> CurlDownloadRequest::Close() {
 }
 
 StatusOr<HttpResponse> CurlDownloadRequest::GetMore(std::string& buffer) {
+  if (event_loop_) {
+    return GetMoreOnEventLoop(buffer);
+  }
   handle_.FlushDebug(__func__);
   auto status = Wait([this] {
     return curl_closed_ or buffer_.size() >= initial_buffer_size_;
@@ -105,8 +111,65 @@ StatusOr<HttpResponse> CurlDownloadRequest::GetMore(std::string& buffer) {
   return HttpResponse{100, {}, {}};
 }
 
+bool CurlDownloadRequest::IsOpen() const {
+  std::unique_lock<std::mutex> lk(mu_, std::defer_lock);
+  if (event_loop_) {
+    // The write callback appends to `buffer_` in the event loop thread.
+    lk.lock();
+  }
+  return not curl_closed_ or not buffer_.empty();
+}
+
+StatusOr<HttpResponse> CurlDownloadRequest::GetMoreDirect(
+    char* data, std::size_t size, std::size_t& bytes_read) {
+  if (event_loop_) {
+    return GetMoreDirectOnEventLoop(data, size, bytes_read);
+  }
+  handle_.FlushDebug(__func__);
+  bytes_read = DrainBuffer(data, size);
+  if (not curl_closed_) {
+    direct_buffer_ = data + bytes_read;
+    direct_size_ = size - bytes_read;
+    // The write callback may have paused the transfer because the buffer was
+    // full, resume it. Note that this may call the write callback immediately.
+    auto status = handle_.EasyPause(CURLPAUSE_RECV_CONT);
+    if (status.ok()) {
+      status = Wait([this] { return curl_closed_ or direct_size_ == 0; });
+    }
+    bytes_read = size - direct_size_;
+    direct_buffer_ = nullptr;
+    direct_size_ = 0;
+    if (not status.ok()) {
+      return status;
+    }
+  }
+  GCP_LOG(DEBUG) << __func__ << "(), bytes_read=" << bytes_read
+                 << ", curl.size=" << buffer_.size() << ", closing=" << closing_
+                 << ", closed=" << curl_closed_;
+  if (not curl_closed_ or not buffer_.empty()) {
+    return HttpResponse{100, {}, {}};
+  }
+  // Remove the handle from the CURLM* interface and wait for the response.
+  auto error = curl_multi_remove_handle(multi_.get(), handle_.handle_.get());
+  auto status = AsStatus(error, __func__);
+  if (not status.ok()) {
+    return status;
+  }
+  StatusOr<long> http_code = handle_.GetResponseCode();
+  if (not http_code.ok()) {
+    return std::move(http_code).status();
+  }
+  return HttpResponse{http_code.value(), std::string{},
+                      std::move(received_headers_)};
+}
+
 Status CurlDownloadRequest::SetOptions() {
   ResetOptions();
+  if (event_loop_) {
+    // The handle is registered with the event loop on the first call to
+    // GetMore() or Close(), at that point this object no longer moves.
+    return Status();
+  }
   auto error = curl_multi_add_handle(multi_.get(), handle_.handle_.get());
   return AsStatus(error, __func__);
 }
@@ -138,6 +201,10 @@ void CurlDownloadRequest::ResetOptions() {
 std::size_t CurlDownloadRequest::WriteCallback(void* ptr, std::size_t size,
                                                std::size_t nmemb) {
   handle_.FlushDebug(__func__);
+  std::unique_lock<std::mutex> lk(mu_, std::defer_lock);
+  if (event_loop_) {
+    lk.lock();
+  }
   GCP_LOG(DEBUG) << __func__ << "() size=" << size << ", nmemb=" << nmemb
                  << ", buffer.size=" << buffer_.size();
   // This transfer is closing, just return zero, that will make libcurl finish
@@ -147,14 +214,160 @@ std::size_t CurlDownloadRequest::WriteCallback(void* ptr, std::size_t size,
   if (closing_) {
     return 0;
   }
+  if (direct_size_ != 0) {
+    // GetMoreDirect() is waiting for data, copy it straight into the caller's
+    // buffer. libcurl requires the callback to consume all the data (or pause),
+    // any excess is kept in `buffer_` for the next call.
+    auto const n = size * nmemb;
+    auto const direct = std::min(n, direct_size_);
+    std::memcpy(direct_buffer_, ptr, direct);
+    direct_buffer_ += direct;
+    direct_size_ -= direct;
+    buffer_.append(static_cast<char const*>(ptr) + direct, n - direct);
+    if (event_loop_ and direct_size_ == 0) {
+      cv_.notify_one();
+    }
+    return n;
+  }
   if (buffer_.size() >= initial_buffer_size_) {
     return CURL_READFUNC_PAUSE;
   }
 
   buffer_.append(static_cast<char const*>(ptr), size * nmemb);
+  if (event_loop_ and buffer_.size() >= initial_buffer_size_) {
+    cv_.notify_one();
+  }
   return size * nmemb;
 }
 
+void CurlDownloadRequest::StartOnEventLoop() {
+  if (registered_) {
+    return;
+  }
+  registered_ = true;
+  event_loop_->AddHandle(handle_.handle_.get(), [this](Status status) {
+    OnTransferDone(std::move(status));
+  });
+}
+
+void CurlDownloadRequest::OnTransferDone(Status status) {
+  handle_.FlushDebug(__func__);
+  std::lock_guard<std::mutex> lk(mu_);
+  transfer_done_ = true;
+  transfer_status_ = std::move(status);
+  cv_.notify_one();
+}
+
+StatusOr<HttpResponse> CurlDownloadRequest::GetMoreOnEventLoop(
+    std::string& buffer) {
+  StartOnEventLoop();
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] {
+    return transfer_done_ or buffer_.size() >= initial_buffer_size_;
+  });
+  buffer_.swap(buffer);
+  buffer_.clear();
+  if (not transfer_done_) {
+    buffer_.reserve(initial_buffer_size_);
+    lk.unlock();
+    // The write callback may have paused the transfer because the buffer was
+    // full, resume it now that the buffer is empty.
+    event_loop_->Unpause(handle_.handle_.get(), CURLPAUSE_RECV_CONT);
+    GCP_LOG(DEBUG) << __func__ << "(), size=" << buffer.size()
+                   << ", closing=" << closing_ << ", closed=" << curl_closed_
+                   << ", code=100";
+    return HttpResponse{100, {}, {}};
+  }
+  curl_closed_ = true;
+  auto status = std::move(transfer_status_);
+  lk.unlock();
+  if (not status.ok()) {
+    return status;
+  }
+  StatusOr<long> http_code = handle_.GetResponseCode();
+  if (not http_code.ok()) {
+    return std::move(http_code).status();
+  }
+  GCP_LOG(DEBUG) << __func__ << "(), size=" << buffer.size()
+                 << ", closing=" << closing_ << ", closed=" << curl_closed_
+                 << ", code=" << *http_code;
+  return HttpResponse{http_code.value(), std::string{},
+                      std::move(received_headers_)};
+}
+
+StatusOr<HttpResponse> CurlDownloadRequest::GetMoreDirectOnEventLoop(
+    char* data, std::size_t size, std::size_t& bytes_read) {
+  StartOnEventLoop();
+  std::unique_lock<std::mutex> lk(mu_);
+  bytes_read = DrainBuffer(data, size);
+  if (bytes_read < size and not transfer_done_) {
+    direct_buffer_ = data + bytes_read;
+    direct_size_ = size - bytes_read;
+    lk.unlock();
+    // The write callback may have paused the transfer because the buffer was
+    // full, resume it so the data flows into `data`.
+    event_loop_->Unpause(handle_.handle_.get(), CURLPAUSE_RECV_CONT);
+    lk.lock();
+    cv_.wait(lk, [this] { return transfer_done_ or direct_size_ == 0; });
+    bytes_read = size - direct_size_;
+    direct_buffer_ = nullptr;
+    direct_size_ = 0;
+  } else if (not transfer_done_) {
+    lk.unlock();
+    event_loop_->Unpause(handle_.handle_.get(), CURLPAUSE_RECV_CONT);
+    lk.lock();
+  }
+  if (not transfer_done_ or not buffer_.empty()) {
+    GCP_LOG(DEBUG) << __func__ << "(), bytes_read=" << bytes_read
+                   << ", closing=" << closing_ << ", code=100";
+    return HttpResponse{100, {}, {}};
+  }
+  curl_closed_ = true;
+  auto status = std::move(transfer_status_);
+  lk.unlock();
+  if (not status.ok()) {
+    return status;
+  }
+  StatusOr<long> http_code = handle_.GetResponseCode();
+  if (not http_code.ok()) {
+    return std::move(http_code).status();
+  }
+  GCP_LOG(DEBUG) << __func__ << "(), bytes_read=" << bytes_read
+                 << ", closing=" << closing_ << ", code=" << *http_code;
+  return HttpResponse{http_code.value(), std::string{},
+                      std::move(received_headers_)};
+}
+
+std::size_t CurlDownloadRequest::DrainBuffer(char* data, std::size_t size) {
+  auto const n = std::min(size, buffer_.size());
+  std::memcpy(data, buffer_.data(), n);
+  buffer_.erase(0, n);
+  return n;
+}
+
+StatusOr<HttpResponse> CurlDownloadRequest::CloseOnEventLoop() {
+  StartOnEventLoop();
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    closing_ = true;
+  }
+  // The transfer may be paused, in which case libcurl will not call the write
+  // callback (and discover that `closing_` is set) until it is resumed.
+  event_loop_->Unpause(handle_.handle_.get(), CURLPAUSE_RECV_CONT);
+  {
+    std::unique_lock<std::mutex> lk(mu_);
+    cv_.wait(lk, [this] { return transfer_done_; });
+    curl_closed_ = true;
+  }
+
+  StatusOr<long> http_code = handle_.GetResponseCode();
+  if (not http_code.ok()) {
+    return http_code.status();
+  }
+  return HttpResponse{http_code.value(), std::string{},
+                      std::move(received_headers_)};
+}
+
 StatusOr<int> CurlDownloadRequest::PerformWork() {
   // Block while there is work to do, apparently newer versions of libcurl do
   // not need this loop and curl_multi_perform() blocks until there is no more
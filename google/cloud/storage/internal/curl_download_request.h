@@ -16,8 +16,11 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_DOWNLOAD_REQUEST_H_
 
 #include "google/cloud/log.h"
+#include "google/cloud/storage/internal/curl_event_loop.h"
 #include "google/cloud/storage/internal/curl_request.h"
 #include "google/cloud/storage/internal/http_response.h"
+#include <condition_variable>
+#include <mutex>
 
 namespace google {
 namespace cloud {
@@ -31,6 +34,11 @@ namespace internal {
  * payload is streamed, and the total size is not known. Under the hood this
  * uses chunked transfer encoding.
  *
+ * If the request is configured with a `CurlEventLoop` the transfer runs in the
+ * event loop background thread, and this class only blocks until the callbacks
+ * (which run in that thread) make progress. Such requests must not be moved
+ * after the first call to `GetMore()` or `Close()`.
+ *
  * @see `CurlRequest` for simpler transfers where the size of the payload is
  *     known and relatively small.
  */
@@ -42,8 +50,13 @@ class CurlDownloadRequest {
     if (not factory_) {
       return;
     }
+    if (event_loop_ and registered_) {
+      event_loop_->RemoveHandle(handle_.handle_.get());
+    }
     factory_->CleanupHandle(std::move(handle_.handle_));
-    factory_->CleanupMultiHandle(std::move(multi_));
+    if (multi_) {
+      factory_->CleanupMultiHandle(std::move(multi_));
+    }
   }
 
   CurlDownloadRequest(CurlDownloadRequest&& rhs) noexcept(false)
@@ -55,6 +68,9 @@ class CurlDownloadRequest {
         handle_(std::move(rhs.handle_)),
         multi_(std::move(rhs.multi_)),
         factory_(std::move(rhs.factory_)),
+        event_loop_(std::move(rhs.event_loop_)),
+        registered_(rhs.registered_),
+        transfer_done_(rhs.transfer_done_),
         closing_(rhs.closing_),
         curl_closed_(rhs.curl_closed_),
         initial_buffer_size_(rhs.initial_buffer_size_) {
@@ -70,6 +86,9 @@ class CurlDownloadRequest {
     handle_ = std::move(rhs.handle_);
     multi_ = std::move(rhs.multi_);
     factory_ = std::move(rhs.factory_);
+    event_loop_ = std::move(rhs.event_loop_);
+    registered_ = rhs.registered_;
+    transfer_done_ = rhs.transfer_done_;
     closing_ = rhs.closing_;
     curl_closed_ = rhs.curl_closed_;
     initial_buffer_size_ = rhs.initial_buffer_size_;
@@ -77,7 +96,8 @@ class CurlDownloadRequest {
     return *this;
   }
 
-  bool IsOpen() const { return not curl_closed_; }
+  /// Returns true while there is data (or a final response) to be returned.
+  bool IsOpen() const;
   StatusOr<HttpResponse> Close();
 
   /**
@@ -92,6 +112,25 @@ class CurlDownloadRequest {
    */
   StatusOr<HttpResponse> GetMore(std::string& buffer);
 
+  /**
+   * Waits for additional data, writing it directly into a caller-owned buffer.
+   *
+   * Any data already received is copied into @p data first. If that does not
+   * fill @p data, this operation blocks until @p size bytes have been written
+   * or the transfer is completed. While it blocks, the libcurl write callback
+   * copies the received bytes straight into @p data, avoiding the intermediate
+   * copy into a `std::string` made by `GetMore()`. If a libcurl chunk does not
+   * fit in the remaining space, the excess is kept in the internal buffer and
+   * returned by the next `GetMore*()` call.
+   *
+   * @param data the location to write the new data.
+   * @param size the number of bytes available in @p data.
+   * @param bytes_read set to the number of bytes written to @p data.
+   * @returns 100-Continue if the transfer is not yet completed.
+   */
+  StatusOr<HttpResponse> GetMoreDirect(char* data, std::size_t size,
+                                       std::size_t& bytes_read);
+
  private:
   friend class CurlRequestBuilder;
   /// Set the underlying CurlHandle options initially.
@@ -103,6 +142,25 @@ class CurlDownloadRequest {
   /// Called by libcurl to show that more data is available in the download.
   std::size_t WriteCallback(void* ptr, std::size_t size, std::size_t nmemb);
 
+  /// Registers the handle with the event loop, if not already registered.
+  void StartOnEventLoop();
+
+  /// Called from the event loop thread when the transfer completes.
+  void OnTransferDone(Status status);
+
+  /// Implements `GetMore()` when the transfer runs in a `CurlEventLoop`.
+  StatusOr<HttpResponse> GetMoreOnEventLoop(std::string& buffer);
+
+  /// Implements `GetMoreDirect()` when the transfer runs in a `CurlEventLoop`.
+  StatusOr<HttpResponse> GetMoreDirectOnEventLoop(char* data, std::size_t size,
+                                                  std::size_t& bytes_read);
+
+  /// Moves up to @p size bytes from `buffer_` into @p data.
+  std::size_t DrainBuffer(char* data, std::size_t size);
+
+  /// Implements `Close()` when the transfer runs in a `CurlEventLoop`.
+  StatusOr<HttpResponse> CloseOnEventLoop();
+
   /// Wait until a condition is met.
   template <typename Predicate>
   Status Wait(Predicate&& predicate) {
@@ -152,7 +210,22 @@ class CurlDownloadRequest {
   CurlMulti multi_;
   std::shared_ptr<CurlHandleFactory> factory_;
 
+  // These members are only used when the transfer runs in a `CurlEventLoop`,
+  // in that case `mu_` guards `buffer_`, `closing_`, `curl_closed_`,
+  // `transfer_done_`, `transfer_status_`, `direct_buffer_` and `direct_size_`,
+  // which are shared with the event loop thread.
+  std::shared_ptr<CurlEventLoop> event_loop_;
+  bool registered_ = false;
+  mutable std::mutex mu_;
+  std::condition_variable cv_;
+  bool transfer_done_ = false;
+  Status transfer_status_;
+
   std::string buffer_;
+  // Set while `GetMoreDirect()` waits for data, the write callback copies up to
+  // `direct_size_` bytes into `direct_buffer_` before using `buffer_`.
+  char* direct_buffer_ = nullptr;
+  std::size_t direct_size_ = 0;
   // Closing the handle happens in two steps.
   // 1. First the application (or higher-level class), calls Close(). This class
   //    needs to notify libcurl that the transfer is terminated by returning 0
@@ -162,7 +235,9 @@ class CurlDownloadRequest {
   // The closing_ flag is set when we enter step 1.
   bool closing_;
   // The curl_closed_ flag is set when we enter step 2, or when the transfer
-  // completes.
+  // completes. With a `CurlEventLoop` the transfer completes in the background
+  // thread (see `transfer_done_`), this flag is only set once the caller has
+  // received all the data.
   bool curl_closed_;
 
   std::size_t initial_buffer_size_;
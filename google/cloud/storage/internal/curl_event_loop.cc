@@ -0,0 +1,322 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/curl_event_loop.h"
+#include "google/cloud/log.h"
+#include <curl/multi.h>
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <sstream>
+#include <vector>
+
+#if LIBCURL_VERSION_NUM >= 0x074400
+#define GOOGLE_CLOUD_CPP_STORAGE_HAVE_CURL_MULTI_WAKEUP 1
+#else
+#define GOOGLE_CLOUD_CPP_STORAGE_HAVE_CURL_MULTI_WAKEUP 0
+#endif  // LIBCURL_VERSION_NUM >= 0x074400
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+// libcurl >= 7.68.0 can interrupt curl_multi_poll() from other threads, so we
+// can afford to block for a long time. With older versions we need to keep the
+// timeout short, otherwise commands posted from other threads would wait until
+// the timeout expires.
+#if GOOGLE_CLOUD_CPP_STORAGE_HAVE_CURL_MULTI_WAKEUP
+int const kWaitTimeoutMs = 1000;
+#else
+int const kWaitTimeoutMs = 1;
+#endif  // GOOGLE_CLOUD_CPP_STORAGE_HAVE_CURL_MULTI_WAKEUP
+
+Status AsStatus(CURLMcode result, char const* where) {
+  if (result == CURLM_OK) {
+    return Status();
+  }
+  std::ostringstream os;
+  os << where << "(): unexpected error code in curl_multi_*, [" << result
+     << "]=" << curl_multi_strerror(result);
+  return Status(StatusCode::kUnknown, std::move(os).str());
+}
+
+Status AsStatus(CURLcode result, char const* where) {
+  if (result == CURLE_OK) {
+    return Status();
+  }
+  std::ostringstream os;
+  os << where << "() - CURL error [" << result
+     << "]=" << curl_easy_strerror(result);
+  return Status(StatusCode::kUnknown, std::move(os).str());
+}
+}  // namespace
+
+CurlEventLoop::CurlEventLoop()
+    : multi_(curl_multi_init(), &curl_multi_cleanup),
+      handle_count_(0),
+      connection_count_(0),
+      shutdown_(false) {
+  SetCurlMultiplexing(multi_.get());
+  thread_ = std::thread([this] { Run(); });
+}
+
+CurlEventLoop::~CurlEventLoop() {
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    shutdown_ = true;
+  }
+  Post([] {});
+  thread_.join();
+  // The requests keep the event loop alive while they are registered, so this
+  // should be empty. Remove any stragglers from the CURLM* handle anyway, it is
+  // not safe to call curl_multi_cleanup() with handles still attached.
+  for (auto const& kv : handles_) {
+    (void)curl_multi_remove_handle(multi_.get(), kv.first);
+  }
+}
+
+std::shared_ptr<CurlEventLoop> CurlEventLoop::Create() {
+  auto deleter = [](CurlEventLoop* p) {
+    if (not p->InEventLoopThread()) {
+      delete p;
+      return;
+    }
+    std::thread([p] { delete p; }).detach();
+  };
+  return std::shared_ptr<CurlEventLoop>(new CurlEventLoop, deleter);
+}
+
+void CurlEventLoop::AddHandle(CURL* handle, CompletionCallback on_completion) {
+  // std::function<> must be copyable, so we cannot capture by move in C++11,
+  // wrap the callback in a shared_ptr<> instead.
+  auto callback =
+      std::make_shared<CompletionCallback>(std::move(on_completion));
+  Post([this, handle, callback] {
+    auto result = curl_multi_add_handle(multi_.get(), handle);
+    if (result != CURLM_OK) {
+      (*callback)(AsStatus(result, "AddHandle"));
+      return;
+    }
+    handles_.emplace(handle, std::move(*callback));
+    std::lock_guard<std::mutex> lk(mu_);
+    ++handle_count_;
+  });
+}
+
+void CurlEventLoop::RemoveHandle(CURL* handle) {
+  auto remove = [this, handle] {
+    auto loc = handles_.find(handle);
+    if (loc == handles_.end()) {
+      return;
+    }
+    (void)curl_multi_remove_handle(multi_.get(), handle);
+    handles_.erase(loc);
+    std::lock_guard<std::mutex> lk(mu_);
+    --handle_count_;
+  };
+  if (InEventLoopThread()) {
+    remove();
+    return;
+  }
+  std::promise<void> done;
+  auto f = done.get_future();
+  Post([&remove, &done] {
+    remove();
+    done.set_value();
+  });
+  f.get();
+}
+
+void CurlEventLoop::Unpause(CURL* handle, int bitmask) {
+  Post([this, handle, bitmask] {
+    if (handles_.find(handle) == handles_.end()) {
+      return;
+    }
+    auto result = curl_easy_pause(handle, bitmask);
+    if (result != CURLE_OK) {
+      GCP_LOG(WARNING) << AsStatus(result, "Unpause");
+    }
+  });
+}
+
+void CurlEventLoop::AddTimer(std::chrono::steady_clock::time_point deadline,
+                             TimerCallback callback) {
+  Post([this, deadline, callback] { timers_.emplace(deadline, callback); });
+}
+
+std::size_t CurlEventLoop::size() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return handle_count_;
+}
+
+std::size_t CurlEventLoop::connection_count() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return connection_count_;
+}
+
+void CurlEventLoop::Run() {
+  for (;;) {
+    std::deque<std::function<void()>> commands;
+    bool shutdown;
+    {
+      std::unique_lock<std::mutex> lk(mu_);
+      auto ready = [this] {
+        return shutdown_ or not commands_.empty() or handle_count_ != 0;
+      };
+      if (timers_.empty()) {
+        cv_.wait(lk, ready);
+      } else {
+        cv_.wait_until(lk, timers_.begin()->first, ready);
+      }
+      commands.swap(commands_);
+      shutdown = shutdown_;
+    }
+    for (auto& c : commands) {
+      c();
+    }
+    if (shutdown) {
+      return;
+    }
+    RunExpiredTimers();
+    if (handles_.empty()) {
+      continue;
+    }
+    auto status = PerformWork();
+    if (not status.ok()) {
+      GCP_LOG(WARNING) << __func__ << "() " << status;
+    }
+    if (handles_.empty()) {
+      continue;
+    }
+    status = WaitForHandles();
+    if (not status.ok()) {
+      GCP_LOG(WARNING) << __func__ << "() " << status;
+    }
+  }
+}
+
+void CurlEventLoop::RunExpiredTimers() {
+  auto const now = std::chrono::steady_clock::now();
+  // The callbacks may add new timers, remove the expired ones before calling
+  // any of them.
+  std::vector<TimerCallback> expired;
+  while (not timers_.empty() and timers_.begin()->first <= now) {
+    expired.push_back(std::move(timers_.begin()->second));
+    timers_.erase(timers_.begin());
+  }
+  for (auto& callback : expired) {
+    callback();
+  }
+}
+
+void CurlEventLoop::Post(std::function<void()> command) {
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    commands_.push_back(std::move(command));
+  }
+  cv_.notify_one();
+#if GOOGLE_CLOUD_CPP_STORAGE_HAVE_CURL_MULTI_WAKEUP
+  (void)curl_multi_wakeup(multi_.get());
+#endif  // GOOGLE_CLOUD_CPP_STORAGE_HAVE_CURL_MULTI_WAKEUP
+}
+
+Status CurlEventLoop::PerformWork() {
+  int running_handles = 0;
+  CURLMcode result;
+  do {
+    result = curl_multi_perform(multi_.get(), &running_handles);
+  } while (result == CURLM_CALL_MULTI_PERFORM);
+
+  if (result != CURLM_OK) {
+    // Something is seriously wrong with the CURLM* handle, we cannot make
+    // progress on any of the transfers, fail all of them.
+    auto status = AsStatus(result, __func__);
+    auto handles = std::move(handles_);
+    handles_.clear();
+    for (auto& kv : handles) {
+      (void)curl_multi_remove_handle(multi_.get(), kv.first);
+      {
+        std::lock_guard<std::mutex> lk(mu_);
+        --handle_count_;
+      }
+      kv.second(status);
+    }
+    return status;
+  }
+
+  int remaining = 0;
+  while (auto* msg = curl_multi_info_read(multi_.get(), &remaining)) {
+    if (msg->msg != CURLMSG_DONE) {
+      continue;
+    }
+    // The data in `msg` is invalidated by curl_multi_remove_handle(), save it.
+    CURL* handle = msg->easy_handle;
+    CURLcode code = msg->data.result;
+    GCP_LOG(DEBUG) << __func__ << "(): msg.msg=[" << msg->msg << "], "
+                   << " result=[" << code << "]=" << curl_easy_strerror(code);
+    auto loc = handles_.find(handle);
+    if (loc == handles_.end()) {
+      continue;
+    }
+    auto callback = std::move(loc->second);
+    handles_.erase(loc);
+    long connects = 0;
+    (void)curl_easy_getinfo(handle, CURLINFO_NUM_CONNECTS, &connects);
+    (void)curl_multi_remove_handle(multi_.get(), handle);
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      --handle_count_;
+      connection_count_ += static_cast<std::size_t>(connects);
+    }
+    callback(AsStatus(code, __func__));
+  }
+  return Status();
+}
+
+Status CurlEventLoop::WaitForHandles() {
+  // Do not wait past the next timer.
+  int timeout_ms = kWaitTimeoutMs;
+  if (not timers_.empty()) {
+    auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+        timers_.begin()->first - std::chrono::steady_clock::now());
+    timeout_ms = static_cast<int>((std::max)(
+        std::chrono::milliseconds::rep(0),
+        (std::min)(remaining.count(),
+                   std::chrono::milliseconds::rep(kWaitTimeoutMs))));
+  }
+  int numfds = 0;
+#if GOOGLE_CLOUD_CPP_STORAGE_HAVE_CURL_MULTI_WAKEUP
+  CURLMcode result =
+      curl_multi_poll(multi_.get(), nullptr, 0, timeout_ms, &numfds);
+#else
+  CURLMcode result =
+      curl_multi_wait(multi_.get(), nullptr, 0, timeout_ms, &numfds);
+  // curl_multi_wait() returns immediately if there are no file descriptors to
+  // wait on, e.g. while resolving DNS names, avoid a busy loop in that case.
+  if (result == CURLM_OK and numfds == 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(timeout_ms));
+  }
+#endif  // GOOGLE_CLOUD_CPP_STORAGE_HAVE_CURL_MULTI_WAKEUP
+  GCP_LOG(DEBUG) << __func__ << "(): numfds=" << numfds
+                 << ", result=" << result;
+  return AsStatus(result, __func__);
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
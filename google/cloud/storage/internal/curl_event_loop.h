@@ -0,0 +1,162 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_EVENT_LOOP_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_EVENT_LOOP_H_
+
+#include "google/cloud/status.h"
+#include "google/cloud/storage/internal/curl_wrappers.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * Drives many CURL* transfers from a single background thread.
+ *
+ * By default each `CurlDownloadRequest` and `CurlUploadRequest` owns a `CURLM*`
+ * handle and runs the libcurl event loop on the calling thread. That works
+ * well for a handful of streams, but with hundreds of concurrent streams the
+ * application needs one (mostly blocked) thread per stream.
+ *
+ * This class owns a single `CURLM*` handle and a background thread that
+ * drives all the transfers registered with it. The streaming requests then
+ * simply block on a condition variable until their callbacks (which run in
+ * the background thread) make progress.
+ *
+ * All the `curl_multi_*()` calls, and any `curl_easy_pause()` calls for
+ * registered handles, happen in the background thread. Other threads post
+ * commands to that thread using `AddHandle()`, `RemoveHandle()`, and
+ * `Unpause()`.
+ *
+ * The loop also runs timers, the asynchronous APIs use them to schedule the
+ * backoff between retries without blocking any thread.
+ */
+class CurlEventLoop {
+ public:
+  CurlEventLoop();
+  ~CurlEventLoop();
+
+  /**
+   * Creates an event loop that can be released from its own thread.
+   *
+   * The callbacks for asynchronous operations may hold the last reference to
+   * the object that owns the event loop. Deleting the event loop from its own
+   * background thread would deadlock, so the deleter for the returned object
+   * hands off the deletion to a separate thread in that case.
+   */
+  static std::shared_ptr<CurlEventLoop> Create();
+
+  CurlEventLoop(CurlEventLoop const&) = delete;
+  CurlEventLoop& operator=(CurlEventLoop const&) = delete;
+
+  /// Called in the background thread once the transfer completes.
+  using CompletionCallback = std::function<void(Status)>;
+
+  /**
+   * Starts a transfer for @p handle in the background thread.
+   *
+   * The callbacks for the handle (read, write, header, debug) are invoked from
+   * the background thread, the caller must synchronize any data they share.
+   * Once the transfer completes the handle is removed from the `CURLM*` and
+   * @p on_completion is called, also from the background thread.
+   */
+  void AddHandle(CURL* handle, CompletionCallback on_completion);
+
+  /**
+   * Stops the transfer for @p handle, if it has not completed already.
+   *
+   * This function blocks until the background thread no longer uses the
+   * handle, after it returns none of the callbacks associated with @p handle
+   * will be invoked. The completion callback is not called in this case.
+   */
+  void RemoveHandle(CURL* handle);
+
+  /// Calls `curl_easy_pause(handle, bitmask)` from the background thread.
+  void Unpause(CURL* handle, int bitmask);
+
+  /// Called in the background thread when a timer expires.
+  using TimerCallback = std::function<void()>;
+
+  /**
+   * Calls @p callback from the background thread once @p deadline expires.
+   *
+   * Timers that have not expired when the event loop is deleted are discarded
+   * without calling @p callback.
+   */
+  void AddTimer(std::chrono::steady_clock::time_point deadline,
+                TimerCallback callback);
+
+  /// The number of handles currently registered, useful in tests.
+  std::size_t size() const;
+
+  /**
+   * The number of connections opened by the completed transfers.
+   *
+   * Transfers that reuse (or multiplex over) an existing connection do not
+   * open a new one. Useful in tests and benchmarks.
+   */
+  std::size_t connection_count() const;
+
+ private:
+  void Run();
+
+  /// Calls the callbacks for all the timers that have expired.
+  void RunExpiredTimers();
+
+  /// Queues @p command to run in the background thread and wakes it up.
+  void Post(std::function<void()> command);
+
+  /// Runs `curl_multi_perform()` and processes any completed transfers.
+  Status PerformWork();
+
+  /// Blocks until there is activity in any of the handles, or a new command.
+  Status WaitForHandles();
+
+  bool InEventLoopThread() const {
+    return std::this_thread::get_id() == thread_.get_id();
+  }
+
+  CurlMulti multi_;
+
+  mutable std::mutex mu_;
+  std::condition_variable cv_;
+  std::deque<std::function<void()>> commands_;  // GUARDED_BY(mu_)
+  std::size_t handle_count_;                     // GUARDED_BY(mu_)
+  std::size_t connection_count_;                 // GUARDED_BY(mu_)
+  bool shutdown_;                                // GUARDED_BY(mu_)
+
+  // Only accessed by the background thread.
+  std::map<CURL*, CompletionCallback> handles_;
+  std::multimap<std::chrono::steady_clock::time_point, TimerCallback> timers_;
+
+  std::thread thread_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_EVENT_LOOP_H_
@@ -0,0 +1,206 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/curl_event_loop.h"
+#include "google/cloud/internal/random.h"
+#include "google/cloud/storage/internal/curl_request_builder.h"
+#include <gmock/gmock.h>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+// These tests use `file://` URLs, that exercises the event loop without
+// requiring a network connection or an HTTP server. libcurl does not support
+// pausing `file://` transfers, the tests that need pause/resume are in
+// `curl_download_request_integration_test.cc`.
+class CurlEventLoopTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    auto generator = google::cloud::internal::MakeDefaultPRNG();
+    file_name_ = ::testing::TempDir() + "curl-event-loop-test-" +
+                 google::cloud::internal::Sample(
+                     generator, 16, "abcdefghijklmnopqrstuvwxyz0123456789");
+    std::ofstream os(file_name_);
+    for (int i = 0; i != 2000; ++i) {
+      os << "line " << i << ": The quick brown fox jumps over the lazy dog\n";
+    }
+    os.close();
+    std::ifstream is(file_name_);
+    contents_.assign(std::istreambuf_iterator<char>{is}, {});
+  }
+
+  void TearDown() override { (void)std::remove(file_name_.c_str()); }
+
+  std::string url() const { return "file://" + file_name_; }
+
+  std::string file_name_;
+  std::string contents_;
+};
+
+extern "C" std::size_t AppendToString(char* ptr, std::size_t size,
+                                      std::size_t nmemb, void* userdata) {
+  static_cast<std::string*>(userdata)->append(ptr, size * nmemb);
+  return size * nmemb;
+}
+
+TEST_F(CurlEventLoopTest, CompletesTransfer) {
+  CurlEventLoop loop;
+  CurlPtr handle(curl_easy_init(), &curl_easy_cleanup);
+  std::string received;
+  auto const u = url();
+  curl_easy_setopt(handle.get(), CURLOPT_URL, u.c_str());
+  curl_easy_setopt(handle.get(), CURLOPT_WRITEFUNCTION, &AppendToString);
+  curl_easy_setopt(handle.get(), CURLOPT_WRITEDATA, &received);
+
+  std::promise<Status> done;
+  loop.AddHandle(handle.get(), [&done](Status s) { done.set_value(s); });
+  auto status = done.get_future().get();
+  EXPECT_TRUE(status.ok()) << "status=" << status;
+  EXPECT_EQ(contents_, received);
+  EXPECT_EQ(0U, loop.size());
+}
+
+TEST_F(CurlEventLoopTest, ReportsErrors) {
+  CurlEventLoop loop;
+  CurlPtr handle(curl_easy_init(), &curl_easy_cleanup);
+  auto const u = url() + "-does-not-exist";
+  curl_easy_setopt(handle.get(), CURLOPT_URL, u.c_str());
+
+  std::promise<Status> done;
+  loop.AddHandle(handle.get(), [&done](Status s) { done.set_value(s); });
+  auto status = done.get_future().get();
+  EXPECT_FALSE(status.ok());
+  EXPECT_EQ(0U, loop.size());
+}
+
+TEST_F(CurlEventLoopTest, RemoveUnknownHandle) {
+  CurlEventLoop loop;
+  CurlPtr handle(curl_easy_init(), &curl_easy_cleanup);
+  loop.RemoveHandle(handle.get());
+  loop.Unpause(handle.get(), CURLPAUSE_CONT);
+  EXPECT_EQ(0U, loop.size());
+}
+
+TEST_F(CurlEventLoopTest, ManyDownloads) {
+  auto loop = std::make_shared<CurlEventLoop>();
+  std::size_t const buffer_size = 2 * contents_.size();
+  int const download_count = 16;
+
+  std::vector<std::future<std::string>> tasks;
+  for (int i = 0; i != download_count; ++i) {
+    auto download_task = [this, loop, buffer_size] {
+      CurlRequestBuilder builder(url(), GetDefaultCurlHandleFactory());
+      builder.SetEventLoop(loop).SetInitialBufferSize(buffer_size);
+      auto download = builder.BuildDownloadRequest(std::string{});
+      std::string received;
+      StatusOr<HttpResponse> response;
+      do {
+        std::string buffer;
+        response = download.GetMore(buffer);
+        if (not response.ok()) {
+          break;
+        }
+        received += buffer;
+      } while (response->status_code == 100);
+      EXPECT_TRUE(response.ok()) << "status=" << response.status();
+      EXPECT_FALSE(download.IsOpen());
+      return received;
+    };
+    tasks.emplace_back(std::async(std::launch::async, download_task));
+  }
+  for (auto& t : tasks) {
+    EXPECT_EQ(contents_, t.get());
+  }
+  EXPECT_EQ(0U, loop->size());
+}
+
+TEST_F(CurlEventLoopTest, CloseDownload) {
+  auto loop = std::make_shared<CurlEventLoop>();
+  CurlRequestBuilder builder(url(), GetDefaultCurlHandleFactory());
+  builder.SetEventLoop(loop).SetInitialBufferSize(2 * contents_.size());
+  auto download = builder.BuildDownloadRequest(std::string{});
+  auto response = download.Close();
+  EXPECT_TRUE(response.ok()) << "status=" << response.status();
+  EXPECT_FALSE(download.IsOpen());
+  EXPECT_EQ(0U, loop->size());
+}
+
+TEST_F(CurlEventLoopTest, TimersRunInDeadlineOrder) {
+  CurlEventLoop loop;
+  auto const now = std::chrono::steady_clock::now();
+  std::mutex mu;
+  std::vector<int> order;
+  std::promise<void> done;
+  loop.AddTimer(now + std::chrono::milliseconds(30), [&] {
+    std::lock_guard<std::mutex> lk(mu);
+    order.push_back(3);
+    done.set_value();
+  });
+  loop.AddTimer(now + std::chrono::milliseconds(10), [&] {
+    std::lock_guard<std::mutex> lk(mu);
+    order.push_back(1);
+  });
+  loop.AddTimer(now + std::chrono::milliseconds(20), [&] {
+    std::lock_guard<std::mutex> lk(mu);
+    order.push_back(2);
+  });
+  done.get_future().get();
+  EXPECT_LE(now + std::chrono::milliseconds(30),
+            std::chrono::steady_clock::now());
+  std::lock_guard<std::mutex> lk(mu);
+  EXPECT_THAT(order, ::testing::ElementsAre(1, 2, 3));
+}
+
+TEST_F(CurlEventLoopTest, MakeRequestAsync) {
+  auto loop = CurlEventLoop::Create();
+  CurlRequestBuilder builder(url(), GetDefaultCurlHandleFactory());
+  auto response = CurlRequest::MakeRequestAsync(builder.BuildRequest(), loop,
+                                                std::string{})
+                      .get();
+  ASSERT_TRUE(response.ok()) << "status=" << response.status();
+  EXPECT_EQ(contents_, response->payload);
+  EXPECT_EQ(0U, loop->size());
+}
+
+TEST_F(CurlEventLoopTest, ReleaseFromEventLoopThread) {
+  auto loop = CurlEventLoop::Create();
+  std::promise<void> done;
+  // The timer callback holds the only reference to the event loop once this
+  // function resets `loop`, the deleter must not join the background thread
+  // from itself.
+  loop->AddTimer(std::chrono::steady_clock::now(),
+                 [loop, &done]() mutable {
+                   loop.reset();
+                   done.set_value();
+                 });
+  loop.reset();
+  done.get_future().get();
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include "google/cloud/storage/internal/curl_handle_factory.h"
+#include <algorithm>
+#include <thread>
 
 namespace google {
 namespace cloud {
@@ -50,70 +52,156 @@ CurlMulti DefaultCurlHandleFactory::CreateMultiHandle() {
 
 void DefaultCurlHandleFactory::CleanupMultiHandle(CurlMulti&& m) { m.reset(); }
 
-PooledCurlHandleFactory::PooledCurlHandleFactory(std::size_t maximum_size)
-    : maximum_size_(maximum_size) {
-  handles_.reserve(maximum_size);
-  multi_handles_.reserve(maximum_size);
+namespace {
+std::size_t DefaultShardCount(std::size_t maximum_size) {
+  std::size_t count = std::thread::hardware_concurrency();
+  if (count == 0) {
+    count = 4;
+  }
+  return std::max(std::size_t(1), std::min(count, maximum_size));
 }
 
-PooledCurlHandleFactory::~PooledCurlHandleFactory() {
-  for (auto* h : handles_) {
-    curl_easy_cleanup(h);
+// Threads are assigned to shards in round-robin order, the first time they use
+// any PooledCurlHandleFactory.
+std::atomic<std::size_t> next_thread_index(0);
+}  // namespace
+
+PooledCurlHandleFactory::PooledCurlHandleFactory(std::size_t maximum_size,
+                                                 std::size_t shard_count)
+    : last_client_ip_address_sequence_(0) {
+  if (shard_count == 0) {
+    shard_count = DefaultShardCount(maximum_size);
   }
-  for (auto* m : multi_handles_) {
-    curl_multi_cleanup(m);
+  for (std::size_t i = 0; i != shard_count; ++i) {
+    std::unique_ptr<Shard> shard(new Shard);
+    shard->maximum_size =
+        maximum_size / shard_count + (i < maximum_size % shard_count ? 1 : 0);
+    shard->handles.reserve(shard->maximum_size);
+    shard->multi_handles.reserve(shard->maximum_size);
+    shards_.push_back(std::move(shard));
+  }
+}
+
+PooledCurlHandleFactory::~PooledCurlHandleFactory() {
+  for (auto& shard : shards_) {
+    for (auto* h : shard->handles) {
+      curl_easy_cleanup(h);
+    }
+    for (auto* m : shard->multi_handles) {
+      curl_multi_cleanup(m);
+    }
   }
 }
 
 CurlPtr PooledCurlHandleFactory::CreateHandle() {
-  std::unique_lock<std::mutex> lk(mu_);
-  if (not handles_.empty()) {
-    CURL* handle = handles_.back();
-    // Clear all the options in the handle so we do not leak its previous state.
-    (void)curl_easy_reset(handle);
-    handles_.pop_back();
-    return CurlPtr(handle, &curl_easy_cleanup);
+  // Start with the shard for this thread, if it is empty try the other shards
+  // before creating a new handle.
+  auto const home = HomeShard();
+  CURL* handle = nullptr;
+  for (std::size_t i = 0; i != shards_.size() and handle == nullptr; ++i) {
+    auto& shard = *shards_[(home + i) % shards_.size()];
+    std::lock_guard<std::mutex> lk(shard.mu);
+    if (not shard.handles.empty()) {
+      handle = shard.handles.back();
+      shard.handles.pop_back();
+    }
   }
-  return CurlPtr(curl_easy_init(), &curl_easy_cleanup);
+  if (handle == nullptr) {
+    return CurlPtr(curl_easy_init(), &curl_easy_cleanup);
+  }
+  // Clear all the options in the handle so we do not leak its previous state.
+  (void)curl_easy_reset(handle);
+  return CurlPtr(handle, &curl_easy_cleanup);
 }
 
 void PooledCurlHandleFactory::CleanupHandle(CurlPtr&& h) {
-  std::unique_lock<std::mutex> lk(mu_);
   char* ip;
+  std::string ip_address;
   auto res = curl_easy_getinfo(h.get(), CURLINFO_LOCAL_IP, &ip);
   if (res == CURLE_OK and ip != nullptr) {
-    last_client_ip_address_ = ip;
+    ip_address = ip;
   }
-  if (handles_.size() >= maximum_size_) {
-    CURL* tmp = handles_.front();
-    handles_.erase(handles_.begin());
-    curl_easy_cleanup(tmp);
+  if (not ip_address.empty()) {
+    auto& shard = *shards_[HomeShard()];
+    std::lock_guard<std::mutex> lk(shard.mu);
+    shard.last_client_ip_address_sequence = ++last_client_ip_address_sequence_;
+    shard.last_client_ip_address = std::move(ip_address);
+  }
+  // The pool now has ownership, so release it.
+  CURL* evicted = ReturnToPool(h.release(), &Shard::handles);
+  if (evicted != nullptr) {
+    curl_easy_cleanup(evicted);
   }
-  handles_.push_back(h.get());
-  // The handles_ vector now has ownership, so release it.
-  (void)h.release();
 }
 
 CurlMulti PooledCurlHandleFactory::CreateMultiHandle() {
-  std::unique_lock<std::mutex> lk(mu_);
-  if (not multi_handles_.empty()) {
-    CURL* m = multi_handles_.back();
-    multi_handles_.pop_back();
-    return CurlMulti(m, &curl_multi_cleanup);
+  auto const home = HomeShard();
+  for (std::size_t i = 0; i != shards_.size(); ++i) {
+    auto& shard = *shards_[(home + i) % shards_.size()];
+    std::lock_guard<std::mutex> lk(shard.mu);
+    if (not shard.multi_handles.empty()) {
+      CURLM* m = shard.multi_handles.back();
+      shard.multi_handles.pop_back();
+      return CurlMulti(m, &curl_multi_cleanup);
+    }
   }
   return CurlMulti(curl_multi_init(), &curl_multi_cleanup);
 }
 
 void PooledCurlHandleFactory::CleanupMultiHandle(CurlMulti&& m) {
-  std::unique_lock<std::mutex> lk(mu_);
-  if (multi_handles_.size() >= maximum_size_) {
-    CURLM* tmp = multi_handles_.front();
-    multi_handles_.erase(multi_handles_.begin());
-    curl_multi_cleanup(tmp);
+  // The pool now has ownership, so release it.
+  CURLM* evicted = ReturnToPool(m.release(), &Shard::multi_handles);
+  if (evicted != nullptr) {
+    curl_multi_cleanup(evicted);
+  }
+}
+
+std::string PooledCurlHandleFactory::LastClientIpAddress() const {
+  std::uint64_t sequence = 0;
+  std::string result;
+  for (auto const& shard : shards_) {
+    std::lock_guard<std::mutex> lk(shard->mu);
+    if (shard->last_client_ip_address_sequence > sequence) {
+      sequence = shard->last_client_ip_address_sequence;
+      result = shard->last_client_ip_address;
+    }
+  }
+  return result;
+}
+
+std::size_t PooledCurlHandleFactory::HomeShard() const {
+  static thread_local std::size_t const thread_index = next_thread_index++;
+  return thread_index % shards_.size();
+}
+
+template <typename T>
+T* PooledCurlHandleFactory::ReturnToPool(T* h, std::vector<T*> Shard::*pool) {
+  auto const home = HomeShard();
+  // Spill into the other shards before evicting anything, the maximum size
+  // applies to the pool as a whole, not to the handles used by each thread.
+  for (std::size_t i = 0; i != shards_.size(); ++i) {
+    auto& shard = *shards_[(home + i) % shards_.size()];
+    std::lock_guard<std::mutex> lk(shard.mu);
+    auto& handles = shard.*pool;
+    if (handles.size() < shard.maximum_size) {
+      handles.push_back(h);
+      return nullptr;
+    }
+  }
+  for (std::size_t i = 0; i != shards_.size(); ++i) {
+    auto& shard = *shards_[(home + i) % shards_.size()];
+    std::lock_guard<std::mutex> lk(shard.mu);
+    auto& handles = shard.*pool;
+    if (handles.empty()) {
+      continue;
+    }
+    T* evicted = handles.front();
+    handles.erase(handles.begin());
+    handles.push_back(h);
+    return evicted;
   }
-  multi_handles_.push_back(m.get());
-  // The multi_handles_ vector now has ownership, so release it.
-  (void)m.release();
+  // The pool cannot hold any handles.
+  return h;
 }
 
 }  // namespace internal
@@ -16,6 +16,9 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_HANDLE_FACTORY_H_
 
 #include "google/cloud/storage/internal/curl_wrappers.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <mutex>
 #include <vector>
 
@@ -74,10 +77,25 @@ class DefaultCurlHandleFactory : public CurlHandleFactory {
  *
  * This implementation keeps up to N handles in memory, they are only released
  * when the factory is destructed.
+ *
+ * To avoid contention when many threads create and release handles, the pool
+ * is split in shards, each with its own mutex. Each thread returns handles to
+ * its own shard, and takes handles from its own shard when possible, only
+ * looking at the other shards when its shard is empty.
  */
 class PooledCurlHandleFactory : public CurlHandleFactory {
  public:
-  explicit PooledCurlHandleFactory(std::size_t maximum_size);
+  /**
+   * Creates a pool with up to @p maximum_size handles split in @p shard_count
+   * shards. A @p shard_count of zero picks a value based on the number of
+   * cores.
+   *
+   * Each thread prefers its own shard, but handles are released into (and
+   * acquired from) the other shards when needed, so a single thread can use
+   * the full pool.
+   */
+  explicit PooledCurlHandleFactory(std::size_t maximum_size,
+                                   std::size_t shard_count = 0);
   ~PooledCurlHandleFactory() override;
 
   CurlPtr CreateHandle() override;
@@ -86,17 +104,38 @@ class PooledCurlHandleFactory : public CurlHandleFactory {
   CurlMulti CreateMultiHandle() override;
   void CleanupMultiHandle(CurlMulti&&) override;
 
-  std::string LastClientIpAddress() const override {
-    std::lock_guard<std::mutex> lk(mu_);
-    return last_client_ip_address_;
-  }
+  std::string LastClientIpAddress() const override;
+
+  std::size_t shard_count() const { return shards_.size(); }
 
  private:
-  std::size_t maximum_size_;
-  mutable std::mutex mu_;
-  std::vector<CURL*> handles_;
-  std::vector<CURLM*> multi_handles_;
-  std::string last_client_ip_address_;
+  struct Shard {
+    mutable std::mutex mu;
+    // The limit for `handles` and `multi_handles` in this shard, the limits
+    // for all the shards add up to the pool maximum size.
+    std::size_t maximum_size = 0;
+    std::vector<CURL*> handles;
+    std::vector<CURLM*> multi_handles;
+    // Used to find the most recent value across all the shards.
+    std::uint64_t last_client_ip_address_sequence = 0;
+    std::string last_client_ip_address;
+  };
+
+  /// Returns the index of the shard used by the calling thread.
+  std::size_t HomeShard() const;
+
+  /**
+   * Returns @p h to the first shard with room, starting with the home shard.
+   *
+   * If all the shards are full the oldest handle in the home shard (or the
+   * next shard with any handles) is evicted.
+   *
+   * @return the handle to cleanup, if any.
+   */
+  template <typename T>
+  T* ReturnToPool(T* h, std::vector<T*> Shard::*pool);
+  std::vector<std::unique_ptr<Shard>> shards_;
+  std::atomic<std::uint64_t> last_client_ip_address_sequence_;
 };
 
 }  // namespace internal
@@ -0,0 +1,129 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/curl_handle_factory.h"
+#include <gmock/gmock.h>
+#include <set>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+TEST(PooledCurlHandleFactoryTest, ReusesHandles) {
+  PooledCurlHandleFactory factory(4, 1);
+  auto handle = factory.CreateHandle();
+  CURL* expected = handle.get();
+  factory.CleanupHandle(std::move(handle));
+  auto reused = factory.CreateHandle();
+  EXPECT_EQ(expected, reused.get());
+
+  auto multi = factory.CreateMultiHandle();
+  CURLM* expected_multi = multi.get();
+  factory.CleanupMultiHandle(std::move(multi));
+  auto reused_multi = factory.CreateMultiHandle();
+  EXPECT_EQ(expected_multi, reused_multi.get());
+}
+
+TEST(PooledCurlHandleFactoryTest, LimitsPoolSize) {
+  PooledCurlHandleFactory factory(2, 1);
+  std::vector<CurlPtr> handles;
+  for (int i = 0; i != 4; ++i) {
+    handles.push_back(factory.CreateHandle());
+  }
+  std::vector<CURL*> released;
+  for (auto& h : handles) {
+    released.push_back(h.get());
+    factory.CleanupHandle(std::move(h));
+  }
+  // Only the two most recently released handles are kept, the rest are
+  // released. Newly created handles may reuse the same addresses, so only check
+  // that the pooled handles are returned first.
+  std::set<CURL*> pooled{factory.CreateHandle().release(),
+                         factory.CreateHandle().release()};
+  EXPECT_EQ((std::set<CURL*>{released[2], released[3]}), pooled);
+  for (auto* h : pooled) {
+    curl_easy_cleanup(h);
+  }
+}
+
+TEST(PooledCurlHandleFactoryTest, UsesHandlesFromOtherShards) {
+  PooledCurlHandleFactory factory(8, 4);
+  EXPECT_EQ(4U, factory.shard_count());
+
+  // Release a handle from a different thread, most likely assigned to a
+  // different shard, it should still be reused.
+  CURL* expected = nullptr;
+  std::thread t([&factory, &expected] {
+    auto handle = factory.CreateHandle();
+    expected = handle.get();
+    factory.CleanupHandle(std::move(handle));
+  });
+  t.join();
+  auto handle = factory.CreateHandle();
+  EXPECT_EQ(expected, handle.get());
+}
+
+TEST(PooledCurlHandleFactoryTest, SingleThreadUsesAllShards) {
+  PooledCurlHandleFactory factory(4, 4);
+  EXPECT_EQ(4U, factory.shard_count());
+  std::vector<CurlPtr> handles;
+  for (int i = 0; i != 4; ++i) {
+    handles.push_back(factory.CreateHandle());
+  }
+  std::set<CURL*> released;
+  for (auto& h : handles) {
+    released.insert(h.get());
+    factory.CleanupHandle(std::move(h));
+  }
+  // The home shard for this thread holds a single handle, the other handles
+  // must spill into the other shards instead of being destroyed.
+  std::set<CURL*> pooled;
+  for (int i = 0; i != 4; ++i) {
+    pooled.insert(factory.CreateHandle().release());
+  }
+  EXPECT_EQ(released, pooled);
+  for (auto* h : pooled) {
+    curl_easy_cleanup(h);
+  }
+}
+
+TEST(PooledCurlHandleFactoryTest, ManyThreads) {
+  PooledCurlHandleFactory factory(16);
+  auto worker = [&factory] {
+    for (int i = 0; i != 1000; ++i) {
+      auto handle = factory.CreateHandle();
+      ASSERT_NE(nullptr, handle.get());
+      factory.CleanupHandle(std::move(handle));
+    }
+  };
+  std::vector<std::thread> threads;
+  for (int i = 0; i != 8; ++i) {
+    threads.emplace_back(worker);
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  EXPECT_EQ("", factory.LastClientIpAddress());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
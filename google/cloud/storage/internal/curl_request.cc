@@ -14,20 +14,60 @@
 
 #include "google/cloud/storage/internal/curl_request.h"
 #include <iostream>
+#include <memory>
 
 namespace google {
 namespace cloud {
 namespace storage {
 inline namespace STORAGE_CLIENT_NS {
 namespace internal {
+namespace {
+/// Keeps a request, and its payload, alive until the transfer completes.
+struct AsyncRequestState {
+  AsyncRequestState(CurlRequest r, std::string p)
+      : request(std::move(r)), payload(std::move(p)) {}
+
+  CurlRequest request;
+  std::string payload;
+  promise<StatusOr<HttpResponse>> done;
+};
+}  // namespace
+
 CurlRequest::CurlRequest() : headers_(nullptr, &curl_slist_free_all) {}
 
 StatusOr<HttpResponse> CurlRequest::MakeRequest(std::string const& payload) {
+  SetPayload(payload);
+  return OnTransferDone(handle_.EasyPerform());
+}
+
+future<StatusOr<HttpResponse>> CurlRequest::MakeRequestAsync(
+    CurlRequest request, std::shared_ptr<CurlEventLoop> const& event_loop,
+    std::string payload) {
+  auto state = std::make_shared<AsyncRequestState>(std::move(request),
+                                                   std::move(payload));
+  auto f = state->done.get_future();
+  state->request.SetPayload(state->payload);
+  // The completion callback owns the state. Release it, and with it the
+  // handle, before satisfying the future: the continuations may release the
+  // last reference to the client that owns the handle factory.
+  event_loop->AddHandle(
+      state->request.handle_.handle_.get(), [state](Status status) mutable {
+        auto response = state->request.OnTransferDone(status);
+        auto done = std::move(state->done);
+        state.reset();
+        done.set_value(std::move(response));
+      });
+  return f;
+}
+
+void CurlRequest::SetPayload(std::string const& payload) {
   if (not payload.empty()) {
     handle_.SetOption(CURLOPT_POSTFIELDSIZE, payload.length());
     handle_.SetOption(CURLOPT_POSTFIELDS, payload.c_str());
   }
-  auto status = handle_.EasyPerform();
+}
+
+StatusOr<HttpResponse> CurlRequest::OnTransferDone(Status const& status) {
   if (not status.ok()) {
     return status;
   }
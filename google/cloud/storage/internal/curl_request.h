@@ -15,6 +15,8 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_REQUEST_H_
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_REQUEST_H_
 
+#include "google/cloud/future.h"
+#include "google/cloud/storage/internal/curl_event_loop.h"
 #include "google/cloud/storage/internal/curl_handle.h"
 #include "google/cloud/storage/internal/curl_handle_factory.h"
 #include "google/cloud/storage/internal/http_response.h"
@@ -79,9 +81,23 @@ class CurlRequest {
    */
   StatusOr<HttpResponse> MakeRequest(std::string const& payload);
 
+  /**
+   * Makes the prepared @p request in @p event_loop.
+   *
+   * The function returns immediately, the transfer runs in the background
+   * thread of @p event_loop. The returned future becomes satisfied, in that
+   * same thread, once the transfer completes. Any continuations attached to
+   * the future also run in that thread, and must not block.
+   */
+  static future<StatusOr<HttpResponse>> MakeRequestAsync(
+      CurlRequest request, std::shared_ptr<CurlEventLoop> const& event_loop,
+      std::string payload);
+
  private:
   friend class CurlRequestBuilder;
   void ResetOptions();
+  void SetPayload(std::string const& payload);
+  StatusOr<HttpResponse> OnTransferDone(Status const& status);
 
   std::string url_;
   CurlHeaders headers_;
@@ -55,7 +55,11 @@ CurlUploadRequest CurlRequestBuilder::BuildUpload() {
   request.headers_ = std::move(headers_);
   request.user_agent_ = user_agent_prefix_ + UserAgentSuffix();
   request.handle_ = std::move(handle_);
-  request.multi_ = factory_->CreateMultiHandle();
+  if (event_loop_) {
+    request.event_loop_ = std::move(event_loop_);
+  } else {
+    request.multi_ = factory_->CreateMultiHandle();
+  }
   request.factory_ = factory_;
   request.logging_enabled_ = logging_enabled_;
   request.SetOptions();
@@ -71,7 +75,11 @@ CurlDownloadRequest CurlRequestBuilder::BuildDownloadRequest(
   request.user_agent_ = user_agent_prefix_ + UserAgentSuffix();
   request.payload_ = std::move(payload);
   request.handle_ = std::move(handle_);
-  request.multi_ = factory_->CreateMultiHandle();
+  if (event_loop_) {
+    request.event_loop_ = std::move(event_loop_);
+  } else {
+    request.multi_ = factory_->CreateMultiHandle();
+  }
   request.factory_ = factory_;
   request.logging_enabled_ = logging_enabled_;
   request.SetOptions();
@@ -116,6 +124,26 @@ CurlRequestBuilder& CurlRequestBuilder::SetCurlShare(CURLSH* share) {
   return *this;
 }
 
+CurlRequestBuilder& CurlRequestBuilder::SetTcpKeepAlive(
+    std::chrono::seconds interval) {
+  ValidateBuilderState(__func__);
+  SetCurlTcpKeepAlive(handle_.handle_.get(), interval);
+  return *this;
+}
+
+CurlRequestBuilder& CurlRequestBuilder::SetMaximumConnectionIdleTime(
+    std::chrono::seconds idle_time) {
+  ValidateBuilderState(__func__);
+  SetCurlMaximumConnectionIdleTime(handle_.handle_.get(), idle_time);
+  return *this;
+}
+
+CurlRequestBuilder& CurlRequestBuilder::SetHttp2(bool enable) {
+  ValidateBuilderState(__func__);
+  SetCurlHttp2(handle_.handle_.get(), enable);
+  return *this;
+}
+
 CurlRequestBuilder& CurlRequestBuilder::SetDebugLogging(bool enabled) {
   ValidateBuilderState(__func__);
   logging_enabled_ = enabled;
@@ -128,6 +156,13 @@ CurlRequestBuilder& CurlRequestBuilder::SetInitialBufferSize(std::size_t size) {
   return *this;
 }
 
+CurlRequestBuilder& CurlRequestBuilder::SetEventLoop(
+    std::shared_ptr<CurlEventLoop> event_loop) {
+  ValidateBuilderState(__func__);
+  event_loop_ = std::move(event_loop);
+  return *this;
+}
+
 std::string CurlRequestBuilder::UserAgentSuffix() const {
   ValidateBuilderState(__func__);
   // Pre-compute and cache the user agent string:
@@ -17,6 +17,7 @@
 
 #include "google/cloud/storage/internal/complex_option.h"
 #include "google/cloud/storage/internal/curl_download_request.h"
+#include "google/cloud/storage/internal/curl_event_loop.h"
 #include "google/cloud/storage/internal/curl_handle_factory.h"
 #include "google/cloud/storage/internal/curl_request.h"
 #include "google/cloud/storage/internal/curl_upload_request.h"
@@ -158,8 +159,27 @@ class CurlRequestBuilder {
   /// Sets the CURLSH* handle to share resources.
   CurlRequestBuilder& SetCurlShare(CURLSH* share);
 
+  /// Enables TCP keep-alive probes, a zero @p interval disables them.
+  CurlRequestBuilder& SetTcpKeepAlive(std::chrono::seconds interval);
+
+  /// Closes connections idle for longer than @p idle_time instead of reusing
+  /// them, zero uses the libcurl default.
+  CurlRequestBuilder& SetMaximumConnectionIdleTime(
+      std::chrono::seconds idle_time);
+
+  /// Prefers HTTP/2 over HTTP/1.1 when @p enable is true.
+  CurlRequestBuilder& SetHttp2(bool enable);
+
   CurlRequestBuilder& SetInitialBufferSize(std::size_t size);
 
+  /**
+   * Runs streaming transfers in @p event_loop instead of the calling thread.
+   *
+   * Only affects the requests created by `BuildUpload()` and
+   * `BuildDownloadRequest()`, a null pointer restores the default behavior.
+   */
+  CurlRequestBuilder& SetEventLoop(std::shared_ptr<CurlEventLoop> event_loop);
+
   /// Gets the user-agent suffix.
   std::string UserAgentSuffix() const;
 
@@ -189,6 +209,8 @@ class CurlRequestBuilder {
   bool logging_enabled_;
 
   std::size_t initial_buffer_size_;
+
+  std::shared_ptr<CurlEventLoop> event_loop_;
 };
 
 }  // namespace internal
@@ -14,6 +14,8 @@
 
 #include "google/cloud/storage/internal/curl_streambuf.h"
 #include "google/cloud/storage/object_stream.h"
+#include <algorithm>
+#include <cstring>
 
 namespace google {
 namespace cloud {
@@ -107,6 +109,42 @@ CurlReadStreambuf::int_type CurlReadStreambuf::underflow() {
   return traits_type::eof();
 }
 
+std::streamsize CurlReadStreambuf::xsgetn(char* s, std::streamsize count) {
+  if (count < static_cast<std::streamsize>(target_buffer_size_)) {
+    return ObjectReadStreambuf::xsgetn(s, count);
+  }
+
+  // Start with any data already in the get area.
+  auto offset = std::min(count, static_cast<std::streamsize>(egptr() - gptr()));
+  std::memcpy(s, gptr(), static_cast<std::size_t>(offset));
+  setg(eback(), gptr() + offset, egptr());
+
+  while (offset < count and IsOpen()) {
+    std::size_t bytes_read = 0;
+    StatusOr<HttpResponse> response = download_.GetMoreDirect(
+        s + offset, static_cast<std::size_t>(count - offset), bytes_read);
+    if (not response.ok()) {
+      ReportError(std::move(response).status());
+      return offset;
+    }
+    for (auto const& kv : response->headers) {
+      hash_validator_->ProcessHeader(kv.first, kv.second);
+      headers_.emplace(kv.first, kv.second);
+    }
+    if (response->status_code >= 300) {
+      ReportError(AsStatus(*response));
+      return offset;
+    }
+    hash_validator_->Update(s + offset, bytes_read);
+    offset += static_cast<std::streamsize>(bytes_read);
+  }
+  if (offset < count) {
+    // The download has completed, underflow() verifies the checksums.
+    underflow();
+  }
+  return offset;
+}
+
 CurlReadStreambuf::int_type CurlReadStreambuf::ReportError(Status status) {
   // The only way to report errors from a std::basic_streambuf<> (which this
   // class derives from) is to throw exceptions:
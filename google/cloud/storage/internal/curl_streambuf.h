@@ -27,6 +27,11 @@ inline namespace STORAGE_CLIENT_NS {
 namespace internal {
 /**
  * Makes streaming download requests using libcurl.
+ *
+ * Small reads are served from an internal buffer, refilled `target_buffer_size`
+ * bytes at a time. Reads of at least `target_buffer_size` bytes (e.g. a large
+ * `std::istream::read()`) bypass that buffer, libcurl writes the data directly
+ * into the application's memory.
  */
 class CurlReadStreambuf : public ObjectReadStreambuf {
  public:
@@ -51,6 +56,7 @@ class CurlReadStreambuf : public ObjectReadStreambuf {
 
  protected:
   int_type underflow() override;
+  std::streamsize xsgetn(char* s, std::streamsize count) override;
 
   int_type ReportError(Status status);
 
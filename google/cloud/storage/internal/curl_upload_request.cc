@@ -39,6 +39,9 @@ CurlUploadRequest::CurlUploadRequest(std::size_t initial_buffer_size)
 
 Status CurlUploadRequest::Flush() {
   ValidateOpen(__func__);
+  if (event_loop_) {
+    return FlushOnEventLoop();
+  }
   handle_.FlushDebug(__func__);
   GCP_LOG(DEBUG) << __func__ << "(), curl.size=" << buffer_.size()
                  << ", curl.rdptr="
@@ -53,6 +56,9 @@ StatusOr<HttpResponse> CurlUploadRequest::Close() {
   if (not status.ok()) {
     return status;
   }
+  if (event_loop_) {
+    return CloseOnEventLoop();
+  }
   handle_.FlushDebug(__func__);
   status = Flush();
   if (not status.ok()) {
@@ -87,6 +93,17 @@ Status CurlUploadRequest::NextBuffer(std::string& next_buffer) {
     return status;
   }
   status = Flush();
+  if (event_loop_) {
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      next_buffer.swap(buffer_);
+      buffer_rdptr_ = buffer_.begin();
+    }
+    // The read callback pauses the transfer when it runs out of data, resume
+    // it now that there is a new buffer.
+    event_loop_->Unpause(handle_.handle_.get(), CURLPAUSE_CONT);
+    return status;
+  }
   next_buffer.swap(buffer_);
   buffer_rdptr_ = buffer_.begin();
   return status;
@@ -94,6 +111,12 @@ Status CurlUploadRequest::NextBuffer(std::string& next_buffer) {
 
 Status CurlUploadRequest::SetOptions() {
   ResetOptions();
+  if (event_loop_) {
+    // The handle is registered with the event loop on the first call to
+    // Flush(), NextBuffer(), or Close(), at that point this object no longer
+    // moves.
+    return Status();
+  }
   auto error = curl_multi_add_handle(multi_.get(), handle_.handle_.get());
   return AsStatus(error, __func__);
 }
@@ -124,6 +147,10 @@ void CurlUploadRequest::ResetOptions() {
 std::size_t CurlUploadRequest::ReadCallback(char* ptr, std::size_t size,
                                             std::size_t nmemb) {
   handle_.FlushDebug(__func__);
+  std::unique_lock<std::mutex> lk(mu_, std::defer_lock);
+  if (event_loop_) {
+    lk.lock();
+  }
 
   std::size_t available =
       static_cast<std::size_t>(std::distance(buffer_rdptr_, buffer_.end()));
@@ -146,9 +173,72 @@ std::size_t CurlUploadRequest::ReadCallback(char* ptr, std::size_t size,
   }
   std::copy(buffer_rdptr_, buffer_rdptr_ + available, ptr);
   buffer_rdptr_ += available;
+  if (event_loop_ and buffer_rdptr_ == buffer_.end()) {
+    cv_.notify_one();
+  }
   return available;
 }
 
+void CurlUploadRequest::StartOnEventLoop() {
+  if (registered_) {
+    return;
+  }
+  registered_ = true;
+  event_loop_->AddHandle(handle_.handle_.get(), [this](Status status) {
+    OnTransferDone(std::move(status));
+  });
+}
+
+void CurlUploadRequest::OnTransferDone(Status status) {
+  handle_.FlushDebug(__func__);
+  std::lock_guard<std::mutex> lk(mu_);
+  transfer_done_ = true;
+  transfer_status_ = std::move(status);
+  cv_.notify_one();
+}
+
+Status CurlUploadRequest::FlushOnEventLoop() {
+  StartOnEventLoop();
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] {
+    return transfer_done_ or buffer_rdptr_ == buffer_.end();
+  });
+  // If the transfer completed early (e.g. the server rejected the upload) the
+  // error is reported here, otherwise the response is reported by Close().
+  return transfer_status_;
+}
+
+StatusOr<HttpResponse> CurlUploadRequest::CloseOnEventLoop() {
+  auto status = FlushOnEventLoop();
+  if (not status.ok()) {
+    return status;
+  }
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    closing_ = true;
+  }
+  // The transfer is paused if the read callback ran out of data, in that case
+  // libcurl will not call the read callback (and discover that `closing_` is
+  // set) until it is resumed.
+  event_loop_->Unpause(handle_.handle_.get(), CURLPAUSE_CONT);
+  {
+    std::unique_lock<std::mutex> lk(mu_);
+    cv_.wait(lk, [this] { return transfer_done_; });
+    curl_closed_ = true;
+    status = std::move(transfer_status_);
+  }
+  if (not status.ok()) {
+    return status;
+  }
+
+  StatusOr<long> http_code = handle_.GetResponseCode();
+  if (not http_code.ok()) {
+    return std::move(http_code).status();
+  }
+  return HttpResponse{http_code.value(), std::move(response_payload_),
+                      std::move(received_headers_)};
+}
+
 StatusOr<int> CurlUploadRequest::PerformWork() {
   // Block while there is work to do, apparently newer versions of libcurl do
   // not need this loop and curl_multi_perform() blocks until there is no more
@@ -16,9 +16,12 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_UPLOAD_REQUEST_H_
 
 #include "google/cloud/log.h"
+#include "google/cloud/storage/internal/curl_event_loop.h"
 #include "google/cloud/storage/internal/curl_handle_factory.h"
 #include "google/cloud/storage/internal/curl_request.h"
 #include "google/cloud/storage/internal/http_response.h"
+#include <condition_variable>
+#include <mutex>
 
 namespace google {
 namespace cloud {
@@ -32,6 +35,11 @@ namespace internal {
  * payload is streamed, and the total size is not known. Under the hood this
  * uses chunked transfer encoding.
  *
+ * If the request is configured with a `CurlEventLoop` the transfer runs in the
+ * event loop background thread, and this class only blocks until the callbacks
+ * (which run in that thread) make progress. Such requests must not be moved
+ * after the first call to `Flush()`, `NextBuffer()`, or `Close()`.
+ *
  * @see `CurlRequest` for simpler transfers where the size of the payload is
  *     known and relatively small.
  */
@@ -43,8 +51,13 @@ class CurlUploadRequest {
     if (not factory_) {
       return;
     }
+    if (event_loop_ and registered_) {
+      event_loop_->RemoveHandle(handle_.handle_.get());
+    }
     factory_->CleanupHandle(std::move(handle_.handle_));
-    factory_->CleanupMultiHandle(std::move(multi_));
+    if (multi_) {
+      factory_->CleanupMultiHandle(std::move(multi_));
+    }
   }
 
   CurlUploadRequest(CurlUploadRequest&& rhs) noexcept(false)
@@ -55,6 +68,9 @@ class CurlUploadRequest {
         handle_(std::move(rhs.handle_)),
         multi_(std::move(rhs.multi_)),
         factory_(std::move(rhs.factory_)),
+        event_loop_(std::move(rhs.event_loop_)),
+        registered_(rhs.registered_),
+        transfer_done_(rhs.transfer_done_),
         buffer_(std::move(rhs.buffer_)),
         buffer_rdptr_(rhs.buffer_rdptr_),
         closing_(rhs.closing_),
@@ -70,6 +86,9 @@ class CurlUploadRequest {
     handle_ = std::move(rhs.handle_);
     multi_ = std::move(rhs.multi_);
     factory_ = std::move(rhs.factory_);
+    event_loop_ = std::move(rhs.event_loop_);
+    registered_ = rhs.registered_;
+    transfer_done_ = rhs.transfer_done_;
     buffer_ = std::move(rhs.buffer_);
     buffer_rdptr_ = rhs.buffer_rdptr_;
     closing_ = rhs.closing_;
@@ -105,6 +124,18 @@ class CurlUploadRequest {
   /// Transfers the data out of libcurl internal buffer.
   std::size_t ReadCallback(char* ptr, std::size_t size, std::size_t nmemb);
 
+  /// Registers the handle with the event loop, if not already registered.
+  void StartOnEventLoop();
+
+  /// Called from the event loop thread when the transfer completes.
+  void OnTransferDone(Status status);
+
+  /// Implements `Flush()` when the transfer runs in a `CurlEventLoop`.
+  Status FlushOnEventLoop();
+
+  /// Implements `Close()` when the transfer runs in a `CurlEventLoop`.
+  StatusOr<HttpResponse> CloseOnEventLoop();
+
   /// Waits until a condition is met.
   template <typename Predicate>
   Status Wait(Predicate&& predicate) {
@@ -160,6 +191,17 @@ class CurlUploadRequest {
   CurlMulti multi_;
   std::shared_ptr<CurlHandleFactory> factory_;
 
+  // These members are only used when the transfer runs in a `CurlEventLoop`,
+  // in that case `mu_` guards `buffer_`, `buffer_rdptr_`, `closing_`,
+  // `transfer_done_` and `transfer_status_`, which are shared with the event
+  // loop thread.
+  std::shared_ptr<CurlEventLoop> event_loop_;
+  bool registered_ = false;
+  std::mutex mu_;
+  std::condition_variable cv_;
+  bool transfer_done_ = false;
+  Status transfer_status_;
+
   std::string buffer_;
   std::string::iterator buffer_rdptr_;
   // Closing the handle happens in two steps.
@@ -180,6 +180,52 @@ bool SslLibraryNeedsLocking(std::string const& curl_ssl_id) {
           curl_ssl_id.rfind("LibreSSL/2", 0) == 0);
 }
 
+void SetCurlTcpKeepAlive(CURL* handle, std::chrono::seconds interval) {
+  if (interval.count() <= 0) {
+    return;
+  }
+  auto const seconds = static_cast<long>(interval.count());
+  (void)curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+  (void)curl_easy_setopt(handle, CURLOPT_TCP_KEEPIDLE, seconds);
+  (void)curl_easy_setopt(handle, CURLOPT_TCP_KEEPINTVL, seconds);
+}
+
+void SetCurlMaximumConnectionIdleTime(CURL* handle,
+                                      std::chrono::seconds idle_time) {
+  if (idle_time.count() <= 0) {
+    return;
+  }
+#if LIBCURL_VERSION_NUM >= 0x074100
+  (void)curl_easy_setopt(handle, CURLOPT_MAXAGE_CONN,
+                         static_cast<long>(idle_time.count()));
+#else
+  (void)handle;
+#endif  // LIBCURL_VERSION_NUM >= 0x074100
+}
+
+void SetCurlHttp2(CURL* handle, bool enable) {
+  if (not enable) {
+    return;
+  }
+#if LIBCURL_VERSION_NUM >= 0x072F00
+  // Negotiate HTTP/2 over TLS, fallback to HTTP/1.1 otherwise. Prefer waiting
+  // for a connection that can multiplex over opening a new one.
+  (void)curl_easy_setopt(handle, CURLOPT_HTTP_VERSION,
+                         static_cast<long>(CURL_HTTP_VERSION_2TLS));
+  (void)curl_easy_setopt(handle, CURLOPT_PIPEWAIT, 1L);
+#else
+  (void)handle;
+#endif  // LIBCURL_VERSION_NUM >= 0x072F00
+}
+
+void SetCurlMultiplexing(CURLM* multi) {
+#if LIBCURL_VERSION_NUM >= 0x072B00
+  (void)curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+#else
+  (void)multi;
+#endif  // LIBCURL_VERSION_NUM >= 0x072B00
+}
+
 bool SslLockingCallbacksInstalled() {
 #if GOOGLE_CLOUD_CPP_SSL_REQUIRES_LOCKS
   return not ssl_locks.empty();
@@ -19,6 +19,7 @@
 #include "google/cloud/storage/version.h"
 #include "google/cloud/storage/well_known_parameters.h"
 #include <curl/curl.h>
+#include <chrono>
 #include <functional>
 #include <map>
 #include <memory>
@@ -57,6 +58,21 @@ std::string CurlSslLibraryId();
 /// Determines if the SSL library requires locking.
 bool SslLibraryNeedsLocking(std::string const& curl_ssl_id);
 
+/// Enables TCP keep-alive probes on @p handle, zero @p interval disables them.
+void SetCurlTcpKeepAlive(CURL* handle, std::chrono::seconds interval);
+
+/// Configures how long @p handle may reuse idle connections, zero is the
+/// libcurl default.
+void SetCurlMaximumConnectionIdleTime(CURL* handle,
+                                      std::chrono::seconds idle_time);
+
+/// Prefers HTTP/2 (over TLS) for @p handle, if @p enable is true and libcurl
+/// supports it.
+void SetCurlHttp2(CURL* handle, bool enable);
+
+/// Allows @p multi to multiplex transfers over the same HTTP/2 connection.
+void SetCurlMultiplexing(CURLM* multi);
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
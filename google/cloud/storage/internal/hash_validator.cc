@@ -13,8 +13,8 @@
 // limitations under the License.
 
 #include "google/cloud/storage/internal/hash_validator.h"
-#include "google/cloud/internal/big_endian.h"
 #include "google/cloud/log.h"
+#include "google/cloud/storage/internal/crc32c.h"
 #include "google/cloud/storage/internal/openssl_util.h"
 #include "google/cloud/storage/object_metadata.h"
 #include "google/cloud/status.h"
@@ -26,9 +26,9 @@ namespace storage {
 inline namespace STORAGE_CLIENT_NS {
 namespace internal {
 
-void CompositeValidator::Update(std::string const& payload) {
-  left_->Update(payload);
-  right_->Update(payload);
+void CompositeValidator::Update(char const* buf, std::size_t n) {
+  left_->Update(buf, n);
+  right_->Update(buf, n);
 }
 
 void CompositeValidator::ProcessMetadata(ObjectMetadata const& meta) {
@@ -56,8 +56,8 @@ HashValidator::Result CompositeValidator::Finish() && {
 
 MD5HashValidator::MD5HashValidator() : context_{} { MD5_Init(&context_); }
 
-void MD5HashValidator::Update(std::string const& payload) {
-  MD5_Update(&context_, payload.c_str(), payload.size());
+void MD5HashValidator::Update(char const* buf, std::size_t n) {
+  MD5_Update(&context_, buf, n);
 }
 
 void MD5HashValidator::ProcessMetadata(ObjectMetadata const& meta) {
@@ -98,10 +98,9 @@ HashValidator::Result MD5HashValidator::Finish() && {
 
 Crc32cHashValidator::Crc32cHashValidator() : current_(0) {}
 
-void Crc32cHashValidator::Update(std::string const& payload) {
-  current_ = crc32c::Extend(
-      current_, reinterpret_cast<std::uint8_t const*>(payload.data()),
-      payload.size());
+void Crc32cHashValidator::Update(char const* buf, std::size_t n) {
+  current_ =
+      crc32c::Extend(current_, reinterpret_cast<std::uint8_t const*>(buf), n);
 }
 
 void Crc32cHashValidator::ProcessMetadata(ObjectMetadata const& meta) {
@@ -132,16 +131,95 @@ void Crc32cHashValidator::ProcessHeader(std::string const& key,
 }
 
 HashValidator::Result Crc32cHashValidator::Finish() && {
-  std::uint32_t big_endian = google::cloud::internal::ToBigEndian(current_);
-  std::string hash;
-  hash.resize(sizeof(big_endian));
-  std::memcpy(&hash[0], &big_endian, sizeof(big_endian));
-  auto computed = OpenSslUtils::Base64Encode(hash);
+  auto computed = Crc32cToBase64(current_);
   bool is_mismatch =
       not received_hash_.empty() and (received_hash_ != computed);
   return Result{std::move(received_hash_), std::move(computed), is_mismatch};
 }
 
+BackgroundHashValidator::BackgroundHashValidator(
+    std::unique_ptr<HashValidator> validator, std::size_t max_pending_bytes)
+    : validator_(std::move(validator)),
+      max_pending_bytes_(max_pending_bytes),
+      worker_([this] { Run(); }) {}
+
+BackgroundHashValidator::~BackgroundHashValidator() { Shutdown(); }
+
+void BackgroundHashValidator::Update(char const* buf, std::size_t n) {
+  if (n == 0) {
+    return;
+  }
+  std::unique_lock<std::mutex> lk(mu_);
+  // Always accept at least one buffer, otherwise a single large `Update()`
+  // would block forever.
+  cv_.wait(lk, [this, n] {
+    return pending_bytes_ == 0 or pending_bytes_ + n <= max_pending_bytes_;
+  });
+  std::string buffer;
+  if (not free_buffers_.empty()) {
+    buffer = std::move(free_buffers_.back());
+    free_buffers_.pop_back();
+  }
+  buffer.assign(buf, n);
+  pending_bytes_ += n;
+  pending_.push_back(std::move(buffer));
+  cv_.notify_all();
+}
+
+void BackgroundHashValidator::ProcessMetadata(ObjectMetadata const& meta) {
+  std::unique_lock<std::mutex> lk(mu_);
+  Drain(lk);
+  validator_->ProcessMetadata(meta);
+}
+
+void BackgroundHashValidator::ProcessHeader(std::string const& key,
+                                            std::string const& value) {
+  std::unique_lock<std::mutex> lk(mu_);
+  Drain(lk);
+  validator_->ProcessHeader(key, value);
+}
+
+HashValidator::Result BackgroundHashValidator::Finish() && {
+  Shutdown();
+  return std::move(*validator_).Finish();
+}
+
+void BackgroundHashValidator::Run() {
+  std::unique_lock<std::mutex> lk(mu_);
+  while (true) {
+    cv_.wait(lk, [this] { return shutdown_ or not pending_.empty(); });
+    if (pending_.empty()) {
+      return;
+    }
+    auto buffer = std::move(pending_.front());
+    pending_.pop_front();
+    busy_ = true;
+    lk.unlock();
+    validator_->Update(buffer);
+    lk.lock();
+    busy_ = false;
+    pending_bytes_ -= buffer.size();
+    free_buffers_.push_back(std::move(buffer));
+    cv_.notify_all();
+  }
+}
+
+void BackgroundHashValidator::Drain(std::unique_lock<std::mutex>& lk) {
+  cv_.wait(lk, [this] { return pending_.empty() and not busy_; });
+}
+
+void BackgroundHashValidator::Shutdown() {
+  {
+    std::unique_lock<std::mutex> lk(mu_);
+    shutdown_ = true;
+    cv_.notify_all();
+  }
+  // The worker processes any pending data before exiting.
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+}
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
@@ -17,9 +17,15 @@
 
 #include "google/cloud/storage/version.h"
 #include <openssl/md5.h>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -38,7 +44,12 @@ class HashValidator {
   virtual std::string Name() const = 0;
 
   /// Update the computed hash value with some portion of the data.
-  virtual void Update(std::string const& payload) = 0;
+  virtual void Update(char const* buf, std::size_t n) = 0;
+
+  /// Update the computed hash value with some portion of the data.
+  void Update(std::string const& payload) {
+    Update(payload.data(), payload.size());
+  }
 
   /// Update the received hash value based on a ObjectMetadata response.
   virtual void ProcessMetadata(ObjectMetadata const& meta) = 0;
@@ -74,8 +85,9 @@ class NullHashValidator : public HashValidator {
  public:
   NullHashValidator() = default;
 
+  using HashValidator::Update;
   std::string Name() const override { return "null"; }
-  void Update(std::string const& payload) override {}
+  void Update(char const* buf, std::size_t n) override {}
   void ProcessMetadata(ObjectMetadata const& meta) override {}
   void ProcessHeader(std::string const& key,
                      std::string const& value) override {}
@@ -91,8 +103,9 @@ class CompositeValidator : public HashValidator {
                      std::unique_ptr<HashValidator> right)
       : left_(std::move(left)), right_(std::move(right)) {}
 
+  using HashValidator::Update;
   std::string Name() const override { return "composite"; }
-  void Update(std::string const& payload) override;
+  void Update(char const* buf, std::size_t n) override;
   void ProcessMetadata(ObjectMetadata const& meta) override;
   void ProcessHeader(std::string const& key, std::string const& value) override;
   Result Finish() && override;
@@ -112,8 +125,9 @@ class MD5HashValidator : public HashValidator {
   MD5HashValidator(MD5HashValidator const&) = delete;
   MD5HashValidator& operator=(MD5HashValidator const&) = delete;
 
+  using HashValidator::Update;
   std::string Name() const override { return "md5"; }
-  void Update(std::string const& payload) override;
+  void Update(char const* buf, std::size_t n) override;
   void ProcessMetadata(ObjectMetadata const& meta) override;
   void ProcessHeader(std::string const& key, std::string const& value) override;
   Result Finish() && override;
@@ -133,8 +147,9 @@ class Crc32cHashValidator : public HashValidator {
   Crc32cHashValidator(Crc32cHashValidator const&) = delete;
   Crc32cHashValidator& operator=(Crc32cHashValidator const&) = delete;
 
+  using HashValidator::Update;
   std::string Name() const override { return "crc32c"; }
-  void Update(std::string const& payload) override;
+  void Update(char const* buf, std::size_t n) override;
   void ProcessMetadata(ObjectMetadata const& meta) override;
   void ProcessHeader(std::string const& key, std::string const& value) override;
   Result Finish() && override;
@@ -144,6 +159,53 @@ class Crc32cHashValidator : public HashValidator {
   std::string received_hash_;
 };
 
+/**
+ * A validator that computes the hash of another validator in a worker thread.
+ *
+ * `Update()` copies the data into a queue and returns immediately, unless the
+ * queue already holds `max_pending_bytes`, in which case it blocks until the
+ * worker catches up. The other member functions wait until the worker has
+ * processed all the pending data, and then call the wrapped validator in the
+ * calling thread.
+ */
+class BackgroundHashValidator : public HashValidator {
+ public:
+  explicit BackgroundHashValidator(std::unique_ptr<HashValidator> validator,
+                                   std::size_t max_pending_bytes =
+                                       kDefaultMaxPendingBytes);
+  ~BackgroundHashValidator() override;
+
+  BackgroundHashValidator(BackgroundHashValidator const&) = delete;
+  BackgroundHashValidator& operator=(BackgroundHashValidator const&) = delete;
+
+  using HashValidator::Update;
+  std::string Name() const override { return validator_->Name(); }
+  void Update(char const* buf, std::size_t n) override;
+  void ProcessMetadata(ObjectMetadata const& meta) override;
+  void ProcessHeader(std::string const& key, std::string const& value) override;
+  Result Finish() && override;
+
+  static std::size_t const kDefaultMaxPendingBytes = 32 * 1024 * 1024;
+
+ private:
+  void Run();
+  void Drain(std::unique_lock<std::mutex>& lk);
+  void Shutdown();
+
+  std::unique_ptr<HashValidator> validator_;
+  std::size_t const max_pending_bytes_;
+  std::mutex mu_;
+  std::condition_variable cv_;
+  std::deque<std::string> pending_;
+  // Buffers already processed by the worker, kept to avoid allocating memory
+  // on each `Update()` call.
+  std::vector<std::string> free_buffers_;
+  std::size_t pending_bytes_ = 0;
+  bool busy_ = false;
+  bool shutdown_ = false;
+  std::thread worker_;
+};
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
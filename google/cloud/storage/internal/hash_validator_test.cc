@@ -215,6 +215,54 @@ TEST(CompositeHashValidator, Missing) {
   EXPECT_FALSE(result.is_mismatch);
 }
 
+TEST(BackgroundHashValidator, Simple) {
+  CompositeValidator validator(
+      google::cloud::internal::make_unique<BackgroundHashValidator>(
+          google::cloud::internal::make_unique<Crc32cHashValidator>()),
+      google::cloud::internal::make_unique<BackgroundHashValidator>(
+          google::cloud::internal::make_unique<MD5HashValidator>()));
+  validator.Update("The quick");
+  validator.Update(" brown");
+  validator.Update(" fox jumps over the lazy dog");
+  validator.ProcessHeader("x-goog-hash", "crc32c=" + QUICK_FOX_CRC32C_CHECKSUM);
+  validator.ProcessHeader("x-goog-hash", "md5=<invalid-md5-for-test>");
+  auto result = std::move(validator).Finish();
+  EXPECT_EQ("crc32c=" + QUICK_FOX_CRC32C_CHECKSUM +
+                ",md5=<invalid-md5-for-test>",
+            result.received);
+  EXPECT_EQ(
+      "crc32c=" + QUICK_FOX_CRC32C_CHECKSUM + ",md5=" + QUICK_FOX_MD5_HASH,
+      result.computed);
+  EXPECT_TRUE(result.is_mismatch);
+}
+
+TEST(BackgroundHashValidator, ManyUpdates) {
+  // Use a small limit for pending data, that forces Update() to block.
+  BackgroundHashValidator background(
+      google::cloud::internal::make_unique<Crc32cHashValidator>(), 1024);
+  Crc32cHashValidator expected;
+  std::string data;
+  for (int i = 0; i != 1000; ++i) {
+    data = "line " + std::to_string(i) + ": lorem ipsum dolor sit amet\n";
+    background.Update(data);
+    expected.Update(data);
+  }
+  // A single buffer larger than the limit is also accepted.
+  data = std::string(4096, 'x');
+  background.Update(data);
+  expected.Update(data);
+  EXPECT_EQ(std::move(expected).Finish().computed,
+            std::move(background).Finish().computed);
+}
+
+TEST(BackgroundHashValidator, DestroyWithPendingData) {
+  BackgroundHashValidator validator(
+      google::cloud::internal::make_unique<MD5HashValidator>());
+  validator.Update("The quick");
+  validator.Update(" brown");
+  // The destructor should not block or crash.
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
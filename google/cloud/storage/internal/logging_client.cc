@@ -78,6 +78,35 @@ MakeCallNoResponseLogging(
   GCP_LOG(INFO) << context << "() << " << request;
   return (client.*function)(request);
 }
+
+/**
+ * Logs the input of an asynchronous `RawClient` operation, and its results
+ * once the returned future is satisfied.
+ *
+ * @param client the storage::RawClient object to make the call through.
+ * @param function the pointer to the member function to call.
+ * @param request an initialized request parameter for the call.
+ * @param context include this string in the log messages.
+ * @return a future satisfied with the result of the call.
+ */
+template <typename T, typename Request>
+future<StatusOr<T>> MakeAsyncCall(
+    RawClient& client,
+    future<StatusOr<T>> (RawClient::*function)(Request const&),
+    Request const& request, char const* context) {
+  GCP_LOG(INFO) << context << "() << " << request;
+  return (client.*function)(request).then([context](future<StatusOr<T>> f) {
+    auto response = f.get();
+    if (response.ok()) {
+      GCP_LOG(INFO) << context << "() >> payload={" << response.value()
+                    << "}";
+    } else {
+      GCP_LOG(INFO) << context << "() >> status={" << response.status()
+                    << "}";
+    }
+    return response;
+  });
+}
 }  // namespace
 
 LoggingClient::LoggingClient(std::shared_ptr<RawClient> client)
@@ -215,6 +244,40 @@ LoggingClient::RestoreResumableSession(std::string const &request){
       *client_, &RawClient::RestoreResumableSession, request, __func__);
 }
 
+future<StatusOr<ObjectMetadata>> LoggingClient::AsyncInsertObjectMedia(
+    InsertObjectMediaRequest const& request) {
+  return MakeAsyncCall(*client_, &RawClient::AsyncInsertObjectMedia, request,
+                       __func__);
+}
+
+future<StatusOr<ObjectMetadata>> LoggingClient::AsyncGetObjectMetadata(
+    GetObjectMetadataRequest const& request) {
+  return MakeAsyncCall(*client_, &RawClient::AsyncGetObjectMetadata, request,
+                       __func__);
+}
+
+future<StatusOr<std::string>> LoggingClient::AsyncReadObject(
+    ReadObjectRangeRequest const& request) {
+  // Log only the size of the contents, they can be arbitrarily large.
+  char const* context = __func__;
+  GCP_LOG(INFO) << context << "() << " << request;
+  return client_->AsyncReadObject(request).then(
+      [context](future<StatusOr<std::string>> f) {
+        auto response = f.get();
+        if (response.ok()) {
+          GCP_LOG(INFO) << context << "() >> size=" << response->size();
+        } else {
+          GCP_LOG(INFO) << context << "() >> status={" << response.status()
+                        << "}";
+        }
+        return response;
+      });
+}
+
+future<void> LoggingClient::AsyncSleep(std::chrono::milliseconds duration) {
+  return client_->AsyncSleep(duration);
+}
+
 StatusOr<ListBucketAclResponse> LoggingClient::ListBucketAcl(
     ListBucketAclRequest const& request) {
   return MakeCall(*client_, &RawClient::ListBucketAcl, request, __func__);
@@ -124,12 +124,13 @@ std::ostream& operator<<(std::ostream& os, InsertObjectMediaRequest const& r);
  */
 class InsertObjectStreamingRequest
     : public GenericObjectRequest<
-          InsertObjectStreamingRequest, ContentEncoding, ContentType,
-          Crc32cChecksumValue, DisableCrc32cChecksum, DisableMD5Hash,
-          EncryptionKey, IfGenerationMatch, IfGenerationNotMatch,
-          IfMetagenerationMatch, IfMetagenerationNotMatch, KmsKeyName,
-          MD5HashValue, PredefinedAcl, Projection, UseResumableUploadSession,
-          UserProject, WithObjectMetadata> {
+          InsertObjectStreamingRequest, ComputeHashesInBackground,
+          ContentEncoding, ContentType, Crc32cChecksumValue,
+          DisableCrc32cChecksum, DisableMD5Hash, EncryptionKey,
+          IfGenerationMatch, IfGenerationNotMatch, IfMetagenerationMatch,
+          IfMetagenerationNotMatch, KmsKeyName, MD5HashValue, PredefinedAcl,
+          Projection, UseResumableUploadSession, UserProject,
+          WithObjectMetadata> {
  public:
   using GenericObjectRequest::GenericObjectRequest;
 };
@@ -177,10 +178,10 @@ std::ostream& operator<<(std::ostream& os, CopyObjectRequest const& r);
  */
 class ReadObjectRangeRequest
     : public GenericObjectRequest<
-          ReadObjectRangeRequest, DisableCrc32cChecksum, DisableMD5Hash,
-          EncryptionKey, Generation, IfGenerationMatch, IfGenerationNotMatch,
-          IfMetagenerationMatch, IfMetagenerationNotMatch, ReadRange,
-          UserProject> {
+          ReadObjectRangeRequest, ComputeHashesInBackground,
+          DisableCrc32cChecksum, DisableMD5Hash, EncryptionKey, Generation,
+          IfGenerationMatch, IfGenerationNotMatch, IfMetagenerationMatch,
+          IfMetagenerationNotMatch, ParallelDownload, ReadRange, UserProject> {
  public:
   using GenericObjectRequest::GenericObjectRequest;
 };
@@ -354,8 +355,8 @@ class ResumableUploadRequest
           Crc32cChecksumValue, DisableCrc32cChecksum, DisableMD5Hash,
           EncryptionKey, IfGenerationMatch, IfGenerationNotMatch,
           IfMetagenerationMatch, IfMetagenerationNotMatch, KmsKeyName,
-          MD5HashValue, PredefinedAcl, Projection, UseResumableUploadSession,
-          UserProject, WithObjectMetadata> {
+          MD5HashValue, ParallelUpload, PredefinedAcl, Projection,
+          UseResumableUploadSession, UserProject, WithObjectMetadata> {
  public:
   ResumableUploadRequest() = default;
 
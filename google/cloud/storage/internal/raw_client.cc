@@ -0,0 +1,69 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/raw_client.h"
+#include <iterator>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+template <typename T>
+future<T> MakeReadyFuture(T value) {
+  promise<T> p;
+  p.set_value(std::move(value));
+  return p.get_future();
+}
+}  // namespace
+
+future<StatusOr<ObjectMetadata>> RawClient::AsyncInsertObjectMedia(
+    InsertObjectMediaRequest const& request) {
+  return MakeReadyFuture(InsertObjectMedia(request));
+}
+
+future<StatusOr<ObjectMetadata>> RawClient::AsyncGetObjectMetadata(
+    GetObjectMetadataRequest const& request) {
+  return MakeReadyFuture(GetObjectMetadata(request));
+}
+
+future<StatusOr<std::string>> RawClient::AsyncReadObject(
+    ReadObjectRangeRequest const& request) {
+  auto buf = ReadObject(request);
+  if (not buf.ok()) {
+    return MakeReadyFuture(StatusOr<std::string>(std::move(buf).status()));
+  }
+  std::string contents{std::istreambuf_iterator<char>((*buf).get()),
+                       std::istreambuf_iterator<char>()};
+  (*buf)->Close();
+  if (not(*buf)->status().ok()) {
+    return MakeReadyFuture(StatusOr<std::string>((*buf)->status()));
+  }
+  return MakeReadyFuture(StatusOr<std::string>(std::move(contents)));
+}
+
+future<void> RawClient::AsyncSleep(std::chrono::milliseconds duration) {
+  std::this_thread::sleep_for(duration);
+  promise<void> p;
+  p.set_value();
+  return p.get_future();
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -15,6 +15,7 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_RAW_CLIENT_H_
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_RAW_CLIENT_H_
 
+#include "google/cloud/future.h"
 #include "google/cloud/status.h"
 #include "google/cloud/status_or.h"
 #include "google/cloud/storage/bucket_metadata.h"
@@ -32,6 +33,7 @@
 #include "google/cloud/storage/oauth2/credentials.h"
 #include "google/cloud/storage/object_metadata.h"
 #include "google/cloud/storage/service_account.h"
+#include <chrono>
 
 namespace google {
 namespace cloud {
@@ -95,6 +97,25 @@ class RawClient {
   RestoreResumableSession(std::string const& session_id) = 0;
   //@}
 
+  //@{
+  /**
+   * @name Asynchronous object resource operations
+   *
+   * The default implementations make the synchronous call and return a
+   * satisfied future, decorators and mocks do not need to override them.
+   * Clients with an event loop should override all of them.
+   */
+  virtual future<StatusOr<ObjectMetadata>> AsyncInsertObjectMedia(
+      InsertObjectMediaRequest const& request);
+  virtual future<StatusOr<ObjectMetadata>> AsyncGetObjectMetadata(
+      GetObjectMetadataRequest const& request);
+  /// Downloads the full object (or the requested range) into a string.
+  virtual future<StatusOr<std::string>> AsyncReadObject(
+      ReadObjectRangeRequest const& request);
+  /// Returns a future that becomes satisfied after @p duration.
+  virtual future<void> AsyncSleep(std::chrono::milliseconds duration);
+  //@}
+
   //@{
   /// @name BucketAccessControls resource operations
   virtual StatusOr<ListBucketAclResponse> ListBucketAcl(
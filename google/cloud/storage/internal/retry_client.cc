@@ -16,6 +16,7 @@
 #include "google/cloud/internal/make_unique.h"
 #include "google/cloud/storage/internal/raw_client_wrapper_utils.h"
 #include "google/cloud/storage/internal/retry_resumable_upload_session.h"
+#include <functional>
 #include <sstream>
 #include <thread>
 
@@ -106,6 +107,96 @@ MakeCall(RetryPolicy& retry_policy, BackoffPolicy& backoff_policy,
   os << "Retry policy exhausted in " << error_message << ": " << last_status;
   return error(std::move(os).str());
 }
+
+/**
+ * Runs an asynchronous operation with retries borrowing the RPC policies.
+ *
+ * This is the asynchronous version of `MakeCall()`, with the same error
+ * handling. The backoff between attempts is a timer scheduled with
+ * `RawClient::AsyncSleep()`, no thread blocks while the loop waits.
+ *
+ * @tparam T the type of the value returned by the operation.
+ */
+template <typename T>
+class AsyncRetryLoop : public std::enable_shared_from_this<AsyncRetryLoop<T>> {
+ public:
+  using Call = std::function<future<StatusOr<T>>(RawClient&)>;
+
+  AsyncRetryLoop(std::unique_ptr<RetryPolicy> retry_policy,
+                 std::unique_ptr<BackoffPolicy> backoff_policy,
+                 bool is_idempotent, std::shared_ptr<RawClient> client,
+                 Call call, char const* error_message)
+      : retry_policy_(std::move(retry_policy)),
+        backoff_policy_(std::move(backoff_policy)),
+        is_idempotent_(is_idempotent),
+        client_(std::move(client)),
+        call_(std::move(call)),
+        error_message_(error_message) {}
+
+  future<StatusOr<T>> Start() {
+    auto f = promise_.get_future();
+    StartAttempt();
+    return f;
+  }
+
+ private:
+  void StartAttempt() {
+    if (retry_policy_->IsExhausted()) {
+      Finish("Retry policy exhausted in ");
+      return;
+    }
+    auto self = this->shared_from_this();
+    call_(*client_).then(
+        [self](future<StatusOr<T>> f) { self->OnCompletion(f.get()); });
+  }
+
+  void OnCompletion(StatusOr<T> result) {
+    if (result.ok()) {
+      promise_.set_value(std::move(result));
+      return;
+    }
+    last_status_ = std::move(result).status();
+    if (not is_idempotent_) {
+      Finish("Error in non-idempotent operation ");
+      return;
+    }
+    if (not retry_policy_->OnFailure(last_status_)) {
+      Finish(retry_policy_->IsExhausted() ? "Retry policy exhausted in "
+                                          : "Permanent error in ");
+      return;
+    }
+    auto self = this->shared_from_this();
+    client_->AsyncSleep(backoff_policy_->OnCompletion())
+        .then([self](future<void>) { self->StartAttempt(); });
+  }
+
+  void Finish(char const* prefix) {
+    std::ostringstream os;
+    os << prefix << error_message_ << ": " << last_status_;
+    promise_.set_value(Status(last_status_.code(), std::move(os).str()));
+  }
+
+  std::unique_ptr<RetryPolicy> retry_policy_;
+  std::unique_ptr<BackoffPolicy> backoff_policy_;
+  bool is_idempotent_;
+  std::shared_ptr<RawClient> client_;
+  Call call_;
+  char const* error_message_;
+  Status last_status_;
+  promise<StatusOr<T>> promise_;
+};
+
+template <typename T>
+future<StatusOr<T>> MakeAsyncCall(
+    std::unique_ptr<RetryPolicy> retry_policy,
+    std::unique_ptr<BackoffPolicy> backoff_policy, bool is_idempotent,
+    std::shared_ptr<RawClient> client,
+    typename AsyncRetryLoop<T>::Call call, char const* error_message) {
+  auto loop = std::make_shared<AsyncRetryLoop<T>>(
+      std::move(retry_policy), std::move(backoff_policy), is_idempotent,
+      std::move(client), std::move(call), error_message);
+  return loop->Start();
+}
 }  // namespace
 
 RetryClient::RetryClient(std::shared_ptr<RawClient> client, DefaultPolicies)
@@ -365,6 +456,41 @@ RetryClient::RestoreResumableSession(std::string const& request) {
                    __func__);
 }
 
+future<StatusOr<ObjectMetadata>> RetryClient::AsyncInsertObjectMedia(
+    InsertObjectMediaRequest const& request) {
+  auto is_idempotent = idempotency_policy_->IsIdempotent(request);
+  return MakeAsyncCall<ObjectMetadata>(
+      retry_policy_->clone(), backoff_policy_->clone(), is_idempotent, client_,
+      [request](RawClient& client) {
+        return client.AsyncInsertObjectMedia(request);
+      },
+      __func__);
+}
+
+future<StatusOr<ObjectMetadata>> RetryClient::AsyncGetObjectMetadata(
+    GetObjectMetadataRequest const& request) {
+  auto is_idempotent = idempotency_policy_->IsIdempotent(request);
+  return MakeAsyncCall<ObjectMetadata>(
+      retry_policy_->clone(), backoff_policy_->clone(), is_idempotent, client_,
+      [request](RawClient& client) {
+        return client.AsyncGetObjectMetadata(request);
+      },
+      __func__);
+}
+
+future<StatusOr<std::string>> RetryClient::AsyncReadObject(
+    ReadObjectRangeRequest const& request) {
+  auto is_idempotent = idempotency_policy_->IsIdempotent(request);
+  return MakeAsyncCall<std::string>(
+      retry_policy_->clone(), backoff_policy_->clone(), is_idempotent, client_,
+      [request](RawClient& client) { return client.AsyncReadObject(request); },
+      __func__);
+}
+
+future<void> RetryClient::AsyncSleep(std::chrono::milliseconds duration) {
+  return client_->AsyncSleep(duration);
+}
+
 StatusOr<ListBucketAclResponse> RetryClient::ListBucketAcl(
     ListBucketAclRequest const& request) {
   auto retry_policy = retry_policy_->clone();
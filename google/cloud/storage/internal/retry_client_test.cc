@@ -90,6 +90,100 @@ TEST_F(RetryClientTest, TooManyTransientsHandling) {
   EXPECT_EQ(TransientError().status_code(), result.status().status_code());
 }
 
+/// A mock that records the backoff requests instead of sleeping.
+class AsyncSleepMockClient : public testing::MockClient {
+ public:
+  future<void> AsyncSleep(std::chrono::milliseconds duration) override {
+    sleeps.push_back(duration);
+    promise<void> p;
+    p.set_value();
+    return p.get_future();
+  }
+
+  std::vector<std::chrono::milliseconds> sleeps;
+};
+
+/// @test Verify that the asynchronous retry loop uses AsyncSleep().
+TEST_F(RetryClientTest, AsyncRetryUsesAsyncSleep) {
+  auto async_mock = std::make_shared<AsyncSleepMockClient>();
+  RetryClient client(std::shared_ptr<internal::RawClient>(async_mock),
+                     LimitedErrorCountRetryPolicy(3),
+                     ExponentialBackoffPolicy(10_ms, 40_ms, 2));
+
+  EXPECT_CALL(*async_mock, GetObjectMetadata(_))
+      .WillOnce(Return(StatusOr<ObjectMetadata>(TransientError())))
+      .WillOnce(Return(StatusOr<ObjectMetadata>(TransientError())))
+      .WillOnce(Return(make_status_or(ObjectMetadata{})));
+
+  StatusOr<ObjectMetadata> result =
+      client
+          .AsyncGetObjectMetadata(
+              GetObjectMetadataRequest("test-bucket", "test-object"))
+          .get();
+  EXPECT_TRUE(result.ok()) << "status=" << result.status();
+  EXPECT_EQ(2U, async_mock->sleeps.size());
+}
+
+/// @test Verify that the asynchronous retry loop stops on permanent errors.
+TEST_F(RetryClientTest, AsyncPermanentErrorHandling) {
+  RetryClient client(std::shared_ptr<internal::RawClient>(mock),
+                     LimitedErrorCountRetryPolicy(3),
+                     // Make the tests faster.
+                     ExponentialBackoffPolicy(1_us, 2_us, 2));
+
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Return(StatusOr<ObjectMetadata>(TransientError())))
+      .WillOnce(Return(StatusOr<ObjectMetadata>(PermanentError())));
+
+  StatusOr<ObjectMetadata> result =
+      client
+          .AsyncGetObjectMetadata(
+              GetObjectMetadataRequest("test-bucket", "test-object"))
+          .get();
+  EXPECT_EQ(PermanentError().status_code(), result.status().status_code());
+  EXPECT_THAT(result.status().error_message(), HasSubstr("Permanent error in"));
+}
+
+/// @test Verify that the asynchronous retry loop respects the retry policy.
+TEST_F(RetryClientTest, AsyncTooManyTransientsHandling) {
+  RetryClient client(std::shared_ptr<internal::RawClient>(mock),
+                     LimitedErrorCountRetryPolicy(3),
+                     // Make the tests faster.
+                     ExponentialBackoffPolicy(1_us, 2_us, 2));
+
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillRepeatedly(Return(StatusOr<ObjectMetadata>(TransientError())));
+
+  StatusOr<ObjectMetadata> result =
+      client
+          .AsyncGetObjectMetadata(
+              GetObjectMetadataRequest("test-bucket", "test-object"))
+          .get();
+  EXPECT_EQ(TransientError().status_code(), result.status().status_code());
+  EXPECT_THAT(result.status().error_message(),
+              HasSubstr("Retry policy exhausted"));
+}
+
+/// @test Verify that non-idempotent asynchronous operations are not retried.
+TEST_F(RetryClientTest, AsyncNonIdempotentErrorHandling) {
+  RetryClient client(std::shared_ptr<internal::RawClient>(mock),
+                     LimitedErrorCountRetryPolicy(3), StrictIdempotencyPolicy(),
+                     // Make the tests faster.
+                     ExponentialBackoffPolicy(1_us, 2_us, 2));
+
+  EXPECT_CALL(*mock, InsertObjectMedia(_))
+      .WillOnce(Return(StatusOr<ObjectMetadata>(TransientError())));
+
+  StatusOr<ObjectMetadata> result =
+      client
+          .AsyncInsertObjectMedia(InsertObjectMediaRequest(
+              "test-bucket", "test-object", "test contents"))
+          .get();
+  EXPECT_EQ(TransientError().status_code(), result.status().status_code());
+  EXPECT_THAT(result.status().error_message(),
+              HasSubstr("Error in non-idempotent operation"));
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
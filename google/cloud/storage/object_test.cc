@@ -31,6 +31,7 @@ using ::testing::Invoke;
 using ::testing::Return;
 using ::testing::ReturnRef;
 using ms = std::chrono::milliseconds;
+using testing::canonical_errors::PermanentError;
 using testing::canonical_errors::TransientError;
 
 /**
@@ -169,6 +170,65 @@ TEST_F(ObjectTest, GetObjectMetadataPermanentFailure) {
       "GetObjectMetadata");
 }
 
+TEST_F(ObjectTest, AsyncGetObjectMetadata) {
+  auto expected = ObjectMetadata::ParseFromString(R"""({
+      "bucket": "test-bucket-name",
+      "generation": "12345",
+      "name": "test-object-name"
+})""").value();
+
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Return(StatusOr<ObjectMetadata>(TransientError())))
+      .WillOnce(
+          Invoke([&expected](internal::GetObjectMetadataRequest const& r) {
+            EXPECT_EQ("test-bucket-name", r.bucket_name());
+            EXPECT_EQ("test-object-name", r.object_name());
+            return make_status_or(expected);
+          }));
+  Client client{std::shared_ptr<internal::RawClient>(mock),
+                LimitedErrorCountRetryPolicy(2)};
+
+  auto actual =
+      client.AsyncGetObjectMetadata("test-bucket-name", "test-object-name")
+          .get();
+  ASSERT_TRUE(actual.ok()) << "status=" << actual.status();
+  EXPECT_EQ(expected, *actual);
+}
+
+TEST_F(ObjectTest, AsyncGetObjectMetadataPermanentFailure) {
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Return(StatusOr<ObjectMetadata>(PermanentError())));
+
+  auto actual =
+      client->AsyncGetObjectMetadata("test-bucket-name", "test-object-name")
+          .get();
+  EXPECT_EQ(PermanentError().code(), actual.status().code());
+}
+
+TEST_F(ObjectTest, AsyncInsertObject) {
+  auto expected = ObjectMetadata::ParseFromString(R"""({
+      "name": "test-bucket-name/test-object-name/1"
+})""").value();
+
+  EXPECT_CALL(*mock, InsertObjectMedia(_))
+      .WillOnce(Return(StatusOr<ObjectMetadata>(TransientError())))
+      .WillOnce(Invoke(
+          [&expected](internal::InsertObjectMediaRequest const& request) {
+            EXPECT_EQ("test-bucket-name", request.bucket_name());
+            EXPECT_EQ("test-object-name", request.object_name());
+            EXPECT_EQ("test object contents", request.contents());
+            return make_status_or(expected);
+          }));
+
+  auto actual = client
+                    ->AsyncInsertObject("test-bucket-name", "test-object-name",
+                                        "test object contents",
+                                        IfGenerationMatch(0))
+                    .get();
+  ASSERT_TRUE(actual.ok()) << "status=" << actual.status();
+  EXPECT_EQ(expected, *actual);
+}
+
 TEST_F(ObjectTest, DeleteObject) {
   EXPECT_CALL(*mock, DeleteObject(_))
       .WillOnce(Return(StatusOr<internal::EmptyResponse>(TransientError())))
@@ -31,9 +31,11 @@ storage_client_hdrs = [
     "internal/complex_option.h",
     "internal/common_metadata.h",
     "internal/compute_engine_util.h",
+    "internal/crc32c.h",
     "internal/curl_handle.h",
     "internal/curl_handle_factory.h",
     "internal/curl_download_request.h",
+    "internal/curl_event_loop.h",
     "internal/curl_request.h",
     "internal/curl_request_builder.h",
     "internal/curl_resumable_streambuf.h",
@@ -109,9 +111,11 @@ storage_client_srcs = [
     "internal/bucket_acl_requests.cc",
     "internal/bucket_requests.cc",
     "internal/compute_engine_util.cc",
+    "internal/crc32c.cc",
     "internal/curl_handle.cc",
     "internal/curl_handle_factory.cc",
     "internal/curl_download_request.cc",
+    "internal/curl_event_loop.cc",
     "internal/curl_request.cc",
     "internal/curl_request_builder.cc",
     "internal/curl_resumable_streambuf.cc",
@@ -134,6 +138,7 @@ storage_client_srcs = [
     "internal/object_requests.cc",
     "internal/object_streambuf.cc",
     "internal/parse_rfc3339.cc",
+    "internal/raw_client.cc",
     "internal/retry_client.cc",
     "internal/retry_resumable_upload_session.cc",
     "internal/service_account_requests.cc",
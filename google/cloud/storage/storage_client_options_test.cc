@@ -122,6 +122,49 @@ TEST_F(ClientOptionsTest, SetdownloadBufferSize) {
   EXPECT_EQ(default_size, client_options.download_buffer_size());
 }
 
+TEST_F(ClientOptionsTest, SetEventLoopThreadCount) {
+  ClientOptions client_options(oauth2::CreateAnonymousCredentials());
+  EXPECT_EQ(0U, client_options.event_loop_thread_count());
+  client_options.set_event_loop_thread_count(4);
+  EXPECT_EQ(4U, client_options.event_loop_thread_count());
+}
+
+TEST_F(ClientOptionsTest, SetConnectionPoolPrewarm) {
+  ClientOptions client_options(oauth2::CreateAnonymousCredentials());
+  EXPECT_FALSE(client_options.enable_connection_pool_prewarm());
+  client_options.set_enable_connection_pool_prewarm(true);
+  EXPECT_TRUE(client_options.enable_connection_pool_prewarm());
+}
+
+TEST_F(ClientOptionsTest, SetConnectionPoolPrewarmTimeout) {
+  ClientOptions client_options(oauth2::CreateAnonymousCredentials());
+  EXPECT_LT(0, client_options.connection_pool_prewarm_timeout().count());
+  client_options.set_connection_pool_prewarm_timeout(
+      std::chrono::milliseconds(250));
+  EXPECT_EQ(250, client_options.connection_pool_prewarm_timeout().count());
+}
+
+TEST_F(ClientOptionsTest, SetTcpKeepAliveInterval) {
+  ClientOptions client_options(oauth2::CreateAnonymousCredentials());
+  EXPECT_EQ(0, client_options.tcp_keepalive_interval().count());
+  client_options.set_tcp_keepalive_interval(std::chrono::seconds(30));
+  EXPECT_EQ(30, client_options.tcp_keepalive_interval().count());
+}
+
+TEST_F(ClientOptionsTest, SetMaximumConnectionIdleTime) {
+  ClientOptions client_options(oauth2::CreateAnonymousCredentials());
+  EXPECT_EQ(0, client_options.maximum_connection_idle_time().count());
+  client_options.set_maximum_connection_idle_time(std::chrono::seconds(60));
+  EXPECT_EQ(60, client_options.maximum_connection_idle_time().count());
+}
+
+TEST_F(ClientOptionsTest, SetEnableHttp2) {
+  ClientOptions client_options(oauth2::CreateAnonymousCredentials());
+  EXPECT_FALSE(client_options.enable_http2());
+  client_options.set_enable_http2(true);
+  EXPECT_TRUE(client_options.enable_http2());
+}
+
 TEST_F(ClientOptionsTest, SetUploadBufferSize) {
   ClientOptions client_options;
   auto default_size = client_options.upload_buffer_size();
@@ -22,12 +22,14 @@ storage_client_unit_tests = [
     "bucket_test.cc",
     "client_bucket_acl_test.cc",
     "client_default_object_acl_test.cc",
+    "client_download_file_test.cc",
     "client_object_acl_test.cc",
     "client_object_copy_test.cc",
     "client_service_account_test.cc",
     "client_notifications_test.cc",
     "client_sign_url_test.cc",
     "client_test.cc",
+    "client_upload_file_test.cc",
     "client_write_object_test.cc",
     "hashing_options_test.cc",
     "idempotency_policy_test.cc",
@@ -36,7 +38,10 @@ storage_client_unit_tests = [
     "internal/bucket_acl_requests_test.cc",
     "internal/bucket_requests_test.cc",
     "internal/compute_engine_util_test.cc",
+    "internal/crc32c_test.cc",
     "internal/curl_client_test.cc",
+    "internal/curl_event_loop_test.cc",
+    "internal/curl_handle_factory_test.cc",
     "internal/curl_resumable_upload_session_test.cc",
     "internal/curl_wrappers_locking_already_present_test.cc",
     "internal/curl_wrappers_locking_enabled_test.cc",
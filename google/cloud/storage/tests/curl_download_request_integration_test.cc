@@ -17,6 +17,7 @@
 #include "google/cloud/storage/internal/curl_request_builder.h"
 #include <gmock/gmock.h>
 #include <cstdlib>
+#include <future>
 #include <vector>
 
 namespace google {
@@ -74,6 +75,40 @@ TEST(CurlDownloadRequestTest, SimpleStream) {
   EXPECT_EQ(kDownloadedLines, count);
 }
 
+TEST(CurlDownloadRequestTest, EventLoopStreams) {
+  constexpr int kStreamCount = 8;
+  auto event_loop = std::make_shared<CurlEventLoop>();
+
+  std::vector<std::future<void>> tasks;
+  for (int i = 0; i != kStreamCount; ++i) {
+    tasks.emplace_back(std::async(std::launch::async, [event_loop] {
+      int const kDownloadedLines = 100;
+      storage::internal::CurlRequestBuilder request(
+          HttpBinEndpoint() + "/stream/" + std::to_string(kDownloadedLines),
+          storage::internal::GetDefaultCurlHandleFactory());
+      // Use a small buffer to force the transfer to pause and resume.
+      request.SetEventLoop(event_loop).SetInitialBufferSize(256);
+      auto download = request.BuildDownloadRequest(std::string{});
+
+      StatusOr<HttpResponse> response;
+      std::iterator_traits<std::string::iterator>::difference_type count = 0;
+      do {
+        std::string buffer;
+        response = download.GetMore(buffer);
+        ASSERT_TRUE(response.ok()) << "status=" << response.status();
+        count += std::count(buffer.begin(), buffer.end(), '\n');
+      } while (response->status_code == 100);
+
+      EXPECT_EQ(200, response->status_code);
+      EXPECT_EQ(kDownloadedLines, count);
+    }));
+  }
+  for (auto& t : tasks) {
+    t.get();
+  }
+  EXPECT_EQ(0U, event_loop->size());
+}
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
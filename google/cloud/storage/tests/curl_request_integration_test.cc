@@ -14,6 +14,7 @@
 
 #include "google/cloud/log.h"
 #include "google/cloud/internal/getenv.h"
+#include "google/cloud/storage/internal/curl_event_loop.h"
 #include "google/cloud/storage/internal/curl_request_builder.h"
 #include "google/cloud/storage/internal/nljson.h"
 #include <gmock/gmock.h>
@@ -403,6 +404,36 @@ TEST(CurlRequestTest, Logging) {
   EXPECT_THAT(log_messages, HasSubstr("curl(Recv Header)"));
   EXPECT_THAT(log_messages, HasSubstr("curl(Recv Data)"));
 }
+
+/// @test Verify that concurrent HTTP/2 requests share a connection.
+TEST(CurlRequestTest, Http2Multiplexing) {
+  auto const endpoint = HttpBinEndpoint();
+  // HTTP/2 is only negotiated over TLS, and only if libcurl supports it.
+  auto const* info = curl_version_info(CURLVERSION_NOW);
+  bool const multiplexed = endpoint.rfind("https://", 0) == 0 and
+                           (info->features & CURL_VERSION_HTTP2) != 0;
+
+  auto loop = CurlEventLoop::Create();
+  std::vector<future<StatusOr<HttpResponse>>> pending;
+  for (int i = 0; i != 8; ++i) {
+    storage::internal::CurlRequestBuilder request(
+        endpoint + "/get", storage::internal::GetDefaultCurlHandleFactory());
+    request.SetHttp2(true);
+    request.AddHeader("Accept: application/json");
+    pending.push_back(CurlRequest::MakeRequestAsync(request.BuildRequest(),
+                                                    loop, std::string{}));
+  }
+  for (auto& f : pending) {
+    auto response = f.get();
+    ASSERT_TRUE(response.ok()) << "status=" << response.status();
+    EXPECT_EQ(200, response->status_code);
+  }
+  if (multiplexed) {
+    EXPECT_EQ(1U, loop->connection_count());
+  } else {
+    EXPECT_LE(1U, loop->connection_count());
+  }
+}
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
@@ -19,6 +19,7 @@
 #include "google/cloud/storage/internal/curl_streambuf.h"
 #include "google/cloud/storage/object_stream.h"
 #include <gmock/gmock.h>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -88,6 +89,42 @@ TEST(CurlStreambufIntegrationTest, WriteManyBytes) {
   EXPECT_EQ(expected, parsed.value("data", ""));
 }
 
+TEST(CurlStreambufIntegrationTest, ReadLargeChunks) {
+  // The /range/{n} endpoint returns `n` bytes, cycling over 'a' to 'z'.
+  std::size_t const size = 64 * 1024;
+  std::size_t const buffer_size = 1024;
+  internal::CurlRequestBuilder builder(
+      HttpBinEndpoint() + "/range/" + std::to_string(size),
+      internal::GetDefaultCurlHandleFactory());
+  builder.SetInitialBufferSize(buffer_size);
+  std::unique_ptr<internal::CurlReadStreambuf> buf(
+      new internal::CurlReadStreambuf(
+          builder.BuildDownloadRequest(std::string{}), buffer_size,
+          google::cloud::internal::make_unique<internal::NullHashValidator>()));
+  ObjectReadStream reader(std::move(buf));
+
+  // Mix small reads, served from the get area, and large reads, which are
+  // written directly into `chunk`.
+  std::string actual;
+  char c;
+  ASSERT_TRUE(reader.get(c));
+  actual.push_back(c);
+  std::vector<char> chunk(4 * buffer_size);
+  while (reader.read(chunk.data(), chunk.size())) {
+    actual.append(chunk.data(), chunk.size());
+  }
+  actual.append(chunk.data(), static_cast<std::size_t>(reader.gcount()));
+  EXPECT_TRUE(reader.status().ok()) << "status=" << reader.status();
+
+  std::string expected;
+  for (std::size_t i = 0; i != size; ++i) {
+    expected.push_back(static_cast<char>('a' + i % 26));
+  }
+  // Printing the delta in EXPECT_EQ() for 64KiB strings is just distracting.
+  ASSERT_EQ(expected.size(), actual.size());
+  EXPECT_TRUE(expected == actual);
+}
+
 }  // namespace
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
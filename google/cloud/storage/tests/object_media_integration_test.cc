@@ -119,6 +119,36 @@ TEST_F(ObjectMediaIntegrationTest, JsonDownloadFile) {
   EXPECT_EQ(0, std::remove(file_name.c_str()));
 }
 
+TEST_F(ObjectMediaIntegrationTest, ParallelDownloadFile) {
+  Client client;
+  auto bucket_name = ObjectMediaTestEnvironment::bucket_name();
+  auto object_name = MakeRandomObjectName();
+  auto file_name = MakeRandomObjectName();
+
+  // We will construct the expected response while streaming the data up.
+  std::ostringstream expected;
+  // Create an object with the contents to download.
+  auto upload =
+      client.WriteObject(bucket_name, object_name, IfGenerationMatch(0));
+  WriteRandomLines(upload, expected);
+  upload.Close();
+  ObjectMetadata meta = upload.metadata().value();
+
+  // Use small slices, so the download uses all the streams.
+  client.DownloadToFile(bucket_name, object_name, file_name,
+                        ParallelDownload(4, 1024));
+  // Create a iostream to read the object back.
+  std::ifstream stream(file_name);
+  std::string actual(std::istreambuf_iterator<char>{stream}, {});
+  ASSERT_FALSE(actual.empty());
+  auto expected_str = expected.str();
+  ASSERT_EQ(expected_str.size(), actual.size()) << " meta=" << meta;
+  EXPECT_EQ(expected_str, actual);
+
+  client.DeleteObject(bucket_name, object_name);
+  EXPECT_EQ(0, std::remove(file_name.c_str()));
+}
+
 TEST_F(ObjectMediaIntegrationTest, DownloadFileFailure) {
   Client client;
   auto bucket_name = ObjectMediaTestEnvironment::bucket_name();
@@ -240,6 +270,50 @@ TEST_F(ObjectMediaIntegrationTest, UploadFile) {
   EXPECT_EQ(0, std::remove(file_name.c_str()));
 }
 
+TEST_F(ObjectMediaIntegrationTest, AsyncInsertReadAndGetMetadata) {
+  Client client;
+  auto bucket_name = ObjectMediaTestEnvironment::bucket_name();
+  auto object_name = MakeRandomObjectName();
+
+  std::ostringstream contents;
+  std::ostringstream expected;
+  WriteRandomLines(contents, expected);
+  auto expected_str = expected.str();
+
+  // Start the insert and the read of a missing object, neither blocks.
+  auto insert = client.AsyncInsertObject(bucket_name, object_name,
+                                         contents.str(), IfGenerationMatch(0));
+  auto missing = client.AsyncGetObjectMetadata(bucket_name,
+                                               object_name + "-not-there");
+
+  StatusOr<ObjectMetadata> meta = insert.get();
+  ASSERT_TRUE(meta.ok()) << "status=" << meta.status();
+  EXPECT_EQ(object_name, meta->name());
+  EXPECT_EQ(bucket_name, meta->bucket());
+  EXPECT_EQ(expected_str.size(), meta->size());
+
+  StatusOr<ObjectMetadata> not_found = missing.get();
+  EXPECT_EQ(StatusCode::kNotFound, not_found.status().code());
+
+  StatusOr<ObjectMetadata> get =
+      client.AsyncGetObjectMetadata(bucket_name, object_name).get();
+  ASSERT_TRUE(get.ok()) << "status=" << get.status();
+  EXPECT_EQ(meta->generation(), get->generation());
+
+  StatusOr<std::string> actual =
+      client.AsyncReadObject(bucket_name, object_name).get();
+  ASSERT_TRUE(actual.ok()) << "status=" << actual.status();
+  EXPECT_EQ(expected_str, *actual);
+
+  StatusOr<std::string> range =
+      client.AsyncReadObject(bucket_name, object_name, ReadRange(10, 20))
+          .get();
+  ASSERT_TRUE(range.ok()) << "status=" << range.status();
+  EXPECT_EQ(expected_str.substr(10, 10), *range);
+
+  client.DeleteObject(bucket_name, object_name);
+}
+
 TEST_F(ObjectMediaIntegrationTest, UploadFileEmpty) {
   Client client;
   auto file_name = ::testing::TempDir() + MakeRandomObjectName();
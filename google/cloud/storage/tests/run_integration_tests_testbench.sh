@@ -33,6 +33,10 @@ echo
 echo "Running Storage integration tests against local servers."
 start_testbench
 
+echo
+echo "Running storage::internal::CurlClient integration test."
+./curl_client_integration_test
+
 echo
 echo "Running storage::internal::CurlRequest integration test."
 ./curl_request_integration_test
@@ -18,6 +18,7 @@
 
 storage_client_integration_tests = [
     "bucket_integration_test.cc",
+    "curl_client_integration_test.cc",
     "curl_upload_request_integration_test.cc",
     "curl_download_request_integration_test.cc",
     "curl_request_integration_test.cc",
@@ -16,6 +16,8 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_UPLOAD_OPTIONS_H_
 
 #include "google/cloud/storage/internal/complex_option.h"
+#include <cstdint>
+#include <iostream>
 #include <string>
 
 namespace google {
@@ -49,6 +51,47 @@ inline UseResumableUploadSession NewResumableUploadSession() {
   return UseResumableUploadSession("");
 }
 
+struct ParallelUploadData {
+  int stream_count;
+  std::int64_t minimum_part_size;
+};
+
+/**
+ * Upload a file using multiple concurrent streams.
+ *
+ * By default `Client::UploadFile()` uploads the file using a single stream.
+ * With this option the file is split into (at most) `stream_count` parts, each
+ * one is uploaded concurrently as a temporary object, and then the parts are
+ * combined using `ComposeObject()`. Parts are never smaller than
+ * `minimum_part_size`, so small files use fewer streams.
+ *
+ * The temporary objects are named after the destination object, with a random
+ * suffix, and are deleted once the upload completes or fails. The CRC32C
+ * checksum of each part is verified, and so is the checksum of the composed
+ * object. If the request includes a `Crc32cChecksumValue` it is compared
+ * against the checksum of the parts before composing the destination.
+ *
+ * Composite objects do not have an MD5 hash, and `ComposeObject()` does not
+ * support the `IfGenerationNotMatch` or `IfMetagenerationNotMatch`
+ * pre-conditions. Requests with any of the `MD5HashValue`,
+ * `IfGenerationNotMatch`, or `IfMetagenerationNotMatch` options use a single
+ * stream.
+ */
+struct ParallelUpload
+    : public internal::ComplexOption<ParallelUpload, ParallelUploadData> {
+  ParallelUpload() : ComplexOption() {}
+  explicit ParallelUpload(int stream_count,
+                          std::int64_t minimum_part_size = 16 * 1024 * 1024)
+      : ComplexOption(ParallelUploadData{stream_count, minimum_part_size}) {}
+  static char const* name() { return "parallel-upload"; }
+};
+
+inline std::ostream& operator<<(std::ostream& os,
+                                ParallelUploadData const& rhs) {
+  return os << "ParallelUploadData={stream_count=" << rhs.stream_count
+            << ", minimum_part_size=" << rhs.minimum_part_size << "}";
+}
+
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
 }  // namespace cloud